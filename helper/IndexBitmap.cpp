@@ -0,0 +1,104 @@
+#include "IndexBitmap.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+namespace xamidi {
+namespace helper {
+
+namespace {
+constexpr uint32_t arrayContainerLimit = 4096; // arrays of up to 4096 16-bit offsets (8 KiB) are no larger than dense containers of 2^16 bits (8 KiB)
+constexpr uint64_t containerWords = IndexBitmap::containerBits / 64;
+
+// Bits of word 'w' that represent indices in [0, end).
+uint64_t maskTo(uint64_t w, uint64_t end) {
+	return w * 64 + 64 <= end ? UINT64_MAX : w * 64 < end ? (uint64_t(1) << (end - w * 64)) - 1 : 0;
+}
+}
+
+IndexBitmap::IndexBitmap(uint64_t size) :
+		bits(size), words(make_unique<atomic<uint64_t>[]>((size + 63) / 64)) {
+	for (uint64_t w = 0; w < (size + 63) / 64; w++)
+		words[w].store(0, memory_order_relaxed);
+}
+
+uint64_t IndexBitmap::count() const {
+	uint64_t result = 0;
+	for (uint64_t w = 0; w < (bits + 63) / 64; w++)
+		result += popcount(words[w].load(memory_order_relaxed));
+	return result;
+}
+
+void IndexBitmap::encode(uint64_t first, uint64_t amount, string& out) const {
+	if (first % containerBits)
+		throw invalid_argument("IndexBitmap::encode(): Range must begin at a container.");
+	uint64_t end = min(first + amount, bits);
+	for (uint64_t begin = first; begin < end; begin += containerBits) {
+		uint64_t wordBegin = begin / 64;
+		uint64_t wordEnd = min(wordBegin + containerWords, (end + 63) / 64);
+		auto word = [&](uint64_t w) { return words[w].load(memory_order_relaxed) & maskTo(w, end); }; // NOTE: Bits at or after 'end' belong to another range.
+		uint32_t cardinality = 0;
+		for (uint64_t w = wordBegin; w < wordEnd; w++)
+			cardinality += popcount(word(w));
+		out.append(reinterpret_cast<const char*>(&cardinality), sizeof(cardinality));
+		if (!cardinality)
+			continue;
+		if (cardinality <= arrayContainerLimit) { // sparse
+			for (uint64_t w = wordBegin; w < wordEnd; w++)
+				for (uint64_t remaining = word(w); remaining; remaining &= remaining - 1) {
+					uint16_t offset = static_cast<uint16_t>((w - wordBegin) * 64 + countr_zero(remaining));
+					out.append(reinterpret_cast<const char*>(&offset), sizeof(offset));
+				}
+		} else // dense
+			for (uint64_t w = wordBegin; w < wordBegin + containerWords; w++) {
+				uint64_t value = w < wordEnd ? word(w) : 0;
+				out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+			}
+	}
+}
+
+void IndexBitmap::merge(uint64_t first, uint64_t amount, string_view encoding) {
+	if (first % containerBits)
+		throw invalid_argument("IndexBitmap::merge(): Range must begin at a container.");
+	uint64_t end = min(first + amount, bits);
+	size_t pos = 0;
+	auto read = [&](void* dest, size_t size) {
+		if (pos + size > encoding.size())
+			throw invalid_argument("IndexBitmap::merge(): Truncated encoding.");
+		memcpy(dest, encoding.data() + pos, size);
+		pos += size;
+	};
+	for (uint64_t begin = first; begin < end; begin += containerBits) {
+		uint64_t wordBegin = begin / 64;
+		uint32_t cardinality;
+		read(&cardinality, sizeof(cardinality));
+		if (!cardinality)
+			continue;
+		if (cardinality <= arrayContainerLimit) // sparse
+			for (uint32_t k = 0; k < cardinality; k++) {
+				uint16_t offset;
+				read(&offset, sizeof(offset));
+				if (begin + offset >= end)
+					throw invalid_argument("IndexBitmap::merge(): Index " + to_string(begin + offset) + " out of range.");
+				set(begin + offset);
+			}
+		else // dense
+			for (uint64_t w = wordBegin; w < wordBegin + containerWords; w++) {
+				uint64_t word;
+				read(&word, sizeof(word));
+				if (uint64_t outside = word & ~maskTo(w, end)) // NOTE: This includes bits after 'end' within the last (partial) word of the range.
+					throw invalid_argument("IndexBitmap::merge(): Index " + to_string(w * 64 + countr_zero(outside)) + " out of range.");
+				if (word)
+					words[w].fetch_or(word, memory_order_relaxed);
+			}
+	}
+	if (pos != encoding.size())
+		throw invalid_argument("IndexBitmap::merge(): Encoding exceeds range.");
+}
+
+}
+}
@@ -0,0 +1,45 @@
+#ifndef XAMIDI_HELPER_INDEXBITMAP_H
+#define XAMIDI_HELPER_INDEXBITMAP_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace xamidi {
+namespace helper {
+
+// Bitmap over an index space [0, size), with thread-safe insertions. Uses one bit per index, rather than e.g. 8 bytes (plus hashing overhead) per index of a hash set.
+// For transfer and storage, ranges of the bitmap can be encoded in a compressed format, in the manner of roaring bitmaps: Each container of 2^16 indices is encoded
+// as its cardinality (uint32), followed by nothing (if empty), an array of 16-bit offsets (if sparse, i.e. for up to 4096 indices), or 2^16 bits (if dense).
+struct IndexBitmap {
+	static constexpr std::uint64_t containerBits = 1 << 16;
+private:
+	std::uint64_t bits;
+	std::unique_ptr<std::atomic<std::uint64_t>[]> words;
+public:
+	IndexBitmap(std::uint64_t size = 0);
+	IndexBitmap(IndexBitmap&& other) = default;
+	IndexBitmap& operator=(IndexBitmap&& other) = default;
+
+	// Sets the bit of index 'i'. Returns true iff it was not set before.
+	bool set(std::uint64_t i) { return !(words[i >> 6].fetch_or(std::uint64_t(1) << (i & 63), std::memory_order_relaxed) & (std::uint64_t(1) << (i & 63))); }
+	// Clears the bit of index 'i'. Returns true iff it was set before.
+	bool reset(std::uint64_t i) { return words[i >> 6].fetch_and(~(std::uint64_t(1) << (i & 63)), std::memory_order_relaxed) & (std::uint64_t(1) << (i & 63)); }
+	bool test(std::uint64_t i) const { return words[i >> 6].load(std::memory_order_relaxed) & (std::uint64_t(1) << (i & 63)); }
+	std::uint64_t size() const { return bits; }
+	std::uint64_t count() const; // amount of set bits
+
+	// Appends the encoding of the bits in [first, min(first + amount, size())) to 'out', where 'first' must be a multiple of 'containerBits'.
+	void encode(std::uint64_t first, std::uint64_t amount, std::string& out) const;
+
+	// Sets all bits of an encoding that was created by encode() for the same 'first' and 'amount' (i.e. merges via bitwise OR). Not thread-safe with respect to other insertions.
+	// Throws std::invalid_argument for encodings that do not fit the range.
+	void merge(std::uint64_t first, std::uint64_t amount, std::string_view encoding);
+};
+
+}
+}
+
+#endif // XAMIDI_HELPER_INDEXBITMAP_H
@@ -0,0 +1,420 @@
+#include "NdJson.h"
+
+#include <tbb/task_group.h>
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace xamidi {
+namespace helper {
+
+namespace {
+struct Parser {
+	string_view s;
+	size_t pos = 0;
+	string error;
+
+	explicit Parser(string_view s) : s(s) { }
+	void skipWhitespace() {
+		while (pos < s.length() && (s[pos] == ' ' || s[pos] == '\t' || s[pos] == '\r' || s[pos] == '\n'))
+			pos++;
+	}
+	bool fail(const string& reason) {
+		if (error.empty())
+			error = reason + " at position " + to_string(pos);
+		return false;
+	}
+	bool literal(string_view word) {
+		if (s.substr(pos, word.length()) != word)
+			return fail("invalid literal");
+		pos += word.length();
+		return true;
+	}
+	bool hex4(uint32_t& codePoint) {
+		if (pos + 4 > s.length())
+			return fail("truncated escape sequence");
+		from_chars_result result = from_chars(s.data() + pos, s.data() + pos + 4, codePoint, 16);
+		if (result.ec != errc() || result.ptr != s.data() + pos + 4)
+			return fail("invalid escape sequence");
+		pos += 4;
+		return true;
+	}
+	static void appendUtf8(string& out, uint32_t codePoint) {
+		if (codePoint < 0x80)
+			out += static_cast<char>(codePoint);
+		else if (codePoint < 0x800) {
+			out += static_cast<char>(0xC0 | codePoint >> 6);
+			out += static_cast<char>(0x80 | (codePoint & 0x3F));
+		} else if (codePoint < 0x10000) {
+			out += static_cast<char>(0xE0 | codePoint >> 12);
+			out += static_cast<char>(0x80 | (codePoint >> 6 & 0x3F));
+			out += static_cast<char>(0x80 | (codePoint & 0x3F));
+		} else {
+			out += static_cast<char>(0xF0 | codePoint >> 18);
+			out += static_cast<char>(0x80 | (codePoint >> 12 & 0x3F));
+			out += static_cast<char>(0x80 | (codePoint >> 6 & 0x3F));
+			out += static_cast<char>(0x80 | (codePoint & 0x3F));
+		}
+	}
+	bool string_(string& out) { // at opening quote
+		pos++;
+		while (pos < s.length() && s[pos] != '"') {
+			char c = s[pos++];
+			if (static_cast<unsigned char>(c) < 0x20)
+				return fail("control character in string");
+			if (c != '\\') {
+				out += c;
+				continue;
+			}
+			if (pos == s.length())
+				break;
+			switch (s[pos++]) {
+			case '"':
+				out += '"';
+				break;
+			case '\\':
+				out += '\\';
+				break;
+			case '/':
+				out += '/';
+				break;
+			case 'b':
+				out += '\b';
+				break;
+			case 'f':
+				out += '\f';
+				break;
+			case 'n':
+				out += '\n';
+				break;
+			case 'r':
+				out += '\r';
+				break;
+			case 't':
+				out += '\t';
+				break;
+			case 'u': {
+				uint32_t codePoint;
+				if (!hex4(codePoint))
+					return false;
+				if (codePoint >= 0xD800 && codePoint < 0xDC00) { // high surrogate, to be followed by a low surrogate
+					uint32_t low;
+					if (s.substr(pos, 2) != "\\u" || (pos += 2, !hex4(low)) || low < 0xDC00 || low >= 0xE000)
+						return fail("invalid surrogate pair");
+					codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+				} else if (codePoint >= 0xDC00 && codePoint < 0xE000)
+					return fail("invalid surrogate pair");
+				appendUtf8(out, codePoint);
+				break;
+			}
+			default:
+				pos--;
+				return fail("invalid escape sequence");
+			}
+		}
+		if (pos == s.length())
+			return fail("unterminated string");
+		pos++;
+		return true;
+	}
+	bool number() {
+		size_t start = pos;
+		if (pos < s.length() && s[pos] == '-')
+			pos++;
+		size_t digits = pos;
+		while (pos < s.length() && isdigit(static_cast<unsigned char>(s[pos])))
+			pos++;
+		if (pos == digits)
+			return fail("invalid number");
+		if (pos < s.length() && s[pos] == '.') {
+			digits = ++pos;
+			while (pos < s.length() && isdigit(static_cast<unsigned char>(s[pos])))
+				pos++;
+			if (pos == digits)
+				return fail("invalid number");
+		}
+		if (pos < s.length() && (s[pos] == 'e' || s[pos] == 'E')) {
+			if (++pos < s.length() && (s[pos] == '+' || s[pos] == '-'))
+				pos++;
+			digits = pos;
+			while (pos < s.length() && isdigit(static_cast<unsigned char>(s[pos])))
+				pos++;
+			if (pos == digits)
+				return fail("invalid number");
+		}
+		return pos > start;
+	}
+	bool value(NdJson::Value& out, unsigned depth) {
+		if (depth > 64)
+			return fail("nesting too deep");
+		skipWhitespace();
+		if (pos == s.length())
+			return fail("missing value");
+		size_t start = pos;
+		bool success;
+		switch (s[pos]) {
+		case 'n':
+			out.type = NdJson::Value::Type::Null;
+			success = literal("null");
+			break;
+		case 't':
+			out.type = NdJson::Value::Type::Boolean;
+			success = literal("true");
+			break;
+		case 'f':
+			out.type = NdJson::Value::Type::Boolean;
+			success = literal("false");
+			break;
+		case '"':
+			out.type = NdJson::Value::Type::String;
+			success = string_(out.string);
+			break;
+		case '[':
+			out.type = NdJson::Value::Type::Array;
+			success = array(out.elements, depth);
+			break;
+		case '{': {
+			out.type = NdJson::Value::Type::Object;
+			map<string, NdJson::Value> members; // nested objects are only validated
+			success = object(members, depth);
+			break;
+		}
+		default:
+			out.type = NdJson::Value::Type::Number;
+			success = number();
+		}
+		out.raw = s.substr(start, pos - start);
+		return success;
+	}
+	bool array(vector<NdJson::Value>& out, unsigned depth) { // at opening bracket
+		pos++;
+		skipWhitespace();
+		if (pos < s.length() && s[pos] == ']') {
+			pos++;
+			return true;
+		}
+		while (true) {
+			out.emplace_back();
+			if (!value(out.back(), depth + 1))
+				return false;
+			skipWhitespace();
+			if (pos < s.length() && s[pos] == ',')
+				pos++;
+			else if (pos < s.length() && s[pos] == ']') {
+				pos++;
+				return true;
+			} else
+				return fail("expected ',' or ']'");
+		}
+	}
+	bool object(map<string, NdJson::Value>& out, unsigned depth) { // at opening brace
+		pos++;
+		skipWhitespace();
+		if (pos < s.length() && s[pos] == '}') {
+			pos++;
+			return true;
+		}
+		while (true) {
+			skipWhitespace();
+			if (pos == s.length() || s[pos] != '"')
+				return fail("expected member name");
+			string name;
+			if (!string_(name))
+				return false;
+			skipWhitespace();
+			if (pos == s.length() || s[pos] != ':')
+				return fail("expected ':'");
+			pos++;
+			NdJson::Value v;
+			if (!value(v, depth + 1))
+				return false;
+			out[name] = std::move(v);
+			skipWhitespace();
+			if (pos < s.length() && s[pos] == ',')
+				pos++;
+			else if (pos < s.length() && s[pos] == '}') {
+				pos++;
+				return true;
+			} else
+				return fail("expected ',' or '}'");
+		}
+	}
+};
+
+string errorResponse(const string& error) {
+	return "{\"error\":" + NdJson::quote(error) + "}";
+}
+
+void handleConcurrently(tbb::task_group& group, const function<string(const string&)>& handler, string line, const function<void(const string&)>& respond) {
+	if (!line.empty() && line.back() == '\r')
+		line.pop_back();
+	if (line.find_first_not_of(" \t") == string::npos)
+		return;
+	group.run([&handler, &respond, line = std::move(line)]() {
+		string response;
+		try {
+			response = handler(line);
+		} catch (exception& e) {
+			response = errorResponse(e.what());
+		}
+		respond(response);
+	});
+}
+}
+
+bool NdJson::Value::toUInt(uint64_t& value) const {
+	if (type != Type::Number)
+		return false;
+	from_chars_result result = from_chars(raw.data(), raw.data() + raw.length(), value);
+	return result.ec == errc() && result.ptr == raw.data() + raw.length();
+}
+
+bool NdJson::parseObject(string_view line, map<string, Value>& out, string& error) {
+	Parser parser { line };
+	parser.skipWhitespace();
+	if (parser.pos == line.length() || line[parser.pos] != '{') {
+		error = "expected object";
+		return false;
+	}
+	if (!parser.object(out, 0)) {
+		error = parser.error;
+		return false;
+	}
+	parser.skipWhitespace();
+	if (parser.pos != line.length()) {
+		error = "unexpected content at position " + to_string(parser.pos);
+		return false;
+	}
+	return true;
+}
+
+string NdJson::quote(string_view s) {
+	static constexpr char hexDigits[] = "0123456789abcdef";
+	string result;
+	result.reserve(s.length() + 2);
+	result += '"';
+	for (char c : s)
+		switch (c) {
+		case '"':
+			result += "\\\"";
+			break;
+		case '\\':
+			result += "\\\\";
+			break;
+		case '\n':
+			result += "\\n";
+			break;
+		case '\r':
+			result += "\\r";
+			break;
+		case '\t':
+			result += "\\t";
+			break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20) {
+				result += "\\u00";
+				result += hexDigits[c >> 4];
+				result += hexDigits[c & 0xF];
+			} else
+				result += c;
+		}
+	result += '"';
+	return result;
+}
+
+void NdJson::serve(const function<string(const string&)>& handler, istream& in, ostream& out) {
+	tbb::task_group group;
+	mutex mtx_out;
+	function<void(const string&)> respond = [&](const string& response) {
+		lock_guard<mutex> lock(mtx_out);
+		out << response << '\n' << flush;
+	};
+	string line;
+	while (getline(in, line))
+		handleConcurrently(group, handler, std::move(line), respond);
+	group.wait();
+}
+
+void NdJson::serveSocket(const function<string(const string&)>& handler, const string& socketPath, bool debug) {
+	sockaddr_un address { };
+	address.sun_family = AF_UNIX;
+	if (socketPath.empty() || socketPath.length() >= sizeof(address.sun_path))
+		throw runtime_error("Invalid socket path \"" + socketPath + "\".");
+	memcpy(address.sun_path, socketPath.data(), socketPath.length());
+	error_code ec;
+	if (filesystem::is_socket(filesystem::u8path(socketPath), ec))
+		filesystem::remove(filesystem::u8path(socketPath), ec);
+	int server = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (server < 0)
+		throw runtime_error("Failed to create socket: " + string(strerror(errno)));
+	if (bind(server, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0 || listen(server, SOMAXCONN) < 0) {
+		string error = strerror(errno);
+		close(server);
+		throw runtime_error("Failed to listen at \"" + socketPath + "\": " + error);
+	}
+	cout << "Listening at \"" << socketPath << "\"." << endl;
+	while (true) {
+		int client = accept(server, nullptr, nullptr);
+		if (client < 0) {
+			if (errno == EINTR || errno == ECONNABORTED)
+				continue;
+			string error = strerror(errno);
+			close(server);
+			throw runtime_error("Failed to accept connection at \"" + socketPath + "\": " + error);
+		}
+		if (debug)
+			cout << "Accepted connection " << client << "." << endl;
+		thread([&handler, client, debug]() { // each connection reads its requests in its own thread, but handles them via the shared task scheduler
+			tbb::task_group group;
+			mutex mtx_out;
+			bool open = true;
+			function<void(const string&)> respond = [&](const string& response) {
+				string data = response + '\n';
+				lock_guard<mutex> lock(mtx_out);
+				for (size_t written = 0; open && written < data.length();) {
+					ssize_t n = send(client, data.data() + written, data.length() - written, MSG_NOSIGNAL);
+					if (n < 0 && errno == EINTR)
+						continue;
+					if (n <= 0)
+						open = false; // peer is gone, so discard further responses
+					else
+						written += static_cast<size_t>(n);
+				}
+			};
+			string buffer;
+			char chunk[65536];
+			while (true) {
+				ssize_t n = recv(client, chunk, sizeof(chunk), 0);
+				if (n < 0 && errno == EINTR)
+					continue;
+				if (n <= 0)
+					break;
+				buffer.append(chunk, static_cast<size_t>(n));
+				string::size_type start = 0;
+				for (string::size_type end; (end = buffer.find('\n', start)) != string::npos; start = end + 1)
+					handleConcurrently(group, handler, buffer.substr(start, end - start), respond);
+				buffer.erase(0, start);
+			}
+			if (!buffer.empty())
+				handleConcurrently(group, handler, std::move(buffer), respond);
+			group.wait();
+			close(client);
+			if (debug)
+				cout << "Closed connection " << client << "." << endl;
+		}).detach();
+	}
+}
+
+}
+}
@@ -0,0 +1,47 @@
+#ifndef XAMIDI_HELPER_NDJSON_H
+#define XAMIDI_HELPER_NDJSON_H
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace xamidi {
+namespace helper {
+
+// Minimal support for newline-delimited JSON (one JSON object per line), as used for requests and responses of a query server.
+// Requests are parsed into their top-level members, where strings and arrays are decoded, and all other values are kept as their raw text.
+struct NdJson {
+	struct Value {
+		enum class Type { Null, Boolean, Number, String, Array, Object } type = Type::Null;
+		std::string_view raw; // text of the value within the parsed line
+		std::string string; // decoded content of a string
+		std::vector<Value> elements; // elements of an array
+
+		bool boolean() const { return type == Type::Boolean && raw == "true"; }
+		bool toUInt(std::uint64_t& value) const; // for non-negative integral numbers
+	};
+
+	// Parses a line that consists of a single JSON object into its members. Fails (and stores the reason in 'error') for malformed JSON.
+	// NOTE: The members refer to 'line' via their 'raw' fields, i.e. 'line' must outlive them.
+	static bool parseObject(std::string_view line, std::map<std::string, Value>& out, std::string& error);
+
+	// JSON string literal (with quotes) of 's', which is assumed to be UTF-8 encoded.
+	static std::string quote(std::string_view s);
+
+	// Answers each line read from 'in' with the (single-line) result of 'handler' written to 'out', where requests are handled concurrently (via TBB tasks),
+	// so responses may be written in a different order than their requests were read. Returns when 'in' is exhausted and all responses are written.
+	static void serve(const std::function<std::string(const std::string&)>& handler, std::istream& in, std::ostream& out);
+
+	// Like serve(), but for each connection to a Unix domain socket (which is created at 'socketPath', replacing an existing socket file) ; runs until the process is terminated.
+	// Throws std::runtime_error when the socket cannot be created.
+	static void serveSocket(const std::function<std::string(const std::string&)>& handler, const std::string& socketPath, bool debug = false);
+};
+
+}
+}
+
+#endif // XAMIDI_HELPER_NDJSON_H
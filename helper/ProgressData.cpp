@@ -2,6 +2,7 @@
 
 #include "FctHelper.h"
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <iterator>
@@ -49,6 +50,7 @@ ProgressData& ProgressData::operator=(const ProgressData& other) {
 	progressSteps = other.progressSteps;
 	progress = static_cast<uint64_t>(other.progress);
 	progressState = static_cast<uint64_t>(other.progressState);
+	skipped = other.skipped;
 	return *this;
 }
 
@@ -56,10 +58,24 @@ void ProgressData::setStartTime() {
 	startTime = chrono::system_clock::now();
 }
 
+void ProgressData::skip(uint64_t amount) {
+	progress += amount;
+	skipped += amount;
+	while (progressState + 1 < progressSteps.size() && progressSteps[progressState] <= progress)
+		progressState++;
+}
+
 bool ProgressData::nextStep() {
 	return ++progress == progressSteps[progressState];
 }
 
+unsigned ProgressData::nextSteps(uint64_t amount) {
+	uint64_t current = progress += amount;
+	uint64_t previous = current - amount;
+	vector<uint64_t>::iterator end = prev(progressSteps.end()); // exclude the sentinel
+	return static_cast<unsigned>(upper_bound(progressSteps.begin(), end, current) - upper_bound(progressSteps.begin(), end, previous));
+}
+
 bool ProgressData::nextState(string& percentage, string& progress, string& estimateToComplete) {
 	if (progressState + 1 < progressSteps.size()) {
 		uint64_t progressInSteps = progressSteps[progressState++];
@@ -71,7 +87,7 @@ bool ProgressData::nextState(string& percentage, string& progress, string& estim
 		ss_progress << string(numeratorMaxLen - numeratorLen, ' ') << progressInSteps << " of " << (maximumEstimated ? "approximately " : "") << maximum;
 		progress = ss_progress.str();
 		chrono::microseconds durRemaining = chrono::duration_cast<chrono::microseconds>(chrono::system_clock::now() - startTime);
-		long double durUs = durRemaining.count() * (static_cast<long double>(maximum) / progressInSteps);
+		long double durUs = durRemaining.count() * (static_cast<long double>(maximum - min(skipped, maximum)) / (progressInSteps - skipped));
 		if (durUs > UINT64_MAX)
 			cerr << "Warning: Overflow in ProgressData::nextState() invalidated progress durations." << endl;
 		chrono::microseconds durFull(static_cast<uint64_t>(durUs));
@@ -18,12 +18,15 @@ struct ProgressData { // NOTE: Displays only integer percentage values, which mi
 	std::vector<std::uint64_t> progressSteps;
 	std::atomic<std::uint64_t> progress = 0;
 	std::atomic<std::uint64_t> progressState = 0;
+	std::uint64_t skipped = 0; // progress that was made before 'startTime', e.g. by a previous process
 	ProgressData() = default;
-	ProgressData(const ProgressData& other) : percentageStepSize(other.percentageStepSize), maximum(other.maximum), maximumEstimated(other.maximumEstimated), progressSteps(other.progressSteps), progress((std::uint64_t) other.progress), progressState((std::uint64_t) other.progressState) { }
+	ProgressData(const ProgressData& other) : percentageStepSize(other.percentageStepSize), maximum(other.maximum), maximumEstimated(other.maximumEstimated), progressSteps(other.progressSteps), progress((std::uint64_t) other.progress), progressState((std::uint64_t) other.progressState), skipped(other.skipped) { }
 	ProgressData(unsigned percentageStepSize, std::uint64_t maximum, bool estimated = false);
 	ProgressData& operator=(const ProgressData& other);
 	void setStartTime();
+	void skip(std::uint64_t amount); // silently passes 'amount' steps, which are excluded from time estimations
 	bool nextStep();
+	unsigned nextSteps(std::uint64_t amount); // passes 'amount' steps at once, and returns the amount of states reached by them (i.e. how often 'nextState' should be called)
 	bool nextState(std::string& percentage, std::string& progress, std::string& estimateToComplete);
 };
 
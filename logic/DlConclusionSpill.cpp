@@ -0,0 +1,286 @@
+#include "DlConclusionSpill.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+#include <tbb/parallel_for.h>
+
+using namespace std;
+
+namespace xamidi {
+namespace logic {
+
+namespace {
+// Records consist of the conclusion's and the D-proof's lengths (as native uint32) followed by their bytes.
+void appendRecord(string& buffer, string_view conclusion, string_view dProof) {
+	uint32_t lengths[2] = { static_cast<uint32_t>(conclusion.length()), static_cast<uint32_t>(dProof.length()) };
+	buffer.append(reinterpret_cast<const char*>(lengths), sizeof(lengths));
+	buffer.append(conclusion);
+	buffer.append(dProof);
+}
+// Sequential reader of a record file, which reads portions that consist of complete records (unless a single record is larger).
+class RecordReader {
+	string file;
+	ifstream fin;
+	uint64_t remaining = 0;
+	size_t portion;
+	string buffer;
+	size_t begin = 0;
+public:
+	RecordReader(const string& file, size_t portion) :
+			file(file), portion(portion) {
+		error_code ec;
+		remaining = filesystem::file_size(filesystem::u8path(file), ec);
+		if (ec)
+			remaining = 0; // no records
+		else {
+			fin.open(filesystem::u8path(file), fstream::in | fstream::binary);
+			if (!fin.is_open())
+				throw runtime_error("Failed to read spill file \"" + file + "\".");
+		}
+	}
+	// Views remain valid until the next call.
+	bool next(string_view& first, string_view& second) {
+		uint32_t lengths[2];
+		while (buffer.size() - begin < sizeof(lengths) || (memcpy(lengths, buffer.data() + begin, sizeof(lengths)), buffer.size() - begin < sizeof(lengths) + lengths[0] + lengths[1])) {
+			if (!remaining) {
+				if (begin < buffer.size())
+					throw runtime_error("Truncated spill file \"" + file + "\".");
+				return false;
+			}
+			buffer.erase(0, begin);
+			begin = 0;
+			size_t amount = static_cast<size_t>(min(remaining, static_cast<uint64_t>(max(portion, buffer.size()))));
+			size_t offset = buffer.size();
+			buffer.resize(offset + amount);
+			if (!fin.read(buffer.data() + offset, static_cast<streamsize>(amount)))
+				throw runtime_error("Failed to read spill file \"" + file + "\".");
+			remaining -= amount;
+		}
+		const char* record = buffer.data() + begin + sizeof(lengths);
+		first = string_view(record, lengths[0]);
+		second = string_view(record + lengths[0], lengths[1]);
+		begin += sizeof(lengths) + lengths[0] + lengths[1];
+		return true;
+	}
+};
+void forEachRecord(const string& file, const function<void(string_view, string_view)>& func) {
+	RecordReader reader(file, size_t(1) << 24); // read in portions of 16 MiB
+	string_view first;
+	string_view second;
+	while (reader.next(first, second))
+		func(first, second);
+}
+void writeRecords(const string& file, const string& buffer) {
+	ofstream fout(filesystem::u8path(file), fstream::out | fstream::binary | fstream::trunc);
+	if (!fout.write(buffer.data(), static_cast<streamsize>(buffer.size())))
+		throw runtime_error("Failed to write spill file \"" + file + "\".");
+}
+}
+
+DlConclusionSpill::DlConclusionSpill(DlConclusionStore& store, const string& directory, size_t memoryBudget) :
+		store(store), directory(directory), memoryBudget(memoryBudget) {
+	// NOTE: Pending candidates are limited to about a quarter of the budget in total (but to at least 64 KiB and at most 1 MiB per bucket).
+	pendingLimit = min(max(memoryBudget / (4 * store.numShards()), size_t(1) << 16), size_t(1) << 20);
+	buckets = make_unique<Bucket[]>(store.numShards());
+	error_code ec;
+	filesystem::create_directories(filesystem::u8path(directory), ec);
+	if (ec)
+		throw runtime_error("Failed to create spill directory \"" + directory + "\".");
+}
+
+DlConclusionSpill::~DlConclusionSpill() {
+	error_code ec;
+	for (size_t i = 0; i < store.numShards(); i++) {
+		filesystem::remove(filesystem::u8path(_file(i, false)), ec);
+		filesystem::remove(filesystem::u8path(_file(i, true)), ec);
+		filesystem::remove(filesystem::u8path(_sortedRunFile(i)), ec);
+	}
+	filesystem::remove(filesystem::u8path(directory), ec); // only if empty
+}
+
+int DlConclusionSpill::emplace(string_view conclusion, string_view dProof) {
+	size_t i = store.shardIndex(conclusion);
+	Bucket& bucket = buckets[i];
+	int result;
+	{
+		lock_guard<mutex> lock(bucket.mtx);
+		if (bucket.evicted) {
+			appendRecord(bucket.pending, conclusion, dProof);
+			bucket.runSize++;
+			if (bucket.pending.size() >= pendingLimit)
+				_flush(i);
+			result = -1;
+		} else
+			result = store.emplace(conclusion, dProof, true);
+	}
+	if (result == 1 && !(++emplacements & 0x3fff)) // check the budget after every 16384 new entries
+		enforceBudget();
+	return result;
+}
+
+void DlConclusionSpill::enforceBudget() {
+	unique_lock<mutex> lock(mtx_evict, try_to_lock);
+	if (!lock.owns_lock()) // another thread is already evicting
+		return;
+	while (true) {
+		size_t usage = 0;
+		size_t largest = SIZE_MAX;
+		size_t largestUsage = 0;
+		for (size_t i = 0; i < store.numShards(); i++) {
+			size_t bucketUsage = store.shardMemoryUsage(i);
+			usage += bucketUsage;
+			if (bucketUsage > largestUsage) {
+				bool evicted;
+				{
+					lock_guard<mutex> bucketLock(buckets[i].mtx);
+					evicted = buckets[i].evicted;
+				}
+				if (!evicted) {
+					largest = i;
+					largestUsage = bucketUsage;
+				}
+			}
+		}
+		if (usage <= memoryBudget || largest == SIZE_MAX)
+			return;
+		_evict(largest);
+	}
+}
+
+void DlConclusionSpill::merge(const function<void(bool)>& fCandidate) {
+	for (size_t i = 0; i < store.numShards(); i++) {
+		Bucket& bucket = buckets[i];
+		lock_guard<mutex> lock(bucket.mtx);
+		if (!bucket.evicted || !bucket.runSize)
+			continue;
+		_flush(i);
+		forEachRecord(_file(i, false), [&](string_view conclusion, string_view dProof) { store.emplace(conclusion, dProof); });
+		forEachRecord(_file(i, true), [&](string_view conclusion, string_view dProof) { fCandidate(store.emplace(conclusion, dProof, true)); });
+		string buffer;
+		bucket.size = 0;
+		store.forEachInShard(i, [&](string_view conclusion, string_view dProof) {
+			appendRecord(buffer, conclusion, dProof);
+			bucket.size++;
+		});
+		writeRecords(_file(i, false), buffer);
+		error_code ec;
+		filesystem::remove(filesystem::u8path(_file(i, true)), ec);
+		bucket.runSize = 0;
+		store.clearShard(i);
+	}
+}
+
+void DlConclusionSpill::forEachInBucket(size_t i, const function<void(string_view, string_view)>& func) const {
+	if (buckets[i].evicted)
+		forEachRecord(_file(i, false), func);
+	else
+		store.forEachInShard(i, func);
+}
+
+uint64_t DlConclusionSpill::writeSortedRuns(size_t proofLength, map<size_t, size_t>& amountPerLength) const {
+	atomic<uint64_t> amount = 0;
+	mutex mtx;
+	tbb::parallel_for(size_t(0), store.numShards(), [&](size_t i) {
+		vector<pair<string, string>> entries;
+		map<size_t, size_t> bucketAmountPerLength;
+		forEachInBucket(i, [&](string_view conclusion, string_view dProof) {
+			if (dProof.length() == proofLength)
+				entries.emplace_back(dProof, conclusion);
+			bucketAmountPerLength[dProof.length()]++;
+		});
+		sort(entries.begin(), entries.end()); // NOTE: D-proofs are unique and of equal length, so this is the order of cmpStringGrow.
+		string buffer;
+		for (const pair<string, string>& p : entries)
+			appendRecord(buffer, p.first, p.second);
+		writeRecords(_sortedRunFile(i), buffer);
+		amount += entries.size();
+		lock_guard<mutex> lock(mtx);
+		for (const pair<const size_t, size_t>& p : bucketAmountPerLength)
+			amountPerLength[p.first] += p.second;
+	});
+	return amount;
+}
+
+void DlConclusionSpill::mergeSortedRuns(const function<void(string_view, string_view)>& func) const {
+	size_t n = store.numShards();
+	vector<RecordReader> readers;
+	readers.reserve(n);
+	for (size_t i = 0; i < n; i++)
+		readers.emplace_back(_sortedRunFile(i), pendingLimit);
+	vector<pair<string_view, string_view>> heads(n);
+	auto cmp = [&](size_t a, size_t b) { return heads[a].first > heads[b].first; }; // min-heap of D-proofs
+	priority_queue<size_t, vector<size_t>, decltype(cmp)> queue(cmp);
+	for (size_t i = 0; i < n; i++)
+		if (readers[i].next(heads[i].first, heads[i].second))
+			queue.push(i);
+	while (!queue.empty()) {
+		size_t i = queue.top();
+		queue.pop();
+		func(heads[i].first, heads[i].second);
+		if (readers[i].next(heads[i].first, heads[i].second))
+			queue.push(i);
+	}
+	readers.clear();
+	error_code ec;
+	for (size_t i = 0; i < n; i++)
+		filesystem::remove(filesystem::u8path(_sortedRunFile(i)), ec);
+}
+
+size_t DlConclusionSpill::evictedCount() const {
+	size_t result = 0;
+	for (size_t i = 0; i < store.numShards(); i++)
+		if (buckets[i].evicted)
+			result++;
+	return result;
+}
+
+uint64_t DlConclusionSpill::evictedSize() const {
+	uint64_t result = 0;
+	for (size_t i = 0; i < store.numShards(); i++)
+		if (buckets[i].evicted)
+			result += buckets[i].size;
+	return result;
+}
+
+string DlConclusionSpill::_file(size_t i, bool run) const {
+	return directory + "bucket" + to_string(i) + (run ? "-run.bin" : ".bin");
+}
+
+string DlConclusionSpill::_sortedRunFile(size_t i) const {
+	return directory + "bucket" + to_string(i) + "-sorted.bin";
+}
+
+void DlConclusionSpill::_flush(size_t i) {
+	Bucket& bucket = buckets[i];
+	if (bucket.pending.empty())
+		return;
+	ofstream fout(filesystem::u8path(_file(i, true)), fstream::out | fstream::binary | fstream::app);
+	if (!fout.write(bucket.pending.data(), static_cast<streamsize>(bucket.pending.size())))
+		throw runtime_error("Failed to write spill file \"" + _file(i, true) + "\".");
+	bucket.pending.clear();
+}
+
+void DlConclusionSpill::_evict(size_t i) {
+	Bucket& bucket = buckets[i];
+	lock_guard<mutex> lock(bucket.mtx);
+	if (bucket.evicted)
+		return;
+	string buffer;
+	bucket.size = 0;
+	store.forEachInShard(i, [&](string_view conclusion, string_view dProof) {
+		appendRecord(buffer, conclusion, dProof);
+		bucket.size++;
+	});
+	writeRecords(_file(i, false), buffer);
+	store.clearShard(i);
+	bucket.evicted = true;
+}
+
+}
+}
@@ -0,0 +1,81 @@
+#ifndef XAMIDI_LOGIC_DLCONCLUSIONSPILL_H
+#define XAMIDI_LOGIC_DLCONCLUSIONSPILL_H
+
+#include "DlConclusionStore.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace xamidi {
+namespace logic {
+
+// Out-of-core extension of a DlConclusionStore for proof collection, where the store's shards serve as buckets (i.e. conclusions are partitioned by hash prefix).
+// When the store's memory usage exceeds the budget, its largest resident buckets are evicted, i.e. their entries are written to a file and removed from memory.
+// Candidates for evicted buckets are appended to the buckets' run files rather than being inserted. After collection, merge() inserts each evicted bucket's file
+// and run into the store (one bucket at a time), keeping the shortest (then lexicographically smallest) D-proof per conclusion, so the entries are exactly those
+// of an in-memory collection. Evicted buckets remain on disk, i.e. they keep collecting runs when the store is used for further collections.
+// NOTE: In order to route candidates consistently, all insertions must use this interface while it exists. Its files are removed upon destruction.
+struct DlConclusionSpill {
+	struct Bucket {
+		std::mutex mtx;
+		bool evicted = false;
+		std::uint64_t size = 0; // amount of entries in the bucket's file
+		std::uint64_t runSize = 0; // amount of candidates in the bucket's run (including pending ones)
+		std::string pending; // candidate records that are not yet appended to the run file
+	};
+private:
+	DlConclusionStore& store;
+	std::string directory;
+	std::size_t memoryBudget;
+	std::size_t pendingLimit;
+	std::unique_ptr<Bucket[]> buckets;
+	std::atomic<std::uint64_t> emplacements = 0;
+	std::mutex mtx_evict;
+public:
+	DlConclusionSpill(DlConclusionStore& store, const std::string& directory, std::size_t memoryBudget);
+	~DlConclusionSpill();
+	DlConclusionSpill(const DlConclusionSpill&) = delete;
+	DlConclusionSpill& operator=(const DlConclusionSpill&) = delete;
+
+	// Like DlConclusionStore::emplace() with 'replaceWorseProof' set, but defers candidates for evicted buckets. Returns 1 if 'conclusion' was new, 0 if it was known, and -1 if deferred.
+	int emplace(std::string_view conclusion, std::string_view dProof);
+
+	// Evicts the largest resident buckets until the store's memory usage is within the budget. Called by emplace() regularly.
+	void enforceBudget();
+
+	// Merges all runs into their buckets, and calls 'fCandidate(isNew)' for each deferred candidate. Since a conclusion is new for exactly one of its candidates (regardless
+	// of their order), counters are identical to those of in-memory collection.
+	void merge(const std::function<void(bool)>& fCandidate);
+
+	// Calls 'func(conclusion, dProof)' for each entry of the given bucket, loading it from file if it is evicted. Requires that there are no deferred candidates, i.e. merge() was called.
+	void forEachInBucket(std::size_t i, const std::function<void(std::string_view, std::string_view)>& func) const;
+
+	// Writes the entries with D-proofs of the given length as sorted runs (one per bucket, concurrently), and adds the amounts of all entries per D-proof length to 'amountPerLength'.
+	// Returns the amount of entries of the given length. Requires that merge() was called.
+	std::uint64_t writeSortedRuns(std::size_t proofLength, std::map<std::size_t, std::size_t>& amountPerLength) const;
+
+	// Calls 'func(dProof, conclusion)' for each entry of the sorted runs in ascending order of D-proofs (i.e. in order of proof files), and removes the runs.
+	void mergeSortedRuns(const std::function<void(std::string_view, std::string_view)>& func) const;
+
+	std::size_t bucketCount() const { return store.numShards(); }
+	std::size_t evictedCount() const;
+	std::uint64_t evictedSize() const; // amount of entries in evicted buckets
+	const std::string& path() const { return directory; }
+private:
+	std::string _file(std::size_t i, bool run) const;
+	std::string _sortedRunFile(std::size_t i) const;
+	void _flush(std::size_t i); // requires the bucket's lock
+	void _evict(std::size_t i);
+};
+
+}
+}
+
+#endif // XAMIDI_LOGIC_DLCONCLUSIONSPILL_H
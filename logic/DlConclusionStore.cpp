@@ -0,0 +1,255 @@
+#include "DlConclusionStore.h"
+
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <functional>
+
+using namespace std;
+
+namespace xamidi {
+namespace logic {
+
+namespace {
+// Records consist of a length prefix (7 bits per byte, least significant group first, with the highest bit set for all but the final byte) followed by the data.
+size_t writeLength(char* dest, size_t length) {
+	size_t i = 0;
+	for (; length >= 0x80; length >>= 7)
+		dest[i++] = static_cast<char>(static_cast<unsigned char>(length) | 0x80);
+	dest[i++] = static_cast<char>(length);
+	return i;
+}
+size_t recordLength(size_t length) {
+	size_t prefixLength = 1;
+	for (size_t n = length; n >= 0x80; n >>= 7)
+		prefixLength++;
+	return prefixLength + length;
+}
+string_view readRecord(const char* record) {
+	size_t length = 0;
+	unsigned shift = 0;
+	unsigned char c;
+	do {
+		c = static_cast<unsigned char>(*record++);
+		length |= static_cast<size_t>(c & 0x7f) << shift;
+		shift += 7;
+	} while (c & 0x80);
+	return string_view(record, length);
+}
+}
+
+uint64_t DlConclusionStore::Arena::append(string_view data) {
+	char prefix[10];
+	size_t prefixLength = writeLength(prefix, data.length());
+	size_t recordLength = prefixLength + data.length();
+	if (chunks.empty() || chunkSizes.back() - chunkUsed < recordLength) {
+		// NOTE: Chunk sizes grow along with the arena (by a quarter of its size, from 4 KiB up to 1 MiB), so that few entries do not occupy much memory,
+		//       while many entries require few chunks, and unused capacity remains small (since only the final chunk is not filled up).
+		size_t chunkSize = max(min(max(allocated / 4, size_t(4096)), size_t(1) << 20), recordLength);
+		chunks.emplace_back(new char[chunkSize]);
+		chunkSizes.push_back(static_cast<uint32_t>(chunkSize));
+		chunkUsed = 0;
+		allocated += chunkSize;
+	}
+	uint64_t reference = (static_cast<uint64_t>(chunks.size() - 1) << 32) | chunkUsed;
+	char* dest = chunks.back().get() + chunkUsed;
+	memcpy(dest, prefix, prefixLength);
+	memcpy(dest + prefixLength, data.data(), data.length());
+	chunkUsed += static_cast<uint32_t>(recordLength);
+	used += recordLength;
+	return reference;
+}
+
+DlConclusionStore::DlConclusionStore(unsigned shardBits) :
+		shardBits(shardBits < 1 ? 1 : shardBits > 16 ? 16 : shardBits), shardCount(size_t(1) << this->shardBits) {
+	shards = make_unique<Shard[]>(shardCount);
+}
+
+bool DlConclusionStore::emplace(string_view conclusion, string_view dProof, bool replaceWorseProof) {
+	uint64_t fingerprint = _fingerprint(conclusion);
+	Shard& shard = _shard(fingerprint);
+	lock_guard<mutex> lock(shard.mtx);
+	if (Slot* slot = _locate(shard, fingerprint, conclusion)) { // a proof for the conclusion is already known
+		if (replaceWorseProof) {
+			char* record = shard.dProofs.record(slot->dProof);
+			string_view storedDProof = readRecord(record);
+			if (storedDProof.length() > dProof.length() || (storedDProof.length() == dProof.length() && storedDProof > dProof)) { // use the shorter or "preceding" proof
+				size_t prefixLength = writeLength(record, dProof.length()); // NOTE: Not longer than the stored prefix, since the length did not increase.
+				memcpy(record + prefixLength, dProof.data(), dProof.length());
+				shard.dead += recordLength(storedDProof.length()) - recordLength(dProof.length());
+			}
+		}
+		return false;
+	}
+	if (8 * (shard.used + 1) > 7 * shard.slots.size()) // maximum load factor 7/8
+		_grow(shard);
+	size_t mask = shard.slots.size() - 1;
+	size_t i = fingerprint & mask;
+	while (shard.slots[i].fingerprint) // NOTE: Erased slots are not reused, since this would require to probe until an empty slot anyway. They are dropped by _grow().
+		i = (i + 1) & mask;
+	shard.slots[i] = Slot { fingerprint, shard.conclusions.append(conclusion), shard.dProofs.append(dProof) };
+	shard.used++;
+	shard.size++;
+	return true;
+}
+
+bool DlConclusionStore::find(string_view conclusion, string_view* optOut_dProof) const {
+	uint64_t fingerprint = _fingerprint(conclusion);
+	Shard& shard = _shard(fingerprint);
+	lock_guard<mutex> lock(shard.mtx);
+	Slot* slot = _locate(shard, fingerprint, conclusion);
+	if (slot && optOut_dProof)
+		*optOut_dProof = _view(shard.dProofs, slot->dProof);
+	return slot;
+}
+
+bool DlConclusionStore::erase(string_view conclusion) {
+	uint64_t fingerprint = _fingerprint(conclusion);
+	Shard& shard = _shard(fingerprint);
+	lock_guard<mutex> lock(shard.mtx);
+	Slot* slot = _locate(shard, fingerprint, conclusion);
+	if (!slot)
+		return false;
+	slot->fingerprint = 1; // keep the slot non-empty, so that probing continues beyond it
+	shard.size--;
+	shard.dead += recordLength(_view(shard.conclusions, slot->conclusion).length()) + recordLength(_view(shard.dProofs, slot->dProof).length());
+	return true;
+}
+
+size_t DlConclusionStore::size() const {
+	size_t result = 0;
+	for (size_t i = 0; i < shardCount; i++)
+		result += shards[i].size;
+	return result;
+}
+
+size_t DlConclusionStore::compact() {
+	atomic<size_t> released = 0;
+	tbb::parallel_for(size_t(0), shardCount, [&](size_t i) {
+		Shard& shard = shards[i];
+		lock_guard<mutex> lock(shard.mtx);
+		if (4 * shard.dead > shard.conclusions.used + shard.dProofs.used) {
+			size_t bytes = _shardMemoryUsage(shard);
+			_compact(shard);
+			released += bytes - _shardMemoryUsage(shard);
+		}
+	});
+	return released;
+}
+
+size_t DlConclusionStore::memoryUsage() const {
+	size_t result = sizeof(DlConclusionStore) + shardCount * sizeof(Shard);
+	for (size_t i = 0; i < shardCount; i++)
+		result += _shardMemoryUsage(shards[i]);
+	return result;
+}
+
+size_t DlConclusionStore::shardSize(size_t i) const {
+	lock_guard<mutex> lock(shards[i].mtx);
+	return shards[i].size;
+}
+
+size_t DlConclusionStore::shardMemoryUsage(size_t i) const {
+	lock_guard<mutex> lock(shards[i].mtx);
+	return _shardMemoryUsage(shards[i]);
+}
+
+void DlConclusionStore::clearShard(size_t i) {
+	Shard& shard = shards[i];
+	lock_guard<mutex> lock(shard.mtx);
+	vector<Slot>().swap(shard.slots);
+	shard.used = 0;
+	shard.size = 0;
+	shard.dead = 0;
+	shard.conclusions = Arena();
+	shard.dProofs = Arena();
+}
+
+size_t DlConclusionStore::stringMapMemoryEstimate() const {
+	auto mallocChunk = [](size_t n) { return max(size_t(32), (n + 8 + 15) & ~size_t(15)); }; // glibc: 8 bytes of header, 16-byte alignment, 32 bytes minimum
+	auto stringHeap = [&](size_t length) { return length > 15 ? mallocChunk(length + 1) : 0; }; // libstdc++: up to 15 characters are stored within the std::string object
+	size_t result = 0;
+	size_t n = 0;
+	forEach([&](string_view conclusion, string_view dProof) {
+		result += mallocChunk(80) + stringHeap(conclusion.length()) + stringHeap(dProof.length()); // node: 'next' pointer, spin_rw_mutex, and std::pair<const std::string, std::string>
+		n++;
+	});
+	return result + 16 * bit_ceil(max(n, size_t(1))); // buckets: spin_rw_mutex and node pointer, at least one per entry
+}
+
+size_t DlConclusionStore::liveMemoryUsage() const {
+	size_t result = 0;
+	for (size_t i = 0; i < shardCount; i++) {
+		const Shard& shard = shards[i];
+		result += shard.size * sizeof(Slot) + shard.conclusions.used + shard.dProofs.used - shard.dead;
+	}
+	return result;
+}
+
+uint64_t DlConclusionStore::_fingerprint(string_view conclusion) {
+	uint64_t fingerprint = hash<string_view>()(conclusion);
+	return fingerprint > 1 ? fingerprint : fingerprint + 2; // 0 and 1 are reserved for empty and erased slots
+}
+
+size_t DlConclusionStore::_shardMemoryUsage(const Shard& shard) {
+	return shard.slots.capacity() * sizeof(Slot) + shard.conclusions.allocated + shard.dProofs.allocated + (shard.conclusions.chunks.capacity() + shard.dProofs.chunks.capacity()) * (sizeof(unique_ptr<char[]>) + sizeof(uint32_t));
+}
+
+string_view DlConclusionStore::_view(const Arena& arena, uint64_t reference) {
+	return readRecord(arena.record(reference));
+}
+
+DlConclusionStore::Slot* DlConclusionStore::_locate(Shard& shard, uint64_t fingerprint, string_view conclusion) {
+	if (shard.slots.empty())
+		return nullptr;
+	size_t mask = shard.slots.size() - 1;
+	for (size_t i = fingerprint & mask; shard.slots[i].fingerprint; i = (i + 1) & mask) {
+		Slot& slot = shard.slots[i];
+		if (slot.fingerprint == fingerprint && _view(shard.conclusions, slot.conclusion) == conclusion)
+			return &slot;
+	}
+	return nullptr;
+}
+
+void DlConclusionStore::_grow(Shard& shard) {
+	// NOTE: When many slots are occupied by erased entries, the table may be rebuilt without growing.
+	_rehash(shard, max(size_t(16), shard.slots.size()));
+}
+
+void DlConclusionStore::_rehash(Shard& shard, size_t capacity) {
+	while (2 * (shard.size + 1) > capacity) // load factor at most 1/2 after growth
+		capacity *= 2;
+	vector<Slot> slots(capacity, Slot { 0, 0, 0 });
+	size_t mask = capacity - 1;
+	for (const Slot& slot : shard.slots)
+		if (slot.fingerprint > 1) {
+			size_t i = slot.fingerprint & mask;
+			while (slots[i].fingerprint)
+				i = (i + 1) & mask;
+			slots[i] = slot;
+		}
+	shard.slots = move(slots);
+	shard.used = shard.size;
+}
+
+void DlConclusionStore::_compact(Shard& shard) {
+	Arena conclusions;
+	Arena dProofs;
+	for (Slot& slot : shard.slots)
+		if (slot.fingerprint > 1) {
+			slot.conclusion = conclusions.append(_view(shard.conclusions, slot.conclusion));
+			slot.dProof = dProofs.append(_view(shard.dProofs, slot.dProof));
+		}
+	shard.conclusions = move(conclusions);
+	shard.dProofs = move(dProofs);
+	shard.dead = 0;
+	if (shard.size)
+		_rehash(shard, 16); // NOTE: Also shrinks the table when many entries were erased.
+	else {
+		vector<Slot>().swap(shard.slots);
+		shard.used = 0;
+	}
+}
+
+}
+}
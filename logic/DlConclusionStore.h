@@ -0,0 +1,113 @@
+#ifndef XAMIDI_LOGIC_DLCONCLUSIONSTORE_H
+#define XAMIDI_LOGIC_DLCONCLUSIONSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include <tbb/parallel_for.h>
+
+namespace xamidi {
+namespace logic {
+
+// Concurrent map from conclusions (e.g. formulas in normal Polish notation with numeric variables, such as "C0C1.0") to D-proofs, as a compact replacement for tbb::concurrent_hash_map<std::string, std::string>.
+// Entries are distributed among shards by 64-bit fingerprints (hashes) of their conclusions, where each shard consists of an open-addressing table of fingerprints and references,
+// and of two append-only byte arenas that hold the shard's conclusions and D-proofs with length prefixes. Thereby, an entry costs neither individual heap allocations nor node overhead.
+// Stored D-proofs are replaced in place, which is possible since they are only ever replaced by D-proofs that are not longer. Erased entries (and the remainders of replaced
+// D-proofs) leave dead bytes in the arenas, which are reclaimed by compact().
+// NOTE: Modifications lock only the affected shard, so they are thread-safe. Views (std::string_view) into the arenas remain valid until compact() is called (or their shard is cleared),
+//       but a D-proof view's contents change when its entry is modified, so views should only be used while there are no concurrent modifications of their entries.
+struct DlConclusionStore {
+	struct Slot {
+		std::uint64_t fingerprint; // 0: empty ; 1: erased
+		std::uint64_t conclusion; // reference to a record in the shard's conclusion arena
+		std::uint64_t dProof; // reference to a record in the shard's D-proof arena
+	};
+	struct Arena {
+		std::vector<std::unique_ptr<char[]>> chunks;
+		std::vector<std::uint32_t> chunkSizes;
+		std::uint32_t chunkUsed = 0; // bytes used in the final chunk
+		std::size_t allocated = 0;
+		std::size_t used = 0; // bytes of all appended records
+
+		std::uint64_t append(std::string_view data); // returns a reference, i.e. (chunk index << 32) | position
+		char* record(std::uint64_t reference) const { return chunks[reference >> 32].get() + static_cast<std::uint32_t>(reference); }
+	};
+	struct Shard {
+		mutable std::mutex mtx;
+		std::vector<Slot> slots; // capacity is zero or a power of two
+		std::size_t used = 0; // amount of non-empty slots, i.e. including erased ones
+		std::size_t size = 0;
+		std::size_t dead = 0; // bytes of erased records and of remainders of replaced records in the arenas
+		Arena conclusions;
+		Arena dProofs;
+	};
+private:
+	std::unique_ptr<Shard[]> shards;
+	unsigned shardBits;
+	std::size_t shardCount;
+public:
+	DlConclusionStore(unsigned shardBits = 8);
+
+	// Inserts the entry if 'conclusion' is new. Otherwise, if 'replaceWorseProof' is set, replaces the stored D-proof by 'dProof' if the latter is shorter,
+	// or if it is of equal length and lexicographically smaller. Returns true iff 'conclusion' was new.
+	bool emplace(std::string_view conclusion, std::string_view dProof, bool replaceWorseProof = false);
+
+	bool find(std::string_view conclusion, std::string_view* optOut_dProof = nullptr) const;
+	bool erase(std::string_view conclusion);
+	std::size_t size() const;
+
+	// Rebuilds the tables and arenas of all shards in which over a quarter of the arena bytes are dead, e.g. after bulk erasure. Returns the amount of released bytes.
+	// NOTE: Invalidates all views into the store, so it must not be called while views (e.g. of a DlSchemaIndex) are in use.
+	std::size_t compact();
+
+	// Amount of bytes allocated by the store (i.e. for tables and arenas), and an estimation of the amount of bytes that tbb::concurrent_hash_map<std::string, std::string> would require
+	// for the same entries (with libstdc++ and glibc's malloc on a 64-bit platform, i.e. 80-byte nodes, 16-byte buckets, and heap-allocated strings of over 15 characters).
+	std::size_t memoryUsage() const;
+	std::size_t stringMapMemoryEstimate() const;
+
+	// Amount of bytes occupied by the store's entries, i.e. by their slots and records (without unused capacity and dead bytes).
+	std::size_t liveMemoryUsage() const;
+
+	// Access to single shards, e.g. to use them as buckets of conclusions (partitioned by hash prefix), as done by DlConclusionSpill.
+	std::size_t numShards() const { return shardCount; }
+	std::size_t shardIndex(std::string_view conclusion) const { return _fingerprint(conclusion) >> (64 - shardBits); }
+	std::size_t shardSize(std::size_t i) const;
+	std::size_t shardMemoryUsage(std::size_t i) const;
+	void clearShard(std::size_t i); // removes all entries of the shard and releases its memory
+	void forEachInShard(std::size_t i, const auto& func) const {
+		_forEachInShard(shards[i], func);
+	}
+
+	// Calls 'func(conclusion, dProof)' for each entry, with both arguments of type std::string_view.
+	void forEach(const auto& func) const {
+		for (std::size_t i = 0; i < shardCount; i++)
+			_forEachInShard(shards[i], func);
+	}
+	void forEach_par(const auto& func) const {
+		tbb::parallel_for(std::size_t(0), shardCount, [&](std::size_t i) { _forEachInShard(shards[i], func); });
+	}
+private:
+	static std::uint64_t _fingerprint(std::string_view conclusion);
+	static std::string_view _view(const Arena& arena, std::uint64_t reference);
+	static std::size_t _shardMemoryUsage(const Shard& shard);
+	Shard& _shard(std::uint64_t fingerprint) const { return shards[fingerprint >> (64 - shardBits)]; }
+	static Slot* _locate(Shard& shard, std::uint64_t fingerprint, std::string_view conclusion); // nullptr if not found
+	static void _grow(Shard& shard);
+	static void _rehash(Shard& shard, std::size_t capacity); // drops erased slots, where 'capacity' is doubled until the load factor is at most 1/2
+	static void _compact(Shard& shard);
+
+	static void _forEachInShard(const Shard& shard, const auto& func) {
+		for (const Slot& slot : shard.slots)
+			if (slot.fingerprint > 1)
+				func(_view(shard.conclusions, slot.conclusion), _view(shard.dProofs, slot.dProof));
+	}
+};
+
+}
+}
+
+#endif // XAMIDI_LOGIC_DLCONCLUSIONSTORE_H
@@ -11,6 +11,8 @@
 #include <tbb/concurrent_unordered_map.h>
 #include <tbb/concurrent_vector.h>
 
+#include <array>
+#include <charconv>
 #include <iostream>
 #include <mutex>
 
@@ -643,21 +645,21 @@ bool DlCore::isSchemaOf_polishNotation_noRename_numVars(const string& potentialS
 	return true;
 }
 
-bool DlCore::isSchemaOf_polishNotation_noRename_numVars_vec(const string& potentialSchema, const string& formula) {
-	vector<string> substitutions;
+bool DlCore::isSchemaOf_polishNotation_noRename_numVars_vec(string_view potentialSchema, string_view formula) {
+	vector<string_view> substitutions;
 	string::size_type formulaIndex = 0;
 	size_t varNum = 0;
 	bool prevVar = false;
 	auto readSubstitutedFormula = [&]() -> bool {
 		if (prevVar) { // read previous variable first
 			string::size_type finalIndex = traverseFormulas_polishNotation_noRename_numVars(formula, formulaIndex);
-			string substitutedFormula = formula.substr(formulaIndex, finalIndex - formulaIndex + 1);
+			string_view substitutedFormula = formula.substr(formulaIndex, finalIndex - formulaIndex + 1);
 			formulaIndex += substitutedFormula.length();
 			if (substitutions.size() <= varNum) {
 				substitutions.resize(varNum + 1);
 				substitutions[varNum] = substitutedFormula;
 			} else {
-				string& entry = substitutions[varNum];
+				string_view& entry = substitutions[varNum];
 				if (entry != substitutedFormula) {
 					if (entry.empty())
 						entry = substitutedFormula;
@@ -732,6 +734,196 @@ bool DlCore::isSchemaOf_polishNotation_noRename_numVars_vec(const string& potent
 	return true;
 }
 
+bool DlCore::condensedDetachment_polishNotation_noRename_numVars(string_view antecedent, string_view conditional, string& output) {
+	// NOTE: Subformulas are referenced by their input (highest bit: unset for 'antecedent', set for 'conditional') and their start index in that input.
+	//       Substitutions are triangular (i.e. substitution entries may contain variables with substitution entries), such that no formulas are built while unifying.
+	constexpr uint32_t conditionalBit = 0x80000000u;
+	constexpr uint32_t none = UINT32_MAX;
+	static const array<int8_t, 128> arities = []() {
+		array<int8_t, 128> arities;
+		arities.fill(-1);
+		for (char c : string("KADXCBFGEJSU"))
+			arities[static_cast<unsigned char>(c)] = 2;
+		for (char c : string("NLMZP"))
+			arities[static_cast<unsigned char>(c)] = 1;
+		arities['V'] = 0;
+		arities['O'] = 0;
+		return arities;
+	}();
+	struct Buffers {
+		vector<uint32_t> next[2]; // for each start index of a subformula, the start index of its subsequent subformula (or the input's length)
+		vector<uint32_t> substitutions[2]; // for each variable, a reference to its substituted subformula
+		vector<uint32_t> translation[2]; // for each variable of the result, its new name according to order of appearance
+		vector<uint32_t> stack;
+		vector<uint32_t> pairs;
+	};
+	thread_local Buffers buffers;
+	const string_view* inputs[2] = { &antecedent, &conditional };
+	auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+	auto readVariable = [&](string_view s, uint32_t& i) {
+		uint32_t variable = 0;
+		while (i < s.length() && isDigit(s[i]))
+			variable = 10 * variable + (s[i++] - '0');
+		return variable;
+	};
+
+	if (conditional.empty() || conditional[0] != 'C')
+		return false;
+
+	// 1. Prepare subformula boundaries and substitution entries of both inputs.
+	for (unsigned side = 0; side < 2; side++) {
+		string_view s = *inputs[side];
+		vector<uint32_t>& next = buffers.next[side];
+		vector<uint32_t>& stack = buffers.stack;
+		next.resize(s.length() + 1);
+		stack.clear();
+		uint32_t variableBound = 0;
+		for (int64_t i = static_cast<int64_t>(s.length()) - 1; i >= 0; i--) {
+			char c = s[i];
+			if (c == '.')
+				continue;
+			if (isDigit(c)) {
+				uint32_t end = static_cast<uint32_t>(i + 1);
+				while (i > 0 && isDigit(s[i - 1]))
+					i--;
+				uint32_t start = static_cast<uint32_t>(i);
+				next[start] = end < s.length() && s[end] == '.' ? end + 1 : end;
+				uint32_t variable = readVariable(s, start);
+				if (variable >= variableBound)
+					variableBound = variable + 1;
+				stack.push_back(static_cast<uint32_t>(i));
+			} else {
+				int8_t arity = static_cast<unsigned char>(c) < 128 ? arities[static_cast<unsigned char>(c)] : -1;
+				if (arity < 0)
+					throw domain_error("DlCore::condensedDetachment_polishNotation_noRename_numVars(): Unknown symbol '" + string { c } + "' in \"" + string(s) + "\".");
+				if (stack.size() < static_cast<size_t>(arity))
+					throw domain_error("DlCore::condensedDetachment_polishNotation_noRename_numVars(): Missing subformula for '" + string { c } + "' in \"" + string(s) + "\".");
+				uint32_t end = static_cast<uint32_t>(i + 1);
+				for (int8_t k = 0; k < arity; k++) {
+					end = next[stack.back()]; // the final child determines where the subformula ends
+					stack.pop_back();
+				}
+				next[i] = end;
+				stack.push_back(static_cast<uint32_t>(i));
+			}
+		}
+		if (stack.size() != 1)
+			throw domain_error("DlCore::condensedDetachment_polishNotation_noRename_numVars(): Invalid formula \"" + string(s) + "\".");
+		buffers.substitutions[side].assign(variableBound, none);
+	}
+
+	// 2. Unify 'antecedent' with the antecedent of 'conditional'.
+	auto variableAt = [&](uint32_t ref, uint32_t& variable) -> bool { // determines whether 'ref' references a variable, and if so, which one
+		string_view s = *inputs[ref >> 31];
+		uint32_t i = ref & ~conditionalBit;
+		if (!isDigit(s[i]))
+			return false;
+		variable = readVariable(s, i);
+		return true;
+	};
+	auto resolve = [&](uint32_t ref) {
+		uint32_t variable;
+		while (variableAt(ref, variable) && buffers.substitutions[ref >> 31][variable] != none)
+			ref = buffers.substitutions[ref >> 31][variable];
+		return ref;
+	};
+	auto occurs = [&](uint32_t side, uint32_t variable, uint32_t ref) {
+		vector<uint32_t>& stack = buffers.stack;
+		stack.clear();
+		stack.push_back(ref);
+		while (!stack.empty()) {
+			uint32_t r = stack.back();
+			stack.pop_back();
+			uint32_t rSide = r >> 31;
+			string_view s = *inputs[rSide];
+			for (uint32_t i = r & ~conditionalBit, end = buffers.next[rSide][i]; i < end;)
+				if (isDigit(s[i])) {
+					uint32_t v = readVariable(s, i);
+					uint32_t substitution = buffers.substitutions[rSide][v];
+					if (substitution != none)
+						stack.push_back(substitution);
+					else if (rSide == side && v == variable)
+						return true;
+				} else
+					i++;
+		}
+		return false;
+	};
+	vector<uint32_t>& pairs = buffers.pairs;
+	pairs.clear();
+	pairs.push_back(0);
+	pairs.push_back(conditionalBit | 1);
+	while (!pairs.empty()) {
+		uint32_t b = resolve(pairs.back());
+		pairs.pop_back();
+		uint32_t a = resolve(pairs.back());
+		pairs.pop_back();
+		if (a == b)
+			continue;
+		uint32_t variableA;
+		uint32_t variableB;
+		bool isVariableA = variableAt(a, variableA);
+		bool isVariableB = variableAt(b, variableB);
+		if (isVariableB) { // NOTE: We want to preferably keep variables in 'antecedent', i.e. map variables in 'conditional' to subformulas of 'antecedent'.
+			if (isVariableA && variableA == variableB && (a >> 31) == (b >> 31))
+				continue; // different occurrences of the same variable
+			if (!isVariableA && occurs(b >> 31, variableB, a))
+				return false; // cannot unify a variable and a formula that contains said variable
+			buffers.substitutions[b >> 31][variableB] = a;
+		} else if (isVariableA) {
+			if (occurs(a >> 31, variableA, b))
+				return false; // cannot unify a variable and a formula that contains said variable
+			buffers.substitutions[a >> 31][variableA] = b;
+		} else {
+			uint32_t iA = a & ~conditionalBit;
+			uint32_t iB = b & ~conditionalBit;
+			char c = (*inputs[a >> 31])[iA];
+			if (c != (*inputs[b >> 31])[iB])
+				return false; // cannot unify a mismatch between two non-variables
+			if (arities[static_cast<unsigned char>(c)] == 2) { // NOTE: Reversed order, such that subformulas are unified from left to right.
+				pairs.push_back((a & conditionalBit) | buffers.next[a >> 31][iA + 1]);
+				pairs.push_back((b & conditionalBit) | buffers.next[b >> 31][iB + 1]);
+			}
+			if (arities[static_cast<unsigned char>(c)] >= 1) {
+				pairs.push_back(a + 1);
+				pairs.push_back(b + 1);
+			}
+		}
+	}
+
+	// 3. Write the substituted consequent of 'conditional', with variables renamed according to their order of appearance.
+	buffers.translation[0].assign(buffers.substitutions[0].size(), none);
+	buffers.translation[1].assign(buffers.substitutions[1].size(), none);
+	uint32_t counter = 0;
+	output.clear();
+	auto write = [&](uint32_t ref, const auto& me) -> void {
+		uint32_t side = ref >> 31;
+		string_view s = *inputs[side];
+		for (uint32_t i = ref & ~conditionalBit, end = buffers.next[side][i]; i < end;)
+			if (isDigit(s[i])) {
+				uint32_t v = readVariable(s, i);
+				uint32_t substitution = buffers.substitutions[side][v];
+				if (substitution != none)
+					me(substitution, me);
+				else {
+					uint32_t& name = buffers.translation[side][v];
+					if (name == none)
+						name = counter++;
+					if (!output.empty() && isDigit(output.back()))
+						output += '.'; // separate consecutive variables
+					char digits[10];
+					to_chars_result result = to_chars(digits, digits + 10, name);
+					output.append(digits, result.ptr);
+				}
+			} else if (s[i] == '.')
+				i++;
+			else
+				output += s[i++];
+	};
+	write(conditionalBit | buffers.next[1][1], write);
+	return true;
+}
+
 bool DlCore::tryUnifyTrees(const shared_ptr<DlFormula>& formulaA, const shared_ptr<DlFormula>& formulaB, map<string, shared_ptr<DlFormula>>* optOut_substitutions, bool debug) {
 	map<string, shared_ptr<DlFormula>> substitutions;
 	if (_tryUnifyTrees(formulaA, formulaB, substitutions, debug)) {
@@ -1147,7 +1339,7 @@ bool DlCore::fromPolishNotation_noRename(shared_ptr<DlFormula>& output, const st
 	return true;
 }
 
-size_t DlCore::symbolicLen_polishNotation_noRename_numVars(const string& formula) {
+size_t DlCore::symbolicLen_polishNotation_noRename_numVars(string_view formula) {
 	size_t repLen = formula.length(); // formula representation length
 	size_t substract = 0;
 	bool atVar = false;
@@ -1215,7 +1407,7 @@ size_t DlCore::symbolicLen_polishNotation_noRename_numVars(const string& formula
 	return repLen - substract;
 }
 
-size_t DlCore::standardLen_polishNotation_noRename_numVars(const string& formula) {
+size_t DlCore::standardLen_polishNotation_noRename_numVars(string_view formula) {
 	size_t repLen = formula.length(); // formula representation length
 	size_t add = 0;
 	size_t substract = 0;
@@ -1266,9 +1458,9 @@ size_t DlCore::standardLen_polishNotation_noRename_numVars(const string& formula
 	return repLen - substract + add;
 }
 
-string::size_type DlCore::traverseFormulas_polishNotation_noRename_numVars(const string& formula, string::size_type startIndex, string::size_type formulasToTraverse) {
+string::size_type DlCore::traverseFormulas_polishNotation_noRename_numVars(string_view formula, string::size_type startIndex, string::size_type formulasToTraverse) {
 	bool prevVar = false;
-	string::const_iterator strIt;
+	string_view::const_iterator strIt;
 	for (strIt = formula.begin() + startIndex; strIt != formula.end(); ++strIt) {
 		char c = *strIt;
 		switch (c) {
@@ -1378,6 +1570,249 @@ void DlCore::_substitute(const shared_ptr<DlFormula>& destinationNode, const sha
 	}
 }
 
+uint32_t DlCore::toFlatFormula(DlFormulaArena& arena, const shared_ptr<DlFormula>& formula, vector<string>* optOut_variableNames) {
+	static const unordered_map<string, char> operatorNames = { { terminalStr_and(), 'K' }, { terminalStr_or(), 'A' }, { terminalStr_nand(), 'D' }, { terminalStr_nor(), 'X' }, { terminalStr_imply(), 'C' }, { terminalStr_implied(), 'B' }, { terminalStr_nimply(), 'F' }, { terminalStr_nimplied(), 'G' }, { terminalStr_equiv(), 'E' }, { terminalStr_xor(), 'J' }, { terminalStr_com(), 'S' }, { terminalStr_app(), 'U' }, { terminalStr_not(), 'N' }, { terminalStr_nece(), 'L' }, { terminalStr_poss(), 'M' }, { terminalStr_obli(), 'Z' }, { terminalStr_perm(), 'P' }, { terminalStr_top(), 'V' }, { terminalStr_bot(), 'O' } };
+	unordered_map<string, uint32_t> variableIds;
+	auto recurse = [&](const shared_ptr<DlFormula>& node, const auto& me) -> uint32_t {
+		const string& value = node->getValue()->value;
+		const vector<shared_ptr<DlFormula>>& children = node->getChildren();
+		unordered_map<string, char>::const_iterator searchResult = operatorNames.find(value);
+		if (searchResult == operatorNames.end()) {
+			if (!children.empty())
+				throw domain_error("DlCore::toFlatFormula(): Unsupported operator '" + value + "'.");
+			pair<unordered_map<string, uint32_t>::iterator, bool> emplaceResult = variableIds.emplace(value, static_cast<uint32_t>(variableIds.size()));
+			if (emplaceResult.second && optOut_variableNames)
+				optOut_variableNames->push_back(value);
+			return arena.addVariable(emplaceResult.first->second);
+		}
+		if (children.size() > 2)
+			throw domain_error("DlCore::toFlatFormula(): There are too many children (" + to_string(children.size()) + ").");
+		uint32_t child0 = children.size() > 0 ? me(children[0], me) : 0;
+		uint32_t child1 = children.size() > 1 ? me(children[1], me) : 0;
+		return arena.addOperator(searchResult->second, static_cast<unsigned>(children.size()), child0, child1);
+	};
+	if (optOut_variableNames)
+		optOut_variableNames->clear();
+	return recurse(formula, recurse);
+}
+
+shared_ptr<DlFormula> DlCore::fromFlatFormula(const DlFormulaArena& arena, uint32_t formula, const vector<string>* variableNames) {
+	static const unordered_map<char, DlOperator> operators = { { 'K', DlOperator::And }, { 'A', DlOperator::Or }, { 'D', DlOperator::Nand }, { 'X', DlOperator::Nor }, { 'C', DlOperator::Imply }, { 'B', DlOperator::Implied }, { 'F', DlOperator::Nimply }, { 'G', DlOperator::Nimplied }, { 'E', DlOperator::Equiv }, { 'J', DlOperator::Xor }, { 'S', DlOperator::Com }, { 'U', DlOperator::App }, { 'N', DlOperator::Not }, { 'L', DlOperator::Nece }, { 'M', DlOperator::Poss }, { 'Z', DlOperator::Obli }, { 'P', DlOperator::Perm }, { 'V', DlOperator::Top }, { 'O', DlOperator::Bot } };
+	vector<shared_ptr<String>> variables(arena.variableBound); // definite symbol for each variable
+	auto recurse = [&](uint32_t index, const auto& me) -> shared_ptr<DlFormula> {
+		const DlFlatNode& node = arena.nodes[index];
+		if (!node.symbol) {
+			uint32_t variable = node.data[0];
+			shared_ptr<String>& symbol = variables[variable];
+			if (!symbol)
+				symbol = make_shared<String>(variableNames ? variableNames->at(variable) : to_string(variable));
+			return make_shared<DlFormula>(symbol);
+		}
+		vector<shared_ptr<DlFormula>> children;
+		for (unsigned i = 0; i < node.arity; i++)
+			children.push_back(me(node.data[i], me));
+		return make_shared<DlFormula>(obtainDefiniteOpSymbol(operators.at(node.symbol)), children);
+	};
+	return recurse(formula, recurse);
+}
+
+bool DlCore::fromPolishNotation_noRename(DlFlatFormula& output, string_view input, bool debug) {
+	static const unordered_map<char, DlOperator> operators = { { 'K', DlOperator::And }, { 'A', DlOperator::Or }, { 'D', DlOperator::Nand }, { 'X', DlOperator::Nor }, { 'C', DlOperator::Imply }, { 'B', DlOperator::Implied }, { 'F', DlOperator::Nimply }, { 'G', DlOperator::Nimplied }, { 'E', DlOperator::Equiv }, { 'J', DlOperator::Xor }, { 'S', DlOperator::Com }, { 'U', DlOperator::App }, { 'N', DlOperator::Not }, { 'L', DlOperator::Nece }, { 'M', DlOperator::Poss }, { 'Z', DlOperator::Obli }, { 'P', DlOperator::Perm }, { 'V', DlOperator::Top }, { 'O', DlOperator::Bot } };
+	output.clear();
+	vector<uint32_t> stack;
+	string::size_type varLast = string::npos;
+	auto registerVariable = [&](string::size_type first) -> bool {
+		uint32_t variable = 0;
+		for (string::size_type j = first; j <= varLast; j++) {
+			char c = input[j];
+			if (c < '0' || c > '9') {
+				if (debug)
+					cerr << "Parse error: Non-numerical variable name \"" << input.substr(first, varLast + 1 - first) << "\" at index " << first << "." << endl;
+				return false;
+			}
+			variable = 10 * variable + (c - '0');
+		}
+		stack.push_back(static_cast<uint32_t>(output.size()));
+		output.push_back(DlFlatNode { '\0', 0, { variable, 0 } });
+		varLast = string::npos;
+		return true;
+	};
+	for (int64_t i = static_cast<int64_t>(input.length()) - 1; i >= 0; i--) {
+		char c = input[i];
+		if (c == '.') { // separator of variables
+			if (varLast == string::npos) {
+				if (debug)
+					cerr << "Parse error: Separator '.' does not precede a variable at index " << i << "." << endl;
+				return false;
+			}
+			if (!registerVariable(i + 1)) // register completed variable
+				return false;
+		} else {
+			unordered_map<char, DlOperator>::const_iterator searchResult = operators.find(c);
+			if (searchResult == operators.end()) {
+				if (varLast == string::npos)
+					varLast = i;
+			} else {
+				if (varLast != string::npos && !registerVariable(i + 1)) // first register completed variable
+					return false;
+				unsigned arity = dlOperatorArity(searchResult->second);
+				if (stack.size() < arity) {
+					if (debug)
+						cerr << "Parse error: Missing variable for '" << string { c } << "' at index " << i << "." << endl;
+					return false;
+				}
+				DlFlatNode node { c, static_cast<uint8_t>(arity), { 0, 0 } };
+				for (unsigned k = 0; k < arity; k++) {
+					node.data[k] = stack.back();
+					stack.pop_back();
+				}
+				stack.push_back(static_cast<uint32_t>(output.size()));
+				output.push_back(node);
+			}
+		}
+	}
+	if (varLast != string::npos && !registerVariable(0)) // still need to register variable
+		return false;
+	if (stack.size() != 1) {
+		if (debug)
+			cerr << "Parse error: Missing or extra variables resulted in a stack of size " << stack.size() << "." << endl;
+		return false;
+	}
+	return true;
+}
+
+bool DlCore::tryUnifyTrees(DlFormulaArena& arena, uint32_t formulaA, uint32_t formulaB, vector<uint32_t>& substitutions) {
+	// Robinson's unification algorithm on pairs of subformulas that are yet to be unified, where variables are resolved lazily (i.e. substitution entries are not applied to each other).
+	const vector<DlFlatNode>& nodes = arena.nodes;
+	substitutions.assign(arena.variableBound, UINT32_MAX);
+	auto resolve = [&](uint32_t index) {
+		const DlFlatNode* node;
+		while (!(node = &nodes[index])->symbol && substitutions[node->data[0]] != UINT32_MAX)
+			index = substitutions[node->data[0]];
+		return index;
+	};
+	auto occurs = [&](uint32_t variable, uint32_t index) {
+		vector<uint32_t>& stack = arena.indexBuffer;
+		stack.clear();
+		stack.push_back(index);
+		while (!stack.empty()) {
+			const DlFlatNode& node = nodes[resolve(stack.back())];
+			stack.pop_back();
+			if (!node.symbol) {
+				if (node.data[0] == variable)
+					return true;
+			} else
+				for (unsigned i = 0; i < node.arity; i++)
+					stack.push_back(node.data[i]);
+		}
+		return false;
+	};
+	vector<uint32_t>& pairs = arena.pairBuffer;
+	pairs.clear();
+	pairs.push_back(formulaA);
+	pairs.push_back(formulaB);
+	while (!pairs.empty()) {
+		uint32_t b = resolve(pairs.back());
+		pairs.pop_back();
+		uint32_t a = resolve(pairs.back());
+		pairs.pop_back();
+		if (a == b)
+			continue;
+		const DlFlatNode& nodeA = nodes[a];
+		const DlFlatNode& nodeB = nodes[b];
+		if (!nodeB.symbol) { // NOTE: We want to preferably keep variables in formulaA, i.e. map variables in formulaB to subformulas of formulaA.
+			if (!nodeA.symbol && nodeA.data[0] == nodeB.data[0])
+				continue; // different nodes of the same variable
+			if (nodeA.symbol && occurs(nodeB.data[0], a))
+				return false; // cannot unify a variable and a formula that contains said variable
+			substitutions[nodeB.data[0]] = a;
+		} else if (!nodeA.symbol) {
+			if (occurs(nodeA.data[0], b))
+				return false; // cannot unify a variable and a formula that contains said variable
+			substitutions[nodeA.data[0]] = b;
+		} else {
+			if (nodeA.symbol != nodeB.symbol)
+				return false; // cannot unify a mismatch between two non-variables
+			if (nodeA.arity != nodeB.arity)
+				throw domain_error("DlCore::tryUnifyTrees(): Nodes represent the same operator '" + string { nodeA.symbol } + "', but differ in arity (" + to_string(nodeA.arity) + " vs. " + to_string(nodeB.arity) + ").");
+			for (unsigned i = nodeA.arity; i > 0; i--) { // NOTE: Reversed order, such that subformulas are unified from left to right.
+				pairs.push_back(nodeA.data[i - 1]);
+				pairs.push_back(nodeB.data[i - 1]);
+			}
+		}
+	}
+	return true;
+}
+
+uint32_t DlCore::substitute(DlFormulaArena& arena, uint32_t formula, const vector<uint32_t>& substitutions) {
+	vector<uint32_t>& substituted = arena.variableBuffer; // for each variable, the index of its resulting formula (once determined)
+	substituted.assign(substitutions.size(), UINT32_MAX);
+	auto recurse = [&](uint32_t index, const auto& me) -> uint32_t {
+		DlFlatNode node = arena.nodes[index]; // NOTE: A copy, since adding nodes may invalidate references.
+		if (!node.symbol) {
+			uint32_t variable = node.data[0];
+			if (variable >= substitutions.size() || substitutions[variable] == UINT32_MAX)
+				return index;
+			uint32_t& result = substituted[variable];
+			if (result == UINT32_MAX)
+				result = me(substitutions[variable], me);
+			return result;
+		}
+		bool modified = false;
+		for (unsigned i = 0; i < node.arity; i++) {
+			uint32_t child = me(node.data[i], me);
+			if (child != node.data[i]) {
+				node.data[i] = child;
+				modified = true;
+			}
+		}
+		return modified ? arena.addOperator(node.symbol, node.arity, node.data[0], node.data[1]) : index;
+	};
+	return recurse(formula, recurse);
+}
+
+string DlCore::toPolishNotation_noRename(const DlFormulaArena& arena, uint32_t formula) {
+	string result;
+	auto recurse = [&](uint32_t index, const auto& me) -> void {
+		const DlFlatNode& node = arena.nodes[index];
+		if (!node.symbol) {
+			if (!result.empty() && result.back() >= '0' && result.back() <= '9')
+				result += '.'; // separate consecutive variables
+			result += to_string(node.data[0]);
+		} else {
+			result += node.symbol;
+			for (unsigned i = 0; i < node.arity; i++)
+				me(node.data[i], me);
+		}
+	};
+	recurse(formula, recurse);
+	return result;
+}
+
+string DlCore::toPolishNotation_numVars(const DlFormulaArena& arena, uint32_t formula) {
+	vector<uint32_t>& translation = arena.variableBuffer; // variable IDs according to order of appearance
+	translation.assign(arena.variableBound, UINT32_MAX);
+	uint32_t counter = 0;
+	string result;
+	auto recurse = [&](uint32_t index, const auto& me) -> void {
+		const DlFlatNode& node = arena.nodes[index];
+		if (!node.symbol) {
+			if (!result.empty() && result.back() >= '0' && result.back() <= '9')
+				result += '.'; // separate consecutive variables
+			uint32_t& variable = translation[node.data[0]];
+			if (variable == UINT32_MAX)
+				variable = counter++;
+			result += to_string(variable);
+		} else {
+			result += node.symbol;
+			for (unsigned i = 0; i < node.arity; i++)
+				me(node.data[i], me);
+		}
+	};
+	recurse(formula, recurse);
+	return result;
+}
+
 void DlCore::calculateEmptyMeanings(const shared_ptr<DlFormula>& formula) { // NOTE: Does the same as reduceFormulaMeaning_modifying(), except it reduces changes to empty meanings and does not return its (modified) input.
 	if (formula->meaning().empty()) {
 		if (formula->getChildren().empty()) {
@@ -2,12 +2,14 @@
 #define XAMIDI_LOGIC_DLCORE_H
 
 #include "../helper/FwdTbb.h"
+#include "DlFormulaArena.h"
 
 #include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -131,7 +133,13 @@ struct DlCore {
 	// Variant where inputs are given in Łukasiewicz-format provided by toPolishNotation_noRename(), and all variable names consist of only numerical characters.
 	static bool isSchemaOf_polishNotation_noRename_numVars(const std::string& potentialSchema, const std::string& formula, std::map<std::size_t, std::string>* optOut_substitutions = nullptr);
 	// Slightly faster than its map-based variant above. Uses a vector for substitution lookups. Ideal when all numerical variables 0, ..., n are given (i.e. there are no gaps).
-	static bool isSchemaOf_polishNotation_noRename_numVars_vec(const std::string& potentialSchema, const std::string& formula);
+	static bool isSchemaOf_polishNotation_noRename_numVars_vec(std::string_view potentialSchema, std::string_view formula);
+
+	// Condensed detachment (i.e. modus ponens via most general unification) for inputs in Łukasiewicz-format provided by toPolishNotation_noRename(), and all variable names consisting of only numerical characters.
+	// Unifies 'antecedent' with the antecedent of 'conditional' (where variables of different inputs are distinct) directly on the strings, and on success writes the substituted consequent
+	// of 'conditional' to 'output', with variables renamed according to their order of appearance (as by toPolishNotation_numVars()). Working memory is retained per thread, so apart from
+	// 'output' (which is only modified on success), no memory is allocated once buffers are large enough.
+	static bool condensedDetachment_polishNotation_noRename_numVars(std::string_view antecedent, std::string_view conditional, std::string& output);
 
 	// Determines whether there exists a unifier for the given formulas, i.e. a substitution that results in the same substituted formula for both of the given formulas.
 	// Essentially applies Robinson's unification algorithm, but modified such that the substituted formulas are not constructed but implicitly compared.
@@ -174,15 +182,15 @@ struct DlCore {
 
 	// Calculate the formula's symbolic length (i.e. the amount of nodes of its syntax tree), where 'formula' is given in Łukasiewicz-format provided by toPolishNotation_noRename(),
 	// and all variable names consist of only numerical characters.
-	static std::size_t symbolicLen_polishNotation_noRename_numVars(const std::string& formula);
+	static std::size_t symbolicLen_polishNotation_noRename_numVars(std::string_view formula);
 	static std::size_t symbolicLen_polishNotation_noRename_numVars(const std::string& formula, std::string::size_type startIndex);
 
 	// Calculate the formula's standard length, where 'formula' is given in Łukasiewicz-format provided by toPolishNotation_noRename(), and all variable names consist of only numerical characters.
-	static std::size_t standardLen_polishNotation_noRename_numVars(const std::string& formula);
+	static std::size_t standardLen_polishNotation_noRename_numVars(std::string_view formula);
 
 	// Traverse the given amount of (sub-)formulas of the given formula in Łukasiewicz-format provided by toPolishNotation_noRename(), and return the index of the final character.
 	// In case 'formula' was traversed entirely (which should only happen for 'startIndex' = 0), does not return the final index, but formula.length().
-	static std::string::size_type traverseFormulas_polishNotation_noRename_numVars(const std::string& formula, std::string::size_type startIndex = 0, std::string::size_type formulasToTraverse = 1);
+	static std::string::size_type traverseFormulas_polishNotation_noRename_numVars(std::string_view formula, std::string::size_type startIndex = 0, std::string::size_type formulasToTraverse = 1);
 
 	// Calculate the substitution's representation based on formulaRepresentation_traverse().
 	static std::string substitutionRepresentation_traverse(const std::map<std::string, std::shared_ptr<DlFormula>>& substitutions);
@@ -193,6 +201,19 @@ struct DlCore {
 	// Create a copy of the given formula where all the variables of formula have been replaced by references to the corresponding substitution entries.
 	static std::shared_ptr<DlFormula> substitute(const std::shared_ptr<DlFormula>& formula, const std::map<std::string, std::shared_ptr<DlFormula>>& substitutions);
 
+	// Variants for formulas in flat representation (see DlFormulaArena), which are addressed by indices of their root nodes. Substitutions map variable IDs to node indices,
+	// where UINT32_MAX indicates a variable without substitution entry. Variable names of 'DlFormula' formulas are mapped to IDs in order of their first occurrence.
+	static std::uint32_t toFlatFormula(DlFormulaArena& arena, const std::shared_ptr<DlFormula>& formula, std::vector<std::string>* optOut_variableNames = nullptr);
+	static std::shared_ptr<DlFormula> fromFlatFormula(const DlFormulaArena& arena, std::uint32_t formula, const std::vector<std::string>* variableNames = nullptr);
+	// Inverse of toPolishNotation_noRename() for Łukasiewicz-format with only numerical variable names, which are used as IDs.
+	static bool fromPolishNotation_noRename(DlFlatFormula& output, std::string_view input, bool debug = false);
+	// Unifies without building any formulas, such that resulting substitutions are triangular, i.e. substitution entries may contain variables with substitution entries.
+	static bool tryUnifyTrees(DlFormulaArena& arena, std::uint32_t formulaA, std::uint32_t formulaB, std::vector<std::uint32_t>& substitutions);
+	// Applies substitutions exhaustively (as required for triangular substitutions). Unaffected subformulas and each substituted variable's resulting formula are shared.
+	static std::uint32_t substitute(DlFormulaArena& arena, std::uint32_t formula, const std::vector<std::uint32_t>& substitutions);
+	static std::string toPolishNotation_noRename(const DlFormulaArena& arena, std::uint32_t formula);
+	static std::string toPolishNotation_numVars(const DlFormulaArena& arena, std::uint32_t formula);
+
 	// Calculates all the meanings in a formula such that no meaning of a node represents an expression (ψ) for a DL-formula ψ.
 	// The meaning of a parent node surrounds a child's meaning by parentheses only if necessary to describe the same tree / formula, using our order of operations with left first bracketing.
 	static void calculateEmptyMeanings(const std::shared_ptr<DlFormula>& formula);
@@ -0,0 +1,55 @@
+#include "DlFormulaArena.h"
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace xamidi {
+namespace logic {
+
+DlFormulaArena& DlFormulaArena::threadLocal() {
+	thread_local DlFormulaArena arena;
+	return arena;
+}
+
+void DlFormulaArena::clear() {
+	nodes.clear();
+	variableBound = 0;
+}
+
+uint32_t DlFormulaArena::addVariable(uint32_t variable) {
+	uint32_t index = static_cast<uint32_t>(nodes.size());
+	nodes.push_back(DlFlatNode { '\0', 0, { variable, 0 } });
+	if (variable >= variableBound)
+		variableBound = variable + 1;
+	return index;
+}
+
+uint32_t DlFormulaArena::addOperator(char symbol, unsigned arity, uint32_t child0, uint32_t child1) {
+	uint32_t index = static_cast<uint32_t>(nodes.size());
+	nodes.push_back(DlFlatNode { symbol, static_cast<uint8_t>(arity), { child0, child1 } });
+	return index;
+}
+
+uint32_t DlFormulaArena::append(const DlFlatFormula& formula, uint32_t variableOffset) {
+	if (formula.empty())
+		throw invalid_argument("DlFormulaArena::append(): Empty formula.");
+	uint32_t base = static_cast<uint32_t>(nodes.size());
+	for (const DlFlatNode& node : formula)
+		if (node.symbol)
+			nodes.push_back(DlFlatNode { node.symbol, node.arity, { node.data[0] + base, node.data[1] + base } });
+		else
+			addVariable(node.data[0] + variableOffset);
+	return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+size_t DlFormulaArena::symbolicLength(uint32_t formula) const {
+	const DlFlatNode& node = nodes[formula];
+	size_t len = 1;
+	for (unsigned i = 0; i < node.arity; i++)
+		len += symbolicLength(node.data[i]);
+	return len;
+}
+
+}
+}
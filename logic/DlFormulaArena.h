@@ -0,0 +1,51 @@
+#ifndef XAMIDI_LOGIC_DLFORMULAARENA_H
+#define XAMIDI_LOGIC_DLFORMULAARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace xamidi {
+namespace logic {
+
+// Node of a formula in flat representation, i.e. of a formula that is stored within a contiguous array of nodes, which address their subformulas via 32-bit indices.
+struct DlFlatNode {
+	char symbol; // Łukasiewicz operator symbol as provided by DlCore::toPolishNotation_noRename() (e.g. 'C' for \imply), or '\0' for variables
+	std::uint8_t arity;
+	std::uint32_t data[2]; // variable: data[0] is the variable's ID ; operator: data[0], ..., data[arity - 1] are node indices of its subformulas
+};
+
+// Self-contained formula in flat representation, where children precede their parents, i.e. the root is the final node. Variables are numerical IDs.
+// Compact alternative to DlFormula, e.g. to store parsed conclusions (see DlCore::fromPolishNotation_noRename()).
+typedef std::vector<DlFlatNode> DlFlatFormula;
+
+// Arena of nodes for formulas in flat representation, where formulas are addressed by the indices of their root nodes, and may share subformulas (e.g. after substitution).
+// Nodes are never freed individually, but all at once via clear(), which retains the arena's capacities. Therefore, reusing an arena (e.g. per thread via threadLocal())
+// for many short-lived formulas (e.g. for D-rule evaluations) means to build and process formulas without heap allocations and without reference counting.
+// Functions that operate on arenas are DlCore's overloads of tryUnifyTrees(), substitute(), toPolishNotation_noRename() and toPolishNotation_numVars().
+struct DlFormulaArena {
+	std::vector<DlFlatNode> nodes;
+	std::uint32_t variableBound = 0; // all variable IDs in 'nodes' are lower than 'variableBound'
+
+	// Buffers for DlCore's functions on arenas, kept here in order to retain their capacities.
+	mutable std::vector<std::uint32_t> indexBuffer;
+	mutable std::vector<std::uint32_t> pairBuffer;
+	mutable std::vector<std::uint32_t> variableBuffer;
+
+	static DlFormulaArena& threadLocal(); // an arena for the calling thread
+
+	void clear();
+	std::uint32_t addVariable(std::uint32_t variable);
+	std::uint32_t addOperator(char symbol, unsigned arity, std::uint32_t child0 = 0, std::uint32_t child1 = 0);
+
+	// Copies all nodes of 'formula' into the arena, with each variable ID increased by 'variableOffset'. Returns the index of the copied root node.
+	std::uint32_t append(const DlFlatFormula& formula, std::uint32_t variableOffset = 0);
+
+	// Amount of nodes of the formula's syntax tree, i.e. shared subformulas are counted for each of their occurrences.
+	std::size_t symbolicLength(std::uint32_t formula) const;
+};
+
+}
+}
+
+#endif // XAMIDI_LOGIC_DLFORMULAARENA_H
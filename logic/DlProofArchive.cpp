@@ -0,0 +1,194 @@
+#include "DlProofArchive.h"
+
+#include <filesystem>
+#include <stdexcept>
+
+using namespace std;
+namespace bip = boost::interprocess;
+
+namespace xamidi {
+namespace logic {
+
+DlProofArchive::Buffer::Buffer(const DlProofArchive& archive) :
+		archive(archive), buffer(1 << 20) {
+	setg(buffer.data(), buffer.data(), buffer.data());
+}
+
+DlProofArchive::Buffer::~Buffer() {
+	endBlock();
+	lzma_end(&strm);
+}
+
+bool DlProofArchive::Buffer::startBlock(uint64_t position) {
+	endBlock();
+	lzma_index_iter_init(&iter, archive.index);
+	if (lzma_index_iter_locate(&iter, position)) // position is not within the uncompressed contents
+		return false;
+	if (iter.block.compressed_file_offset + iter.block.total_size > archive.fileSize)
+		throw runtime_error("Truncated xz block at position " + to_string(iter.block.compressed_file_offset) + ".");
+	const uint8_t* p = archive.data + iter.block.compressed_file_offset;
+	block = lzma_block { };
+	block.version = 1;
+	block.check = iter.stream.flags->check;
+	block.header_size = lzma_block_header_size_decode(p[0]);
+	block.filters = filters;
+	if (block.header_size > iter.block.total_size || lzma_block_header_decode(&block, nullptr, p) != LZMA_OK)
+		throw runtime_error("Corrupt xz block header at position " + to_string(iter.block.compressed_file_offset) + ".");
+	hasFilters = true;
+	if (lzma_block_compressed_size(&block, iter.block.unpadded_size) != LZMA_OK || lzma_block_decoder(&strm, &block) != LZMA_OK)
+		throw runtime_error("Unsupported xz block at position " + to_string(iter.block.compressed_file_offset) + ".");
+	strm.next_in = p + block.header_size;
+	strm.avail_in = iter.block.total_size - block.header_size;
+	hasBlock = true;
+	bufferPosition = iter.block.uncompressed_file_offset;
+	setg(buffer.data(), buffer.data(), buffer.data());
+	return true;
+}
+
+void DlProofArchive::Buffer::endBlock() {
+	if (hasFilters) {
+		lzma_filters_free(filters, nullptr);
+		hasFilters = false;
+	}
+	hasBlock = false;
+}
+
+DlProofArchive::Buffer::int_type DlProofArchive::Buffer::underflow() {
+	if (gptr() < egptr())
+		return traits_type::to_int_type(*gptr());
+	bufferPosition += static_cast<uint64_t>(egptr() - eback());
+	setg(buffer.data(), buffer.data(), buffer.data());
+	while (true) {
+		if (!hasBlock && !startBlock(bufferPosition))
+			return traits_type::eof();
+		strm.next_out = reinterpret_cast<uint8_t*>(buffer.data());
+		strm.avail_out = buffer.size();
+		lzma_ret ret = lzma_code(&strm, LZMA_RUN);
+		size_t n = buffer.size() - strm.avail_out;
+		if (ret == LZMA_STREAM_END) {
+			if (bufferPosition + n != iter.block.uncompressed_file_offset + iter.block.uncompressed_size)
+				throw runtime_error("Inconsistent size of xz block at position " + to_string(iter.block.compressed_file_offset) + ".");
+			endBlock();
+		} else if (ret != LZMA_OK || (!n && !strm.avail_in))
+			throw runtime_error("Corrupt xz block at position " + to_string(iter.block.compressed_file_offset) + ".");
+		if (n) {
+			setg(buffer.data(), buffer.data(), buffer.data() + n);
+			return traits_type::to_int_type(*gptr());
+		}
+	}
+}
+
+DlProofArchive::Buffer::pos_type DlProofArchive::Buffer::seekoff(off_type off, ios_base::seekdir dir, ios_base::openmode which) {
+	off_type base = dir == ios_base::beg ? 0 : dir == ios_base::cur ? static_cast<off_type>(bufferPosition) + (gptr() - eback()) : static_cast<off_type>(archive.size());
+	return seekpos(pos_type(base + off), which);
+}
+
+DlProofArchive::Buffer::pos_type DlProofArchive::Buffer::seekpos(pos_type pos, ios_base::openmode which) {
+	if (!(which & ios_base::in) || off_type(pos) < 0 || static_cast<uint64_t>(off_type(pos)) > archive.size())
+		return pos_type(off_type(-1));
+	uint64_t target = static_cast<uint64_t>(off_type(pos));
+	if (target >= bufferPosition && target <= bufferPosition + static_cast<uint64_t>(egptr() - eback())) { // buffered
+		setg(eback(), eback() + (target - bufferPosition), egptr());
+		return pos;
+	}
+	if (!startBlock(target)) { // end of contents
+		bufferPosition = target;
+		setg(buffer.data(), buffer.data(), buffer.data());
+		return pos;
+	}
+	while (!traits_type::eq_int_type(underflow(), traits_type::eof())) { // decode from the beginning of the block up to the target
+		uint64_t available = static_cast<uint64_t>(egptr() - eback());
+		if (target < bufferPosition + available) {
+			setg(eback(), eback() + (target - bufferPosition), egptr());
+			return pos;
+		}
+		setg(eback(), egptr(), egptr());
+	}
+	return pos_type(off_type(-1));
+}
+
+DlProofArchive::Stream::Stream(const shared_ptr<const DlProofArchive>& archive) :
+		istream(nullptr), archive(archive), buffer(*archive) {
+	rdbuf(&buffer);
+	exceptions(ios_base::badbit); // rethrow decoding errors rather than to indicate a regular end of input
+}
+
+DlProofArchive::~DlProofArchive() {
+	if (index)
+		lzma_index_end(index, nullptr);
+}
+
+string DlProofArchive::archivePath(const string& textFile) {
+	return textFile + ".xz";
+}
+
+bool DlProofArchive::open(const string& file, string* optOut_error) {
+	auto fail = [&](const string& error) {
+		if (optOut_error)
+			*optOut_error = error;
+		if (index) {
+			lzma_index_end(index, nullptr);
+			index = nullptr;
+		}
+		region = bip::mapped_region();
+		mapping = bip::file_mapping();
+		data = nullptr;
+		fileSize = 0;
+		blockOffsets.clear();
+		return false;
+	};
+	error_code ec;
+	fileSize = filesystem::file_size(filesystem::u8path(file), ec);
+	if (ec)
+		return fail("missing file");
+	if (fileSize < 2 * LZMA_STREAM_HEADER_SIZE)
+		return fail("truncated file");
+	try {
+		mapping = bip::file_mapping(file.c_str(), bip::read_only);
+		region = bip::mapped_region(mapping, bip::read_only);
+	} catch (bip::interprocess_exception& e) {
+		return fail(string("failed mapping (") + e.what() + ")");
+	}
+	if (region.get_size() != fileSize)
+		return fail("failed mapping");
+	data = static_cast<const uint8_t*>(region.get_address());
+	region.advise(bip::mapped_region::advice_sequential);
+
+	// Decode the index fields of all streams (which are located at the end of each stream), so only a small portion of the file is accessed.
+	lzma_stream strm = LZMA_STREAM_INIT;
+	if (lzma_file_info_decoder(&strm, &index, UINT64_MAX, fileSize) != LZMA_OK)
+		return fail("insufficient memory");
+	strm.next_in = data;
+	strm.avail_in = fileSize;
+	lzma_ret ret;
+	while ((ret = lzma_code(&strm, LZMA_RUN)) == LZMA_OK || ret == LZMA_SEEK_NEEDED) {
+		if (ret == LZMA_SEEK_NEEDED) {
+			strm.next_in = data + strm.seek_pos;
+			strm.avail_in = fileSize - strm.seek_pos;
+		} else if (!strm.avail_in)
+			break;
+	}
+	lzma_end(&strm);
+	switch (ret) {
+	case LZMA_STREAM_END:
+		break;
+	case LZMA_FORMAT_ERROR:
+		return fail("unknown format");
+	case LZMA_MEM_ERROR:
+		return fail("insufficient memory");
+	case LZMA_OK:
+	case LZMA_BUF_ERROR:
+		return fail("truncated file");
+	default:
+		return fail("corrupt file");
+	}
+	lzma_index_iter iter;
+	lzma_index_iter_init(&iter, index);
+	while (!lzma_index_iter_next(&iter, LZMA_INDEX_ITER_NONEMPTY_BLOCK))
+		blockOffsets.push_back(iter.block.uncompressed_file_offset);
+	blockOffsets.push_back(lzma_index_uncompressed_size(index));
+	return true;
+}
+
+}
+}
@@ -0,0 +1,85 @@
+#ifndef XAMIDI_LOGIC_DLPROOFARCHIVE_H
+#define XAMIDI_LOGIC_DLPROOFARCHIVE_H
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <lzma.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace xamidi {
+namespace logic {
+
+// Read-only access to an xz-compressed proof file (e.g. "dProofs29.txt.xz" for "dProofs29.txt"), which is used in place of a missing text proof file.
+// The file is memory-mapped, and its index (i.e. the list of independently compressed blocks) is read upon opening, so any position of the uncompressed
+// contents can be reached by decoding only from the beginning of the block that contains it. Multiple streams of the same archive can be read concurrently.
+// NOTE: Random access requires multiple blocks, e.g. "xz -T0 -k dProofs29.txt" (which uses blocks of 24 MiB by default) or "xz --block-size=16MiB -k dProofs29.txt".
+//       Single-threaded xz creates a single block, in which case the archive can only be read sequentially (i.e. without chunk-level concurrency).
+struct DlProofArchive {
+	// Sequential reader of the uncompressed contents. Seeking is supported, but costs the decoding of up to one block (unless the target is buffered).
+	class Buffer : public std::streambuf {
+		const DlProofArchive& archive;
+		lzma_stream strm = LZMA_STREAM_INIT;
+		lzma_index_iter iter;
+		lzma_block block; // referenced by the decoder
+		lzma_filter filters[LZMA_FILTERS_MAX + 1];
+		bool hasFilters = false;
+		bool hasBlock = false; // whether 'iter' refers to a block that is being decoded
+		std::vector<char> buffer;
+		std::uint64_t bufferPosition = 0; // uncompressed position of eback()
+		bool startBlock(std::uint64_t position);
+		void endBlock();
+	public:
+		explicit Buffer(const DlProofArchive& archive);
+		~Buffer();
+		Buffer(const Buffer&) = delete;
+		Buffer& operator=(const Buffer&) = delete;
+	protected:
+		int_type underflow() override;
+		pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in) override;
+		pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in) override;
+	};
+
+	// Input stream that owns its buffer and keeps the archive alive.
+	class Stream : public std::istream {
+		std::shared_ptr<const DlProofArchive> archive;
+		Buffer buffer;
+	public:
+		explicit Stream(const std::shared_ptr<const DlProofArchive>& archive);
+	};
+private:
+	boost::interprocess::file_mapping mapping;
+	boost::interprocess::mapped_region region;
+	const std::uint8_t* data = nullptr;
+	std::uint64_t fileSize = 0;
+	lzma_index* index = nullptr;
+	std::vector<std::uint64_t> blockOffsets; // uncompressed positions of all non-empty blocks, followed by the uncompressed size
+public:
+	DlProofArchive() = default;
+	~DlProofArchive();
+	DlProofArchive(const DlProofArchive&) = delete;
+	DlProofArchive& operator=(const DlProofArchive&) = delete;
+
+	// Path of the archive of a text proof file, i.e. with ".xz" appended.
+	static std::string archivePath(const std::string& textFile);
+
+	// Maps 'file' and decodes its index. Fails (and stores the reason in 'optOut_error') when the file is missing or no valid xz file.
+	bool open(const std::string& file, std::string* optOut_error = nullptr);
+
+	std::uint64_t size() const { return blockOffsets.empty() ? 0 : blockOffsets.back(); }
+	std::uint64_t compressedSize() const { return fileSize; }
+	std::size_t blockCount() const { return blockOffsets.empty() ? 0 : blockOffsets.size() - 1; }
+	std::uint64_t blockOffset(std::size_t i) const { return blockOffsets[i]; } // blockOffset(blockCount()) == size()
+};
+
+}
+}
+
+#endif // XAMIDI_LOGIC_DLPROOFARCHIVE_H
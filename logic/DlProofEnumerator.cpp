@@ -1,24 +1,36 @@
 #include "DlProofEnumerator.h"
 
 #include "../helper/FctHelper.h"
+#include "../helper/IndexBitmap.h"
+#include "../helper/NdJson.h"
 #include "../helper/Resources.h"
 #include "../tree/TreeNode.h"
 #include "../cryptography/sha2.h"
 #include "DlCore.h"
 #include "DlFormula.h"
+#include "DlProofArchive.h"
+#include "DlProofFile.h"
+#include "DlProofIndex.h"
+#include "DlSchemaIndex.h"
+#include "DlSkeletonIndex.h"
+#include "DlTermIndex.h"
 
 #include <boost/algorithm/string.hpp>
 
+#include <tbb/blocked_range2d.h>
 #include <tbb/concurrent_map.h>
 #include <tbb/concurrent_unordered_set.h>
 #include <tbb/concurrent_vector.h>
+#include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_sort.h>
 
+#include <climits>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
 #include <numeric>
+#include <queue>
 
 using namespace std;
 using namespace xamidi::helper;
@@ -33,6 +45,42 @@ inline string myTime() {
 	time_t time = chrono::system_clock::to_time_t(chrono::system_clock::now());
 	return strtok(ctime(&time), "\n");
 }
+inline string throughputString(uint64_t bytes, const chrono::microseconds& dur) {
+	return FctHelper::round(static_cast<long double>(bytes) / max(dur.count(), chrono::microseconds::rep(1)) / 1000, 2) + " GB/s";
+}
+void mpi_printBalancingStatistics(int mpi_rank, int mpi_size, const string& scheme, chrono::microseconds idleTime, uint64_t messageCount) { // NOTE: Collective, i.e. to be called by all processes.
+	array<uint64_t, 2> local = { static_cast<uint64_t>(idleTime.count()), messageCount };
+	vector<uint64_t> all(mpi_rank ? 0 : 2 * mpi_size);
+	MPI_Gather(local.data(), 2, MPI_UNSIGNED_LONG_LONG, mpi_rank ? nullptr : all.data(), 2, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+	if (!mpi_rank) {
+		uint64_t totalMessages = 0;
+		uint64_t maxMessages = 0;
+		vector<string> idleTimes;
+		for (int rank = 0; rank < mpi_size; rank++) {
+			totalMessages += all[2 * rank + 1];
+			maxMessages = max(maxMessages, all[2 * rank + 1]);
+			idleTimes.push_back(to_string(rank) + ":" + FctHelper::durationStringMs(chrono::microseconds(all[2 * rank])));
+		}
+		cout << "Load balancing via " + scheme + ": " + to_string(totalMessages) + " message" + (totalMessages == 1 ? "" : "s") + " in total (at most " + to_string(maxMessages) + " per rank) ; idle times per rank: " + FctHelper::vectorString(idleTimes, "{ ", " }") << endl;
+	}
+}
+bool indexCoversFiles(const auto& index, const string& filePrefix, const vector<pair<uint32_t, uint32_t>>& files, string& error) { // for DlProofIndex and DlTermIndex
+	if (index.fileCount() != files.size()) {
+		error = "outdated file";
+		return false;
+	}
+	for (size_t i = 0; i < files.size(); i++) {
+		const DlProofIndex::FileRecord& record = index.fileRecord(i);
+		string file = filePrefix + to_string(record.wordLengthLimit) + (record.unfiltered ? "-unfiltered" + to_string(record.unfiltered) + "+" : "") + ".txt";
+		filesystem::path path = filesystem::u8path(record.flags & 1 ? DlProofArchive::archivePath(file) : file);
+		error_code ec;
+		if (record.wordLengthLimit != files[i].first || record.unfiltered != files[i].second || filesystem::file_size(path, ec) != record.size || ec || filesystem::last_write_time(path, ec).time_since_epoch().count() != record.time || ec) {
+			error = "outdated file";
+			return false;
+		}
+	}
+	return true;
+}
 inline void switchRefs(char& c, bool& inReference, unsigned& refIndex, const auto& inRefAction, const auto& outRefAction) {
 	if (inReference)
 		switch (c) {
@@ -174,7 +222,7 @@ bool DlProofEnumerator::resetRepresentativesFor(const vector<string>* customAxio
 		// 1.2 Filter out redundant axioms to obtain representatives
 		uint64_t representativeCounter = customAxioms->size();
 		uint64_t redundantCounter = 0;
-		tbb::concurrent_hash_map<string, string> representativeProofs;
+		DlConclusionStore representativeProofs;
 		for (size_t i = 0; i < customAxiomFormulas.size(); i++)
 			representativeProofs.emplace(customAxiomFormulas[i], customAxiomNames[i]);
 		_removeRedundantConclusionsForProofsOfMaxLength(1, representativeProofs, nullptr, representativeCounter, redundantCounter);
@@ -186,11 +234,11 @@ bool DlProofEnumerator::resetRepresentativesFor(const vector<string>* customAxio
 				*errOut << "Warning: There " << (numDuplicates == 1 ? "is " : "are ") << numDuplicates << " axiom" << (numDuplicates == 1 ? " which is a duplicate." : "s which are duplicates.") << endl;
 			vector<pair<string, string>> redundancies;
 			for (size_t i = 0; i < customAxiomFormulas.size(); i++) {
-				tbb::concurrent_hash_map<string, string>::const_accessor rAcc;
-				if (representativeProofs.find(rAcc, customAxiomFormulas[i])) {
-					_customRepresentatives1.push_back(rAcc->second);
-					_customConclusions1.push_back(rAcc->first);
-					representativeProofs.erase(rAcc);
+				string_view dProof;
+				if (representativeProofs.find(customAxiomFormulas[i], &dProof)) {
+					_customRepresentatives1.push_back(string(dProof));
+					_customConclusions1.push_back(customAxiomFormulas[i]);
+					representativeProofs.erase(customAxiomFormulas[i]);
 				} else
 					redundancies.push_back(make_pair(customAxiomNames[i], customAxiomFormulas[i]));
 			}
@@ -469,17 +517,19 @@ vector<const vector<string>*>& DlProofEnumerator::currentConclusions() {
 	return _builtinConclusions;
 }
 
-vector<vector<string>> DlProofEnumerator::composeToLookupVector(const vector<const vector<string>*>& all, const uint32_t* proofLenStepSize) {
+DlProofLookup DlProofEnumerator::composeToLookupVector(const vector<const vector<string>*>& all, const uint32_t* proofLenStepSize) {
 	const uint32_t c = proofLenStepSize ? *proofLenStepSize : _necessitationLimit ? 1 : 2;
-	vector<vector<string>> all_refined(2 * all.size());
+	DlProofLookup all_refined(2 * all.size());
 	vector<const vector<string>*>::const_iterator it = all.begin();
 	uint32_t limit = static_cast<uint32_t>(2 * all.size() - 1);
-	for (uint32_t wordLengthLimit = 1; wordLengthLimit <= limit; wordLengthLimit += c)
-		all_refined[wordLengthLimit] = **it++;
+	for (uint32_t wordLengthLimit = 1; wordLengthLimit <= limit; wordLengthLimit += c) {
+		const vector<string>& representatives = **it++; // NOTE: Built-in (or initial) representatives are static (and only replaced between tasks), so they outlive the lookup.
+		all_refined[wordLengthLimit].assign(representatives.begin(), representatives.end());
+	}
 	return all_refined;
 }
 
-bool DlProofEnumerator::readRepresentativesLookupVectorFromFiles_seq(vector<vector<string>>& allRepresentativesLookup, vector<vector<string>>* optOut_allConclusionsLookup, bool debug, const string& filePrefix, const string& filePostfix, bool initFresh, uint32_t limit, const uint32_t* proofLenStepSize) {
+bool DlProofEnumerator::readRepresentativesLookupVectorFromFiles_seq(DlProofLookup& allRepresentativesLookup, DlProofLookup* optOut_allConclusionsLookup, bool debug, const string& filePrefix, const string& filePostfix, bool initFresh, uint32_t limit, const uint32_t* proofLenStepSize) {
 	const uint32_t c = proofLenStepSize ? *proofLenStepSize : _necessitationLimit ? 1 : 2;
 	chrono::time_point<chrono::steady_clock> startTime;
 	if (initFresh) {
@@ -493,38 +543,53 @@ bool DlProofEnumerator::readRepresentativesLookupVectorFromFiles_seq(vector<vect
 	}
 	for (uint32_t wordLengthLimit = static_cast<uint32_t>(allRepresentativesLookup.size() + c - 1); wordLengthLimit <= limit; wordLengthLimit += c) { // look for files containing D-proofs, starting from built-in limit + c
 		string file = filePrefix + to_string(wordLengthLimit) + filePostfix;
-		if (filesystem::exists(file)) { // load
+		if (_proofFileExists(file)) { // load
 			allRepresentativesLookup.resize(allRepresentativesLookup.size() + c);
-			vector<string>& contents = allRepresentativesLookup.back();
-			vector<string>* conclusions = nullptr;
+			vector<string_view>& contents = allRepresentativesLookup.back();
+			vector<string_view>* conclusions = nullptr;
 			if (optOut_allConclusionsLookup) {
 				optOut_allConclusionsLookup->resize(optOut_allConclusionsLookup->size() + c);
 				conclusions = &optOut_allConclusionsLookup->back();
 			}
 			if (debug)
 				startTime = chrono::steady_clock::now();
-			ifstream fin(file, fstream::in | fstream::binary);
-			if (!fin.is_open()) {
+			string error;
+			if (shared_ptr<const void> mapping = _readProofFileCompanion(file, contents, conclusions, error)) {
+				allRepresentativesLookup.keep(mapping);
+				if (optOut_allConclusionsLookup)
+					optOut_allConclusionsLookup->keep(mapping);
+				if (debug)
+					cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to read " << contents.size() << " condensed detachment proof" << (contents.size() == 1 ? "" : "s") << (conclusions ? contents.size() == 1 ? " and conclusion" : " and conclusions" : "")  << " from " << DlProofFile::companionPath(file) << " (memory-mapped)." << endl;
+				continue;
+			} else if (debug && !error.empty())
+				cerr << "Ignored binary companion " << DlProofFile::companionPath(file) << " due to " << error << "." << endl;
+			unique_ptr<istream> fin = _openProofFile(file);
+			if (!fin) {
 				if (debug)
 					cerr << "Failed to read the data file \"" << file << "\". Aborting." << endl;
 				return false;
 			}
+			vector<vector<string>> lines(1);
+			vector<vector<string>> conclusionLines(1);
 			string line;
-			while (getline(fin, line)) {
+			while (getline(*fin, line)) {
 				string::size_type i = line.find(':'); // support both variants "<D-proof>:<formula>" and "<D-proof>"
 				if (i == string::npos) {
-					contents.push_back(line);
+					lines[0].push_back(line);
 					if (conclusions) {
 						if (debug)
 							cerr << "Missing conclusion in data file " << file << "\". Aborting." << endl;
 						return false;
 					}
 				} else {
-					contents.push_back(line.substr(0, i));
+					lines[0].push_back(line.substr(0, i));
 					if (conclusions)
-						conclusions->push_back(line.substr(i + 1));
+						conclusionLines[0].push_back(line.substr(i + 1));
 				}
 			}
+			allRepresentativesLookup.keep(DlProofLookup::concatenate(lines, contents));
+			if (conclusions)
+				optOut_allConclusionsLookup->keep(DlProofLookup::concatenate(conclusionLines, *conclusions));
 			if (debug)
 				cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to read " << contents.size() << " condensed detachment proof" << (contents.size() == 1 ? "" : "s") << (conclusions ? contents.size() == 1 ? " and conclusion" : " and conclusions" : "")  << " from " << file << "." << endl;
 		} else
@@ -533,7 +598,7 @@ bool DlProofEnumerator::readRepresentativesLookupVectorFromFiles_seq(vector<vect
 	return true;
 }
 
-bool DlProofEnumerator::readRepresentativesLookupVectorFromFiles_par(vector<vector<string>>& allRepresentativesLookup, vector<vector<string>>* optOut_allConclusionsLookup, bool debug, unsigned concurrencyCount, const string& filePrefix, const string& filePostfix, bool initFresh, uint32_t limit, const uint32_t* proofLenStepSize) {
+bool DlProofEnumerator::readRepresentativesLookupVectorFromFiles_par(DlProofLookup& allRepresentativesLookup, DlProofLookup* optOut_allConclusionsLookup, bool debug, unsigned concurrencyCount, const string& filePrefix, const string& filePostfix, bool initFresh, uint32_t limit, const uint32_t* proofLenStepSize) {
 	if (concurrencyCount < 2)
 		return readRepresentativesLookupVectorFromFiles_seq(allRepresentativesLookup, optOut_allConclusionsLookup, debug, filePrefix, filePostfix, initFresh, limit); // system cannot execute threads concurrently
 	const uint32_t c = proofLenStepSize ? *proofLenStepSize : _necessitationLimit ? 1 : 2;
@@ -552,13 +617,14 @@ bool DlProofEnumerator::readRepresentativesLookupVectorFromFiles_par(vector<vect
 	vector<string> threadResults(concurrencyCount);
 	vector<thread> threads;
 	unsigned t = 0;
-	bool abortAll = false;
+	atomic<bool> abortAll = false;
+	mutex mtx_owners;
 
 	// 1. Ensure there will be no reallocations during concurrent access
 	uint32_t fileCounter = 0;
 	for (uint32_t wordLengthLimit = static_cast<uint32_t>(allRepresentativesLookup.size() + c - 1); wordLengthLimit <= limit; wordLengthLimit += c) {
 		const string file = filePrefix + to_string(wordLengthLimit) + filePostfix;
-		if (filesystem::exists(file))
+		if (_proofFileExists(file))
 			fileCounter++;
 		else
 			break;
@@ -571,49 +637,82 @@ bool DlProofEnumerator::readRepresentativesLookupVectorFromFiles_par(vector<vect
 	// 2. Load files
 	for (uint32_t wordLengthLimit = static_cast<uint32_t>(allRepresentativesLookup.size() + c - 1); wordLengthLimit <= limit; wordLengthLimit += c) { // look for files containing D-proofs, starting from built-in limit + c
 		const string file = filePrefix + to_string(wordLengthLimit) + filePostfix;
-		if (filesystem::exists(file)) {
+		if (_proofFileExists(file)) {
 			allRepresentativesLookup.resize(allRepresentativesLookup.size() + c);
 			if (optOut_allConclusionsLookup)
 				optOut_allConclusionsLookup->resize(optOut_allConclusionsLookup->size() + c);
 			auto load = [&](unsigned t, size_t index, const string& file) {
+				chrono::time_point<chrono::steady_clock> startTime;
 				if (debug)
 					startTime = chrono::steady_clock::now();
-				ifstream fin(file, fstream::in | fstream::binary);
-				if (!fin.is_open()) {
+				vector<string_view>& contents = allRepresentativesLookup[index];
+				vector<string_view>* conclusions = optOut_allConclusionsLookup ? &(*optOut_allConclusionsLookup)[index] : nullptr;
+				auto keep = [&](const shared_ptr<const void>& owner, DlProofLookup& lookup) {
+					lock_guard<mutex> lock(mtx_owners);
+					lookup.keep(owner);
+				};
+				string error;
+				if (shared_ptr<const void> mapping = _readProofFileCompanion(file, contents, conclusions, error)) {
+					keep(mapping, allRepresentativesLookup);
+					if (optOut_allConclusionsLookup)
+						keep(mapping, *optOut_allConclusionsLookup);
 					if (debug) {
 						stringstream ss;
-						ss << "Failed to read the data file \"" << file << "\". Aborting.";
+						ss << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to read " << contents.size() << " condensed detachment proof" << (contents.size() == 1 ? "" : "s") << (conclusions ? contents.size() == 1 ? " and conclusion" : " and conclusions" : "")  << " from " << DlProofFile::companionPath(file) << " (memory-mapped). [tid:" << this_thread::get_id() << "]";
 						threadResults[t] = ss.str();
 					}
-					threadAbort[t] = 1;
 					threadComplete[t] = 1;
-					abortAll = true;
 					return;
 				}
-				vector<string>& contents = allRepresentativesLookup[index];
-				vector<string>* conclusions = optOut_allConclusionsLookup ? &(*optOut_allConclusionsLookup)[index] : nullptr;
-				string line;
-				while (getline(fin, line) && !abortAll) {
+				string note = debug && !error.empty() ? "Ignored binary companion " + DlProofFile::companionPath(file) + " due to " + error + ". " : "";
+				vector<vector<string>> chunkContents;
+				vector<vector<string>> chunkConclusions;
+				atomic<bool> missingConclusion = false;
+				uint64_t bytes;
+				if (!_forEachLineInChunks(file, [&](size_t n) {
+					chunkContents.resize(n);
+					if (conclusions)
+						chunkConclusions.resize(n);
+				}, [&](size_t chunk, uint64_t, string& line) {
 					string::size_type i = line.find(':'); // support both variants "<D-proof>:<formula>" and "<D-proof>"
 					if (i == string::npos) {
-						contents.push_back(line);
 						if (conclusions) {
-							if (debug)
-								threadResults[t] = "Missing conclusion in data file " + file + "\". Aborting.";
-							threadAbort[t] = 1;
-							threadComplete[t] = 1;
-							abortAll = true;
-							return;
+							missingConclusion = true;
+							abortAll.store(true, memory_order_relaxed);
+							return false;
 						}
+						chunkContents[chunk].push_back(line);
 					} else {
-						contents.push_back(line.substr(0, i));
+						chunkContents[chunk].push_back(line.substr(0, i));
 						if (conclusions)
-							conclusions->push_back(line.substr(i + 1));
+							chunkConclusions[chunk].push_back(line.substr(i + 1));
+					}
+					return !abortAll.load(memory_order_relaxed);
+				}, nullptr, &bytes)) {
+					if (debug) {
+						stringstream ss;
+						ss << "Failed to read the data file \"" << file << "\". Aborting.";
+						threadResults[t] = ss.str();
 					}
+					threadAbort[t] = 1;
+					threadComplete[t] = 1;
+					abortAll = true;
+					return;
 				}
+				if (missingConclusion) {
+					if (debug)
+						threadResults[t] = "Missing conclusion in data file " + file + "\". Aborting.";
+					threadAbort[t] = 1;
+					threadComplete[t] = 1;
+					return;
+				}
+				keep(DlProofLookup::concatenate(chunkContents, contents), allRepresentativesLookup);
+				if (conclusions)
+					keep(DlProofLookup::concatenate(chunkConclusions, *conclusions), *optOut_allConclusionsLookup);
 				if (debug && !abortAll) {
+					chrono::microseconds dur = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime);
 					stringstream ss;
-					ss << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to read " << contents.size() << " condensed detachment proof" << (contents.size() == 1 ? "" : "s") << (conclusions ? contents.size() == 1 ? " and conclusion" : " and conclusions" : "")  << " from " << file << ". [tid:" << this_thread::get_id() << "]";
+					ss << note << FctHelper::durationStringMs(dur) << " taken to read " << contents.size() << " condensed detachment proof" << (contents.size() == 1 ? "" : "s") << (conclusions ? contents.size() == 1 ? " and conclusion" : " and conclusions" : "")  << " from " << file << " in " << chunkContents.size() << " chunk" << (chunkContents.size() == 1 ? "" : "s") << " (" << throughputString(bytes, dur) << "). [tid:" << this_thread::get_id() << "]";
 					threadResults[t] = ss.str();
 				}
 				threadComplete[t] = 1;
@@ -753,7 +852,7 @@ void DlProofEnumerator::sampleCombinations() {
 		chrono::time_point<chrono::steady_clock> startTime = chrono::steady_clock::now();
 		atomic<size_t> iterationCounter = 0;
 		tbb::concurrent_unordered_set<string> sequences;
-		vector<vector<string>> allRepresentativesLookup = { { }, { "1", "2", "3" } };
+		DlProofLookup allRepresentativesLookup = { { }, { "1", "2", "3" } };
 		tbb::concurrent_vector<string> recent; // NOTE: std::vector does not work since there might be reallocations
 		const uint32_t c = necessitationLimit ? 1 : 2;
 		if (combined) { // combined
@@ -763,7 +862,8 @@ void DlProofEnumerator::sampleCombinations() {
 			}, necessitationLimit);
 			printDRules(wordLengthLimit - c, false, necessitationLimit);
 		} else { // stepwise
-			sequences.insert(allRepresentativesLookup[1].begin(), allRepresentativesLookup[1].end());
+			for (string_view sequence : allRepresentativesLookup[1])
+				sequences.emplace(sequence);
 			for (uint32_t i = 1; i + c <= wordLengthLimit; i += c) {
 				processCondensedDetachmentProofs_dynamic( { i + c }, i + c, i, allRepresentativesLookup, [&](string& sequence) {
 					iterationCounter++;
@@ -772,8 +872,10 @@ void DlProofEnumerator::sampleCombinations() {
 				}, necessitationLimit);
 				if (!necessitationLimit)
 					allRepresentativesLookup.push_back( { });
-				allRepresentativesLookup.push_back(vector<string>(recent.begin(), recent.end()));
-				//#cout << "allRepresentativesLookup = " << FctHelper::vectorStringF(allRepresentativesLookup, [](const vector<string>& v) { return FctHelper::vectorString(v); }) << endl;
+				allRepresentativesLookup.push_back( { });
+				for (const string& sequence : recent)
+					allRepresentativesLookup.back().push_back(allRepresentativesLookup.store(sequence));
+				//#cout << "allRepresentativesLookup = " << FctHelper::vectorStringF(allRepresentativesLookup, [](const vector<string_view>& v) { return FctHelper::vectorString(v); }) << endl;
 				recent.clear();
 				printDRules(i, true, necessitationLimit);
 			}
@@ -1422,7 +1524,7 @@ void DlProofEnumerator::rebaseProofSummary(const string& inputFile, const string
 	}
 }
 
-bool DlProofEnumerator::loadDProofRepresentatives(vector<vector<string>>& allRepresentatives, vector<vector<string>>* optOut_allConclusions, uint64_t* optOut_allRepresentativesCount, map<uint32_t, uint64_t>* optOut_representativeCounts, uint32_t* optOut_firstMissingIndex, bool debug, const string& filePrefix, const string& filePostfix, bool initFresh, uint32_t limit, const uint32_t* proofLenStepSize) {
+bool DlProofEnumerator::loadDProofRepresentatives(DlProofLookup& allRepresentatives, DlProofLookup* optOut_allConclusions, uint64_t* optOut_allRepresentativesCount, map<uint32_t, uint64_t>* optOut_representativeCounts, uint32_t* optOut_firstMissingIndex, bool debug, const string& filePrefix, const string& filePostfix, bool initFresh, uint32_t limit, const uint32_t* proofLenStepSize) {
 	const uint32_t c = proofLenStepSize ? *proofLenStepSize : _necessitationLimit ? 1 : 2;
 	chrono::time_point<chrono::steady_clock> startTime;
 	if (debug)
@@ -1464,17 +1566,17 @@ bool DlProofEnumerator::loadDProofRepresentatives(vector<vector<string>>& allRep
 	return true;
 }
 
-tbb::concurrent_hash_map<string, string> DlProofEnumerator::parseDProofRepresentatives(const vector<string>& representatives, ProgressData* const progressData, atomic<uint64_t>* misses_speedupN, tbb::concurrent_hash_map<string, string>* target_speedupN, tbb::concurrent_unordered_map<string, string>* lookup_speedupN) {
-	tbb::concurrent_hash_map<string, string> _representativeProofs;
-	tbb::concurrent_hash_map<string, string>& representativeProofs = target_speedupN ? *target_speedupN : _representativeProofs;
+DlConclusionStore DlProofEnumerator::parseDProofRepresentatives(const vector<string_view>& representatives, ProgressData* const progressData, atomic<uint64_t>* misses_speedupN, DlConclusionStore* target_speedupN, tbb::concurrent_unordered_map<string, string>* lookup_speedupN) {
+	DlConclusionStore _representativeProofs;
+	DlConclusionStore& representativeProofs = target_speedupN ? *target_speedupN : _representativeProofs;
 	tbb::concurrent_unordered_map<string, string> _lookup_speedupN;
 	if (!lookup_speedupN && _speedupN)
 		lookup_speedupN = &_lookup_speedupN;
 	if (progressData)
 		progressData->setStartTime();
-	tbb::parallel_for(tbb::blocked_range<vector<string>::const_iterator>(representatives.begin(), representatives.end()), [&progressData, &misses_speedupN, &lookup_speedupN, &representativeProofs](tbb::blocked_range<vector<string>::const_iterator>& range) {
-		for (vector<string>::const_iterator it = range.begin(); it != range.end(); ++it) {
-			parseAndInsertDProof_speedupN(nullptr, nullptr, *it, representativeProofs, lookup_speedupN, false, misses_speedupN); // NOTE: Guaranteed to store only if the input files do not contain redundancies with equal conclusions.
+	tbb::parallel_for(tbb::blocked_range<vector<string_view>::const_iterator>(representatives.begin(), representatives.end()), [&progressData, &misses_speedupN, &lookup_speedupN, &representativeProofs](tbb::blocked_range<vector<string_view>::const_iterator>& range) {
+		for (vector<string_view>::const_iterator it = range.begin(); it != range.end(); ++it) {
+			parseAndInsertDProof_speedupN(nullptr, string(*it), representativeProofs, lookup_speedupN, false, misses_speedupN); // NOTE: Guaranteed to store only if the input files do not contain redundancies with equal conclusions.
 
 			// Show progress if requested
 			if (progressData && progressData->nextStep()) {
@@ -1486,9 +1588,9 @@ tbb::concurrent_hash_map<string, string> DlProofEnumerator::parseDProofRepresent
 			}
 		}
 	});
-	return representativeProofs;
+	return target_speedupN ? DlConclusionStore() : move(_representativeProofs); // NOTE: When given, results are stored in (and not copied from) '*target_speedupN'.
 }
-tbb::concurrent_unordered_map<string, string> DlProofEnumerator::parseDProofRepresentatives_um(const vector<string>& representatives, ProgressData* const progressData, atomic<uint64_t>* misses_speedupN, tbb::concurrent_unordered_map<string, string>* target_speedupN, tbb::concurrent_unordered_map<string, tbb::concurrent_unordered_map<string, string>::iterator>* lookup_speedupN) {
+tbb::concurrent_unordered_map<string, string> DlProofEnumerator::parseDProofRepresentatives_um(const vector<string_view>& representatives, ProgressData* const progressData, atomic<uint64_t>* misses_speedupN, tbb::concurrent_unordered_map<string, string>* target_speedupN, tbb::concurrent_unordered_map<string, tbb::concurrent_unordered_map<string, string>::iterator>* lookup_speedupN) {
 	tbb::concurrent_unordered_map<string, string> _representativeProofs;
 	tbb::concurrent_unordered_map<string, string>& representativeProofs = target_speedupN ? *target_speedupN : _representativeProofs;
 	tbb::concurrent_unordered_map<string, tbb::concurrent_unordered_map<string, string>::iterator> _lookup_speedupN;
@@ -1496,9 +1598,9 @@ tbb::concurrent_unordered_map<string, string> DlProofEnumerator::parseDProofRepr
 		lookup_speedupN = &_lookup_speedupN;
 	if (progressData)
 		progressData->setStartTime();
-	tbb::parallel_for(tbb::blocked_range<vector<string>::const_iterator>(representatives.begin(), representatives.end()), [&progressData, &misses_speedupN, &lookup_speedupN, &representativeProofs](tbb::blocked_range<vector<string>::const_iterator>& range) {
-		for (vector<string>::const_iterator it = range.begin(); it != range.end(); ++it) {
-			parseAndInsertDProof_speedupN_um(*it, representativeProofs, lookup_speedupN, false, misses_speedupN); // NOTE: Guaranteed to store only if the input files do not contain redundancies with equal conclusions.
+	tbb::parallel_for(tbb::blocked_range<vector<string_view>::const_iterator>(representatives.begin(), representatives.end()), [&progressData, &misses_speedupN, &lookup_speedupN, &representativeProofs](tbb::blocked_range<vector<string_view>::const_iterator>& range) {
+		for (vector<string_view>::const_iterator it = range.begin(); it != range.end(); ++it) {
+			parseAndInsertDProof_speedupN_um(string(*it), representativeProofs, lookup_speedupN, false, misses_speedupN); // NOTE: Guaranteed to store only if the input files do not contain redundancies with equal conclusions.
 
 			// Show progress if requested
 			if (progressData && progressData->nextStep()) {
@@ -1513,19 +1615,19 @@ tbb::concurrent_unordered_map<string, string> DlProofEnumerator::parseDProofRepr
 	return representativeProofs;
 }
 
-tbb::concurrent_hash_map<string, string> DlProofEnumerator::parseDProofRepresentatives(const vector<vector<string>>& allRepresentatives, ProgressData* const progressData, atomic<uint64_t>* misses_speedupN, tbb::concurrent_unordered_map<string, string>* lookup_speedupN, const uint32_t* proofLenStepSize) {
+DlConclusionStore DlProofEnumerator::parseDProofRepresentatives(const vector<vector<string_view>>& allRepresentatives, ProgressData* const progressData, atomic<uint64_t>* misses_speedupN, tbb::concurrent_unordered_map<string, string>* lookup_speedupN, const uint32_t* proofLenStepSize) {
 	const uint32_t c = proofLenStepSize ? *proofLenStepSize : _necessitationLimit ? 1 : 2;
-	tbb::concurrent_hash_map<string, string> representativeProofs;
+	DlConclusionStore representativeProofs;
 	tbb::concurrent_unordered_map<string, string> _lookup_speedupN;
 	if (!lookup_speedupN && _speedupN)
 		lookup_speedupN = &_lookup_speedupN;
 	if (progressData)
 		progressData->setStartTime();
 	for (uint32_t wordLengthLimit = 1; wordLengthLimit < allRepresentatives.size(); wordLengthLimit += c) { // FASTEST: Parse each string individually and without translation to DlProof objects.
-		const vector<string>& representativesOfWordLengthLimit = allRepresentatives[wordLengthLimit];
-		tbb::parallel_for(tbb::blocked_range<vector<string>::const_iterator>(representativesOfWordLengthLimit.begin(), representativesOfWordLengthLimit.end()), [&progressData, &misses_speedupN, &lookup_speedupN, &representativeProofs](tbb::blocked_range<vector<string>::const_iterator>& range) {
-			for (vector<string>::const_iterator it = range.begin(); it != range.end(); ++it) {
-				parseAndInsertDProof_speedupN(nullptr, nullptr, *it, representativeProofs, lookup_speedupN, false, misses_speedupN); // NOTE: Guaranteed to store only if the input files do not contain redundancies with equal conclusions.
+		const vector<string_view>& representativesOfWordLengthLimit = allRepresentatives[wordLengthLimit];
+		tbb::parallel_for(tbb::blocked_range<vector<string_view>::const_iterator>(representativesOfWordLengthLimit.begin(), representativesOfWordLengthLimit.end()), [&progressData, &misses_speedupN, &lookup_speedupN, &representativeProofs](tbb::blocked_range<vector<string_view>::const_iterator>& range) {
+			for (vector<string_view>::const_iterator it = range.begin(); it != range.end(); ++it) {
+				parseAndInsertDProof_speedupN(nullptr, string(*it), representativeProofs, lookup_speedupN, false, misses_speedupN); // NOTE: Guaranteed to store only if the input files do not contain redundancies with equal conclusions.
 
 				// Show progress if requested
 				if (progressData && progressData->nextStep()) {
@@ -1540,7 +1642,7 @@ tbb::concurrent_hash_map<string, string> DlProofEnumerator::parseDProofRepresent
 	}
 	return representativeProofs;
 }
-tbb::concurrent_unordered_map<string, string> DlProofEnumerator::parseDProofRepresentatives_um(const vector<vector<string>>& allRepresentatives, ProgressData* const progressData, atomic<uint64_t>* misses_speedupN, tbb::concurrent_unordered_map<string, tbb::concurrent_unordered_map<string, string>::iterator>* lookup_speedupN, const uint32_t* proofLenStepSize) {
+tbb::concurrent_unordered_map<string, string> DlProofEnumerator::parseDProofRepresentatives_um(const vector<vector<string_view>>& allRepresentatives, ProgressData* const progressData, atomic<uint64_t>* misses_speedupN, tbb::concurrent_unordered_map<string, tbb::concurrent_unordered_map<string, string>::iterator>* lookup_speedupN, const uint32_t* proofLenStepSize) {
 	const uint32_t c = proofLenStepSize ? *proofLenStepSize : _necessitationLimit ? 1 : 2;
 	tbb::concurrent_unordered_map<string, string> representativeProofs;
 	tbb::concurrent_unordered_map<string, tbb::concurrent_unordered_map<string, string>::iterator> _lookup_speedupN;
@@ -1549,10 +1651,10 @@ tbb::concurrent_unordered_map<string, string> DlProofEnumerator::parseDProofRepr
 	if (progressData)
 		progressData->setStartTime();
 	for (uint32_t wordLengthLimit = 1; wordLengthLimit < allRepresentatives.size(); wordLengthLimit += c) { // FASTEST: Parse each string individually and without translation to DlProof objects.
-		const vector<string>& representativesOfWordLengthLimit = allRepresentatives[wordLengthLimit];
-		tbb::parallel_for(tbb::blocked_range<vector<string>::const_iterator>(representativesOfWordLengthLimit.begin(), representativesOfWordLengthLimit.end()), [&progressData, &misses_speedupN, &lookup_speedupN, &representativeProofs](tbb::blocked_range<vector<string>::const_iterator>& range) {
-			for (vector<string>::const_iterator it = range.begin(); it != range.end(); ++it) {
-				parseAndInsertDProof_speedupN_um(*it, representativeProofs, lookup_speedupN, false, misses_speedupN); // NOTE: Guaranteed to store only if the input files do not contain redundancies with equal conclusions.
+		const vector<string_view>& representativesOfWordLengthLimit = allRepresentatives[wordLengthLimit];
+		tbb::parallel_for(tbb::blocked_range<vector<string_view>::const_iterator>(representativesOfWordLengthLimit.begin(), representativesOfWordLengthLimit.end()), [&progressData, &misses_speedupN, &lookup_speedupN, &representativeProofs](tbb::blocked_range<vector<string_view>::const_iterator>& range) {
+			for (vector<string_view>::const_iterator it = range.begin(); it != range.end(); ++it) {
+				parseAndInsertDProof_speedupN_um(string(*it), representativeProofs, lookup_speedupN, false, misses_speedupN); // NOTE: Guaranteed to store only if the input files do not contain redundancies with equal conclusions.
 
 				// Show progress if requested
 				if (progressData && progressData->nextStep()) {
@@ -1568,16 +1670,16 @@ tbb::concurrent_unordered_map<string, string> DlProofEnumerator::parseDProofRepr
 	return representativeProofs;
 }
 
-tbb::concurrent_hash_map<string, string> DlProofEnumerator::connectDProofConclusions(const vector<vector<string>>& allRepresentatives, const vector<vector<string>>& allConclusions, ProgressData* const progressData, const uint32_t* proofLenStepSize) {
+DlConclusionStore DlProofEnumerator::connectDProofConclusions(const vector<vector<string_view>>& allRepresentatives, const vector<vector<string_view>>& allConclusions, ProgressData* const progressData, const uint32_t* proofLenStepSize) {
 	const uint32_t c = proofLenStepSize ? *proofLenStepSize : _necessitationLimit ? 1 : 2;
-	tbb::concurrent_hash_map<string, string> representativeProofs;
+	DlConclusionStore representativeProofs;
 	if (progressData)
 		progressData->setStartTime();
 	for (uint32_t wordLengthLimit = 1; wordLengthLimit < allRepresentatives.size(); wordLengthLimit += c) {
-		const vector<string>& representativesOfWordLengthLimit = allRepresentatives[wordLengthLimit];
+		const vector<string_view>& representativesOfWordLengthLimit = allRepresentatives[wordLengthLimit];
 		if (representativesOfWordLengthLimit.empty())
 			continue;
-		const vector<string>& conclusionsOfWordLengthLimit = allConclusions[wordLengthLimit];
+		const vector<string_view>& conclusionsOfWordLengthLimit = allConclusions[wordLengthLimit];
 		if (representativesOfWordLengthLimit.size() != conclusionsOfWordLengthLimit.size())
 			throw invalid_argument("allRepresentatives[" + to_string(wordLengthLimit) + "].size() = " + to_string(representativesOfWordLengthLimit.size()) + " != " + to_string(conclusionsOfWordLengthLimit.size()) + " = allConclusions[" + to_string(wordLengthLimit) + "].size()");
 		tbb::parallel_for(size_t(0), representativesOfWordLengthLimit.size(), [&progressData, &representativeProofs, &representativesOfWordLengthLimit, &conclusionsOfWordLengthLimit](size_t i) { // NOTE: Counts from i = start := 0 until i < end := representativesOfWordLengthLimit.size().
@@ -1595,16 +1697,16 @@ tbb::concurrent_hash_map<string, string> DlProofEnumerator::connectDProofConclus
 	}
 	return representativeProofs;
 }
-tbb::concurrent_unordered_map<string, string> DlProofEnumerator::connectDProofConclusions_um(const vector<vector<string>>& allRepresentatives, const vector<vector<string>>& allConclusions, ProgressData* const progressData, const uint32_t* proofLenStepSize) {
+tbb::concurrent_unordered_map<string, string> DlProofEnumerator::connectDProofConclusions_um(const vector<vector<string_view>>& allRepresentatives, const vector<vector<string_view>>& allConclusions, ProgressData* const progressData, const uint32_t* proofLenStepSize) {
 	const uint32_t c = proofLenStepSize ? *proofLenStepSize : _necessitationLimit ? 1 : 2;
 	tbb::concurrent_unordered_map<string, string> representativeProofs;
 	if (progressData)
 		progressData->setStartTime();
 	for (uint32_t wordLengthLimit = 1; wordLengthLimit < allRepresentatives.size(); wordLengthLimit += c) {
-		const vector<string>& representativesOfWordLengthLimit = allRepresentatives[wordLengthLimit];
+		const vector<string_view>& representativesOfWordLengthLimit = allRepresentatives[wordLengthLimit];
 		if (representativesOfWordLengthLimit.empty())
 			continue;
-		const vector<string>& conclusionsOfWordLengthLimit = allConclusions[wordLengthLimit];
+		const vector<string_view>& conclusionsOfWordLengthLimit = allConclusions[wordLengthLimit];
 		if (representativesOfWordLengthLimit.size() != conclusionsOfWordLengthLimit.size())
 			throw invalid_argument("allRepresentatives[" + to_string(wordLengthLimit) + "].size() = " + to_string(representativesOfWordLengthLimit.size()) + " != " + to_string(conclusionsOfWordLengthLimit.size()) + " = allConclusions[" + to_string(wordLengthLimit) + "].size()");
 		tbb::parallel_for(size_t(0), representativesOfWordLengthLimit.size(), [&progressData, &representativeProofs, &representativesOfWordLengthLimit, &conclusionsOfWordLengthLimit](size_t i) { // NOTE: Counts from i = start := 0 until i < end := representativesOfWordLengthLimit.size().
@@ -1626,18 +1728,14 @@ tbb::concurrent_unordered_map<string, string> DlProofEnumerator::connectDProofCo
 // A D-N-proof Nα has conclusion Lβ iff α has conclusion β (according to Łukasiewicz notation). If we know (α,β), there is no need to parse Nα.
 // But this also requires a (proofs -> conclusions) lookup table, so it is more memory intensive. Do it when chosen by the user (i.e. when 'lookup_speedupN' is not null).
 // Note that the caller is still responsible to ensure proofs with leading N's are parsed last. Which is entailed when building up proofs incrementally by their length.
-bool DlProofEnumerator::parseAndInsertDProof_speedupN(tbb::concurrent_hash_map<string, string>::accessor* wAcc, bool* isNew, const string& dProof, tbb::concurrent_hash_map<string, string>& results, tbb::concurrent_unordered_map<string, string>* lookup_speedupN, bool permissive, atomic<uint64_t>* misses_speedupN, size_t maxSymbolicConclusionLength, size_t maxSymbolicConsequentLength) {
+bool DlProofEnumerator::parseAndInsertDProof_speedupN(bool* isNew, const string& dProof, DlConclusionStore& results, tbb::concurrent_unordered_map<string, string>* lookup_speedupN, bool permissive, atomic<uint64_t>* misses_speedupN, size_t maxSymbolicConclusionLength, size_t maxSymbolicConsequentLength, bool replaceWorseProof) {
 	if (lookup_speedupN) { // NOTE: There shall never be N-rules without them being enabled, i.e. this should imply _necessitationLimit > 0.
 		auto countLeadingNs = [](const string& p) { size_t counter = 0; for (string::const_iterator it = p.begin(); it != p.end() && *it == 'N'; ++it) counter++; return counter; };
 		size_t leadingNs = countLeadingNs(dProof);
 		if (leadingNs) {
 			tbb::concurrent_unordered_map<string, string>::iterator searchResult = lookup_speedupN->find(dProof.substr(leadingNs));
 			if (searchResult != lookup_speedupN->end()) {
-				bool written;
-				if (wAcc)
-					written = results.emplace(*wAcc, string(leadingNs, 'L') + searchResult->second, dProof);
-				else
-					written = results.emplace(string(leadingNs, 'L') + searchResult->second, dProof);
+				bool written = results.emplace(string(leadingNs, 'L') + searchResult->second, dProof, replaceWorseProof);
 				if (isNew)
 					*isNew = written;
 				return true;
@@ -1658,16 +1756,12 @@ bool DlProofEnumerator::parseAndInsertDProof_speedupN(tbb::concurrent_hash_map<s
 			} else if (conclusion->size() > maxSymbolicConsequentLength)
 				return false;
 		}
-		tbb::concurrent_hash_map<string, string>::const_accessor rAcc;
-		bool written;
-		if (wAcc)
-			written = results.emplace(*wAcc, DlCore::toPolishNotation_noRename(conclusion), dProof);
-		else
-			written = results.emplace(rAcc, DlCore::toPolishNotation_noRename(conclusion), dProof);
+		string conclusionStr = DlCore::toPolishNotation_noRename(conclusion);
+		bool written = results.emplace(conclusionStr, dProof, replaceWorseProof);
 		if (isNew)
 			*isNew = written;
 		if (lookup_speedupN && !leadingNs) // NOTE: Also memorizing proofs that were not inserted, so their conclusions can be found regardless of potential proof variants.
-			lookup_speedupN->emplace(dProof, wAcc ? (*wAcc)->first : rAcc->first); // to save memory only store iterators of formulas without leading N's
+			lookup_speedupN->emplace(dProof, move(conclusionStr)); // to save memory only store formulas without leading N's
 	} else {
 		if (misses_speedupN && _necessitationLimit && dProof.starts_with('N'))
 			(*misses_speedupN)++; // missed due to no lookup table, despite N-rules being enabled
@@ -1684,11 +1778,7 @@ bool DlProofEnumerator::parseAndInsertDProof_speedupN(tbb::concurrent_hash_map<s
 			} else if (conclusion->size() > maxSymbolicConsequentLength)
 				return false;
 		}
-		bool written;
-		if (wAcc)
-			written = results.emplace(*wAcc, DlCore::toPolishNotation_noRename(conclusion), dProof);
-		else
-			written = results.emplace(DlCore::toPolishNotation_noRename(conclusion), dProof);
+		bool written = results.emplace(DlCore::toPolishNotation_noRename(conclusion), dProof, replaceWorseProof);
 		if (isNew)
 			*isNew = written;
 	}
@@ -1769,7 +1859,7 @@ void DlProofEnumerator::printGenerationExpenditures(bool redundantSchemaRemoval,
 		const size_t maxFileStart = 1 + c * currentRepresentatives().size();
 		vector<uint32_t> limits;
 		for (uint32_t limit = 1; true; limit += c)
-			if (!filesystem::exists(filePrefix + to_string(limit) + filePostfix)) {
+			if (!_proofFileExists(filePrefix + to_string(limit) + filePostfix)) {
 				if (limit >= maxFileStart) {
 					if (!redundantSchemaRemoval && !unfiltered) {
 						unfiltered = limit;
@@ -1790,6 +1880,7 @@ void DlProofEnumerator::printGenerationExpenditures(bool redundantSchemaRemoval,
 
 		tbb::concurrent_map<uint32_t, uint64_t> cardinalities;
 		tbb::concurrent_map<uint32_t, uint64_t> maxed;
+		atomic<uint64_t> totalBytes = 0;
 		tbb::parallel_for(tbb::blocked_range<vector<uint32_t>::const_iterator>(limits.begin(), limits.end()), [&](tbb::blocked_range<vector<uint32_t>::const_iterator>& range) {
 			chrono::time_point<chrono::steady_clock> startTime;
 			for (vector<uint32_t>::const_iterator it = range.begin(); run && it != range.end(); ++it) {
@@ -1800,44 +1891,46 @@ void DlProofEnumerator::printGenerationExpenditures(bool redundantSchemaRemoval,
 				string file = filePrefix + to_string(wordLengthLimit) + currentFilePostfix;
 				if (debug)
 					startTime = chrono::steady_clock::now();
-				ifstream fin(file, fstream::in | fstream::binary);
-				if (!fin.is_open()) {
-					run = false; // stop all threads
-					throw runtime_error("Failed to read the data file \"" + file + "\".");
-				}
 
 				// 1.2 Count lines (and how many of those have the maximum amount of leading 'N's, if relevant).
-				uint64_t lineCounter = 0;
-				uint64_t maxNs = 0;
+				atomic<uint64_t> lineCounter = 0;
+				atomic<uint64_t> maxNs = 0;
 				auto countLeadingNs = [](const string& p) { uint32_t counter = 0; for (string::const_iterator it = p.begin(); it != p.end() && *it == 'N'; ++it) counter++; return counter; };
-				string line;
-				while (run && getline(fin, line)) {
+				size_t chunkCount = 0;
+				uint64_t bytes;
+				if (!_forEachLineInChunks(file, [&](size_t n) { chunkCount = n; }, [&](size_t, uint64_t, string& line) {
 					lineCounter++;
 					if (needMaxNs) {
 						if (countLeadingNs(line) >= _necessitationLimit) // also tolerate manual file edits such that some entries exceed '_necessitationLimit'
 							maxNs++;
 					}
+					return run.load();
+				}, nullptr, &bytes)) {
+					run = false; // stop all threads
+					throw runtime_error("Failed to read the data file \"" + file + "\".");
 				}
 				if (run && debug) {
+					chrono::microseconds dur = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime);
 					stringstream ss;
-					ss << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to load and count " << lineCounter << " line" << (lineCounter == 1 ? "" : "s") << (needMaxNs ? " (" + to_string(maxNs) + " with maximum amount of leading 'N's)" : "") << " from 'dProofs" << wordLengthLimit << currentFilePostfix << "'. [tid:" << this_thread::get_id() << "]";
+					ss << FctHelper::durationStringMs(dur) << " taken to load and count " << lineCounter << " line" << (lineCounter == 1 ? "" : "s") << (needMaxNs ? " (" + to_string(maxNs) + " with maximum amount of leading 'N's)" : "") << " from 'dProofs" << wordLengthLimit << currentFilePostfix << "' in " << chunkCount << " chunk" << (chunkCount == 1 ? "" : "s") << " (" << throughputString(bytes, dur) << "). [tid:" << this_thread::get_id() << "]";
 					lock_guard<mutex> lock(mtx_cout);
 					cout << ss.str() << endl;
 				}
 				cardinalities.emplace(wordLengthLimit, lineCounter);
 				if (needMaxNs)
 					maxed.emplace(wordLengthLimit, maxNs);
+				totalBytes += bytes;
 			}
 		});
 		allRepresentativeCounts.insert(cardinalities.begin(), cardinalities.end());
 		if (needMaxNs)
 			maxNCounts.insert(maxed.begin(), maxed.end());
 		if (debug) {
-			string dur = FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime));
+			chrono::microseconds dur = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime);
 			size_t linesTotal = 0;
 			for (const pair<const uint32_t, uint64_t>& p : cardinalities)
 				linesTotal += p.second;
-			cout << dur << " taken to traverse " << cardinalities.size() << " proof file" << (cardinalities.size() == 1 ? "" : "s") << " and count " << linesTotal << " line" << (linesTotal == 1 ? "" : "s") << "." << endl;
+			cout << FctHelper::durationStringMs(dur) << " taken to traverse " << cardinalities.size() << " proof file" << (cardinalities.size() == 1 ? "" : "s") << " and count " << linesTotal << " line" << (linesTotal == 1 ? "" : "s") << " (" << throughputString(totalBytes, dur) << ")." << endl;
 		}
 
 		// 1.3 Consult built-in collections. ; NOTE: It is assumed that only axioms are built-in when limited consecutive necessitation steps are configured (just like with all customized systems), so 'maxNCounts' can be ignored here.
@@ -1928,8 +2021,8 @@ void DlProofEnumerator::countNextIterationAmount(bool redundantSchemaRemoval, bo
 	cout << myTime() << ": Next iteration amount counter started. " << myInfo() << endl;
 	string filePrefix = "data/" + _customizedPath + (withConclusions ? "dProofs-withConclusions/dProofs" : "dProofs-withoutConclusions/dProofs");
 	string filePostfix = ".txt";
-	vector<vector<string>> allRepresentatives;
-	vector<vector<string>> allConclusions;
+	DlProofLookup allRepresentatives;
+	DlProofLookup allConclusions;
 	uint64_t allRepresentativesCount;
 	uint32_t wordLengthLimit;
 	if (!loadDProofRepresentatives(allRepresentatives, withConclusions ? &allConclusions : nullptr, &allRepresentativesCount, nullptr, &wordLengthLimit, true, filePrefix, filePostfix))
@@ -1954,7 +2047,7 @@ void DlProofEnumerator::countNextIterationAmount(bool redundantSchemaRemoval, bo
 	// 3. Prepare representative proofs that are already known addressable by conclusions, for filtering.
 	atomic<uint64_t> misses_speedupN = 0;
 	startTime = chrono::steady_clock::now();
-	tbb::concurrent_hash_map<string, string> representativeProofs = withConclusions ? connectDProofConclusions(allRepresentatives, allConclusions, showProgress ? &parseProgress : nullptr) : parseDProofRepresentatives(allRepresentatives, showProgress ? &parseProgress : nullptr, &misses_speedupN);
+	DlConclusionStore representativeProofs = withConclusions ? connectDProofConclusions(allRepresentatives, allConclusions, showProgress ? &parseProgress : nullptr) : parseDProofRepresentatives(allRepresentatives, showProgress ? &parseProgress : nullptr, &misses_speedupN);
 	cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " total " << (withConclusions ? "" : "parse, conversion & ") << "insertion duration." << (misses_speedupN ? " Parsed " + to_string(misses_speedupN) + (misses_speedupN == 1 ? " proof" : " proofs") + " - i.e. ≈" + FctHelper::round((long double) misses_speedupN * 100 / allRepresentativesCount, 2) + "% - of the form Nα:Lβ, despite α:β allowing for composition based on previous results." : "") << endl;
 
 	// 4. Iterate and count candidates of length 'wordLengthLimit'.
@@ -2162,7 +2255,7 @@ map<uint32_t, uint64_t>& DlProofEnumerator::removalCounts() {
 	return _;
 }
 
-void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool redundantSchemaRemoval, bool withConclusions, size_t* candidateQueueCapacities, size_t maxSymbolicConclusionLength, size_t maxSymbolicConsequentLength, bool useConclusionStrings, bool useConclusionTrees) { // NOTE: More debug code & performance results available before https://github.com/deontic-logic/proof-tool/commit/45627054d14b6a1e08eb56eaafcf7cf202f2ab96 ; representation of formulas as tree structures before https://github.com/xamidi/pmGenerator/commit/63c7f17b82d56ec639f2b843b688d3e9a0a2a077
+void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool redundantSchemaRemoval, bool withConclusions, size_t* candidateQueueCapacities, size_t maxSymbolicConclusionLength, size_t maxSymbolicConsequentLength, bool useConclusionStrings, bool useConclusionTrees, bool useSchemaIndex, uint32_t checkpointInterval, bool resume, size_t memoryBudget, bool groupedEvaluation, bool onlineSchemaRemoval) { // NOTE: More debug code & performance results available before https://github.com/deontic-logic/proof-tool/commit/45627054d14b6a1e08eb56eaafcf7cf202f2ab96 ; representation of formulas as tree structures before https://github.com/xamidi/pmGenerator/commit/63c7f17b82d56ec639f2b843b688d3e9a0a2a077
 	chrono::time_point<chrono::steady_clock> startTime;
 	if (useConclusionTrees)
 		withConclusions = true; // need conclusions when brief parsing was requested
@@ -2174,19 +2267,39 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 			candidateQueueCapacities = nullptr;
 	} else
 		candidateQueueCapacities = &defaultQC;
+	if (memoryBudget) {
+		if (redundantSchemaRemoval || (!useConclusionStrings && !useConclusionTrees)) {
+			cerr << "Warning: Ignored memory budget, since out-of-core collection requires unfiltered generation from conclusion strings or trees." << endl;
+			memoryBudget = 0;
+		} else if (checkpointInterval || resume) {
+			cerr << "Warning: Ignored checkpoint settings, since checkpoints are unavailable for out-of-core collection." << endl;
+			checkpointInterval = 0;
+			resume = false;
+		}
+	}
+	if (onlineSchemaRemoval) {
+		if (!redundantSchemaRemoval || (!useConclusionStrings && !useConclusionTrees)) {
+			cerr << "Warning: Ignored online schema removal, since it requires filtered generation from conclusion strings or trees." << endl;
+			onlineSchemaRemoval = false;
+		} else if (checkpointInterval || resume) {
+			cerr << "Warning: Ignored checkpoint settings, since checkpoints are unavailable for online schema removal." << endl;
+			checkpointInterval = 0;
+			resume = false;
+		}
+	}
 
 	// 1. Load representative D-proof strings.
 	auto myInfo = [&]() -> string {
 		stringstream ss;
-		ss << "[parallel ; " << thread::hardware_concurrency() << " hardware thread contexts" << (limit == UINT32_MAX ? "" : ", limit: " + to_string(limit)) << (redundantSchemaRemoval ? "" : ", unfiltered") << (candidateQueueCapacities ? ", candidate queue capacities: " + to_string(*candidateQueueCapacities) : "") << (maxSymbolicConclusionLength < SIZE_MAX ? ", conclusion length limit: " + to_string(maxSymbolicConclusionLength) : "") << (maxSymbolicConsequentLength < SIZE_MAX ? ", consequent length limit: " + to_string(maxSymbolicConsequentLength) : "") << (useConclusionTrees ? ", use conclusion trees" : useConclusionStrings ? ", use conclusion strings" : "") << "]";
+		ss << "[parallel ; " << thread::hardware_concurrency() << " hardware thread contexts" << (limit == UINT32_MAX ? "" : ", limit: " + to_string(limit)) << (redundantSchemaRemoval ? "" : ", unfiltered") << (candidateQueueCapacities ? ", candidate queue capacities: " + to_string(*candidateQueueCapacities) : "") << (maxSymbolicConclusionLength < SIZE_MAX ? ", conclusion length limit: " + to_string(maxSymbolicConclusionLength) : "") << (maxSymbolicConsequentLength < SIZE_MAX ? ", consequent length limit: " + to_string(maxSymbolicConsequentLength) : "") << (useConclusionTrees ? groupedEvaluation ? ", use grouped conclusion trees" : ", use conclusion trees" : useConclusionStrings ? ", use conclusion strings" : "") << (checkpointInterval ? ", checkpoint interval: " + to_string(checkpointInterval) + " s" : "") << (resume ? ", resume" : "") << (memoryBudget ? ", memory budget: " + to_string(memoryBudget) + " bytes" : "") << (onlineSchemaRemoval ? ", online schema removal" : "") << "]";
 		return ss.str();
 	};
 	cout << myTime() << ": " << (limit == UINT32_MAX ? "Unl" : "L") << "imited D-proof representative generator started. " << myInfo() << endl;
 	string filePrefix = "data/" + _customizedPath + (withConclusions ? "dProofs-withConclusions/dProofs" : "dProofs-withoutConclusions/dProofs");
 	string filePostfix = ".txt";
-	vector<vector<string>> allRepresentatives;
-	vector<vector<string>> allConclusions;
-	vector<vector<shared_ptr<DlFormula>>> allParsedConclusions; // used when 'useConclusionTrees' is enabled
+	DlProofLookup allRepresentatives;
+	DlProofLookup allConclusions;
+	vector<vector<DlFlatFormula>> allParsedConclusions; // used when 'useConclusionTrees' is enabled
 	vector<vector<atomic<bool>>> allParsedConclusions_init;
 	uint64_t allRepresentativesCount;
 	map<uint32_t, uint64_t> representativeCounts;
@@ -2293,7 +2406,7 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 	// 3. Prepare representative proofs that are already known addressable by conclusions, for filtering.
 	atomic<uint64_t> misses_speedupN = 0;
 	startTime = chrono::steady_clock::now();
-	tbb::concurrent_hash_map<string, string> representativeProofs = withConclusions ? connectDProofConclusions(allRepresentatives, allConclusions, showProgress ? &parseProgress : nullptr) : parseDProofRepresentatives(allRepresentatives, showProgress ? &parseProgress : nullptr, &misses_speedupN);
+	DlConclusionStore representativeProofs = withConclusions ? connectDProofConclusions(allRepresentatives, allConclusions, showProgress ? &parseProgress : nullptr) : parseDProofRepresentatives(allRepresentatives, showProgress ? &parseProgress : nullptr, &misses_speedupN);
 	cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " total " << (withConclusions ? "" : "parse, conversion & ") << "insertion duration." << (misses_speedupN ? " Parsed " + to_string(misses_speedupN) + (misses_speedupN == 1 ? " proof" : " proofs") + " - i.e. ≈" + FctHelper::round((long double) misses_speedupN * 100 / allRepresentativesCount, 2) + "% - of the form Nα:Lβ, despite α:β allowing for composition based on previous results." : "") << endl;
 	// e.g. 15:    165.82 ms                         total parse, conversion & insertion duration.  | [with conclusions]   1.06 ms total insertion duration.
 	//      17:    482.36 ms                         total parse, conversion & insertion duration.  |                      2.07 ms total insertion duration.
@@ -2308,6 +2421,7 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 	// 4. Compute and store new representatives.
 	const uint32_t c = _necessitationLimit ? 1 : 2;
 	tbb::concurrent_unordered_map<string, string> lookup_speedupN;
+	unique_ptr<DlConclusionSpill> spill = memoryBudget ? make_unique<DlConclusionSpill>(representativeProofs, filePrefix + "-spill/", memoryBudget) : nullptr;
 	for (uint32_t wordLengthLimit = start; wordLengthLimit <= limit; wordLengthLimit += c) {
 		if (allRepresentatives.back().empty() && 2 * longestKnownMinimalProofLength + 1 < wordLengthLimit) { // proved non-generativeness when checked up to 2k+1, for the longest proof having length k
 			cout << myTime() << ": " << (limit == UINT32_MAX ? "Unl" : "L") << "imited D-proof representative generator cancelled due to non-generative system. " << myInfo() << endl;
@@ -2369,10 +2483,10 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 		if (showProgress) {
 			uint64_t maxNs = 0; // how many longest known D-N-proofs have the maximum amount of leading 'N's
 			if (_necessitationLimit && _necessitationLimit != UINT32_MAX) { // initialize further information required to determine iteration count
-				auto countLeadingNs = [](const string& p) { uint32_t counter = 0; for (string::const_iterator it = p.begin(); it != p.end() && *it == 'N'; ++it) counter++; return counter; };
-				const vector<string>& representatives = allRepresentatives.back();
+				auto countLeadingNs = [](string_view p) { uint32_t counter = 0; for (string_view::const_iterator it = p.begin(); it != p.end() && *it == 'N'; ++it) counter++; return counter; };
+				const vector<string_view>& representatives = allRepresentatives.back();
 				if (!representatives.empty()) {
-					for (vector<string>::const_reverse_iterator it = representatives.rbegin(); it != representatives.rend(); ++it)
+					for (vector<string_view>::const_reverse_iterator it = representatives.rbegin(); it != representatives.rend(); ++it)
 						if (countLeadingNs(*it) >= _necessitationLimit) // also tolerate manual file edits such that some entries exceed '_necessitationLimit'
 							maxNs++;
 						else
@@ -2385,7 +2499,7 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 			if (redundantSchemaRemoval) {
 				uint64_t removalCount;
 				bool removalCountEstimated = determineCountingLimit(wordLengthLimit, removalCount, _customAxiomsPtr ? removalCounts_custom : removalCounts(), false);
-				filterProgress = ProgressData(wordLengthLimit >= filterProgressSteps2 ? 2 : wordLengthLimit >= filterProgressSteps5 ? 5 : wordLengthLimit >= filterProgressSteps10 ? 10 : 20, removalCount, removalCountEstimated);
+				filterProgress = ProgressData(wordLengthLimit >= filterProgressSteps2 ? 2 : wordLengthLimit >= filterProgressSteps5 ? 5 : wordLengthLimit >= filterProgressSteps10 ? 10 : 20, removalCount, removalCountEstimated || onlineSchemaRemoval); // NOTE: Online schema removal leaves an unknown part of the removals to the filter.
 			}
 		}
 
@@ -2396,12 +2510,40 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 		uint64_t representativeCounter;
 		uint64_t redundantCounter;
 		uint64_t invalidCounter;
+		uint64_t skippedCounter = 0;
+		uint64_t subsumedCounter = 0;
 		misses_speedupN = 0; // NOTE: Lazy N-rule parsing is barely relevant for generation since for dProofs<n+1> there are only |dProofs<n>| candidates starting with 'N' (and they are all valid), which is only a small proportion of all candidates (of which most will fail to parse).
 		const vector<uint32_t> stack = { wordLengthLimit }; // do not generate all words up to a certain length, but only of length 'wordLengthLimit' ; NOTE: Uses nonterminal 'A' as lower limit 'wordLengthLimit' in combination with upper limit 'wordLengthLimit'.
 		const unsigned knownLimit = wordLengthLimit - c;
+		const DlProofEnumeratorMode mode = useConclusionTrees ? groupedEvaluation ? DlProofEnumeratorMode::FromGroupedConclusionTrees : DlProofEnumeratorMode::FromConclusionTrees : useConclusionStrings ? DlProofEnumeratorMode::FromConclusionStrings : DlProofEnumeratorMode::Dynamic;
+		vector<chrono::microseconds> workerIdleTimes;
+		// NOTE: Checkpoints are only valid for equal inputs and settings, which is why these are stored along with (and compared to) the checkpoints.
+		//       Grouped evaluation enumerates the same segments with the same results, so it shares checkpoints with DlProofEnumeratorMode::FromConclusionTrees.
+		string checkpointFile = filePrefix + to_string(wordLengthLimit) + filePostfix.substr(0, filePostfix.length() - 4) + "-checkpoint.bin";
+		vector<uint64_t> checkpointSettings = { wordLengthLimit, static_cast<uint64_t>(mode == DlProofEnumeratorMode::FromGroupedConclusionTrees ? DlProofEnumeratorMode::FromConclusionTrees : mode), _necessitationLimit, redundantSchemaRemoval, withConclusions, maxSymbolicConclusionLength, maxSymbolicConsequentLength, accumulate(allRepresentatives.begin(), allRepresentatives.end(), uint64_t(0), [](uint64_t sum, const vector<string_view>& v) { return sum + v.size(); }) };
+		DlCollectionCheckpoint resumePoint;
+		bool resumed = false;
+		if (resume && filesystem::exists(checkpointFile)) {
+			startTime = chrono::steady_clock::now();
+			string error;
+			if ((resumed = _readCollectionCheckpoint(checkpointFile, checkpointSettings, resumePoint, representativeProofs, error)))
+				cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to load checkpoint from " << checkpointFile << ". Resuming " << (resumePoint.position == UINT64_MAX ? "after complete collection" : "at position " + to_string(resumePoint.position)) << " with " << resumePoint.conclusionCounter << " conclusion" << (resumePoint.conclusionCounter == 1 ? "" : "s") << " from " << resumePoint.counter << " iterated candidate" << (resumePoint.counter == 1 ? "" : "s") << "." << endl;
+			else
+				cerr << "Warning: Ignored checkpoint at " << checkpointFile << " due to " << error << "." << endl;
+		}
+		auto storeCheckpoint = [&](const DlCollectionCheckpoint& checkpoint) {
+			chrono::time_point<chrono::steady_clock> checkpointStartTime = chrono::steady_clock::now();
+			if (_writeCollectionCheckpoint(checkpointFile, checkpointSettings, checkpoint, representativeProofs, wordLengthLimit))
+				cout << myTime() << ": Stored " << (checkpoint.position == UINT64_MAX ? "checkpoint of complete collection" : "checkpoint at position " + to_string(checkpoint.position)) << " with " << checkpoint.conclusionCounter << " conclusion" << (checkpoint.conclusionCounter == 1 ? "" : "s") << " to " << checkpointFile << ". [" << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - checkpointStartTime)) << "]" << endl;
+			else
+				cerr << "Failed to store checkpoint at \"" << checkpointFile << "\"." << endl;
+		};
 		startTime = chrono::steady_clock::now();
-		_collectProvenFormulas(representativeProofs, wordLengthLimit, useConclusionTrees ? DlProofEnumeratorMode::FromConclusionTrees : useConclusionStrings ? DlProofEnumeratorMode::FromConclusionStrings : DlProofEnumeratorMode::Dynamic, showProgress ? &collectProgress : nullptr, _speedupN ? &lookup_speedupN : nullptr, _speedupN ? nullptr : &misses_speedupN, &counter, &representativeCounter, &redundantCounter, &invalidCounter, &stack, &knownLimit, &allRepresentatives, useConclusionStrings || useConclusionTrees ? &allConclusions : nullptr, useConclusionTrees ? &allParsedConclusions : nullptr, useConclusionTrees ? &allParsedConclusions_init : nullptr, candidateQueueCapacities, maxSymbolicConclusionLength, maxSymbolicConsequentLength);
-		cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to collect " << representativeCounter << " D-proof" << (representativeCounter == 1 ? "" : "s") << " of length " << wordLengthLimit << ". [iterated " << counter << " condensed detachment proof strings]" << (misses_speedupN ? " (Parsed " + to_string(misses_speedupN) + (misses_speedupN == 1 ? " proof" : " proofs") + " - i.e. ≈" + FctHelper::round((long double) misses_speedupN * 100 / counter, 2) + "% - of the form Nα:Lβ, despite α:β allowing for composition based on previous results.)" : "") << endl;
+		if (spill)
+			spill->enforceBudget(); // in case the previous iteration's output (or the initial loading) exceeds the budget
+		_collectProvenFormulas(representativeProofs, wordLengthLimit, mode, showProgress ? &collectProgress : nullptr, _speedupN ? &lookup_speedupN : nullptr, _speedupN ? nullptr : &misses_speedupN, &counter, &representativeCounter, &redundantCounter, &invalidCounter, &stack, &knownLimit, &allRepresentatives, useConclusionStrings || useConclusionTrees ? &allConclusions : nullptr, useConclusionTrees ? &allParsedConclusions : nullptr, useConclusionTrees ? &allParsedConclusions_init : nullptr, candidateQueueCapacities, maxSymbolicConclusionLength, maxSymbolicConsequentLength, &workerIdleTimes, resumed ? &resumePoint : nullptr, chrono::seconds(checkpointInterval), storeCheckpoint, spill.get(), nullptr, &skippedCounter, onlineSchemaRemoval, &subsumedCounter);
+		uint64_t iteratedCounter = counter - (resumed ? resumePoint.counter : 0); // candidates of this run, i.e. to which 'skippedCounter' refers
+		cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to collect " << representativeCounter << " D-proof" << (representativeCounter == 1 ? "" : "s") << " of length " << wordLengthLimit << ". [iterated " << counter << " condensed detachment proof strings" << (skippedCounter ? ", of which " + to_string(skippedCounter) + " (≈" + FctHelper::round((long double) skippedCounter * 100 / iteratedCounter, 2) + "%" + (resumed ? " of this run's" : "") + ") were skipped due to incompatible skeletons" : "") << (subsumedCounter ? " ; rejected " + to_string(subsumedCounter) + " candidate" + (subsumedCounter == 1 ? "" : "s") + " with conclusions that have more general variants proven in fewer steps" : "") << "]" << (misses_speedupN ? " (Parsed " + to_string(misses_speedupN) + (misses_speedupN == 1 ? " proof" : " proofs") + " - i.e. ≈" + FctHelper::round((long double) misses_speedupN * 100 / counter, 2) + "% - of the form Nα:Lβ, despite α:β allowing for composition based on previous results.)" : "") << endl;
 		// e.g. 17:    1631.72 ms (        1 s 631.72 ms) taken to collect    6649 [...]
 		//      19:    5586.94 ms (        5 s 586.94 ms) taken to collect   19416 [...] ;    5586.94 /   1631.72 ≈ 3.42396
 		//      21:   20238.31 ms (       20 s 238.31 ms) taken to collect   56321 [...] ;   20238.31 /   5586.94 ≈ 3.62243
@@ -2409,6 +2551,21 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 		//      25:  258267.65 ms ( 4 min 18 s 267.65 ms) taken to collect  490604 [...] ;  258267.65 /  72496.97 ≈ 3.56246
 		//      27:  916905.86 ms (15 min 16 s 905.86 ms) taken to collect 1459555 [...] ;  916905.86 / 258267.65 ≈ 3.55022
 		//      29: 3187900.65 ms (53 min  7 s 900.65 ms) taken to collect 4375266 [...] ; 3187900.65 / 916905.86 ≈ 3.47680
+		if (!workerIdleTimes.empty()) {
+			chrono::microseconds totalIdleTime = accumulate(workerIdleTimes.begin(), workerIdleTimes.end(), chrono::microseconds(0));
+			cout << "Worker idle times: " << FctHelper::round(static_cast<long double>(totalIdleTime.count()) / 1000.0, 2) << " ms in total, ≈" << FctHelper::round(static_cast<long double>(totalIdleTime.count()) * 100 / (static_cast<long double>(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime).count()) * workerIdleTimes.size()), 2) << "% of thread time. [";
+			for (size_t t = 0; t < workerIdleTimes.size(); t++)
+				cout << (t ? ", " : "") << t << ": " << FctHelper::round(static_cast<long double>(workerIdleTimes[t].count()) / 1000.0, 2) << " ms";
+			cout << "]" << endl;
+		}
+		if (representativeProofs.size()) {
+			long double entries = static_cast<long double>(representativeProofs.size());
+			size_t bytes = representativeProofs.memoryUsage();
+			size_t liveBytes = representativeProofs.liveMemoryUsage();
+			cout << "Conclusion store: " << representativeProofs.size() << " entries in " << bytes << " bytes, of which " << liveBytes << " bytes are occupied by entries, i.e. ≈" << FctHelper::round(liveBytes / entries, 2) << " bytes per entry. [estimated ≈" << FctHelper::round(representativeProofs.stringMapMemoryEstimate() / entries, 2) << " bytes per entry via tbb::concurrent_hash_map<string, string>]" << endl;
+		}
+		if (spill && spill->evictedCount())
+			cout << "Spilled conclusions: " << spill->evictedSize() << " entries in " << spill->evictedCount() << " of " << spill->bucketCount() << " buckets at " << spill->path() << "." << endl;
 		if (showProgress && collectProgress.maximum != counter)
 			cerr << "Warning: Determined " << collectProgress.maximum << " candidate" << (collectProgress.maximum == 1 ? "" : "s") << " for iteration, but iterated " << counter << "." << endl;
 
@@ -2428,9 +2585,8 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 		if (redundantSchemaRemoval) {
 			startTime = chrono::steady_clock::now();
 			uint64_t oldRepresentativeCounter = representativeCounter;
-			// TODO: Performance should be improved significantly if possible. Can we define a schema tree database structure to reduce the amount of schema checks?
-			_removeRedundantConclusionsForProofsOfMaxLength(wordLengthLimit, representativeProofs, showProgress ? &filterProgress : nullptr, representativeCounter, redundantCounter);
-			cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to detect " << oldRepresentativeCounter - representativeCounter << " conclusions for which there are more general variants proven in lower or equal amounts of steps." << endl;
+			_removeRedundantConclusionsForProofsOfMaxLength(wordLengthLimit, representativeProofs, showProgress ? &filterProgress : nullptr, representativeCounter, redundantCounter, useSchemaIndex, onlineSchemaRemoval);
+			cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to detect " << oldRepresentativeCounter - representativeCounter << " conclusions for which there are more general variants proven in " << (onlineSchemaRemoval ? "equally many steps" : "lower or equal amounts of steps") << "." << endl;
 			// e.g. 17:     1440.11 ms (                1 s 440.11 ms) taken to detect   1428 conclusions [...]
 			//      19:    13487.20 ms (               13 s 487.20 ms) taken to detect   4141 conclusions [...] ;    13487.20 /     1440.11 ≈ 9.36540
 			//      21:   120905.65 ms (         2 min      905.65 ms) taken to detect  12115 conclusions [...] ;   120905.65 /    13487.20 ≈ 8.96447
@@ -2441,7 +2597,9 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 				cerr << "Warning: Determined " << filterProgress.maximum << " candidate" << (filterProgress.maximum == 1 ? "" : "s") << " for removal, but removed " << oldRepresentativeCounter - representativeCounter << "." << endl;
 
 			// 4.4 Update removal progress information.
-			if (_customAxiomsPtr) {
+			if (subsumedCounter) // NOTE: Online schema removal counts rejected candidates rather than distinct conclusions, so the amount of removed conclusions remains unknown.
+				cout << "Removal counts remain unchanged, since online schema removal rejected conclusions without counting them." << endl;
+			else if (_customAxiomsPtr) {
 				if (removalCounts_custom.emplace(wordLengthLimit, oldRepresentativeCounter - representativeCounter).second) {
 					string& infoLine = customInfoLines[removalCounts_infoLine];
 					infoLine += (infoLine.back() != ';' && infoLine.back() != ',' ? "," : "") + to_string(wordLengthLimit) + ":" + to_string(oldRepresentativeCounter - representativeCounter);
@@ -2463,16 +2621,16 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 			map<string::size_type, size_t> amountPerLength_test2;
 			map<string::size_type, size_t> amountPerLength_test3;
 			if (withConclusions) {
-				for (const pair<const string, string>& p : representativeProofs) {
-					string::size_type len = p.second.length();
+				representativeProofs.forEach([&](string_view conclusion, string_view dProof) {
+					string::size_type len = dProof.length();
 					amountPerLength_test1[len]++;
-				}
+				});
 				for (size_t i = 1; i < allRepresentatives.size(); i += c) {
-					vector<string>& representatives = allRepresentatives[i];
+					vector<string_view>& representatives = allRepresentatives[i];
 					amountPerLength_test2[i] = representatives.size();
 				}
 				for (size_t i = 1; i < allConclusions.size(); i += c) {
-					vector<string>& conclusions = allConclusions[i];
+					vector<string_view>& conclusions = allConclusions[i];
 					amountPerLength_test3[i] = conclusions.size();
 				}
 			}
@@ -2500,30 +2658,30 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 				if (!diffAB.empty())
 					for (map<string::size_type, pair<size_t, size_t>>::const_iterator it = diffAB.begin(); it != diffAB.end(); ++it) {
 						string::size_type proofLen = it->first;
-						vector<string>& representatives = allRepresentatives[proofLen];
-						vector<string>& conclusions = allConclusions[proofLen];
+						vector<string_view>& representatives = allRepresentatives[proofLen];
+						vector<string_view>& conclusions = allConclusions[proofLen];
 						if (representatives.size() != conclusions.size())
 							throw logic_error("representatives.size() != conclusions.size(), for proofLen = " + to_string(proofLen));
 						for (size_t i = 0; i < conclusions.size(); i++) {
-							const string& conclusion = conclusions[i];
-							if (!representativeProofs.count(conclusion))
+							string conclusion(conclusions[i]);
+							if (!representativeProofs.find(conclusion))
 								cout << "Missing from 'representativeProofs': [" << proofLen << "][" << i << "], i.e. " << representatives[i] << ":" << conclusions[i] << endl;
 						}
 						set<string> conclusionsSet(conclusions.begin(), conclusions.end());
 						vector<string> conclusionsOfProofLen;
-						for (tbb::concurrent_hash_map<string, string>::const_iterator itR = representativeProofs.begin(); itR != representativeProofs.end(); ++itR)
-							if (itR->second.length() == proofLen)
-								conclusionsOfProofLen.push_back(itR->first);
+						representativeProofs.forEach([&](string_view conclusion, string_view dProof) {
+							if (dProof.length() == proofLen)
+								conclusionsOfProofLen.push_back(string(conclusion));
+						});
 						cout << "[NOTE] For proof length " << proofLen << ": |representatives| = " << representatives.size() << ", |conclusions| = " << conclusions.size() << ", |conclusionsSet| = " << conclusionsSet.size() << ", |conclusionsOfProofLen| = " << conclusionsOfProofLen.size() << endl;
 						set<string> conclusionsOfProofLenSet(conclusionsOfProofLen.begin(), conclusionsOfProofLen.end());
 						for (size_t i = 0; i < conclusions.size(); i++) {
-							const string& conclusion = conclusions[i];
+							string conclusion(conclusions[i]);
 							if (!conclusionsOfProofLenSet.count(conclusion)) {
 								cout << "Not found in 'representativeProofs': [" << proofLen << "][" << i << "], i.e. " << representatives[i] << ":" << conclusions[i] << endl;
-								if (representativeProofs.count(conclusion)) {
-									tbb::concurrent_hash_map<string, string>::const_accessor rAcc;
-									representativeProofs.find(rAcc, conclusion);
-									cout << "BUT representativeProofs[conclusion] exists: " << rAcc->second << ":" << rAcc->first << endl;
+								string_view dProof;
+								if (representativeProofs.find(conclusion, &dProof)) {
+									cout << "BUT representativeProofs[conclusion] exists: " << dProof << ":" << conclusion << endl;
 									// NOTE: This was used to figure out the reason for loaded input not being used by 'representativeProofs'.
 									//       It turned out that the proof files had been edited manually ("squished") such that afterwards
 									//       the same conclusions existed for different proof lengths, i.e. in different proof files.
@@ -2532,9 +2690,9 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 						}
 						for (const string& conclusion : conclusionsOfProofLen)
 							if (!conclusionsSet.count(conclusion)) {
-								tbb::concurrent_hash_map<string, string>::const_accessor rAcc;
-								representativeProofs.find(rAcc, conclusion);
-								cout << "Missing from 'allRepresentatives' and 'allConclusions' at [" << proofLen << "]: " << rAcc->second << ":" << conclusion << endl;
+								string_view dProof;
+								representativeProofs.find(conclusion, &dProof);
+								cout << "Missing from 'allRepresentatives' and 'allConclusions' at [" << proofLen << "]: " << dProof << ":" << conclusion << endl;
 							}
 					}
 			};
@@ -2559,42 +2717,50 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 		bool last = wordLengthLimit + c > limit;
 		map<string::size_type, size_t> amountPerLength;
 		if (last) {
-			for (size_t i = 1; i < allRepresentatives.size(); i += c)
-				allRepresentatives[i].clear();
+			allRepresentatives.clear(); // NOTE: Also releases the lookup's memory (e.g. unmaps binary proof files).
 			for (size_t i = 1; i < allConclusions.size(); i += c) {
-				vector<string>& conclusions = allConclusions[i];
-				atomic<size_t> amount = 0;
-				tbb::parallel_for(size_t(0), conclusions.size(), [&](size_t j) {
-					if (representativeProofs.erase(conclusions[j]))
-						amount++;
-				});
-				if (amount)
-					amountPerLength[i] = amount; // erased from 'representativeProofs', thus won't be counted hereafter ; NOTE: May vary from conclusions.size() due to redundancies with equal conclusions from (manually edited) input files.
-				conclusions.clear();
+				const vector<string_view>& conclusions = allConclusions[i];
+				if (!spill) { // NOTE: Erasure cannot reach evicted buckets, so out-of-core output counts all entries instead.
+					atomic<size_t> amount = 0;
+					tbb::parallel_for(size_t(0), conclusions.size(), [&](size_t j) {
+						if (representativeProofs.erase(conclusions[j]))
+							amount++;
+					});
+					if (amount)
+						amountPerLength[i] = amount; // erased from 'representativeProofs', thus won't be counted hereafter ; NOTE: May vary from conclusions.size() due to redundancies with equal conclusions from (manually edited) input files.
+				}
 			}
+			allConclusions.clear();
+			if (!spill)
+				representativeProofs.compact(); // release the bytes of erased entries
 		}
 
 		// 4.6 Order and output information.
 		startTime = chrono::steady_clock::now();
 		set<string, cmpStringGrow> newRepresentatives;
 		map<string, string, cmpStringGrow> newContent;
-		if (withConclusions)
-			for (const pair<const string, string>& p : representativeProofs) {
-				string::size_type len = p.second.length();
+		uint64_t newAmount = 0; // used for out-of-core output, where new entries are merged from sorted runs while writing
+		if (spill)
+			newAmount = spill->writeSortedRuns(wordLengthLimit, amountPerLength);
+		else if (withConclusions)
+			representativeProofs.forEach([&](string_view conclusion, string_view dProof) {
+				string::size_type len = dProof.length();
 				if (len == wordLengthLimit)
-					newContent.emplace(p.second, p.first);
+					newContent.emplace(dProof, conclusion);
 				amountPerLength[len]++;
-			}
+			});
 		else
-			for (const pair<const string, string>& p : representativeProofs) {
-				string::size_type len = p.second.length();
+			representativeProofs.forEach([&](string_view, string_view dProof) {
+				string::size_type len = dProof.length();
 				if (len == wordLengthLimit)
-					newRepresentatives.insert(p.second);
+					newRepresentatives.emplace(dProof);
 				amountPerLength[len]++;
-			}
+			});
 		cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to filter and order new representative proofs." << endl;
 		cout << "Found " << representativeCounter << " representative, " << redundantCounter << " redundant, and " << invalidCounter << " invalid condensed detachment proof strings." << endl;
-		cout << "lengths up to " << wordLengthLimit << " ; amounts per length: " << FctHelper::mapString(amountPerLength) << " ; " << (withConclusions ? newContent.size() : newRepresentatives.size()) << " new representative proof" << ((withConclusions ? newContent.size() : newRepresentatives.size()) == 1 ? "" : "s") << " (" << redundantCounter << " redundant, " << invalidCounter << " invalid)" << endl;
+		if (!spill)
+			newAmount = withConclusions ? newContent.size() : newRepresentatives.size();
+		cout << "lengths up to " << wordLengthLimit << " ; amounts per length: " << FctHelper::mapString(amountPerLength) << " ; " << newAmount << " new representative proof" << (newAmount == 1 ? "" : "s") << " (" << redundantCounter << " redundant, " << invalidCounter << " invalid)" << endl;
 		// e.g. 17:    5221 representative,   14809 redundant, and   11358 invalid condensed detachment proof strings
 		//      19:   15275 representative,   44743 redundant, and   34889 invalid condensed detachment proof strings
 		//      21:   44206 representative,  134493 redundant, and  111693 invalid condensed detachment proof strings
@@ -2609,10 +2775,37 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 		{
 			while (!filesystem::exists(file) && !FctHelper::ensureDirExists(file.string()))
 				cerr << "Failed to create file at \"" << file.string() << "\", trying again." << endl;
-			cout << myTime() << ": Starting to write " << (withConclusions ? newContent.size() : newRepresentatives.size()) << " entries to " << file.string() << "." << endl;
+			cout << myTime() << ": Starting to write " << newAmount << " entries to " << file.string() << "." << endl;
 			ofstream fout(file, fstream::out | fstream::binary);
 			bool first = true;
-			if (withConclusions)
+			if (spill) { // NOTE: Out-of-core output also stores the new entries for the next iteration while writing, in order to not keep them in memory twice.
+				bool updateConclusions = !last && (useConclusionStrings || useConclusionTrees);
+				if (!last) {
+					if (!_necessitationLimit)
+						allRepresentatives.push_back( { });
+					allRepresentatives.push_back( { });
+					if (updateConclusions) {
+						if (!_necessitationLimit)
+							allConclusions.push_back( { });
+						allConclusions.push_back( { });
+					}
+				}
+				spill->mergeSortedRuns([&](string_view dProof, string_view conclusion) {
+					if (first) {
+						bytes += dProof.length() + conclusion.length() + 1;
+						fout << dProof << ":" << conclusion;
+						first = false;
+					} else {
+						bytes += dProof.length() + conclusion.length() + 2;
+						fout << "\n" << dProof << ":" << conclusion;
+					}
+					if (!last) {
+						allRepresentatives.back().push_back(allRepresentatives.store(dProof));
+						if (updateConclusions)
+							allConclusions.back().push_back(allConclusions.store(conclusion));
+					}
+				});
+			} else if (withConclusions)
 				for (const pair<const string, string>& p : newContent) {
 					const string& dProof = p.first;
 					const string& conclusion = p.second;
@@ -2637,11 +2830,19 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 					}
 		}
 		cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to print and save " << bytes << " bytes of representative condensed detachment proof strings to " << file.string() << "." << endl;
+		if ((checkpointInterval || resumed) && filesystem::exists(checkpointFile) && !filesystem::remove(checkpointFile))
+			cerr << "Failed to remove checkpoint at \"" << checkpointFile << "\"." << endl;
 
 		// 4.8 Store information from current iteration for next iteration. Note that 'allRepresentatives' must be updated since it is used for D-proof generation,
 		//     but 'allConclusions' must only be updated if 'useConclusionStrings' or 'useConclusionTrees' (which imply 'withConclusions') are enabled.
 		//     NOTE: Do this after storing to disk in order to delay potential out-of-memory issues until after information was secured.
-		if (!last) {
+		if (spill) {
+			if (!last) {
+				if (!allRepresentatives.back().empty())
+					longestKnownMinimalProofLength = wordLengthLimit;
+				representativeCounts.emplace(wordLengthLimit, allRepresentatives.back().size());
+			}
+		} else if (!last) {
 			bool updateConclusions = useConclusionStrings || useConclusionTrees;
 			if (!_necessitationLimit)
 				allRepresentatives.push_back( { });
@@ -2651,16 +2852,17 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 					allConclusions.push_back( { });
 				allConclusions.push_back( { });
 			}
-			vector<string>& representatives = allRepresentatives.back();
-			vector<string>& conclusions = allConclusions.back();
+			vector<string_view>& representatives = allRepresentatives.back();
+			vector<string_view>& conclusions = allConclusions.back();
 			if (withConclusions)
 				for (map<string, string, cmpStringGrow>::const_iterator it = newContent.begin(); it != newContent.end(); ++it) {
-					representatives.push_back(it->first);
+					representatives.push_back(allRepresentatives.store(it->first));
 					if (updateConclusions)
-						conclusions.push_back(it->second);
+						conclusions.push_back(allConclusions.store(it->second));
 				}
 			else
-				representatives.insert(representatives.end(), newRepresentatives.begin(), newRepresentatives.end());
+				for (const string& dProof : newRepresentatives)
+					representatives.push_back(allRepresentatives.store(dProof));
 			if (!representatives.empty())
 				longestKnownMinimalProofLength = wordLengthLimit;
 			representativeCounts.emplace(wordLengthLimit, representatives.size());
@@ -2669,7 +2871,7 @@ void DlProofEnumerator::generateDProofRepresentativeFiles(uint32_t limit, bool r
 	cout << myTime() << ": Limited D-proof representative generator complete. " << myInfo() << endl;
 }
 
-void DlProofEnumerator::mpi_filterDProofRepresentativeFile(uint32_t wordLengthLimit, bool smoothProgress) {
+void DlProofEnumerator::mpi_filterDProofRepresentativeFile(uint32_t wordLengthLimit, bool smoothProgress, bool useSchemaIndex, bool oneSidedBalancing, uint32_t checkpointInterval, bool resume) {
 	chrono::time_point<chrono::steady_clock> startTime;
 
 	// Obtain the process ID and the number of processes
@@ -2680,7 +2882,8 @@ void DlProofEnumerator::mpi_filterDProofRepresentativeFile(uint32_t wordLengthLi
 	if (mpi_size <= 1)
 		cerr << "Single-process call. Utilize multiple processes via \"mpiexec -n <np> ./pmGenerator <args>\" or \"srun -n <np> ./pmGenerator <args>\" (or similar), for np > 1." << endl;
 
-	// 1. Load representative D-proof strings.
+	// 1. Load representative D-proof strings. Only the first process of each node loads proof files, and provides all conclusions to the node's processes via a shared memory segment.
+	//    Only the main process keeps the unfiltered file's D-proofs (for storing the results), since the filter itself only requires conclusions.
 	auto myInfo = [&]() -> string {
 		stringstream ss;
 		ss << "[rank " << mpi_rank << " on \"" << FctHelper::mpi_nodeName() << "\" ; " << mpi_size << " process" << (mpi_size == 1 ? "" : "es") << " ; " << thread::hardware_concurrency() << " local hardware thread contexts]";
@@ -2688,53 +2891,108 @@ void DlProofEnumerator::mpi_filterDProofRepresentativeFile(uint32_t wordLengthLi
 	};
 	cout << myTime() + ": MPI-based D-proof representative filter started. " + myInfo() << endl;
 	bool isMainProc = mpi_rank == 0;
+	MPI_Comm nodeComm;
+	MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, mpi_rank, MPI_INFO_NULL, &nodeComm);
+	int node_size;
+	int node_rank;
+	MPI_Comm_size(nodeComm, &node_size);
+	MPI_Comm_rank(nodeComm, &node_rank);
+	bool isNodeLeader = node_rank == 0; // NOTE: Ranks are ordered by their MPI_COMM_WORLD ranks, so the main process leads its node.
 	string filePrefix = "data/" + _customizedPath + "dProofs-withConclusions/dProofs";
 	string filePostfix = ".txt";
-	vector<vector<string>> allRepresentatives;
-	vector<vector<string>> allConclusions;
-	uint64_t allRepresentativesCount;
-	uint32_t start;
-	if (!loadDProofRepresentatives(allRepresentatives, &allConclusions, &allRepresentativesCount, nullptr, &start, isMainProc, filePrefix, filePostfix)) {
-		cerr << "[Rank " + to_string(mpi_rank) + "] Failed to load D-proof representatives. Aborting." << endl;
-		MPI_Abort(MPI_COMM_WORLD, 1);
-		return;
-	}
-	if (start != wordLengthLimit) {
-		cerr << "[Rank " + to_string(mpi_rank) + "] First unfiltered file to load would be ./" + filePrefix + to_string(start) + "-unfiltered" + to_string(start) + "+.txt, but wordLengthLimit := " + to_string(wordLengthLimit) + ". Aborting." << endl;
-		MPI_Abort(MPI_COMM_WORLD, 1);
-		return;
+	const uint32_t c = _necessitationLimit ? 1 : 2;
+	DlProofLookup allConclusions;
+	vector<string> recentRepresentativeSequence; // only loaded by the main process
+	uint64_t allRepresentativesCount = 0;
+	uint64_t segmentSize = 0;
+	if (isNodeLeader) {
+		DlProofLookup allRepresentatives;
+		uint32_t start;
+		if (!loadDProofRepresentatives(allRepresentatives, &allConclusions, &allRepresentativesCount, nullptr, &start, isMainProc, filePrefix, filePostfix)) {
+			cerr << "[Rank " + to_string(mpi_rank) + "] Failed to load D-proof representatives. Aborting." << endl;
+			MPI_Abort(MPI_COMM_WORLD, 1);
+			return;
+		}
+		if (start != wordLengthLimit) {
+			cerr << "[Rank " + to_string(mpi_rank) + "] First unfiltered file to load would be ./" + filePrefix + to_string(start) + "-unfiltered" + to_string(start) + "+.txt, but wordLengthLimit := " + to_string(wordLengthLimit) + ". Aborting." << endl;
+			MPI_Abort(MPI_COMM_WORLD, 1);
+			return;
+		}
+		if (!loadDProofRepresentatives(allRepresentatives, &allConclusions, &allRepresentativesCount, nullptr, &start, isMainProc, filePrefix, "-unfiltered" + to_string(start) + "+.txt", false, wordLengthLimit)) {
+			cerr << "[Rank " + to_string(mpi_rank) + "] Failed to load D-proof representatives. Aborting." << endl;
+			MPI_Abort(MPI_COMM_WORLD, 1);
+			return;
+		}
+		if (start != wordLengthLimit + c) {
+			cerr << "[Rank " + to_string(mpi_rank) + "] Could not find ./" + filePrefix + to_string(wordLengthLimit) + "-unfiltered" + to_string(wordLengthLimit) + ".txt. Aborting." << endl;
+			MPI_Abort(MPI_COMM_WORLD, 1);
+			return;
+		}
+		if (isMainProc)
+			recentRepresentativeSequence.assign(allRepresentatives[wordLengthLimit].begin(), allRepresentatives[wordLengthLimit].end());
+		allRepresentatives.clear();
+
+		// Segment layout: [amount m of conclusions] [index of the first unfiltered conclusion] [m + 1 offsets of conclusions] [conclusions' characters]
+		uint64_t characters = 0;
+		for (const vector<string_view>& conclusions : allConclusions)
+			for (string_view conclusion : conclusions)
+				characters += conclusion.length();
+		segmentSize = (3 + allRepresentativesCount) * sizeof(uint64_t) + characters;
 	}
-	if (!loadDProofRepresentatives(allRepresentatives, &allConclusions, &allRepresentativesCount, nullptr, &start, isMainProc, filePrefix, "-unfiltered" + to_string(start) + "+.txt", false, wordLengthLimit)) {
-		cerr << "[Rank " + to_string(mpi_rank) + "] Failed to load D-proof representatives. Aborting." << endl;
-		MPI_Abort(MPI_COMM_WORLD, 1);
-		return;
+	MPI_Bcast(&segmentSize, 1, MPI_UNSIGNED_LONG_LONG, 0, nodeComm);
+	MPI_Win segmentWin;
+	char* segment;
+	MPI_Win_allocate_shared(isNodeLeader ? static_cast<MPI_Aint>(segmentSize) : 0, 1, MPI_INFO_NULL, nodeComm, &segment, &segmentWin);
+	if (!isNodeLeader) {
+		MPI_Aint size;
+		int dispUnit;
+		MPI_Win_shared_query(segmentWin, 0, &size, &dispUnit, &segment);
 	}
-	const uint32_t c = _necessitationLimit ? 1 : 2;
-	if (start != wordLengthLimit + c) {
-		cerr << "[Rank " + to_string(mpi_rank) + "] Could not find ./" + filePrefix + to_string(wordLengthLimit) + "-unfiltered" + to_string(wordLengthLimit) + ".txt. Aborting." << endl;
-		MPI_Abort(MPI_COMM_WORLD, 1);
-		return;
+	MPI_Win_fence(0, segmentWin);
+	if (isNodeLeader) {
+		uint64_t* header = reinterpret_cast<uint64_t*>(segment);
+		uint64_t* offsets = header + 2;
+		char* characters = reinterpret_cast<char*>(offsets + allRepresentativesCount + 1);
+		uint64_t index = 0;
+		uint64_t offset = 0;
+		for (uint32_t proofLength = 1; proofLength < allConclusions.size(); proofLength += c) {
+			if (proofLength == wordLengthLimit)
+				header[1] = index;
+			for (string_view conclusion : allConclusions[proofLength]) {
+				offsets[index++] = offset;
+				memcpy(characters + offset, conclusion.data(), conclusion.length());
+				offset += conclusion.length();
+			}
+		}
+		allConclusions.clear(); // free memory early
+		offsets[index] = offset;
+		header[0] = index;
 	}
+	MPI_Win_fence(0, segmentWin);
+	const uint64_t* header = reinterpret_cast<const uint64_t*>(segment);
+	const uint64_t* offsets = header + 2;
+	const char* characters = reinterpret_cast<const char*>(offsets + header[0] + 1);
+	const uint64_t recentBegin = header[1];
+	vector<string_view> conclusions(header[0]);
+	tbb::parallel_for(uint64_t(0), header[0], [&](uint64_t i) { conclusions[i] = string_view(characters + offsets[i], offsets[i + 1] - offsets[i]); });
+	uint64_t conclusionCount = conclusions.size();
 	if (isMainProc) {
 		ManagedArray<uint64_t> recvbuf(mpi_size);
-		MPI_Gather(&allRepresentativesCount, 1, MPI_UNSIGNED_LONG_LONG, recvbuf.data, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+		MPI_Gather(&conclusionCount, 1, MPI_UNSIGNED_LONG_LONG, recvbuf.data, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
 		for (int source = 1; source < mpi_size; source++)
-			if (allRepresentativesCount != recvbuf.data[source]) {
-				cerr << "Uniform loading failed: " + to_string(allRepresentativesCount) + " representatives loaded on rank 0, but " + to_string(recvbuf.data[source]) + " representatives loaded on rank " + to_string(source) + ". Aborting." << endl;
+			if (conclusionCount != recvbuf.data[source]) {
+				cerr << "Uniform loading failed: " + to_string(conclusionCount) + " representatives loaded on rank 0, but " + to_string(recvbuf.data[source]) + " representatives loaded on rank " + to_string(source) + ". Aborting." << endl;
 				MPI_Abort(MPI_COMM_WORLD, 1);
 				return;
 			}
-		cout << myTime() + ": Representative collections were initialized successfully on all ranks." << endl;
+		cout << myTime() + ": Representative collections were initialized successfully on all ranks. [" + to_string(segmentSize) + " bytes of shared memory per node ; " + to_string(node_size) + " process" + (node_size == 1 ? "" : "es") + " on rank 0's node]" << endl;
 	} else
-		MPI_Gather(&allRepresentativesCount, 1, MPI_UNSIGNED_LONG_LONG, nullptr, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+		MPI_Gather(&conclusionCount, 1, MPI_UNSIGNED_LONG_LONG, nullptr, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
 
 	// 2. Initialize and prepare progress data.
 	map<uint32_t, uint64_t> removalCounts_custom;
 	vector<string> customInfoLines;
 	size_t removalCounts_infoLine = 0;
-	size_t showProgress_bound = 17;
-	size_t parseProgressSteps5 = 29;
-	size_t parseProgressSteps10 = 27;
 	size_t filterProgressSteps2 = 23;
 	size_t filterProgressSteps5 = 21;
 	size_t filterProgressSteps10 = 19;
@@ -2747,10 +3005,8 @@ void DlProofEnumerator::mpi_filterDProofRepresentativeFile(uint32_t wordLengthLi
 			return;
 		}
 		// '!.conf' file
-		readConfigFile(true, &showProgress_bound, &parseProgressSteps5, &parseProgressSteps10, nullptr, nullptr, nullptr, &filterProgressSteps2, &filterProgressSteps5, &filterProgressSteps10);
+		readConfigFile(true, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, &filterProgressSteps2, &filterProgressSteps5, &filterProgressSteps10);
 	}
-	bool showProgress = isMainProc && allRepresentatives.size() > showProgress_bound;
-	ProgressData connectProgress = showProgress ? ProgressData(allRepresentatives.size() > parseProgressSteps5 ? 5 : allRepresentatives.size() > parseProgressSteps10 ? 10 : 20, allRepresentativesCount) : ProgressData();
 	ProgressData filterProgress;
 	if (isMainProc) {
 		uint64_t removalCount;
@@ -2758,36 +3014,92 @@ void DlProofEnumerator::mpi_filterDProofRepresentativeFile(uint32_t wordLengthLi
 		filterProgress = ProgressData(wordLengthLimit >= filterProgressSteps2 ? 2 : wordLengthLimit >= filterProgressSteps5 ? 5 : wordLengthLimit >= filterProgressSteps10 ? 10 : 20, removalCount, removalCountEstimated);
 	}
 
-	// 3. Prepare representative proofs that are already known addressable by conclusions, for filtering.
-	if (isMainProc)
-		startTime = chrono::steady_clock::now();
-	tbb::concurrent_hash_map<string, string> representativeProofs = connectDProofConclusions(allRepresentatives, allConclusions, showProgress ? &connectProgress : nullptr);
-	if (isMainProc)
-		cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) + " total insertion duration." << endl;
-
-	// 4. Try to prevent potential out-of-memory issues by clearing data that is no longer needed.
-	for (size_t i = 1; i < wordLengthLimit; i += c) {
-		allRepresentatives[i].clear();
-		allConclusions[i].clear();
+	// 3. Prepare checkpoints. The main process merges all previous checkpoints of equal settings into its own (so that they can be replaced by those of this run), and distributes the completed ranges.
+	//    NOTE: Checkpoints are only valid for equal inputs and settings, which is why these are stored along with (and compared to) the checkpoints.
+	uint64_t n = conclusions.size() - recentBegin;
+	string checkpointDir = filePrefix + to_string(wordLengthLimit) + "-checkpoint-mpi/";
+	vector<uint64_t> checkpointSettings = { wordLengthLimit, n, conclusions.size(), smoothProgress };
+	DlFilterCheckpointing checkpointing { chrono::seconds(checkpointInterval), { }, helper::IndexBitmap(), nullptr };
+	if (checkpointInterval || resume) {
+		uint64_t rangeCount = 0;
+		if (isMainProc) {
+			error_code ec;
+			vector<filesystem::path> files;
+			for (filesystem::directory_iterator it(filesystem::u8path(checkpointDir), ec), end; !ec && it != end; it.increment(ec))
+				if (it->path().filename().string().starts_with("rank") && it->path().extension() == ".bin")
+					files.push_back(it->path());
+			if (resume) {
+				startTime = chrono::steady_clock::now();
+				checkpointing.redundant = helper::IndexBitmap(n);
+				uint64_t loaded = 0;
+				for (const filesystem::path& file : files) {
+					string error;
+					if (_readFilterCheckpoint(file.string(), checkpointSettings, checkpointing.completed, checkpointing.redundant, error))
+						loaded++;
+					else
+						cerr << "Warning: Ignored checkpoint at " << file.string() << " due to " << error << "." << endl;
+				}
+				sort(checkpointing.completed.begin(), checkpointing.completed.end());
+				vector<array<uint64_t, 2>> joined; // NOTE: Ranges of different checkpoints may overlap, e.g. when a process stored its checkpoint before the main process merged it.
+				for (const array<uint64_t, 2>& range : checkpointing.completed)
+					if (!joined.empty() && range[0] <= joined.back()[1])
+						joined.back()[1] = max(joined.back()[1], range[1]);
+					else
+						joined.push_back(range);
+				checkpointing.completed = move(joined);
+				uint64_t completedAmount = 0;
+				for (const array<uint64_t, 2>& range : checkpointing.completed)
+					completedAmount += range[1] - range[0];
+				cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to load " << loaded << " checkpoint" << (loaded == 1 ? "" : "s") << " from " << checkpointDir << ". Resuming with " << completedAmount << " of " << n << " positions complete." << endl;
+				if (loaded && !_writeFilterCheckpoint(checkpointDir + "rank0.bin", checkpointSettings, checkpointing.completed, checkpointing.redundant)) {
+					cerr << "Failed to merge checkpoints into \"" << checkpointDir << "rank0.bin\". Aborting." << endl;
+					MPI_Abort(MPI_COMM_WORLD, 1);
+					return;
+				}
+			}
+			for (const filesystem::path& file : files) // remove previous checkpoints, which are either merged or invalid
+				if (file.filename() != "rank0.bin" || !resume)
+					filesystem::remove(file, ec);
+			rangeCount = checkpointing.completed.size();
+		}
+		MPI_Bcast(&rangeCount, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+		checkpointing.completed.resize(rangeCount);
+		MPI_Bcast(checkpointing.completed.data(), static_cast<int>(2 * rangeCount), MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+		if (checkpointInterval) {
+			string checkpointFile = checkpointDir + "rank" + to_string(mpi_rank) + ".bin";
+			checkpointing.fCheckpoint = [&, checkpointFile](const vector<array<uint64_t, 2>>& completed, const helper::IndexBitmap& redundant) {
+				chrono::time_point<chrono::steady_clock> checkpointStartTime = chrono::steady_clock::now();
+				if (!_writeFilterCheckpoint(checkpointFile, checkpointSettings, completed, redundant))
+					cerr << "[Rank " + to_string(mpi_rank) + "] Failed to store checkpoint at \"" + checkpointFile + "\"." << endl;
+				else if (isMainProc) {
+					uint64_t completedAmount = 0;
+					for (const array<uint64_t, 2>& range : completed)
+						completedAmount += range[1] - range[0];
+					cout << myTime() + ": Stored checkpoint with " + to_string(completedAmount) + " of " + to_string(n) + " positions complete to " + checkpointFile + ". [" + FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - checkpointStartTime)) + "]" << endl;
+				}
+			};
+		}
 	}
 
-	// 5. Remove new proofs with redundant conclusions.
-	const vector<string>& recentRepresentativeSequence = allRepresentatives[wordLengthLimit];
-	const vector<string>& recentConclusionSequence = allConclusions[wordLengthLimit];
+	// 4. Remove new proofs with redundant conclusions.
+	//    NOTE: All conclusions are potential schemas (including those of the unfiltered file), and workloads move between processes, so every process accesses all conclusions.
 	if (isMainProc)
 		startTime = chrono::steady_clock::now();
-	tbb::concurrent_unordered_set<uint64_t> redundant = _mpi_removeRedundantConclusionsForProofsOfMaxLength(mpi_rank, mpi_size, wordLengthLimit, representativeProofs, recentConclusionSequence, isMainProc ? &filterProgress : nullptr, smoothProgress);
+	helper::IndexBitmap redundant = _mpi_removeRedundantConclusionsForProofsOfMaxLength(mpi_rank, mpi_size, conclusions, recentBegin, isMainProc ? &filterProgress : nullptr, smoothProgress, useSchemaIndex, oneSidedBalancing, checkpointInterval || resume ? &checkpointing : nullptr);
+	uint64_t ownRedundantAmount = redundant.count(); // NOTE: The processes' detections are disjoint, since each index is checked by exactly one process.
+	uint64_t redundantAmount = 0;
+	MPI_Reduce(&ownRedundantAmount, &redundantAmount, 1, MPI_UINT64_T, MPI_SUM, 0, MPI_COMM_WORLD);
 	if (isMainProc)
-		cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) + " taken to detect " + to_string(redundant.size()) + " conclusions for which there are more general variants proven in lower or equal amounts of steps." << endl;
+		cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) + " taken to detect " + to_string(redundantAmount) + " conclusions for which there are more general variants proven in lower or equal amounts of steps." << endl;
 
-	// 6. Print removal progress information.
+	// 5. Print removal progress information.
 	if (isMainProc) {
-		cout << "Found " + to_string(recentRepresentativeSequence.size() - redundant.size()) + " representative and " + to_string(redundant.size()) + " redundant condensed detachment proof strings." << endl;
-		cout << "[Copy] Removal count: { " + to_string(wordLengthLimit) + ", " + to_string(redundant.size()) + " }" << endl;
+		cout << "Found " + to_string(conclusions.size() - recentBegin - redundantAmount) + " representative and " + to_string(redundantAmount) + " redundant condensed detachment proof strings." << endl;
+		cout << "[Copy] Removal count: { " + to_string(wordLengthLimit) + ", " + to_string(redundantAmount) + " }" << endl;
 		if (_customAxiomsPtr) {
-			if (removalCounts_custom.emplace(wordLengthLimit, redundant.size()).second) {
+			if (removalCounts_custom.emplace(wordLengthLimit, redundantAmount).second) {
 				string& infoLine = customInfoLines[removalCounts_infoLine];
-				infoLine += (infoLine.back() != ';' && infoLine.back() != ',' ? "," : "") + to_string(wordLengthLimit) + ":" + to_string(redundant.size());
+				infoLine += (infoLine.back() != ';' && infoLine.back() != ',' ? "," : "") + to_string(wordLengthLimit) + ":" + to_string(redundantAmount);
 				string infoFilePath = "data/" + _customizedPath + "!.def";
 				if (!FctHelper::writeToFile(infoFilePath, FctHelper::stringJoin("\n", customInfoLines)))
 					cerr << "Failed to update info file at \"" << infoFilePath << "\"." << endl;
@@ -2796,31 +3108,25 @@ void DlProofEnumerator::mpi_filterDProofRepresentativeFile(uint32_t wordLengthLi
 		}
 	}
 
-	// 7. Store new representatives.
-	tbb::concurrent_map<string, string, cmpStringGrow> newContent;
+	// 6. Gather redundancy bitmaps and store new representatives.
+	//    NOTE: Bitmaps are transferred in encoded pieces of 16 containers (i.e. 2^20 indices each), so that the main process never holds more than one piece per process in transit.
+	//          Synchronous sends ensure that pieces are not buffered in advance. When the new representatives are already ordered (as is the case for generated files), each piece
+	//          is written right after it was merged, otherwise they are ordered after all pieces were merged.
+	constexpr int mpi_tag_bitmap_piece = 5;
+	uint64_t pieceSize = 16 * helper::IndexBitmap::containerBits;
 	if (isMainProc) {
-
-		// 7.1 Order information.
-		startTime = chrono::steady_clock::now();
-		tbb::parallel_for(size_t(0), recentRepresentativeSequence.size(), [&recentRepresentativeSequence, &recentConclusionSequence, &redundant, &newContent](size_t i) { // NOTE: Counts from i = start := 0 until i < end := recentRepresentativeSequence.size().
-			if (!redundant.count(i))
-				newContent.emplace(recentRepresentativeSequence[i], recentConclusionSequence[i]);
-		});
-		cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) + " taken to filter and order new representative proofs." << endl;
-
-		// 7.2 Store information permanently. Not using FctHelper::writeToFile() in order to write huge files without huge string acquisition.
 		startTime = chrono::steady_clock::now();
 		filesystem::path file = filesystem::u8path(filePrefix + to_string(wordLengthLimit) + filePostfix);
 		string::size_type bytes = 0;
 		{
 			while (!filesystem::exists(file) && !FctHelper::ensureDirExists(file.string()))
 				cerr << "Failed to create file at \"" + file.string() + "\", trying again." << endl;
-			cout << myTime() + ": Starting to write " + to_string(newContent.size()) + " entries to " + file.string() + "." << endl;
+			cout << myTime() + ": Starting to write " + to_string(n - redundantAmount) + " entries to " + file.string() + "." << endl;
 			ofstream fout(file, fstream::out | fstream::binary);
 			bool first = true;
-			for (const pair<const string, string>& p : newContent) {
-				const string& dProof = p.first;
-				const string& conclusion = p.second;
+			auto writeEntry = [&](uint64_t i) {
+				const string& dProof = recentRepresentativeSequence[i];
+				string_view conclusion = conclusions[recentBegin + i];
 				if (first) {
 					bytes += dProof.length() + conclusion.length() + 1;
 					fout << dProof << ":" << conclusion;
@@ -2829,83 +3135,422 @@ void DlProofEnumerator::mpi_filterDProofRepresentativeFile(uint32_t wordLengthLi
 					bytes += dProof.length() + conclusion.length() + 2;
 					fout << "\n" << dProof << ":" << conclusion;
 				}
+			};
+			bool ordered = is_sorted(recentRepresentativeSequence.begin(), recentRepresentativeSequence.end(), cmpStringGrow());
+			string buffer;
+			for (uint64_t begin = 0; begin < n; begin += pieceSize) {
+				for (int source = 1; source < mpi_size; source++) {
+					MPI_Status status;
+					MPI_Probe(source, FctHelper::mpi_tag_custom + mpi_tag_bitmap_piece, MPI_COMM_WORLD, &status);
+					int count;
+					MPI_Get_count(&status, MPI_CHAR, &count);
+					buffer.resize(count);
+					MPI_Recv(buffer.data(), count, MPI_CHAR, source, FctHelper::mpi_tag_custom + mpi_tag_bitmap_piece, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+					redundant.merge(begin, pieceSize, buffer);
+				}
+				if (ordered)
+					for (uint64_t i = begin; i < min(begin + pieceSize, n); i++)
+						if (!redundant.test(i))
+							writeEntry(i);
 			}
+			if (!ordered) {
+				vector<uint64_t> indices;
+				indices.reserve(n - redundantAmount);
+				for (uint64_t i = 0; i < n; i++)
+					if (!redundant.test(i))
+						indices.push_back(i);
+				tbb::parallel_sort(indices.begin(), indices.end(), [&](uint64_t a, uint64_t b) { return cmpStringGrow()(recentRepresentativeSequence[a], recentRepresentativeSequence[b]); });
+				for (uint64_t i : indices)
+					writeEntry(i);
+			}
+		}
+		cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) + " taken to gather redundancy bitmaps, and to print and save " + to_string(bytes) + " bytes of representative condensed detachment proof strings to " + file.string() + "." << endl;
+		error_code ec;
+		if ((checkpointInterval || resume) && filesystem::exists(filesystem::u8path(checkpointDir)) && !filesystem::remove_all(filesystem::u8path(checkpointDir), ec))
+			cerr << "Failed to remove checkpoints at \"" << checkpointDir << "\"." << endl;
+	} else {
+		string buffer;
+		for (uint64_t begin = 0; begin < n; begin += pieceSize) {
+			buffer.clear();
+			redundant.encode(begin, pieceSize, buffer);
+			MPI_Ssend(buffer.data(), static_cast<int>(buffer.size()), MPI_CHAR, 0, FctHelper::mpi_tag_custom + mpi_tag_bitmap_piece, MPI_COMM_WORLD);
 		}
-		cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) + " taken to print and save " + to_string(bytes) + " bytes of representative condensed detachment proof strings to " + file.string() + "." << endl;
 	}
+	MPI_Win_free(&segmentWin); // NOTE: Collective, i.e. all processes of the node are done with the segment.
+	MPI_Comm_free(&nodeComm);
 	cout << myTime() + ": MPI-based D-proof representative filter complete. " + myInfo() << endl;
 }
 
-void DlProofEnumerator::createGeneratorFilesWithConclusions(const string& dataLocation, const string& inputFilePrefix, const string& outputFilePrefix, bool memoryOnly, bool debug, const uint32_t* proofLenStepSize) {
-	const uint32_t c = proofLenStepSize ? *proofLenStepSize : _necessitationLimit ? 1 : 2;
+void DlProofEnumerator::mpi_generateDProofRepresentativeFiles(uint32_t limit, bool useConclusionTrees) {
 	chrono::time_point<chrono::steady_clock> startTime;
-	if (debug)
-		startTime = chrono::steady_clock::now();
-	string fullInputFilePrefix = concatenateDataPath(dataLocation, inputFilePrefix);
-	string fullOutputFilePrefix = concatenateDataPath(dataLocation, outputFilePrefix);
 
-	// 1. Load generated D-proofs.
-	string filePostfix = ".txt";
-	vector<vector<string>> allRepresentatives;
+	// Obtain the process ID and the number of processes
+	int mpi_size;
+	int mpi_rank;
+	MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+	MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+	if (mpi_size <= 1)
+		cerr << "Single-process call. Utilize multiple processes via \"mpiexec -n <np> ./pmGenerator <args>\" or \"srun -n <np> ./pmGenerator <args>\" (or similar), for np > 1." << endl;
+
+	// 1. Load representative D-proof strings.
+	auto myInfo = [&]() -> string {
+		stringstream ss;
+		ss << "[rank " << mpi_rank << " on \"" << FctHelper::mpi_nodeName() << "\" ; " << mpi_size << " process" << (mpi_size == 1 ? "" : "es") << " ; " << thread::hardware_concurrency() << " local hardware thread contexts" << (limit == UINT32_MAX ? "" : ", limit: " + to_string(limit)) << (useConclusionTrees ? ", use conclusion trees" : ", use conclusion strings") << "]";
+		return ss.str();
+	};
+	cout << myTime() + ": MPI-based D-proof representative generator started. " + myInfo() << endl;
+	bool isMainProc = mpi_rank == 0;
+	string filePrefix = "data/" + _customizedPath + "dProofs-withConclusions/dProofs";
+	DlProofLookup allRepresentatives;
+	DlProofLookup allConclusions;
+	vector<vector<DlFlatFormula>> allParsedConclusions; // used when 'useConclusionTrees' is enabled
+	vector<vector<atomic<bool>>> allParsedConclusions_init;
 	uint64_t allRepresentativesCount;
-	uint32_t filteredMissing;
-	if (!loadDProofRepresentatives(allRepresentatives, nullptr, &allRepresentativesCount, nullptr, &filteredMissing, debug, fullInputFilePrefix, filePostfix, true, memoryOnly ? 0 : UINT32_MAX)) {
-		cerr << "Failed to load generated D-proof data." << endl;
+	uint32_t start;
+	if (!loadDProofRepresentatives(allRepresentatives, &allConclusions, &allRepresentativesCount, nullptr, &start, isMainProc, filePrefix, ".txt")) {
+		cerr << "[Rank " + to_string(mpi_rank) + "] Failed to load D-proof representatives. Aborting." << endl;
+		MPI_Abort(MPI_COMM_WORLD, 1);
 		return;
 	}
-	if (!memoryOnly) {
-		filePostfix = "-unfiltered" + to_string(filteredMissing) + "+.txt";
-		uint32_t unfilteredMissing;
-		if (!loadDProofRepresentatives(allRepresentatives, nullptr, &allRepresentativesCount, nullptr, &unfilteredMissing, debug, fullInputFilePrefix, filePostfix, false)) {
-			cerr << "Failed to load generated D-proof data." << endl;
-			return;
-		}
+	const uint32_t unfilteredStart = start;
+	const string filePostfix = "-unfiltered" + to_string(unfilteredStart) + "+.txt";
+	if (!loadDProofRepresentatives(allRepresentatives, &allConclusions, &allRepresentativesCount, nullptr, &start, isMainProc, filePrefix, filePostfix, false)) {
+		cerr << "[Rank " + to_string(mpi_rank) + "] Failed to load D-proof representatives. Aborting." << endl;
+		MPI_Abort(MPI_COMM_WORLD, 1);
+		return;
 	}
-	size_t showProgress_bound = 17;
-	size_t parseProgressSteps5 = 29;
-	size_t parseProgressSteps10 = 27;
-	if (_customAxiomsPtr)
-		readConfigFile(true, &showProgress_bound, &parseProgressSteps5, &parseProgressSteps10);
+	if (isMainProc) {
+		ManagedArray<uint64_t> recvbuf(mpi_size);
+		MPI_Gather(&allRepresentativesCount, 1, MPI_UNSIGNED_LONG_LONG, recvbuf.data, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+		for (int source = 1; source < mpi_size; source++)
+			if (allRepresentativesCount != recvbuf.data[source]) {
+				cerr << "Uniform loading failed: " + to_string(allRepresentativesCount) + " representatives loaded on rank 0, but " + to_string(recvbuf.data[source]) + " representatives loaded on rank " + to_string(source) + ". Aborting." << endl;
+				MPI_Abort(MPI_COMM_WORLD, 1);
+				return;
+			}
+		cout << myTime() + ": Representative collections were initialized successfully on all ranks." << endl;
+	} else
+		MPI_Gather(&allRepresentativesCount, 1, MPI_UNSIGNED_LONG_LONG, nullptr, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+	if (start > limit) {
+		if (isMainProc)
+			cout << myTime() + ": MPI-based D-proof representative generator skipped. " + myInfo() << endl;
+		return;
+	}
+	const uint32_t c = _necessitationLimit ? 1 : 2;
+	uint32_t longestKnownMinimalProofLength = 0;
+	for (int64_t i = allRepresentatives.size() - 1; i > 0; i -= c)
+		if (!allRepresentatives[i].empty()) {
+			longestKnownMinimalProofLength = static_cast<uint32_t>(i);
+			break;
+		}
 
-	// 2. Parse generated D-proofs and keep their conclusion representation strings.
-	tbb::concurrent_unordered_map<string, string> lookup_speedupN;
-	vector<tbb::concurrent_hash_map<string, string>> allRepresentativeProofs_speedupN;
-	if (_speedupN) // need to keep the entries alive for lookup_speedupN
-		allRepresentativeProofs_speedupN.resize(allRepresentatives.size()); // NOTE: _speedupN implies _necessitationLimit, thus c = 1.
+	// 2. Insert the conclusions that are owned by this process, i.e. the conclusions of the process's hash-based buckets (see DlConclusionStore::shardIndex()).
+	//    NOTE: Since all processes hold all representatives and conclusions for candidate generation, only the conclusion store is partitioned.
+	if (isMainProc)
+		startTime = chrono::steady_clock::now();
+	DlConclusionStore representativeProofs;
+	auto owner = [&representativeProofs, &mpi_size](string_view conclusion) { return static_cast<int>(representativeProofs.shardIndex(conclusion) % static_cast<size_t>(mpi_size)); };
 	for (uint32_t wordLengthLimit = 1; wordLengthLimit < allRepresentatives.size(); wordLengthLimit += c) {
-		const vector<string>& representativesOfWordLengthLimit = allRepresentatives[wordLengthLimit];
-		bool showProgress = wordLengthLimit >= showProgress_bound;
-		ProgressData parseProgress = showProgress ? ProgressData(wordLengthLimit >= parseProgressSteps5 ? 5 : wordLengthLimit >= parseProgressSteps10 ? 10 : 20, representativesOfWordLengthLimit.size()) : ProgressData();
-		atomic<uint64_t> misses_speedupN = 0;
-		if (debug)
-			startTime = chrono::steady_clock::now();
-		tbb::concurrent_hash_map<string, string>* representativeProofs;
-		tbb::concurrent_hash_map<string, string> _representativeProofs;
-		if (_speedupN) {
-			representativeProofs = &allRepresentativeProofs_speedupN[wordLengthLimit];
-			parseDProofRepresentatives(representativesOfWordLengthLimit, showProgress ? &parseProgress : nullptr, debug ? &misses_speedupN : nullptr, representativeProofs, &lookup_speedupN);
-		} else {
-			_representativeProofs = parseDProofRepresentatives(representativesOfWordLengthLimit, showProgress ? &parseProgress : nullptr, debug ? &misses_speedupN : nullptr);
-			representativeProofs = &_representativeProofs;
-		}
-		map<string, string, cmpStringGrow> result;
-		for (const pair<const string, string>& p : *representativeProofs)
-			result.emplace(p.second, p.first);
-		if (debug) {
-			cout << wordLengthLimit << ": Parsed " << representativeProofs->size() << " generated D-proof" << (representativeProofs->size() == 1 ? "" : "s") << " in " << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << "." << (misses_speedupN ? " Parsed " + to_string(misses_speedupN) + (misses_speedupN == 1 ? " proof" : " proofs") + " - i.e. ≈" + FctHelper::round((long double) misses_speedupN * 100 / representativesOfWordLengthLimit.size(), 2) + "% - of the form Nα:Lβ, despite α:β allowing for composition based on previous results." : "") << endl;
-			//#cout << FctHelper::mapStringF(result, [](const pair<const string, string>& p) { return p.first + ":" + p.second; }, { }, { }, "\n");
+		const vector<string_view>& representatives = allRepresentatives[wordLengthLimit];
+		const vector<string_view>& conclusions = allConclusions[wordLengthLimit];
+		if (representatives.size() != conclusions.size())
+			throw invalid_argument("allRepresentatives[" + to_string(wordLengthLimit) + "].size() = " + to_string(representatives.size()) + " != " + to_string(conclusions.size()) + " = allConclusions[" + to_string(wordLengthLimit) + "].size()");
+		tbb::parallel_for(size_t(0), representatives.size(), [&](size_t i) {
+			if (owner(conclusions[i]) == mpi_rank)
+				representativeProofs.emplace(conclusions[i], representatives[i]);
+		});
+	}
+	if (isMainProc)
+		cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) + " total insertion duration. [rank 0 owns " + to_string(representativeProofs.size()) + " of " + to_string(allRepresentativesCount) + " conclusions]" << endl;
+
+	// 3. Compute and store new representatives.
+	// NOTE: Records of forwarded conclusions consist of the conclusion's and the D-proof's lengths (as native uint32) followed by their bytes.
+	auto appendRecord = [](string& buffer, string_view conclusion, string_view dProof) {
+		uint32_t lengths[2] = { static_cast<uint32_t>(conclusion.length()), static_cast<uint32_t>(dProof.length()) };
+		buffer.append(reinterpret_cast<const char*>(lengths), sizeof(lengths));
+		buffer.append(conclusion);
+		buffer.append(dProof);
+	};
+	const string partDirectory = filePrefix + "-mpi/";
+	for (uint32_t wordLengthLimit = start; wordLengthLimit <= limit; wordLengthLimit += c) {
+		if (allRepresentatives.back().empty() && 2 * longestKnownMinimalProofLength + 1 < wordLengthLimit) { // proved non-generativeness when checked up to 2k+1, for the longest proof having length k
+			if (isMainProc)
+				cout << myTime() + ": MPI-based D-proof representative generator cancelled due to non-generative system. " + myInfo() << endl;
+			return;
 		}
+		if (isMainProc)
+			cout << myTime() + ": Starting to generate D-proof representatives of length " + to_string(wordLengthLimit) + "." << endl;
 
-		// 3. Store generated D-proofs together with their conclusions permanently. Not using FctHelper::writeToFile() in order to write huge files without huge string acquisition.
-		startTime = chrono::steady_clock::now();
-		filesystem::path file = filesystem::u8path(fullOutputFilePrefix + to_string(wordLengthLimit) + (wordLengthLimit < filteredMissing ? ".txt" : filePostfix));
-		string::size_type bytes = 0;
-		{
-			while (!filesystem::exists(file) && !FctHelper::ensureDirExists(file.string()))
-				cerr << "Failed to create file at \"" << file.string() << "\", trying again." << endl;
-			cout << myTime() << ": Starting to write " << result.size() << " entries to " << file.string() << "." << endl;
-			ofstream fout(file, fstream::out | fstream::binary);
-			bool first = true;
+		// 3.1 Collect conclusions of the candidates of this process's segments. Conclusions of other processes are buffered per owner, and exchanged after each round.
+		//     NOTE: Proofs are kept per conclusion by shortest and then lexicographically smallest D-proof, so results are independent of the order of insertions.
+		if (isMainProc)
+			startTime = chrono::steady_clock::now();
+		tbb::enumerable_thread_specific<vector<string>> outgoing([&mpi_size]() { return vector<string>(mpi_size); });
+		uint64_t receivedConclusionCounter = 0;
+		uint64_t receivedRedundantCounter = 0;
+		uint64_t sentRecords = 0;
+		auto forward = [&](string_view conclusion, string_view dProof) -> bool {
+			int dest = owner(conclusion);
+			if (dest == mpi_rank)
+				return false;
+			appendRecord(outgoing.local()[dest], conclusion, dProof);
+			return true;
+		};
+		auto exchange = [&]() {
+			vector<string> sendBuffers(mpi_size);
+			for (vector<string>& buffers : outgoing)
+				for (int dest = 0; dest < mpi_size; dest++) {
+					sendBuffers[dest] += buffers[dest];
+					string().swap(buffers[dest]);
+				}
+			vector<int> sendCounts(mpi_size);
+			vector<int> sendDispls(mpi_size);
+			string sendBuffer;
+			for (int dest = 0; dest < mpi_size; dest++) {
+				if (sendBuffer.size() + sendBuffers[dest].size() > INT_MAX)
+					throw length_error("Exchange buffer of rank " + to_string(mpi_rank) + " exceeds " + to_string(INT_MAX) + " bytes.");
+				sendCounts[dest] = static_cast<int>(sendBuffers[dest].size());
+				sendDispls[dest] = static_cast<int>(sendBuffer.size());
+				sendBuffer += sendBuffers[dest];
+				string().swap(sendBuffers[dest]);
+			}
+			vector<int> recvCounts(mpi_size);
+			vector<int> recvDispls(mpi_size);
+			MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+			uint64_t recvSize = 0;
+			for (int source = 0; source < mpi_size; source++) {
+				recvDispls[source] = static_cast<int>(recvSize);
+				recvSize += recvCounts[source];
+				if (recvSize > INT_MAX)
+					throw length_error("Exchange buffer of rank " + to_string(mpi_rank) + " exceeds " + to_string(INT_MAX) + " bytes.");
+			}
+			string recvBuffer(recvSize, '\0');
+			MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendDispls.data(), MPI_CHAR, recvBuffer.data(), recvCounts.data(), recvDispls.data(), MPI_CHAR, MPI_COMM_WORLD);
+			for (size_t pos = 0; pos < sendBuffer.size(); sentRecords++) {
+				uint32_t lengths[2];
+				memcpy(lengths, sendBuffer.data() + pos, sizeof(lengths));
+				pos += sizeof(lengths) + lengths[0] + lengths[1];
+			}
+			vector<pair<string_view, string_view>> records;
+			for (size_t pos = 0; pos < recvBuffer.size();) {
+				uint32_t lengths[2];
+				memcpy(lengths, recvBuffer.data() + pos, sizeof(lengths));
+				const char* record = recvBuffer.data() + pos + sizeof(lengths);
+				records.emplace_back(string_view(record, lengths[0]), string_view(record + lengths[0], lengths[1]));
+				pos += sizeof(lengths) + lengths[0] + lengths[1];
+			}
+			atomic<uint64_t> conclusionCounter = 0;
+			tbb::parallel_for(size_t(0), records.size(), [&](size_t i) {
+				if (representativeProofs.emplace(records[i].first, records[i].second, true))
+					conclusionCounter++;
+			});
+			receivedConclusionCounter += conclusionCounter;
+			receivedRedundantCounter += records.size() - conclusionCounter;
+		};
+		// NOTE: Each round covers one segment per hardware thread of each process, which bounds the amount of buffered conclusions.
+		const DlCollectionPartition partition { static_cast<uint32_t>(mpi_size), static_cast<uint32_t>(mpi_rank), static_cast<uint64_t>(mpi_size) * max(thread::hardware_concurrency(), 1u), exchange, forward };
+		uint64_t counter;
+		uint64_t representativeCounter;
+		uint64_t redundantCounter;
+		uint64_t invalidCounter;
+		uint64_t skippedCounter;
+		const unsigned knownLimit = wordLengthLimit - c;
+		_collectProvenFormulas(representativeProofs, wordLengthLimit, useConclusionTrees ? DlProofEnumeratorMode::FromConclusionTrees : DlProofEnumeratorMode::FromConclusionStrings, nullptr, nullptr, nullptr, &counter, &representativeCounter, &redundantCounter, &invalidCounter, nullptr, &knownLimit, &allRepresentatives, &allConclusions, useConclusionTrees ? &allParsedConclusions : nullptr, useConclusionTrees ? &allParsedConclusions_init : nullptr, nullptr, SIZE_MAX, SIZE_MAX, nullptr, nullptr, chrono::milliseconds(0), nullptr, nullptr, &partition, &skippedCounter);
+		representativeCounter += receivedConclusionCounter;
+		redundantCounter += receivedRedundantCounter;
+		array<uint64_t, 6> localCounters = { counter, representativeCounter, redundantCounter, invalidCounter, sentRecords, skippedCounter };
+		array<uint64_t, 6> counters;
+		MPI_Reduce(localCounters.data(), counters.data(), 6, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+		ManagedArray<uint64_t> candidateCounts(isMainProc ? mpi_size : 0);
+		MPI_Gather(&counter, 1, MPI_UNSIGNED_LONG_LONG, isMainProc ? candidateCounts.data : nullptr, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+		if (isMainProc) {
+			cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) + " taken to collect " + to_string(counters[1]) + " D-proof" + (counters[1] == 1 ? "" : "s") + " of length " + to_string(wordLengthLimit) + ". [iterated " + to_string(counters[0]) + " condensed detachment proof strings" + (counters[5] ? ", of which " + to_string(counters[5]) + " (≈" + FctHelper::round((long double) counters[5] * 100 / counters[0], 2) + "%) were skipped due to incompatible skeletons" : "") + " ; forwarded " + to_string(counters[4]) + " conclusion" + (counters[4] == 1 ? "" : "s") + " to their owners]" << endl;
+			cout << "Candidates per rank: " + FctHelper::vectorStringF(vector<uint64_t>(candidateCounts.data, candidateCounts.data + mpi_size), [](uint64_t n) { return to_string(n); }, "{ ", " }") << endl;
+		}
+
+		// 3.2 Write this process's new representatives to a sorted part file, and count the entries per proof length.
+		// NOTE: Part files are located at a common directory, i.e. multi-node runs require a shared file system (as for loading).
+		if (isMainProc)
+			startTime = chrono::steady_clock::now();
+		vector<uint64_t> localAmounts(wordLengthLimit + 1);
+		vector<pair<string_view, string_view>> newContent; // NOTE: Views remain valid, since no modifications happen meanwhile.
+		representativeProofs.forEach([&](string_view conclusion, string_view dProof) {
+			size_t len = dProof.length();
+			if (len == wordLengthLimit)
+				newContent.emplace_back(dProof, conclusion);
+			if (len < localAmounts.size())
+				localAmounts[len]++;
+		});
+		tbb::parallel_sort(newContent.begin(), newContent.end()); // NOTE: D-proofs are unique and of equal length, so this is the order of cmpStringGrow.
+		vector<uint64_t> amounts(isMainProc ? localAmounts.size() : 0);
+		MPI_Reduce(localAmounts.data(), isMainProc ? amounts.data() : nullptr, static_cast<int>(localAmounts.size()), MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+		string partFile = partDirectory + "part" + to_string(mpi_rank) + ".txt";
+		{
+			while (!filesystem::exists(partFile) && !FctHelper::ensureDirExists(partFile))
+				cerr << "[Rank " + to_string(mpi_rank) + "] Failed to create file at \"" + partFile + "\", trying again." << endl;
+			ofstream fout(filesystem::u8path(partFile), fstream::out | fstream::binary | fstream::trunc);
+			for (const pair<string_view, string_view>& p : newContent)
+				fout << p.first << ":" << p.second << "\n";
+			if (!fout)
+				throw runtime_error("[Rank " + to_string(mpi_rank) + "] Failed to write \"" + partFile + "\".");
+		}
+		vector<pair<string_view, string_view>>().swap(newContent);
+		MPI_Barrier(MPI_COMM_WORLD); // all part files are complete
+		if (isMainProc) {
+			map<size_t, uint64_t> amountPerLength;
+			for (size_t len = 0; len < amounts.size(); len++)
+				if (amounts[len])
+					amountPerLength[len] = amounts[len];
+			cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) + " taken to filter, order and share new representative proofs." << endl;
+			cout << "Found " + to_string(counters[1]) + " representative, " + to_string(counters[2]) + " redundant, and " + to_string(counters[3]) + " invalid condensed detachment proof strings." << endl;
+			cout << "lengths up to " + to_string(wordLengthLimit) + " ; amounts per length: " + FctHelper::mapString(amountPerLength) + " ; " + to_string(amounts[wordLengthLimit]) + " new representative proof" + (amounts[wordLengthLimit] == 1 ? "" : "s") + " (" + to_string(counters[2]) + " redundant, " + to_string(counters[3]) + " invalid)" << endl;
+		}
+
+		// 3.3 Merge all part files in order of D-proofs. The main process writes the result to the proof file, and all processes keep it for the next iteration.
+		if (isMainProc)
+			startTime = chrono::steady_clock::now();
+		bool last = wordLengthLimit + c > limit;
+		if (!last) {
+			if (!_necessitationLimit) {
+				allRepresentatives.push_back( { });
+				allConclusions.push_back( { });
+			}
+			allRepresentatives.push_back( { });
+			allConclusions.push_back( { });
+		}
+		vector<string_view>& representatives = allRepresentatives.back();
+		vector<string_view>& conclusions = allConclusions.back();
+		filesystem::path file = filesystem::u8path(filePrefix + to_string(wordLengthLimit) + filePostfix);
+		string::size_type bytes = 0;
+		if (isMainProc || !last) {
+			ofstream fout;
+			if (isMainProc) {
+				while (!filesystem::exists(file) && !FctHelper::ensureDirExists(file.string()))
+					cerr << "Failed to create file at \"" + file.string() + "\", trying again." << endl;
+				cout << myTime() + ": Starting to write " + to_string(amounts[wordLengthLimit]) + " entries to " + file.string() + "." << endl;
+				fout.open(file, fstream::out | fstream::binary);
+			}
+			vector<ifstream> parts(mpi_size);
+			vector<string> heads(mpi_size);
+			for (int rank = 0; rank < mpi_size; rank++) {
+				parts[rank].open(filesystem::u8path(partDirectory + "part" + to_string(rank) + ".txt"), fstream::in | fstream::binary);
+				if (!parts[rank].is_open())
+					throw runtime_error("[Rank " + to_string(mpi_rank) + "] Failed to read \"" + partDirectory + "part" + to_string(rank) + ".txt\".");
+			}
+			auto cmp = [&heads](int a, int b) { return heads[a] > heads[b]; }; // min-heap of lines, which are ordered by their D-proofs (since these are unique and of equal length)
+			priority_queue<int, vector<int>, decltype(cmp)> queue(cmp);
+			for (int rank = 0; rank < mpi_size; rank++)
+				if (getline(parts[rank], heads[rank]))
+					queue.push(rank);
+			bool first = true;
+			while (!queue.empty()) {
+				int rank = queue.top();
+				queue.pop();
+				const string& line = heads[rank];
+				if (isMainProc) {
+					if (first) {
+						bytes += line.length();
+						fout << line;
+						first = false;
+					} else {
+						bytes += line.length() + 1;
+						fout << "\n" << line;
+					}
+				}
+				if (!last) {
+					string::size_type sep = line.find(':');
+					representatives.push_back(allRepresentatives.store(string_view(line).substr(0, sep)));
+					conclusions.push_back(allConclusions.store(string_view(line).substr(sep + 1)));
+				}
+				if (getline(parts[rank], heads[rank]))
+					queue.push(rank);
+			}
+		}
+		MPI_Barrier(MPI_COMM_WORLD); // all part files were read
+		error_code ec;
+		filesystem::remove(filesystem::u8path(partFile), ec);
+		if (isMainProc)
+			cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) + " taken to print and save " + to_string(bytes) + " bytes of representative condensed detachment proof strings to " + file.string() + "." << endl;
+		if (!last && !representatives.empty())
+			longestKnownMinimalProofLength = wordLengthLimit;
+	}
+	MPI_Barrier(MPI_COMM_WORLD); // all part files were removed
+	if (isMainProc) {
+		error_code ec;
+		filesystem::remove(filesystem::u8path(partDirectory), ec); // only if empty
+	}
+	cout << myTime() + ": MPI-based D-proof representative generator complete. " + myInfo() << endl;
+}
+
+void DlProofEnumerator::createGeneratorFilesWithConclusions(const string& dataLocation, const string& inputFilePrefix, const string& outputFilePrefix, bool memoryOnly, bool binaryCompanions, bool debug, const uint32_t* proofLenStepSize) {
+	const uint32_t c = proofLenStepSize ? *proofLenStepSize : _necessitationLimit ? 1 : 2;
+	chrono::time_point<chrono::steady_clock> startTime;
+	if (debug)
+		startTime = chrono::steady_clock::now();
+	string fullInputFilePrefix = concatenateDataPath(dataLocation, inputFilePrefix);
+	string fullOutputFilePrefix = concatenateDataPath(dataLocation, outputFilePrefix);
+
+	// 1. Load generated D-proofs.
+	string filePostfix = ".txt";
+	DlProofLookup allRepresentatives;
+	uint64_t allRepresentativesCount;
+	uint32_t filteredMissing;
+	if (!loadDProofRepresentatives(allRepresentatives, nullptr, &allRepresentativesCount, nullptr, &filteredMissing, debug, fullInputFilePrefix, filePostfix, true, memoryOnly ? 0 : UINT32_MAX)) {
+		cerr << "Failed to load generated D-proof data." << endl;
+		return;
+	}
+	if (!memoryOnly) {
+		filePostfix = "-unfiltered" + to_string(filteredMissing) + "+.txt";
+		uint32_t unfilteredMissing;
+		if (!loadDProofRepresentatives(allRepresentatives, nullptr, &allRepresentativesCount, nullptr, &unfilteredMissing, debug, fullInputFilePrefix, filePostfix, false)) {
+			cerr << "Failed to load generated D-proof data." << endl;
+			return;
+		}
+	}
+	size_t showProgress_bound = 17;
+	size_t parseProgressSteps5 = 29;
+	size_t parseProgressSteps10 = 27;
+	if (_customAxiomsPtr)
+		readConfigFile(true, &showProgress_bound, &parseProgressSteps5, &parseProgressSteps10);
+
+	// 2. Parse generated D-proofs and keep their conclusion representation strings.
+	tbb::concurrent_unordered_map<string, string> lookup_speedupN;
+	vector<DlConclusionStore> allRepresentativeProofs_speedupN;
+	if (_speedupN) // need to keep the entries alive for lookup_speedupN
+		allRepresentativeProofs_speedupN.resize(allRepresentatives.size()); // NOTE: _speedupN implies _necessitationLimit, thus c = 1.
+	for (uint32_t wordLengthLimit = 1; wordLengthLimit < allRepresentatives.size(); wordLengthLimit += c) {
+		const vector<string_view>& representativesOfWordLengthLimit = allRepresentatives[wordLengthLimit];
+		bool showProgress = wordLengthLimit >= showProgress_bound;
+		ProgressData parseProgress = showProgress ? ProgressData(wordLengthLimit >= parseProgressSteps5 ? 5 : wordLengthLimit >= parseProgressSteps10 ? 10 : 20, representativesOfWordLengthLimit.size()) : ProgressData();
+		atomic<uint64_t> misses_speedupN = 0;
+		if (debug)
+			startTime = chrono::steady_clock::now();
+		DlConclusionStore* representativeProofs;
+		DlConclusionStore _representativeProofs;
+		if (_speedupN) {
+			representativeProofs = &allRepresentativeProofs_speedupN[wordLengthLimit];
+			parseDProofRepresentatives(representativesOfWordLengthLimit, showProgress ? &parseProgress : nullptr, debug ? &misses_speedupN : nullptr, representativeProofs, &lookup_speedupN);
+		} else {
+			_representativeProofs = parseDProofRepresentatives(representativesOfWordLengthLimit, showProgress ? &parseProgress : nullptr, debug ? &misses_speedupN : nullptr);
+			representativeProofs = &_representativeProofs;
+		}
+		map<string, string, cmpStringGrow> result;
+		representativeProofs->forEach([&](string_view conclusion, string_view dProof) { result.emplace(dProof, conclusion); });
+		if (debug) {
+			cout << wordLengthLimit << ": Parsed " << representativeProofs->size() << " generated D-proof" << (representativeProofs->size() == 1 ? "" : "s") << " in " << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << "." << (misses_speedupN ? " Parsed " + to_string(misses_speedupN) + (misses_speedupN == 1 ? " proof" : " proofs") + " - i.e. ≈" + FctHelper::round((long double) misses_speedupN * 100 / representativesOfWordLengthLimit.size(), 2) + "% - of the form Nα:Lβ, despite α:β allowing for composition based on previous results." : "") << endl;
+			//#cout << FctHelper::mapStringF(result, [](const pair<const string, string>& p) { return p.first + ":" + p.second; }, { }, { }, "\n");
+		}
+
+		// 3. Store generated D-proofs together with their conclusions permanently. Not using FctHelper::writeToFile() in order to write huge files without huge string acquisition.
+		startTime = chrono::steady_clock::now();
+		filesystem::path file = filesystem::u8path(fullOutputFilePrefix + to_string(wordLengthLimit) + (wordLengthLimit < filteredMissing ? ".txt" : filePostfix));
+		string::size_type bytes = 0;
+		{
+			while (!filesystem::exists(file) && !FctHelper::ensureDirExists(file.string()))
+				cerr << "Failed to create file at \"" << file.string() << "\", trying again." << endl;
+			cout << myTime() << ": Starting to write " << result.size() << " entries to " << file.string() << "." << endl;
+			ofstream fout(file, fstream::out | fstream::binary);
+			bool first = true;
 			for (const pair<const string, string>& p : result) {
 				const string& dProof = p.first;
 				const string& conclusion = p.second;
@@ -2920,13 +3565,24 @@ void DlProofEnumerator::createGeneratorFilesWithConclusions(const string& dataLo
 			}
 		}
 		cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to print and save " << bytes << " bytes of representative condensed detachment proof strings to " << file.string() << "." << endl;
+		if (binaryCompanions) {
+			vector<string_view> dProofs;
+			vector<string_view> conclusions;
+			dProofs.reserve(result.size());
+			conclusions.reserve(result.size());
+			for (const pair<const string, string>& p : result) {
+				dProofs.push_back(p.first);
+				conclusions.push_back(p.second);
+			}
+			_writeProofFileCompanion(file.string(), dProofs, &conclusions);
+		}
 
 		//#if (wordLengthLimit <= 15)
 		//#	cout << "const vector<string> Resources::dProofConclusions" << wordLengthLimit << " = " << FctHelper::mapStringF(result, [](const pair<const string, string>& p) { return p.second; }, "{ \"", "\" };", "\", \"") << endl;
 	}
 }
 
-void DlProofEnumerator::createGeneratorFilesWithoutConclusions(const string& dataLocation, const string& inputFilePrefix, const string& outputFilePrefix, bool memoryOnly, bool debug, const uint32_t* proofLenStepSize) {
+void DlProofEnumerator::createGeneratorFilesWithoutConclusions(const string& dataLocation, const string& inputFilePrefix, const string& outputFilePrefix, bool memoryOnly, bool binaryCompanions, bool debug, const uint32_t* proofLenStepSize) {
 	const uint32_t c = proofLenStepSize ? *proofLenStepSize : _necessitationLimit ? 1 : 2;
 	chrono::time_point<chrono::steady_clock> startTime;
 	if (debug)
@@ -2936,7 +3592,7 @@ void DlProofEnumerator::createGeneratorFilesWithoutConclusions(const string& dat
 
 	// 1. Load generated D-proofs.
 	string filePostfix = ".txt";
-	vector<vector<string>> allRepresentatives;
+	DlProofLookup allRepresentatives;
 	uint64_t allRepresentativesCount;
 	uint32_t filteredMissing;
 	if (!loadDProofRepresentatives(allRepresentatives, nullptr, &allRepresentativesCount, nullptr, &filteredMissing, debug, fullInputFilePrefix, filePostfix, true, memoryOnly ? 0 : UINT32_MAX)) {
@@ -2963,7 +3619,7 @@ void DlProofEnumerator::createGeneratorFilesWithoutConclusions(const string& dat
 			cout << myTime() << ": Starting to write " << allRepresentatives[wordLengthLimit].size() << " entries to " << file.string() << "." << endl;
 			ofstream fout(file, fstream::out | fstream::binary);
 			bool first = true;
-			for (const string& s : allRepresentatives[wordLengthLimit])
+			for (string_view s : allRepresentatives[wordLengthLimit])
 				if (first) {
 					bytes += s.length();
 					fout << s;
@@ -2974,10 +3630,12 @@ void DlProofEnumerator::createGeneratorFilesWithoutConclusions(const string& dat
 				}
 		}
 		cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to print and save " << bytes << " bytes of representative condensed detachment proof strings to " << file.string() << "." << endl;
+		if (binaryCompanions)
+			_writeProofFileCompanion(file.string(), allRepresentatives[wordLengthLimit], nullptr);
 	}
 }
 
-map<string, string> DlProofEnumerator::searchProofFiles(const vector<string>& searchTerms, bool normalPolishNotation, bool searchProofs, unsigned schemaSearch, const string* inputFile, bool debug) {
+map<string, string> DlProofEnumerator::searchProofFiles(const vector<string>& searchTerms, bool normalPolishNotation, bool searchProofs, unsigned schemaSearch, const string* inputFile, bool createIndex, bool debug) {
 	chrono::time_point<chrono::steady_clock> startTime;
 	map<string, string> bestResults;
 	vector<string> searchTermsFromFile;
@@ -3058,40 +3716,121 @@ map<string, string> DlProofEnumerator::searchProofFiles(const vector<string>& se
 	}
 	string filePrefix = searchPath + "dProofs";
 	string filePostfix = ".txt";
-	string filePostfix_unf;
-	uint32_t unfiltered = 0;
-	const uint32_t c = _necessitationLimit ? 1 : 2;
-	const size_t maxFileStart = 1 + c * currentRepresentatives().size();
+	uint32_t unfiltered;
+	vector<pair<uint32_t, uint32_t>> indexedFiles = _listProofFilesForSearch(filePrefix, unfiltered); // all files that an index must cover
+	string filePostfix_unf = "-unfiltered" + to_string(unfiltered) + "+" + filePostfix;
 	unordered_set<uint32_t> proofLengths;
 	if (searchProofs)
 		for (const string& s : _searchTerms)
 			proofLengths.emplace(s.length());
 	vector<uint32_t> limits;
-	for (uint32_t limit = 1; true; limit += c)
-		if (!filesystem::exists(filePrefix + to_string(limit) + filePostfix)) {
-			if (limit >= maxFileStart) {
-				if (!unfiltered) {
-					unfiltered = limit;
-					limit -= c;
-					filePostfix = "-unfiltered" + to_string(unfiltered) + "+" + filePostfix;
-				} else
-					break; // remains to generate
+	for (const pair<uint32_t, uint32_t>& p : indexedFiles)
+		if (!searchProofs || proofLengths.count(p.first))
+			limits.push_back(p.first);
+
+	// Exact searches are answered via lookup index, and schema searches via term index, when the index covers exactly the current files (in their current sizes and last write times).
+	auto coversFiles = [&](const auto& index, string& error) {
+		return indexCoversFiles(index, filePrefix, indexedFiles, error);
+	};
+	DlProofIndex index;
+	DlTermIndex termIndex;
+	bool useIndex = false;
+	string error;
+	if (!schemaSearch) {
+		auto openIndex = [&]() {
+			return index.open(DlProofIndex::indexPath(searchPath), _customAxiomsHash, &error) && coversFiles(index, error);
+		};
+		if (!(useIndex = openIndex()) && createIndex) {
+			if (debug)
+				cout << "Creating lookup index at \"" << DlProofIndex::indexPath(searchPath) << "\" due to " << error << "." << endl;
+			if (!_createSearchIndex(searchPath, indexedFiles, debug))
+				throw runtime_error("Failed to create lookup index at \"" + DlProofIndex::indexPath(searchPath) + "\".");
+			useIndex = openIndex();
+		}
+		if (debug)
+			cout << (useIndex ? "Using lookup index at \"" + DlProofIndex::indexPath(searchPath) + "\"." : "Not using lookup index at \"" + DlProofIndex::indexPath(searchPath) + "\" due to " + error + ".") << endl;
+	} else {
+		useIndex = termIndex.open(DlTermIndex::indexPath(searchPath), _customAxiomsHash, &error) && coversFiles(termIndex, error);
+		if (useIndex && schemaSearch == 3) {
+			// NOTE: Instance queries skip a whole subformula for each variable of a search term, so general search terms (e.g. with many leading variables) narrow down few ranges of the index,
+			//       and their candidates may amount to large multiples of the indexed conclusions. A scan instead matches each line against a discrimination tree over the search terms,
+			//       which is cheap for instance searches. For example, 2002 search terms of lengths 17 to 21 (with 64702 indexed conclusions) had 756 candidates per indexed conclusion,
+			//       and took 26.5 s via index but 4.0 s via scan. Therefore, candidates are counted first (which is cheap compared to checking them), and too many of them lead to a scan.
+			constexpr uint64_t maxCandidatesPerEntry = 64;
+			atomic<uint64_t> candidateCounter = 0;
+			tbb::parallel_for(size_t(0), terms.size(), [&](size_t i) {
+				uint64_t n = 0;
+				termIndex.forEachPotentialInstanceOf(terms[i], [&n](size_t) { n++; });
+				candidateCounter += n;
+			});
+			if (candidateCounter > maxCandidatesPerEntry * termIndex.size()) {
+				useIndex = false;
+				error = to_string(candidateCounter) + " candidates for " + to_string(termIndex.size()) + " indexed conclusions (scanning is preferred for more than " + to_string(maxCandidatesPerEntry) + " candidates per indexed conclusion)";
 			}
-		} else if (!searchProofs || proofLengths.count(limit))
-			limits.push_back(limit);
-	filePostfix_unf = filePostfix;
-	filePostfix = ".txt";
+		}
+		if (debug)
+			cout << (useIndex ? "Using term index at \"" + DlTermIndex::indexPath(searchPath) + "\"." : "Not using term index at \"" + DlTermIndex::indexPath(searchPath) + "\" due to " + error + ".") << endl;
+	}
 
 	mutex mtx_cout;
 	mutex mtx_results;
 	atomic<bool> run = true;
 	if (debug)
 		startTime = chrono::steady_clock::now();
+
+	// Schema searches without term index match each line against all search terms at once, via a discrimination tree over the search terms (see DlSchemaIndex), which stores
+	// the index of each search term along with it. Conclusions that cannot be parsed into queries are checked against all search terms individually, i.e. they do not match.
+	auto forEachCandidateTerm = [&](const DlSchemaIndex& termSchemaIndex, const vector<size_t>& termIndices, bool instances, const string& conclusion, const auto& func) {
+		try {
+			if (instances)
+				termSchemaIndex.forEachPotentialInstanceOf(conclusion, [&](string_view, uint32_t i) { func(i); return false; });
+			else
+				termSchemaIndex.forEachPotentialSchemaOf(conclusion, [&](string_view, uint32_t i) { func(i); return false; });
+		} catch (const domain_error&) { // unparsable conclusion
+			for (size_t i : termIndices)
+				func(i);
+		}
+	};
+
+	// Files are searched concurrently, and each file in chunks of lines that are read and searched concurrently (see _forEachLineInChunks()). Since line numbers within a file are only
+	// known once all of its chunks are done, matches and erroneous lines are collected with chunk-relative line indices, and reported in order of their lines after their file is done.
+	struct LineMatch {
+		size_t chunk;
+		uint64_t line;
+		size_t index; // of the search term
+		string content;
+		string substitutions;
+	};
+	struct LineError {
+		size_t chunk = SIZE_MAX;
+		uint64_t line = 0;
+		string content;
+	};
+	auto checkLine = [&](uint32_t wordLengthLimit, size_t chunk, uint64_t line, const string& content, LineError& lineError, mutex& mtx_lineError) {
+		if (content.length() < wordLengthLimit + 2 || content[wordLengthLimit] != ':') {
+			lock_guard<mutex> lock(mtx_lineError);
+			if (chunk < lineError.chunk || (chunk == lineError.chunk && line < lineError.line))
+				lineError = LineError { chunk, line, content };
+			run = false; // stop all threads
+			return false;
+		}
+		return true;
+	};
+	auto throwLineError = [&](const string& file, uint32_t wordLengthLimit, const LineError& lineError, const vector<uint64_t>& lineOffsets) {
+		uint64_t lineNo = lineOffsets[lineError.chunk] + lineError.line + 1;
+		if (lineError.content.length() < wordLengthLimit + 2)
+			throw domain_error("Erroneous proof file at \"" + file + "\": Line " + to_string(lineNo) + " (\"" + lineError.content + "\") too short.");
+		else
+			throw domain_error("Erroneous proof file at \"" + file + "\": Line " + to_string(lineNo) + " (\"" + lineError.content + "\") should contain ':' at index " + to_string(wordLengthLimit) + ".");
+	};
+	auto searchInfo = [&](const chrono::time_point<chrono::steady_clock>& startTime, uint64_t lineCounter, uint32_t wordLengthLimit, const string& currentFilePostfix, size_t chunkCount, uint64_t bytes) {
+		chrono::microseconds dur = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime);
+		stringstream ss;
+		ss << FctHelper::durationStringMs(dur) << " taken to load and search " << lineCounter << " lines from 'dProofs" << wordLengthLimit << currentFilePostfix << "' in " << chunkCount << " chunk" << (chunkCount == 1 ? "" : "s") << " (" << throughputString(bytes, dur) << "). [tid:" << this_thread::get_id() << "]";
+		lock_guard<mutex> lock(mtx_cout);
+		cout << ss.str() << endl;
+	};
 	switch (schemaSearch) { // select multi-threaded strategy based on request
-	// NOTE: In principle, one could parallelize over lines within files rather than over different files (using a tbb::concurrent_bounded_queue and worker threads), and even do
-	//       binary search when looking for proofs, but one would still have to read all lines from disk, which takes most of the time, so it wouldn't give much of an improvement.
-	//       Reading whole files even without searching (after which lines could be handled fully concurrently) tends to take far longer (and runs out of memory for huge files)
-	//       than simply iterating _and_ searching lines.
 	default:
 		throw invalid_argument("Invalid schemaSearch = " + to_string(schemaSearch) + " > 2.");
 
@@ -3099,90 +3838,147 @@ map<string, string> DlProofEnumerator::searchProofFiles(const vector<string>& se
 		atomic<size_t> totalResults = 0;
 		vector<atomic<bool>> found(_searchTerms.size());
 		map<size_t, string> results;
-		tbb::parallel_for(tbb::blocked_range<vector<uint32_t>::const_iterator>(limits.begin(), limits.end()), [&](tbb::blocked_range<vector<uint32_t>::const_iterator>& range) {
-			chrono::time_point<chrono::steady_clock> startTime;
-			for (vector<uint32_t>::const_iterator it = range.begin(); run && it != range.end(); ++it) {
-				uint32_t wordLengthLimit = *it;
+		auto registerResult = [&](size_t i, uint64_t lineNo, const string& line, uint32_t wordLengthLimit, const string& currentFilePostfix) {
+			const string& term = terms[i];
+			stringstream ss;
+			ss << "Found [" << i << "] : \"" << term << "\"" << (modified[i] ? " (originally \"" + _searchTerms[i] + "\")" : "") << "\n\tin line " << lineNo << " - " + line + "\n\tof 'dProofs" << wordLengthLimit << currentFilePostfix << "'.";
+			string searchTerm = modified[i] ? _searchTerms[i] : term;
+			string searchResult = searchProofs ? line.substr(wordLengthLimit + 1) : line.substr(0, wordLengthLimit);
+			if (debug) {
+				lock_guard<mutex> lock(mtx_cout);
+				cout << ss.str() << endl;
+			}
+			lock_guard<mutex> lock(mtx_results);
+			results[i] = ss.str();
+			bestResults.emplace(searchTerm, searchResult);
+		};
+		if (useIndex) {
+			// 1. Look up candidate locations, which are sorted by line for each file.
+			vector<vector<pair<uint64_t, size_t>>> fileCandidates(index.fileCount()); // pairs of line and index of the search term
+			size_t candidateCounter = 0;
+			for (size_t i = 0; i < _searchTerms.size(); i++) {
+				pair<const DlProofIndex::Entry*, const DlProofIndex::Entry*> range = searchProofs ? index.findDProof(DlProofIndex::fingerprint(terms[i])) : index.findConclusion(DlProofIndex::fingerprint(terms[i]));
+				for (const DlProofIndex::Entry* it = range.first; it != range.second; ++it) {
+					fileCandidates[DlProofIndex::fileIndexOf(it->location)].emplace_back(DlProofIndex::lineOf(it->location), i);
+					candidateCounter++;
+				}
+			}
 
-				// 1. Check which indices are still to search for 'wordLengthLimit'.
-				vector<size_t> relevantIndices;
-				bool anything = false;
-				for (size_t i = 0; i < _searchTerms.size(); i++)
-					if (searchProofs) {
-						if (terms[i].length() == wordLengthLimit) { // fresh at proofs of length 'wordLengthLimit' => no proofs of that length could already be found
-							anything = true;
-							relevantIndices.push_back(i);
+			// 2. Read and compare the candidates' lines, seeking via the index's line offsets.
+			vector<vector<LineMatch>> fileMatches(index.fileCount());
+			tbb::parallel_for(size_t(0), index.fileCount(), [&](size_t k) {
+				vector<pair<uint64_t, size_t>>& candidates = fileCandidates[k];
+				if (candidates.empty())
+					return;
+				sort(candidates.begin(), candidates.end());
+				const DlProofIndex::FileRecord& record = index.fileRecord(k);
+				uint32_t wordLengthLimit = record.wordLengthLimit;
+				string file = filePrefix + to_string(wordLengthLimit) + (record.unfiltered ? filePostfix_unf : filePostfix);
+				unique_ptr<istream> stream = _openProofFile(file);
+				if (!stream)
+					throw runtime_error("Failed to read the data file \"" + file + "\".");
+				istream& fin = *stream;
+				string line;
+				uint64_t next = 0; // index of the line that is read next
+				for (const pair<uint64_t, size_t>& candidate : candidates) {
+					uint64_t lineIndex = candidate.first;
+					if (!next || next - 1 != lineIndex) { // not the most recently read line
+						pair<uint64_t, uint64_t> seek = index.seekPosition(k, lineIndex);
+						if (next > lineIndex || seek.second > next) {
+							fin.clear();
+							fin.seekg(static_cast<streamoff>(seek.first));
+							next = seek.second;
 						}
-					} else if (!found[i]) {
-						anything = true;
-						relevantIndices.push_back(i);
+						while (next <= lineIndex && getline(fin, line))
+							next++;
+						if (next <= lineIndex)
+							throw runtime_error("Failed to read line " + to_string(lineIndex + 1) + " of the data file \"" + file + "\".");
 					}
-				if (!anything)
-					break;
-
-				// 2. Read current file.
-				const string& currentFilePostfix = wordLengthLimit < unfiltered ? filePostfix : filePostfix_unf;
-				string file = filePrefix + to_string(wordLengthLimit) + currentFilePostfix;
-				if (debug)
-					startTime = chrono::steady_clock::now();
-				ifstream fin(file, fstream::in | fstream::binary);
-				if (!fin.is_open()) {
-					run = false; // stop all threads
-					throw runtime_error("Failed to read the data file \"" + file + "\".");
+					const string& term = terms[candidate.second];
+					if (line.length() >= wordLengthLimit + 2 && line[wordLengthLimit] == ':' && (searchProofs ? string_view(line).substr(0, wordLengthLimit) == term : string_view(line).substr(wordLengthLimit + 1) == term))
+						fileMatches[k].push_back(LineMatch { k, lineIndex, candidate.second, line, { } });
 				}
+			});
 
-				// 3. Search current file.
-				string line;
-				size_t lineNo = 1;
-				while (run && getline(fin, line)) {
-					if (line.length() < wordLengthLimit + 2) {
-						run = false; // stop all threads
-						throw domain_error("Erroneous proof file at \"" + file + "\": Line " + to_string(lineNo) + " (\"" + line + "\") too short.");
-					} else if (line[wordLengthLimit] != ':') {
-						run = false; // stop all threads
-						throw domain_error("Erroneous proof file at \"" + file + "\": Line " + to_string(lineNo) + " (\"" + line + "\") should contain ':' at index " + to_string(wordLengthLimit) + ".");
+			// 3. Register results in order of files and lines, i.e. the first match of each search term.
+			for (size_t k = 0; k < fileMatches.size(); k++)
+				for (const LineMatch& match : fileMatches[k])
+					if (!found[match.index].exchange(true)) {
+						totalResults++;
+						const DlProofIndex::FileRecord& record = index.fileRecord(k);
+						registerResult(match.index, match.line + 1, match.content, record.wordLengthLimit, record.unfiltered ? filePostfix_unf : filePostfix);
 					}
+			if (debug)
+				cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to look up " << _searchTerms.size() << " search term" << (_searchTerms.size() == 1 ? "" : "s") << " via lookup index and to compare " << candidateCounter << " candidate line" << (candidateCounter == 1 ? "" : "s") << "." << endl;
+		} else {
+			tbb::parallel_for(tbb::blocked_range<vector<uint32_t>::const_iterator>(limits.begin(), limits.end()), [&](tbb::blocked_range<vector<uint32_t>::const_iterator>& range) {
+				chrono::time_point<chrono::steady_clock> startTime;
+				for (vector<uint32_t>::const_iterator it = range.begin(); run && it != range.end(); ++it) {
+					uint32_t wordLengthLimit = *it;
+
+					// 1. Check which indices are still to search for 'wordLengthLimit'.
+					vector<size_t> relevantIndices;
+					bool anything = false;
+					for (size_t i = 0; i < _searchTerms.size(); i++)
+						if (searchProofs) {
+							if (terms[i].length() == wordLengthLimit) { // fresh at proofs of length 'wordLengthLimit' => no proofs of that length could already be found
+								anything = true;
+								relevantIndices.push_back(i);
+							}
+						} else if (!found[i]) {
+							anything = true;
+							relevantIndices.push_back(i);
+						}
+					if (!anything)
+						break;
+					unordered_map<string_view, vector<size_t>> relevantTerms; // search term -> indices of equal search terms, so that each line is looked up only once
 					for (size_t i : relevantIndices)
-						if (!found[i]) {
-							const string& term = terms[i];
-							if (searchProofs ? line.substr(0, wordLengthLimit) == term : line.substr(wordLengthLimit + 1) == term) {
-								totalResults++;
-								found[i] = true;
-								{
-									stringstream ss;
-									ss << "Found [" << i << "] : \"" << term << "\"" << (modified[i] ? " (originally \"" + _searchTerms[i] + "\")" : "") << "\n\tin line " << lineNo << " - " + line + "\n\tof 'dProofs" << wordLengthLimit << currentFilePostfix << "'.";
-									string searchTerm = modified[i] ? _searchTerms[i] : term;
-									string searchResult = searchProofs ? line.substr(wordLengthLimit + 1) : line.substr(0, wordLengthLimit);
-									if (debug) {
-										lock_guard<mutex> lock(mtx_cout);
-										cout << ss.str() << endl;
-									}
-									lock_guard<mutex> lock(mtx_results);
-									results[i] = ss.str();
-									bestResults.emplace(searchTerm, searchResult);
-								}
-								if (totalResults == _searchTerms.size()) {
-									run = false;
-									if (debug) {
-										stringstream ss;
-										ss << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to load and search " << lineNo << " lines from 'dProofs" << wordLengthLimit << currentFilePostfix << "'.";
-										lock_guard<mutex> lock(mtx_cout);
-										cout << ss.str() << endl;
+						relevantTerms[terms[i]].push_back(i);
+
+					// 2. Read and search current file.
+					const string& currentFilePostfix = wordLengthLimit < unfiltered ? filePostfix : filePostfix_unf;
+					string file = filePrefix + to_string(wordLengthLimit) + currentFilePostfix;
+					if (debug)
+						startTime = chrono::steady_clock::now();
+					vector<vector<LineMatch>> chunkMatches;
+					vector<uint64_t> lineOffsets;
+					LineError lineError;
+					mutex mtx_lineError;
+					atomic<uint64_t> lineCounter = 0;
+					atomic<bool> completed = false;
+					uint64_t bytes;
+					if (!_forEachLineInChunks(file, [&](size_t n) { chunkMatches.resize(n); }, [&](size_t chunk, uint64_t lineIndex, string& line) {
+						lineCounter++;
+						if (!checkLine(wordLengthLimit, chunk, lineIndex, line, lineError, mtx_lineError))
+							return false;
+						unordered_map<string_view, vector<size_t>>::const_iterator searchResult = relevantTerms.find(searchProofs ? string_view(line).substr(0, wordLengthLimit) : string_view(line).substr(wordLengthLimit + 1));
+						if (searchResult != relevantTerms.end())
+							for (size_t i : searchResult->second)
+								if (!found[i].exchange(true)) {
+									chunkMatches[chunk].push_back(LineMatch { chunk, lineIndex, i, line, { } });
+									if (++totalResults == _searchTerms.size()) {
+										run = false;
+										completed = true;
+										return false;
 									}
-									return;
 								}
-							}
-						}
-					lineNo++;
-				}
-				if (run && debug) {
-					stringstream ss;
-					ss << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to load and search " << lineNo - 1 << " lines from 'dProofs" << wordLengthLimit << currentFilePostfix << "'. [tid:" << this_thread::get_id() << "]";
-					lock_guard<mutex> lock(mtx_cout);
-					cout << ss.str() << endl;
+						return run.load();
+					}, &lineOffsets, &bytes)) {
+						run = false; // stop all threads
+						throw runtime_error("Failed to read the data file \"" + file + "\".");
+					}
+					if (lineError.chunk != SIZE_MAX)
+						throwLineError(file, wordLengthLimit, lineError, lineOffsets);
+
+					// 3. Register results of current file.
+					for (const vector<LineMatch>& matches : chunkMatches)
+						for (const LineMatch& match : matches)
+							registerResult(match.index, lineOffsets[match.chunk] + match.line + 1, match.content, wordLengthLimit, currentFilePostfix);
+					if ((run || completed) && debug)
+						searchInfo(startTime, lineCounter, wordLengthLimit, currentFilePostfix, chunkMatches.size(), bytes);
 				}
-			}
-		});
+			});
+		}
 		if (debug)
 			cout << "Search completed after " << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << "." << endl;
 		cout << "Found " << results.size() << " of " << _searchTerms.size() << (searchProofs ? " proof" : " formula") << (_searchTerms.size() == 1 ? "" : "s") << "." << (results.empty() ? "" : " All results:\n" + FctHelper::mapStringF(results, [](const pair<const size_t, string>& p) { return p.second; }, { }, { }, "\n")) << endl;
@@ -3204,144 +4000,174 @@ map<string, string> DlProofEnumerator::searchProofFiles(const vector<string>& se
 	}
 
 	case 1: { // search for formula schemas that are minimal representatives ; there can be multiple results for each search term, but we have to obtain the first one
-		vector<uint32_t> lowestLimitsWithResults(_searchTerms.size(), UINT32_MAX);
-		vector<mutex> mtxs(_searchTerms.size());
+		vector<atomic<uint32_t>> lowestLimitsWithResults(_searchTerms.size());
+		for (atomic<uint32_t>& lowestLimitWithResults : lowestLimitsWithResults)
+			lowestLimitWithResults = UINT32_MAX;
 		condition_variable cond; // cond is to be notified whenever a term is found, so all threads can update for which terms[i] they still need to search
 		atomic<size_t> cond_updateId = 0;
 		map<size_t, map<uint32_t, pair<string, string>>> results;
-		tbb::parallel_for(tbb::blocked_range<vector<uint32_t>::const_iterator>(limits.begin(), limits.end()), [&](tbb::blocked_range<vector<uint32_t>::const_iterator>& range) {
-			chrono::time_point<chrono::steady_clock> startTime;
-			for (vector<uint32_t>::const_iterator it = range.begin(); run && it != range.end(); ++it) {
-				uint32_t wordLengthLimit = *it;
-
-				// 1. Check which indices are still to search for 'wordLengthLimit'.
-				vector<size_t> relevantIndices;
-				vector<atomic<bool>> stillRelevant(_searchTerms.size());
-				size_t updateId = cond_updateId;
-				for (size_t i = 0; i < _searchTerms.size(); i++) {
-					uint32_t lowestLimitWithResults;
-					{
-						lock_guard<mutex> lock(mtxs[i]);
-						lowestLimitWithResults = lowestLimitsWithResults[i];
-					}
-					if (lowestLimitWithResults > wordLengthLimit) {
-						relevantIndices.push_back(i);
-						stillRelevant[i] = true;
-					}
+		if (useIndex) { // the first result for a term is the confirmed schema with the lowest location
+			atomic<uint64_t> candidateCounter = 0;
+			tbb::parallel_for(size_t(0), _searchTerms.size(), [&](size_t i) {
+				const string& term = terms[i];
+				size_t best = SIZE_MAX;
+				termIndex.forEachPotentialSchemaOf(term, [&](size_t k) {
+					candidateCounter++;
+					if ((best == SIZE_MAX || termIndex.location(k) < termIndex.location(best)) && DlCore::isSchemaOf_polishNotation_noRename_numVars_vec(termIndex.conclusion(k), term))
+						best = k;
+				});
+				if (best == SIZE_MAX)
+					return;
+				uint64_t location = termIndex.location(best);
+				const DlProofIndex::FileRecord& record = termIndex.fileRecord(DlProofIndex::fileIndexOf(location));
+				uint32_t wordLengthLimit = record.wordLengthLimit;
+				string line(termIndex.line(best));
+				map<size_t, string> substitutions;
+				DlCore::isSchemaOf_polishNotation_noRename_numVars(line.substr(wordLengthLimit + 1), term, &substitutions);
+				stringstream ss;
+				ss << "Found [" << i << "] : \"" << term << "\"" << (modified[i] ? " (originally \"" + _searchTerms[i] + "\")" : "") << "\n\tin line " << DlProofIndex::lineOf(location) + 1 << " - " + line + "\n\tof 'dProofs" << wordLengthLimit << (record.unfiltered ? filePostfix_unf : filePostfix) << "'.";
+				ss << "\n\tSubstitution is " << FctHelper::mapString(substitutions) << ".";
+				if (debug) {
+					lock_guard<mutex> lock(mtx_cout);
+					cout << ss.str() << endl;
 				}
-				if (relevantIndices.empty())
-					continue; // may still be relevant for lower limits
-
-				// 2. Start a thread to update 'stillRelevant'.
-				mutex mtx;
-				unique_lock<mutex> condLock(mtx);
-				atomic<bool> searching = true;
-				atomic<bool> terminating = false;
-				thread updaterThread([&]() {
-					while (searching) {
-						if (updateId == cond_updateId) {
-							cond.wait(condLock);
-							if (!searching)
-								break;
+				lowestLimitsWithResults[i] = wordLengthLimit;
+				lock_guard<mutex> lock(mtx_results);
+				results[i].emplace(wordLengthLimit, make_pair(ss.str(), line.substr(0, wordLengthLimit)));
+			});
+			if (debug)
+				cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to query term index for " << _searchTerms.size() << " search term" << (_searchTerms.size() == 1 ? "" : "s") << " and to check " << candidateCounter << " candidate" << (candidateCounter == 1 ? "" : "s") << "." << endl;
+		} else {
+			tbb::parallel_for(tbb::blocked_range<vector<uint32_t>::const_iterator>(limits.begin(), limits.end()), [&](tbb::blocked_range<vector<uint32_t>::const_iterator>& range) {
+				chrono::time_point<chrono::steady_clock> startTime;
+				for (vector<uint32_t>::const_iterator it = range.begin(); run && it != range.end(); ++it) {
+					uint32_t wordLengthLimit = *it;
+
+					// 1. Check which indices are still to search for 'wordLengthLimit'.
+					vector<size_t> relevantIndices;
+					vector<atomic<bool>> stillRelevant(_searchTerms.size());
+					size_t updateId = cond_updateId;
+					for (size_t i = 0; i < _searchTerms.size(); i++)
+						if (lowestLimitsWithResults[i] > wordLengthLimit) {
+							relevantIndices.push_back(i);
+							stillRelevant[i] = true;
 						}
-						updateId = cond_updateId;
-						bool anything = false;
-						for (size_t i = 0; i < stillRelevant.size(); i++)
-							if (stillRelevant[i]) {
-								uint32_t lowestLimitWithResults;
-								{
-									lock_guard<mutex> lock(mtxs[i]);
-									lowestLimitWithResults = lowestLimitsWithResults[i];
-								}
-								if (lowestLimitWithResults <= wordLengthLimit)
-									stillRelevant[i] = false;
-								else
-									anything = true;
+					if (relevantIndices.empty())
+						continue; // may still be relevant for lower limits
+					DlSchemaIndex relevantTerms;
+					for (size_t i : relevantIndices)
+						relevantTerms.insert(terms[i], static_cast<uint32_t>(i));
+					size_t relevanceCheckInterval = max(relevantIndices.size() / 16, size_t(1)); // amount of lines after which a chunk checks whether any terms remain to be searched by it
+
+					// 2. Start a thread to update 'stillRelevant'.
+					mutex mtx;
+					unique_lock<mutex> condLock(mtx);
+					atomic<bool> searching = true;
+					atomic<bool> terminating = false;
+					thread updaterThread([&]() {
+						while (searching) {
+							if (updateId == cond_updateId) {
+								cond.wait(condLock);
+								if (!searching)
+									break;
 							}
-						if (!anything)
-							searching = false;
-					}
-					terminating = true;
-				});
-				auto terminateUpdater = [&]() {
-					searching = false;
-					while (!terminating) {
-						cond.notify_all();
-						this_thread::yield();
-					}
-					updaterThread.join();
-				};
-
-				// 3. Read current file.
-				const string& currentFilePostfix = wordLengthLimit < unfiltered ? filePostfix : filePostfix_unf;
-				string file = filePrefix + to_string(wordLengthLimit) + currentFilePostfix;
-				if (debug)
-					startTime = chrono::steady_clock::now();
-				ifstream fin(file, fstream::in | fstream::binary);
-				if (!fin.is_open()) {
-					run = false; // stop all threads
-					terminateUpdater();
-					throw runtime_error("Failed to read the data file \"" + file + "\".");
-				}
+							updateId = cond_updateId;
+							bool anything = false;
+							for (size_t i = 0; i < stillRelevant.size(); i++)
+								if (stillRelevant[i]) {
+									if (lowestLimitsWithResults[i] < wordLengthLimit) // NOTE: Results for 'wordLengthLimit' are from the current file, whose chunks may still find results in preceding lines.
+										stillRelevant[i] = false;
+									else
+										anything = true;
+								}
+							if (!anything)
+								searching = false;
+						}
+						terminating = true;
+					});
+					auto terminateUpdater = [&]() {
+						searching = false;
+						while (!terminating) {
+							cond.notify_all();
+							this_thread::yield();
+						}
+						updaterThread.join();
+					};
 
-				// 4. Search current file.
-				string line;
-				size_t lineNo = 1;
-				map<size_t, string> substitutions;
-				bool done = false;
-				while (searching && run && getline(fin, line)) {
-					if (line.length() < wordLengthLimit + 2) {
+					// 3. Read and search current file. ; NOTE: The first result for a term is from the lowest chunk with a result for that term, so chunks may skip terms with results in preceding chunks.
+					const string& currentFilePostfix = wordLengthLimit < unfiltered ? filePostfix : filePostfix_unf;
+					string file = filePrefix + to_string(wordLengthLimit) + currentFilePostfix;
+					if (debug)
+						startTime = chrono::steady_clock::now();
+					vector<vector<LineMatch>> chunkMatches;
+					vector<uint64_t> lineOffsets;
+					LineError lineError;
+					mutex mtx_lineError;
+					atomic<uint64_t> lineCounter = 0;
+					vector<atomic<size_t>> firstChunkWithResult(_searchTerms.size());
+					for (atomic<size_t>& chunk : firstChunkWithResult)
+						chunk = SIZE_MAX;
+					uint64_t bytes;
+					bool readable;
+					try {
+						readable = _forEachLineInChunks(file, [&](size_t n) { chunkMatches.resize(n); }, [&](size_t chunk, uint64_t lineIndex, string& line) {
+							lineCounter++;
+							if (!checkLine(wordLengthLimit, chunk, lineIndex, line, lineError, mtx_lineError))
+								return false;
+							string conclusion = line.substr(wordLengthLimit + 1);
+							map<size_t, string> substitutions;
+							forEachCandidateTerm(relevantTerms, relevantIndices, true, conclusion, [&](size_t i) {
+								if (stillRelevant[i] && firstChunkWithResult[i] > chunk && DlCore::isSchemaOf_polishNotation_noRename_numVars(conclusion, terms[i], &substitutions)) {
+									uint32_t lowestLimitWithResults = lowestLimitsWithResults[i];
+									while (wordLengthLimit < lowestLimitWithResults && !lowestLimitsWithResults[i].compare_exchange_weak(lowestLimitWithResults, wordLengthLimit));
+									size_t firstChunk = firstChunkWithResult[i];
+									while (chunk < firstChunk && !firstChunkWithResult[i].compare_exchange_weak(firstChunk, chunk));
+									chunkMatches[chunk].push_back(LineMatch { chunk, lineIndex, i, line, FctHelper::mapString(substitutions) });
+									cond_updateId++;
+									cond.notify_all();
+								}
+							});
+							if (lineIndex % relevanceCheckInterval == 0 && none_of(relevantIndices.begin(), relevantIndices.end(), [&](size_t i) { return stillRelevant[i] && firstChunkWithResult[i] > chunk; }))
+								return false;
+							return searching && run;
+						}, &lineOffsets, &bytes);
+					} catch (...) { // the updater thread must be joined before it is destroyed
 						run = false; // stop all threads
 						terminateUpdater();
-						throw domain_error("Erroneous proof file at \"" + file + "\": Line " + to_string(lineNo) + " (\"" + line + "\") too short.");
-					} else if (line[wordLengthLimit] != ':') {
+						throw;
+					}
+					terminateUpdater();
+					if (!readable) {
 						run = false; // stop all threads
-						terminateUpdater();
-						throw domain_error("Erroneous proof file at \"" + file + "\": Line " + to_string(lineNo) + " (\"" + line + "\") should contain ':' at index " + to_string(wordLengthLimit) + ".");
+						throw runtime_error("Failed to read the data file \"" + file + "\".");
 					}
-					for (size_t i : relevantIndices)
-						if (stillRelevant[i]) {
+					if (lineError.chunk != SIZE_MAX)
+						throwLineError(file, wordLengthLimit, lineError, lineOffsets);
+
+					// 4. Register the first result of current file for each term.
+					for (const vector<LineMatch>& matches : chunkMatches)
+						for (const LineMatch& match : matches) {
+							size_t i = match.index;
+							if (firstChunkWithResult[i] != match.chunk)
+								continue;
+							firstChunkWithResult[i] = SIZE_MAX; // only register the first result of the lowest chunk
 							const string& term = terms[i];
-							if (DlCore::isSchemaOf_polishNotation_noRename_numVars(line.substr(wordLengthLimit + 1), term, &substitutions)) {
-								{
-									lock_guard<mutex> lock(mtxs[i]);
-									uint32_t& lowestLimitWithResults = lowestLimitsWithResults[i];
-									if (wordLengthLimit < lowestLimitWithResults)
-										lowestLimitWithResults = wordLengthLimit;
-								}
-								{
-									stringstream ss;
-									ss << "Found [" << i << "] : \"" << term << "\"" << (modified[i] ? " (originally \"" + _searchTerms[i] + "\")" : "") << "\n\tin line " << lineNo << " - " + line + "\n\tof 'dProofs" << wordLengthLimit << currentFilePostfix << "'.";
-									ss << "\n\tSubstitution is " << FctHelper::mapString(substitutions) << ".";
-									if (debug) {
-										lock_guard<mutex> lock(mtx_cout);
-										cout << ss.str() << endl;
-									}
-									lock_guard<mutex> lock(mtx_results);
-									results[i].emplace(wordLengthLimit, make_pair(ss.str(), line.substr(0, wordLengthLimit)));
-								}
-								cond_updateId++;
-								cond.notify_all();
-								stillRelevant[i] = false;
-								if (!any_of(stillRelevant.begin(), stillRelevant.end(), [](const atomic<bool>& b) -> bool { return b; })) {
-									done = true;
-									break;
-								}
+							const string& line = match.content;
+							stringstream ss;
+							ss << "Found [" << i << "] : \"" << term << "\"" << (modified[i] ? " (originally \"" + _searchTerms[i] + "\")" : "") << "\n\tin line " << lineOffsets[match.chunk] + match.line + 1 << " - " + line + "\n\tof 'dProofs" << wordLengthLimit << currentFilePostfix << "'.";
+							ss << "\n\tSubstitution is " << match.substitutions << ".";
+							if (debug) {
+								lock_guard<mutex> lock(mtx_cout);
+								cout << ss.str() << endl;
 							}
+							lock_guard<mutex> lock(mtx_results);
+							results[i].emplace(wordLengthLimit, make_pair(ss.str(), line.substr(0, wordLengthLimit)));
 						}
-					lineNo++;
-					if (done)
-						break;
-				}
-				if (run && debug) {
-					stringstream ss;
-					ss << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to load and search " << lineNo - 1 << " lines from 'dProofs" << wordLengthLimit << currentFilePostfix << "'. [tid:" << this_thread::get_id() << "]";
-					lock_guard<mutex> lock(mtx_cout);
-					cout << ss.str() << endl;
+					if (run && debug)
+						searchInfo(startTime, lineCounter, wordLengthLimit, currentFilePostfix, chunkMatches.size(), bytes);
 				}
-				terminateUpdater();
-			}
-		});
+			});
+		}
 		if (debug)
 			cout << "Search completed after " << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << "." << endl;
 		cout << "Found " << results.size() << " of " << _searchTerms.size() << " formula schema" << (_searchTerms.size() == 1 ? "" : "s") << "." << (results.empty() ? "" : " Minimal results:\n" + FctHelper::mapStringF(results, [](const pair<const size_t, map<uint32_t, pair<string, string>>>& p) { return p.second.begin()->second.first; }, { }, { }, "\n")) << endl;
@@ -3374,40 +4200,94 @@ map<string, string> DlProofEnumerator::searchProofFiles(const vector<string>& se
 		// there can be multiple results for each search term, and we want them all
 		const bool abstractSearch = schemaSearch == 3;
 		map<size_t, map<uint32_t, pair<vector<string>, string>>> results;
-		tbb::parallel_for(tbb::blocked_range<vector<uint32_t>::const_iterator>(limits.begin(), limits.end()), [&](tbb::blocked_range<vector<uint32_t>::const_iterator>& range) {
-			chrono::time_point<chrono::steady_clock> startTime;
-			for (vector<uint32_t>::const_iterator it = range.begin(); run && it != range.end(); ++it) {
-				uint32_t wordLengthLimit = *it;
-
-				// 1. Read current file.
-				const string& currentFilePostfix = wordLengthLimit < unfiltered ? filePostfix : filePostfix_unf;
-				string file = filePrefix + to_string(wordLengthLimit) + currentFilePostfix;
-				if (debug)
-					startTime = chrono::steady_clock::now();
-				ifstream fin(file, fstream::in | fstream::binary);
-				if (!fin.is_open()) {
-					run = false; // stop all threads
-					throw runtime_error("Failed to read the data file \"" + file + "\".");
+		if (useIndex) { // results for a term are its confirmed candidates in order of locations
+			atomic<uint64_t> candidateCounter = 0;
+			tbb::parallel_for(size_t(0), _searchTerms.size(), [&](size_t i) {
+				const string& term = terms[i];
+				vector<pair<size_t, string>> matches; // pairs of entry and substitution
+				map<size_t, string> substitutions;
+				auto check = [&](size_t k) {
+					candidateCounter++;
+					string conclusion(termIndex.conclusion(k));
+					if (abstractSearch ? DlCore::isSchemaOf_polishNotation_noRename_numVars(term, conclusion, &substitutions) : DlCore::isSchemaOf_polishNotation_noRename_numVars(conclusion, term, &substitutions))
+						matches.emplace_back(k, FctHelper::mapString(substitutions));
+				};
+				if (abstractSearch)
+					termIndex.forEachPotentialInstanceOf(term, check);
+				else
+					termIndex.forEachPotentialSchemaOf(term, check);
+				sort(matches.begin(), matches.end(), [&](const pair<size_t, string>& a, const pair<size_t, string>& b) { return termIndex.location(a.first) < termIndex.location(b.first); });
+				for (const pair<size_t, string>& match : matches) {
+					uint64_t location = termIndex.location(match.first);
+					const DlProofIndex::FileRecord& record = termIndex.fileRecord(DlProofIndex::fileIndexOf(location));
+					uint32_t wordLengthLimit = record.wordLengthLimit;
+					string line(termIndex.line(match.first));
+					stringstream ss;
+					ss << "Found [" << i << "] : \"" << term << "\"" << (modified[i] ? " (originally \"" + _searchTerms[i] + "\")" : "") << "\n\tin line " << DlProofIndex::lineOf(location) + 1 << " - " + line + "\n\tof 'dProofs" << wordLengthLimit << (record.unfiltered ? filePostfix_unf : filePostfix) << "'.";
+					ss << "\n\tSubstitution is " << match.second << ".";
+					if (debug) {
+						lock_guard<mutex> lock(mtx_cout);
+						cout << ss.str() << endl;
+					}
+					lock_guard<mutex> lock(mtx_results);
+					pair<vector<string>, string>& p = results[i][wordLengthLimit];
+					if (p.first.empty())
+						p.second = line.substr(0, wordLengthLimit);
+					p.first.push_back(ss.str());
 				}
+			});
+			if (debug)
+				cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to query term index for " << _searchTerms.size() << " search term" << (_searchTerms.size() == 1 ? "" : "s") << " and to check " << candidateCounter << " candidate" << (candidateCounter == 1 ? "" : "s") << "." << endl;
+		} else {
+			DlSchemaIndex allTerms;
+			vector<size_t> allIndices(terms.size());
+			for (size_t i = 0; i < terms.size(); i++) {
+				allTerms.insert(terms[i], static_cast<uint32_t>(i));
+				allIndices[i] = i;
+			}
+			tbb::parallel_for(tbb::blocked_range<vector<uint32_t>::const_iterator>(limits.begin(), limits.end()), [&](tbb::blocked_range<vector<uint32_t>::const_iterator>& range) {
+				chrono::time_point<chrono::steady_clock> startTime;
+				for (vector<uint32_t>::const_iterator it = range.begin(); run && it != range.end(); ++it) {
+					uint32_t wordLengthLimit = *it;
 
-				// 2. Search current file.
-				string line;
-				size_t lineNo = 1;
-				map<size_t, string> substitutions;
-				while (run && getline(fin, line)) {
-					if (line.length() < wordLengthLimit + 2) {
-						run = false; // stop all threads
-						throw domain_error("Erroneous proof file at \"" + file + "\": Line " + to_string(lineNo) + " (\"" + line + "\") too short.");
-					} else if (line[wordLengthLimit] != ':') {
+					// 1. Read and search current file.
+					const string& currentFilePostfix = wordLengthLimit < unfiltered ? filePostfix : filePostfix_unf;
+					string file = filePrefix + to_string(wordLengthLimit) + currentFilePostfix;
+					if (debug)
+						startTime = chrono::steady_clock::now();
+					vector<vector<LineMatch>> chunkMatches;
+					vector<uint64_t> lineOffsets;
+					LineError lineError;
+					mutex mtx_lineError;
+					atomic<uint64_t> lineCounter = 0;
+					uint64_t bytes;
+					if (!_forEachLineInChunks(file, [&](size_t n) { chunkMatches.resize(n); }, [&](size_t chunk, uint64_t lineIndex, string& line) {
+						lineCounter++;
+						if (!checkLine(wordLengthLimit, chunk, lineIndex, line, lineError, mtx_lineError))
+							return false;
+						string conclusion = line.substr(wordLengthLimit + 1);
+						map<size_t, string> substitutions;
+						forEachCandidateTerm(allTerms, allIndices, !abstractSearch, conclusion, [&](size_t i) {
+							if (abstractSearch ? DlCore::isSchemaOf_polishNotation_noRename_numVars(terms[i], conclusion, &substitutions) : DlCore::isSchemaOf_polishNotation_noRename_numVars(conclusion, terms[i], &substitutions))
+								chunkMatches[chunk].push_back(LineMatch { chunk, lineIndex, i, line, FctHelper::mapString(substitutions) });
+						});
+						return run.load();
+					}, &lineOffsets, &bytes)) {
 						run = false; // stop all threads
-						throw domain_error("Erroneous proof file at \"" + file + "\": Line " + to_string(lineNo) + " (\"" + line + "\") should contain ':' at index " + to_string(wordLengthLimit) + ".");
+						throw runtime_error("Failed to read the data file \"" + file + "\".");
 					}
-					for (size_t i = 0; i < _searchTerms.size(); i++) {
-						const string& term = terms[i];
-						if (abstractSearch ? DlCore::isSchemaOf_polishNotation_noRename_numVars(term, line.substr(wordLengthLimit + 1), &substitutions) : DlCore::isSchemaOf_polishNotation_noRename_numVars(line.substr(wordLengthLimit + 1), term, &substitutions)) {
+					if (lineError.chunk != SIZE_MAX)
+						throwLineError(file, wordLengthLimit, lineError, lineOffsets);
+
+					// 2. Register results of current file.
+					for (const vector<LineMatch>& matches : chunkMatches)
+						for (const LineMatch& match : matches) {
+							size_t i = match.index;
+							const string& term = terms[i];
+							const string& line = match.content;
 							stringstream ss;
-							ss << "Found [" << i << "] : \"" << term << "\"" << (modified[i] ? " (originally \"" + _searchTerms[i] + "\")" : "") << "\n\tin line " << lineNo << " - " + line + "\n\tof 'dProofs" << wordLengthLimit << currentFilePostfix << "'.";
-							ss << "\n\tSubstitution is " << FctHelper::mapString(substitutions) << ".";
+							ss << "Found [" << i << "] : \"" << term << "\"" << (modified[i] ? " (originally \"" + _searchTerms[i] + "\")" : "") << "\n\tin line " << lineOffsets[match.chunk] + match.line + 1 << " - " + line + "\n\tof 'dProofs" << wordLengthLimit << currentFilePostfix << "'.";
+							ss << "\n\tSubstitution is " << match.substitutions << ".";
 							if (debug) {
 								lock_guard<mutex> lock(mtx_cout);
 								cout << ss.str() << endl;
@@ -3418,17 +4298,11 @@ map<string, string> DlProofEnumerator::searchProofFiles(const vector<string>& se
 								p.second = line.substr(0, wordLengthLimit);
 							p.first.push_back(ss.str());
 						}
-					}
-					lineNo++;
-				}
-				if (run && debug) {
-					stringstream ss;
-					ss << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to load and search " << lineNo - 1 << " lines from 'dProofs" << wordLengthLimit << currentFilePostfix << "'. [tid:" << this_thread::get_id() << "]";
-					lock_guard<mutex> lock(mtx_cout);
-					cout << ss.str() << endl;
+					if (run && debug)
+						searchInfo(startTime, lineCounter, wordLengthLimit, currentFilePostfix, chunkMatches.size(), bytes);
 				}
-			}
-		});
+			});
+		}
 		if (debug)
 			cout << "Search completed after " << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << "." << endl;
 		cout << "Found " << results.size() << " of " << _searchTerms.size() << " formula " << (abstractSearch ? "type" : "schema") << (_searchTerms.size() == 1 ? "" : "s") << "." << (results.empty() ? "" : " All results:\n" + FctHelper::mapStringF(results, [](const pair<const size_t, map<uint32_t, pair<vector<string>, string>>>& p) { return FctHelper::mapStringF(p.second, [](const pair<const uint32_t, pair<vector<string>, string>>& q) { return FctHelper::vectorString(q.second.first, { }, { }, "\n"); }, { }, { }, "\n"); }, { }, { }, "\n")) << endl;
@@ -3460,6 +4334,247 @@ map<string, string> DlProofEnumerator::searchProofFiles(const vector<string>& se
 	return bestResults;
 }
 
+void DlProofEnumerator::createTermIndex(bool debug) {
+	chrono::time_point<chrono::steady_clock> startTime = chrono::steady_clock::now();
+	string searchPath = "data/" + _customizedPath + "dProofs-withConclusions/";
+	uint32_t unfiltered;
+	vector<pair<uint32_t, uint32_t>> files = _listProofFilesForSearch(searchPath + "dProofs", unfiltered);
+	if (files.empty()) {
+		cerr << "Missing proof files at \"" << searchPath << "\". Aborting." << endl;
+		return;
+	}
+	if (debug)
+		cout << "Creating term index at \"" << DlTermIndex::indexPath(searchPath) << "\" for " << files.size() << " proof file" << (files.size() == 1 ? "" : "s") << "." << endl;
+
+	// 1. Read files.
+	vector<DlProofIndex::FileRecord> records(files.size());
+	vector<vector<uint64_t>> fileLocations(files.size());
+	vector<vector<string>> fileLines(files.size());
+	vector<vector<string>> fileSkeletons(files.size());
+	if (!_readProofFilesForIndex(searchPath, files, [&](size_t k, uint64_t lineIndex, uint64_t, const string& line) {
+		fileLocations[k].push_back(DlProofIndex::location(k, lineIndex));
+		fileLines[k].push_back(line);
+		fileSkeletons[k].push_back(DlTermIndex::skeleton(string_view(line).substr(files[k].first + 1)));
+	}, [&](size_t k, uint64_t size, int64_t time, bool archived, uint64_t lineCount) {
+		records[k] = DlProofIndex::FileRecord { files[k].first, files[k].second, archived ? 1u : 0u, 0, size, time, lineCount, 0 };
+	}, debug))
+		throw runtime_error("Failed to read the data files at \"" + searchPath + "\".");
+
+	// 2. Merge and sort entries by skeletons.
+	vector<uint64_t> locations;
+	vector<string> lines;
+	vector<string> skeletons;
+	for (size_t k = 0; k < files.size(); k++) {
+		locations.insert(locations.end(), fileLocations[k].begin(), fileLocations[k].end());
+		lines.insert(lines.end(), make_move_iterator(fileLines[k].begin()), make_move_iterator(fileLines[k].end()));
+		skeletons.insert(skeletons.end(), make_move_iterator(fileSkeletons[k].begin()), make_move_iterator(fileSkeletons[k].end()));
+		vector<string>().swap(fileLines[k]);
+		vector<string>().swap(fileSkeletons[k]);
+	}
+	vector<size_t> order(lines.size());
+	iota(order.begin(), order.end(), 0);
+	tbb::parallel_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+		int cmp = skeletons[a].compare(skeletons[b]);
+		return cmp < 0 || (cmp == 0 && locations[a] < locations[b]);
+	});
+
+	// 3. Save index.
+	string indexFile = DlTermIndex::indexPath(searchPath);
+	size_t bytes = DlTermIndex::write(indexFile, records, locations, lines, skeletons, order, _customAxiomsHash);
+	if (!bytes)
+		throw runtime_error("Failed to write term index to \"" + indexFile + "\".");
+	cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to index " << lines.size() << " conclusions of " << files.size() << " proof file" << (files.size() == 1 ? "" : "s") << " and to save " << bytes << " bytes of term index data to " << indexFile << "." << endl;
+}
+
+void DlProofEnumerator::serveQueries(const string* socketPath, bool debug) {
+	chrono::time_point<chrono::steady_clock> startTime = chrono::steady_clock::now();
+	string searchPath = "data/" + _customizedPath + "dProofs-withConclusions/";
+	string filePrefix = searchPath + "dProofs";
+	uint32_t unfiltered;
+	vector<pair<uint32_t, uint32_t>> files = _listProofFilesForSearch(filePrefix, unfiltered);
+	if (files.empty())
+		throw runtime_error("Missing proof files at \"" + searchPath + "\".");
+
+	// 1. Map term index, which contains all lines of the proof files, and create it first when it is missing or outdated.
+	DlTermIndex termIndex;
+	string indexFile = DlTermIndex::indexPath(searchPath);
+	string error;
+	auto openIndex = [&]() {
+		return termIndex.open(indexFile, _customAxiomsHash, &error) && indexCoversFiles(termIndex, filePrefix, files, error);
+	};
+	if (!openIndex()) {
+		cout << "Creating term index at \"" << indexFile << "\" due to " << error << "." << endl;
+		createTermIndex(debug);
+		if (!openIndex())
+			throw runtime_error("Failed to use term index at \"" + indexFile + "\" due to " + error + ".");
+	}
+	size_t n = termIndex.size();
+	vector<string> fileNames(termIndex.fileCount());
+	for (size_t k = 0; k < fileNames.size(); k++) {
+		const DlProofIndex::FileRecord& record = termIndex.fileRecord(k);
+		fileNames[k] = "dProofs" + to_string(record.wordLengthLimit) + (record.unfiltered ? "-unfiltered" + to_string(record.unfiltered) + "+" : "") + ".txt";
+	}
+
+	// 2. Order entries by fingerprints of their D-proofs (for exact proof searches), and by symbolic lengths of their conclusions (for top lists). Both are ordered by location second.
+	vector<pair<uint64_t, size_t>> dProofEntries(n); // pairs of fingerprint and entry
+	vector<uint32_t> symbolicLengths(n);
+	vector<size_t> smallestEntries(n);
+	tbb::parallel_for(size_t(0), n, [&](size_t k) {
+		uint32_t wordLengthLimit = termIndex.fileRecord(DlProofIndex::fileIndexOf(termIndex.location(k))).wordLengthLimit;
+		dProofEntries[k] = make_pair(DlProofIndex::fingerprint(termIndex.line(k).substr(0, wordLengthLimit)), k);
+		symbolicLengths[k] = static_cast<uint32_t>(DlCore::symbolicLen_polishNotation_noRename_numVars(string(termIndex.conclusion(k))));
+		smallestEntries[k] = k;
+	});
+	tbb::parallel_sort(dProofEntries.begin(), dProofEntries.end(), [&](const pair<uint64_t, size_t>& a, const pair<uint64_t, size_t>& b) {
+		return a.first < b.first || (a.first == b.first && termIndex.location(a.second) < termIndex.location(b.second));
+	});
+	tbb::parallel_sort(smallestEntries.begin(), smallestEntries.end(), [&](size_t a, size_t b) {
+		return symbolicLengths[a] < symbolicLengths[b] || (symbolicLengths[a] == symbolicLengths[b] && termIndex.location(a) < termIndex.location(b));
+	});
+	if (debug)
+		cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to load " << n << " conclusions of " << fileNames.size() << " proof file" << (fileNames.size() == 1 ? "" : "s") << " via term index at \"" << indexFile << "\"." << endl;
+
+	// 3. Answer requests, each of which is a JSON object with an operation "op" and an optional identifier "id" (which is copied to its response).
+	//    {"op":"search","terms":[…],"mode":<"conclusion" | "proof" | "schema" | "schemas" | "instances">,"normalPolishNotation":<bool>,"limit":<amount per term>} ; like '--search' (with '-p', '-s', '-w', '-t' and '-n')
+	//    {"op":"parse","proofs":[…]} ; conclusions of D-proofs, like '--parse [...] -b'
+	//    {"op":"extract","amount":<amount>} ; smallest conclusions, like '--extract -t' (without redundant schema removal)
+	auto entryJson = [&](size_t k, const map<size_t, string>* substitutions) {
+		uint64_t location = termIndex.location(k);
+		size_t fileIndex = DlProofIndex::fileIndexOf(location);
+		uint32_t wordLengthLimit = termIndex.fileRecord(fileIndex).wordLengthLimit;
+		string_view line = termIndex.line(k);
+		string s = "{\"proof\":" + NdJson::quote(line.substr(0, wordLengthLimit)) + ",\"conclusion\":" + NdJson::quote(line.substr(wordLengthLimit + 1)) + ",\"file\":" + NdJson::quote(fileNames[fileIndex]) + ",\"line\":" + to_string(DlProofIndex::lineOf(location) + 1);
+		if (substitutions)
+			s += ",\"substitutions\":" + FctHelper::mapStringF(*substitutions, [](const pair<const size_t, string>& p) { return "\"" + to_string(p.first) + "\":" + NdJson::quote(p.second); }, "{", "}", ",");
+		return s + "}";
+	};
+	auto handleRequest = [&](const string& line) -> string {
+		map<string, NdJson::Value> request;
+		string error;
+		if (!NdJson::parseObject(line, request, error))
+			return "{\"error\":" + NdJson::quote("Invalid request: " + error + ".") + "}";
+		string response = request.count("id") ? "{\"id\":" + string(request["id"].raw) + "," : "{";
+		auto strings = [&](const string& name) {
+			const NdJson::Value& v = request[name];
+			if (v.type != NdJson::Value::Type::Array || any_of(v.elements.begin(), v.elements.end(), [](const NdJson::Value& e) { return e.type != NdJson::Value::Type::String; }))
+				throw invalid_argument("Member \"" + name + "\" must be an array of strings.");
+			vector<string> result;
+			for (const NdJson::Value& e : v.elements)
+				result.push_back(e.string);
+			return result;
+		};
+		auto amount = [&](const string& name, uint64_t defaultValue) {
+			if (!request.count(name))
+				return defaultValue;
+			uint64_t result;
+			if (!request[name].toUInt(result))
+				throw invalid_argument("Member \"" + name + "\" must be a non-negative integer.");
+			return result;
+		};
+		auto resultsJson = [](const vector<vector<string>>& results) {
+			return FctHelper::vectorStringF(results, [](const vector<string>& v) { return FctHelper::vectorString(v, "[", "]", ","); }, "[", "]", ",");
+		};
+		try {
+			string op = request["op"].string;
+			if (op == "search") {
+				vector<string> terms = strings("terms");
+				string mode = request.count("mode") ? request["mode"].string : "conclusion";
+				uint64_t limit = amount("limit", UINT64_MAX);
+				if (mode != "proof") { // formula conversion
+					bool normalPolishNotation = request["normalPolishNotation"].boolean();
+					for (string& term : terms) {
+						shared_ptr<DlFormula> formula;
+						if (normalPolishNotation ? !DlCore::fromPolishNotation(formula, term) : !DlCore::fromPolishNotation_noRename(formula, term))
+							throw invalid_argument("Cannot parse \"" + term + "\" as a formula in " + (normalPolishNotation ? "normal" : "dotted") + " Polish notation.");
+						term = DlCore::toPolishNotation_numVars(formula);
+					}
+				}
+				vector<vector<string>> results(terms.size());
+				if (mode == "conclusion" || mode == "proof" || mode == "schema") { // at most the first result for each term
+					tbb::parallel_for(size_t(0), terms.size(), [&](size_t i) {
+						const string& term = terms[i];
+						size_t best = SIZE_MAX;
+						if (mode == "conclusion") { // entries with equal skeletons are ordered by location
+							pair<size_t, size_t> range = termIndex.skeletonRange(term);
+							for (size_t k = range.first; best == SIZE_MAX && k < range.second; k++)
+								if (termIndex.conclusion(k) == term)
+									best = k;
+						} else if (mode == "proof") {
+							uint64_t fingerprint = DlProofIndex::fingerprint(term);
+							for (vector<pair<uint64_t, size_t>>::const_iterator it = lower_bound(dProofEntries.begin(), dProofEntries.end(), make_pair(fingerprint, size_t(0)), [](const pair<uint64_t, size_t>& a, const pair<uint64_t, size_t>& b) { return a.first < b.first; }); best == SIZE_MAX && it != dProofEntries.end() && it->first == fingerprint; ++it)
+								if (termIndex.line(it->second).substr(0, term.length() + 1) == term + ":")
+									best = it->second;
+						} else
+							termIndex.forEachPotentialSchemaOf(term, [&](size_t k) {
+								if ((best == SIZE_MAX || termIndex.location(k) < termIndex.location(best)) && DlCore::isSchemaOf_polishNotation_noRename_numVars_vec(termIndex.conclusion(k), term))
+									best = k;
+							});
+						if (best != SIZE_MAX && limit) {
+							map<size_t, string> substitutions;
+							if (mode == "schema")
+								DlCore::isSchemaOf_polishNotation_noRename_numVars(string(termIndex.conclusion(best)), term, &substitutions);
+							results[i].push_back(entryJson(best, mode == "schema" ? &substitutions : nullptr));
+						}
+					});
+				} else if (mode == "schemas" || mode == "instances") { // all results for each term
+					const bool abstractSearch = mode == "instances";
+					tbb::parallel_for(size_t(0), terms.size(), [&](size_t i) {
+						const string& term = terms[i];
+						vector<pair<size_t, map<size_t, string>>> matches; // pairs of entry and substitution
+						map<size_t, string> substitutions;
+						auto check = [&](size_t k) {
+							string conclusion(termIndex.conclusion(k));
+							if (abstractSearch ? DlCore::isSchemaOf_polishNotation_noRename_numVars(term, conclusion, &substitutions) : DlCore::isSchemaOf_polishNotation_noRename_numVars(conclusion, term, &substitutions))
+								matches.emplace_back(k, substitutions);
+						};
+						if (abstractSearch)
+							termIndex.forEachPotentialInstanceOf(term, check);
+						else
+							termIndex.forEachPotentialSchemaOf(term, check);
+						sort(matches.begin(), matches.end(), [&](const pair<size_t, map<size_t, string>>& a, const pair<size_t, map<size_t, string>>& b) { return termIndex.location(a.first) < termIndex.location(b.first); });
+						for (size_t j = 0; j < matches.size() && j < limit; j++)
+							results[i].push_back(entryJson(matches[j].first, &matches[j].second));
+					});
+				} else
+					throw invalid_argument("Unknown search mode \"" + mode + "\".");
+				return response + "\"results\":" + resultsJson(results) + "}";
+			} else if (op == "parse") {
+				vector<string> dProofs = strings("proofs");
+				vector<string> results(dProofs.size());
+				tbb::parallel_for(size_t(0), dProofs.size(), [&](size_t i) {
+					vector<DProofInfo> rawParseData;
+					try {
+						rawParseData = DRuleParser::parseDProof_raw(dProofs[i], _customAxiomsPtr, 1, false, true);
+					} catch (exception& e) {
+						throw invalid_argument("Cannot parse \"" + dProofs[i] + "\" as a proof: " + e.what());
+					}
+					results[i] = NdJson::quote(DlCore::toPolishNotation_numVars(get<0>(rawParseData.back().second).back()));
+				});
+				return response + "\"conclusions\":" + FctHelper::vectorString(results, "[", "]", ",") + "}";
+			} else if (op == "extract") {
+				uint64_t extractAmount = amount("amount", 0);
+				vector<string> results;
+				for (size_t j = 0; j < smallestEntries.size() && j < extractAmount; j++) {
+					size_t k = smallestEntries[j];
+					string s = entryJson(k, nullptr);
+					s.insert(s.length() - 1, ",\"symbolicLength\":" + to_string(symbolicLengths[k]));
+					results.push_back(s);
+				}
+				return response + "\"results\":" + FctHelper::vectorString(results, "[", "]", ",") + "}";
+			} else
+				throw invalid_argument("Unknown operation \"" + op + "\".");
+		} catch (exception& e) {
+			return response + "\"error\":" + NdJson::quote(e.what()) + "}";
+		}
+	};
+	if (socketPath)
+		NdJson::serveSocket(handleRequest, *socketPath, debug);
+	else {
+		cout << "{\"ready\":true,\"files\":" << fileNames.size() << ",\"conclusions\":" << n << "}" << endl;
+		NdJson::serve(handleRequest, cin, cout);
+	}
+}
+
 void DlProofEnumerator::extractConclusions(ExtractionMethod method, uint32_t extractAmount, const string* config, bool allowRedundantSchemaRemoval, bool forceRedundantSchemaRemoval, size_t bound1, size_t bound2, bool debug, string* optOut_createdExDir) {
 	chrono::time_point<chrono::steady_clock> startTime;
 	vector<string> dProofs;
@@ -3535,7 +4650,7 @@ void DlProofEnumerator::extractConclusions(ExtractionMethod method, uint32_t ext
 		const uint32_t c = _necessitationLimit ? 1 : 2;
 		const size_t maxFileStart = 1 + c * currentRepresentatives().size();
 		for (uint32_t limit = 1; true; limit += c)
-			if (!filesystem::exists(filePrefix + to_string(limit) + filePostfix)) {
+			if (!_proofFileExists(filePrefix + to_string(limit) + filePostfix)) {
 				if (limit >= maxFileStart) {
 					if (!unfiltered) {
 						unfiltered = limit;
@@ -3581,6 +4696,35 @@ void DlProofEnumerator::extractConclusions(ExtractionMethod method, uint32_t ext
 				maximumOverhead = utilizedExtractAmount - extractAmount;
 		}
 		tbb::concurrent_map<size_t, atomic<size_t>> sizes; // sizes[<symbolic conclusion length>] = <amount of conclusions of that length found (capped)>
+
+		// NOTE: Proof files are streamed (in chunks that are searched concurrently), where each chunk and each thread only keeps the candidates of symbolic
+		//       conclusion lengths for which it has less than 'utilizedExtractAmount' candidates of lower lengths, such that memory requirements are bounded
+		//       by the amount of conclusions that may be relevant (i.e. including all conclusions of the greatest relevant length), rather than by the size
+		//       of the proof files. Since complete length groups are kept, redundant schema removal (and marking of instances for ExtractionMethod::TopListFile)
+		//       considers the same formulas as if all conclusions up to the greatest relevant length were loaded.
+		struct Candidate {
+			size_t symConLen;
+			uint32_t proofLen;
+			uint64_t lineNo; // line index within its chunk, until its file is done
+			string line;
+		};
+		struct Candidates {
+			map<size_t, vector<Candidate>> groups; // groups[<symbolic conclusion length>] = <candidates of that length>
+			size_t total = 0;
+		};
+		auto admissible = [&](const Candidates& candidates, size_t symConLen) {
+			return utilizedExtractAmount == UINT32_MAX || candidates.total < utilizedExtractAmount || (!candidates.groups.empty() && symConLen <= candidates.groups.rbegin()->first);
+		};
+		auto offer = [&](Candidates& candidates, Candidate&& candidate) { // drops groups of greatest lengths while there are enough candidates of lower lengths
+			vector<Candidate>& group = candidates.groups[candidate.symConLen];
+			group.push_back(move(candidate));
+			candidates.total++;
+			if (utilizedExtractAmount != UINT32_MAX)
+				while (!candidates.groups.empty() && candidates.total - candidates.groups.rbegin()->second.size() >= utilizedExtractAmount) {
+					candidates.total -= candidates.groups.rbegin()->second.size();
+					candidates.groups.erase(prev(candidates.groups.end()));
+				}
+		};
 		do {
 			mutex mtx_cout;
 			atomic<bool> run = true;
@@ -3588,66 +4732,85 @@ void DlProofEnumerator::extractConclusions(ExtractionMethod method, uint32_t ext
 				startTime = chrono::steady_clock::now();
 			topList.clear();
 			sizes.clear();
-			tbb::concurrent_map<size_t, atomic<bool>> check; // check[<symbolic conclusion length>] = true iff size is not yet known to not fit into the list
+			tbb::enumerable_thread_specific<Candidates> threadCandidates; // bounded candidates of each thread, merged after all files are done
 			tbb::parallel_for(tbb::blocked_range<vector<uint32_t>::const_iterator>(limits.begin(), limits.end()), [&](tbb::blocked_range<vector<uint32_t>::const_iterator>& range) {
 				chrono::time_point<chrono::steady_clock> startTime;
 				for (vector<uint32_t>::const_iterator it = range.begin(); run && it != range.end(); ++it) {
 					uint32_t wordLengthLimit = *it;
 
-					// 1.1 Read current file.
+					// 1.1 Read and search current file, where each chunk keeps its own candidates.
 					const string& currentFilePostfix = wordLengthLimit < unfiltered ? filePostfix : filePostfix_unf;
 					string file = filePrefix + to_string(wordLengthLimit) + currentFilePostfix;
 					if (debug)
 						startTime = chrono::steady_clock::now();
-					ifstream fin(file, fstream::in | fstream::binary);
-					if (!fin.is_open()) {
+					vector<Candidates> chunkCandidates;
+					vector<uint64_t> lineOffsets;
+					size_t errorChunk = SIZE_MAX;
+					uint64_t errorLine = 0;
+					string errorContent;
+					mutex mtx_error;
+					atomic<uint64_t> lineCounter = 0;
+					if (!_forEachLineInChunks(file, [&](size_t n) { chunkCandidates.resize(n); }, [&](size_t chunk, uint64_t lineIndex, string& line) {
+						lineCounter++;
+						if (line.length() < wordLengthLimit + 2 || line[wordLengthLimit] != ':') {
+							lock_guard<mutex> lock(mtx_error);
+							if (chunk < errorChunk || (chunk == errorChunk && lineIndex < errorLine)) {
+								errorChunk = chunk;
+								errorLine = lineIndex;
+								errorContent = line;
+							}
+							run = false; // stop all threads
+							return false;
+						}
+						size_t len = DlCore::symbolicLen_polishNotation_noRename_numVars(line, wordLengthLimit + 1);
+						Candidates& candidates = chunkCandidates[chunk];
+						if (admissible(candidates, len))
+							offer(candidates, Candidate { len, wordLengthLimit, lineIndex, line });
+						return run.load();
+					}, &lineOffsets)) {
 						run = false; // stop all threads
 						throw runtime_error("Failed to read the data file \"" + file + "\".");
 					}
+					if (errorChunk != SIZE_MAX) {
+						uint64_t lineNo = lineOffsets[errorChunk] + errorLine + 1;
+						if (errorContent.length() < wordLengthLimit + 2)
+							throw domain_error("Erroneous proof file at \"" + file + "\": Line " + to_string(lineNo) + " (\"" + errorContent + "\") too short.");
+						else
+							throw domain_error("Erroneous proof file at \"" + file + "\": Line " + to_string(lineNo) + " (\"" + errorContent + "\") should contain ':' at index " + to_string(wordLengthLimit) + ".");
+					}
 
-					// 1.2 Search current file.
-					string line;
-					size_t lineNo = 1;
-					map<size_t, string> substitutions;
-					while (run && getline(fin, line)) {
-						if (line.length() < wordLengthLimit + 2) {
-							run = false; // stop all threads
-							throw domain_error("Erroneous proof file at \"" + file + "\": Line " + to_string(lineNo) + " (\"" + line + "\") too short.");
-						} else if (line[wordLengthLimit] != ':') {
-							run = false; // stop all threads
-							throw domain_error("Erroneous proof file at \"" + file + "\": Line " + to_string(lineNo) + " (\"" + line + "\") should contain ':' at index " + to_string(wordLengthLimit) + ".");
-						}
-						string conclusion = line.substr(wordLengthLimit + 1);
-						size_t len = DlCore::symbolicLen_polishNotation_noRename_numVars(conclusion);
-						if (utilizedExtractAmount == UINT32_MAX) // add everything
-							topList[len][wordLengthLimit][lineNo] = line;
-						else { // filter
-							if (!check.count(len))
-								check.emplace(len, true);
-							if (check.at(len)) { // still a potential candidate
-								size_t betterCandidatesAmount = 0;
-								for (const pair<const size_t, atomic<size_t>>& p : sizes)
-									if (p.first >= len)
-										break;
-									else
-										betterCandidatesAmount += p.second;
-								if (betterCandidatesAmount < utilizedExtractAmount) { // candidate might be relevant => register
-									sizes[len]++;
-									topList[len][wordLengthLimit][lineNo] = line;
-								} else
-									check[len] = false; // note that all candidates of that length are now known to be irrelevant
+					// 1.2 Merge candidates of current file, now that their line numbers are known.
+					Candidates& candidates = threadCandidates.local();
+					for (size_t chunk = 0; chunk < chunkCandidates.size(); chunk++)
+						for (pair<const size_t, vector<Candidate>>& p : chunkCandidates[chunk].groups)
+							for (Candidate& candidate : p.second) {
+								candidate.lineNo += lineOffsets[chunk] + 1;
+								if (utilizedExtractAmount == UINT32_MAX) // add everything
+									topList[candidate.symConLen][candidate.proofLen][candidate.lineNo] = move(candidate.line);
+								else if (admissible(candidates, candidate.symConLen))
+									offer(candidates, move(candidate));
 							}
-						}
-						lineNo++;
-					}
 					if (run && debug) {
 						stringstream ss;
-						ss << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to load " << (utilizedExtractAmount == UINT32_MAX ? "" : "and search ") << lineNo - 1 << " lines from 'dProofs" << wordLengthLimit << currentFilePostfix << "'. [tid:" << this_thread::get_id() << "]";
+						ss << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to load " << (utilizedExtractAmount == UINT32_MAX ? "" : "and search ") << lineCounter << " lines from 'dProofs" << wordLengthLimit << currentFilePostfix << "' in " << chunkCandidates.size() << " chunk" << (chunkCandidates.size() == 1 ? "" : "s") << ". [tid:" << this_thread::get_id() << "]";
 						lock_guard<mutex> lock(mtx_cout);
 						cout << ss.str() << endl;
 					}
 				}
 			});
+
+			// 1.3 Merge candidates of all threads into the top list.
+			Candidates candidates;
+			for (Candidates& local : threadCandidates)
+				for (pair<const size_t, vector<Candidate>>& p : local.groups)
+					for (Candidate& candidate : p.second)
+						if (admissible(candidates, candidate.symConLen))
+							offer(candidates, move(candidate));
+			for (pair<const size_t, vector<Candidate>>& p : candidates.groups)
+				for (Candidate& candidate : p.second) {
+					sizes[candidate.symConLen]++;
+					topList[candidate.symConLen][candidate.proofLen][candidate.lineNo] = move(candidate.line);
+				}
 			if (redundantSchemaRemoval) {
 				vector<array<size_t, 3>> validCombos;
 				size_t representativeCounter = 0;
@@ -4031,7 +5194,7 @@ void DlProofEnumerator::extractConclusions(ExtractionMethod method, uint32_t ext
 		const uint32_t c = _necessitationLimit ? 1 : 2;
 		vector<uint32_t> limits;
 		for (uint32_t limit = 1; true; limit += c)
-			if (!filesystem::exists(filePrefix + to_string(limit) + filePostfix)) {
+			if (!_proofFileExists(filePrefix + to_string(limit) + filePostfix)) {
 				if (limit > c) {
 					if (!unfiltered) {
 						unfiltered = limit;
@@ -4062,8 +5225,8 @@ void DlProofEnumerator::extractConclusions(ExtractionMethod method, uint32_t ext
 				string target = targetPrefix + to_string(wordLengthLimit) + currentFilePostfix;
 				if (debug)
 					startTime = chrono::steady_clock::now();
-				ifstream fin(file, fstream::in | fstream::binary);
-				if (!fin.is_open()) {
+				unique_ptr<istream> fin = _openProofFile(file);
+				if (!fin) {
 					run = false; // stop all threads
 					throw runtime_error("Failed to read the data file \"" + file + "\".");
 				}
@@ -4094,7 +5257,7 @@ void DlProofEnumerator::extractConclusions(ExtractionMethod method, uint32_t ext
 				size_t localCounter = 0;
 				map<size_t, string> substitutions;
 				bool first = true;
-				while (run && getline(fin, line)) {
+				while (run && getline(*fin, line)) {
 					if (line.length() < wordLengthLimit + 2) {
 						run = false; // stop all threads
 						throw domain_error("Erroneous proof file at \"" + file + "\": Line " + to_string(lineNo) + " (\"" + line + "\") too short.");
@@ -4142,7 +5305,7 @@ void DlProofEnumerator::printConclusionLengthPlotData(bool measureSymbolicLength
 	uint32_t unfiltered = 0;
 	vector<uint32_t> limits;
 	for (uint32_t limit = 1; true; limit += c)
-		if (!filesystem::exists(fullInputFilePrefix + to_string(limit) + filePostfix)) {
+		if (!_proofFileExists(fullInputFilePrefix + to_string(limit) + filePostfix)) {
 			if (limit > c) {
 				if (!unfiltered) {
 					unfiltered = limit;
@@ -4172,8 +5335,8 @@ void DlProofEnumerator::printConclusionLengthPlotData(bool measureSymbolicLength
 			string file = fullInputFilePrefix + to_string(wordLengthLimit) + currentFilePostfix;
 			if (debug)
 				startTime = chrono::steady_clock::now();
-			ifstream fin(file, fstream::in | fstream::binary);
-			if (!fin.is_open()) {
+			unique_ptr<istream> fin = _openProofFile(file);
+			if (!fin) {
 				run = false; // stop all threads
 				throw runtime_error("Failed to read the data file \"" + file + "\".");
 			}
@@ -4184,7 +5347,7 @@ void DlProofEnumerator::printConclusionLengthPlotData(bool measureSymbolicLength
 			// 2. Iterate lines in current file.
 			string line;
 			size_t lineNo = 1;
-			while (run && getline(fin, line)) {
+			while (run && getline(*fin, line)) {
 				if (line.length() < wordLengthLimit + 2) {
 					run = false; // stop all threads
 					throw domain_error("Erroneous proof file at \"" + file + "\": Line " + to_string(lineNo) + " (\"" + line + "\") too short.");
@@ -4369,121 +5532,98 @@ void DlProofEnumerator::printConclusionLengthPlotData(bool measureSymbolicLength
 			_mout << it->second << flush;
 }
 
-void DlProofEnumerator::_collectProvenFormulas(tbb::concurrent_hash_map<string, string>& representativeProofs, uint32_t wordLengthLimit, DlProofEnumeratorMode mode, ProgressData* const progressData, tbb::concurrent_unordered_map<string, string>* lookup_speedupN, atomic<uint64_t>* misses_speedupN, uint64_t* optOut_counter, uint64_t* optOut_conclusionCounter, uint64_t* optOut_redundantCounter, uint64_t* optOut_invalidCounter, const vector<uint32_t>* genIn_stack, const uint32_t* genIn_n, const vector<vector<string>>* genIn_allRepresentativesLookup, const vector<vector<string>>* genIn_allConclusionsLookup, vector<vector<shared_ptr<DlFormula>>>* genInOut_allParsedConclusions, vector<vector<atomic<bool>>>* genInOut_allParsedConclusions_init, size_t* candidateQueueCapacities, size_t maxSymbolicConclusionLength, size_t maxSymbolicConsequentLength) {
-	atomic<uint64_t> counter = 0;
-	atomic<uint64_t> conclusionCounter = 0;
-	atomic<uint64_t> redundantCounter = 0;
-	atomic<uint64_t> invalidCounter = 0;
-	auto handleEmplacement = [&](tbb::concurrent_hash_map<string, string>::accessor& wAcc, bool isNew, const string& dProof) {
-		if (!isNew) { // a proof for the conclusion is already known
+void DlProofEnumerator::_collectProvenFormulas(DlConclusionStore& representativeProofs, uint32_t wordLengthLimit, DlProofEnumeratorMode mode, ProgressData* const progressData, tbb::concurrent_unordered_map<string, string>* lookup_speedupN, atomic<uint64_t>* misses_speedupN, uint64_t* optOut_counter, uint64_t* optOut_conclusionCounter, uint64_t* optOut_redundantCounter, uint64_t* optOut_invalidCounter, const vector<uint32_t>* genIn_stack, const uint32_t* genIn_n, const vector<vector<string_view>>* genIn_allRepresentativesLookup, const vector<vector<string_view>>* genIn_allConclusionsLookup, vector<vector<DlFlatFormula>>* genInOut_allParsedConclusions, vector<vector<atomic<bool>>>* genInOut_allParsedConclusions_init, size_t* candidateQueueCapacities, size_t maxSymbolicConclusionLength, size_t maxSymbolicConsequentLength, vector<chrono::microseconds>* optOut_workerIdleTimes, const DlCollectionCheckpoint* resumePoint, chrono::milliseconds checkpointInterval, const function<void(const DlCollectionCheckpoint&)>& fCheckpoint, DlConclusionSpill* spill, const DlCollectionPartition* partition, uint64_t* optOut_skippedCounter, bool onlineSchemaRemoval, uint64_t* optOut_subsumedCounter) {
+	if (spill && mode != DlProofEnumeratorMode::FromConclusionStrings && mode != DlProofEnumeratorMode::FromConclusionTrees && mode != DlProofEnumeratorMode::FromGroupedConclusionTrees)
+		throw invalid_argument("Out-of-core collection requires DlProofEnumeratorMode::FromConclusionStrings, DlProofEnumeratorMode::FromConclusionTrees or DlProofEnumeratorMode::FromGroupedConclusionTrees.");
+	if (partition && mode != DlProofEnumeratorMode::FromConclusionStrings && mode != DlProofEnumeratorMode::FromConclusionTrees && mode != DlProofEnumeratorMode::FromGroupedConclusionTrees)
+		throw invalid_argument("Distributed collection requires DlProofEnumeratorMode::FromConclusionStrings, DlProofEnumeratorMode::FromConclusionTrees or DlProofEnumeratorMode::FromGroupedConclusionTrees.");
+	atomic<uint64_t> counter = resumePoint ? resumePoint->counter : 0;
+	atomic<uint64_t> conclusionCounter = resumePoint ? resumePoint->conclusionCounter : 0;
+	atomic<uint64_t> redundantCounter = resumePoint ? resumePoint->redundantCounter : 0;
+	atomic<uint64_t> invalidCounter = resumePoint ? resumePoint->invalidCounter : 0;
+	atomic<uint64_t> skippedCounter = 0; // D-rule candidates that were not iterated due to incompatible skeletons (see DlSkeletonIndex), which are also counted as invalid
+	// NOTE: Checkpoints are only taken when there are no pending candidates, so the counters are consistent with the conclusions collected so far.
+	bool checkpoints = fCheckpoint && checkpointInterval.count() > 0;
+	DlEnumerationCheckpointing checkpointing { checkpointInterval, resumePoint ? resumePoint->position : 0, nullptr };
+	if (checkpoints)
+		checkpointing.fCheckpoint = [&](uint64_t position) { fCheckpoint(DlCollectionCheckpoint { position, counter, conclusionCounter, redundantCounter, invalidCounter }); };
+	const DlEnumerationCheckpointing* _checkpointing = checkpoints || resumePoint ? &checkpointing : nullptr;
+	if (progressData && counter)
+		progressData->skip(counter);
+	auto handleEmplacement = [&](bool isNew) { // NOTE: When a proof for the conclusion was already known, the shorter or "preceding" proof was kept by DlConclusionStore::emplace().
+		if (!isNew)
 			redundantCounter++;
-			string& storedDProof = wAcc->second;
-			if (storedDProof.length() > dProof.length())
-				storedDProof = dProof; // use the shorter proof
-			else if (storedDProof.length() == dProof.length() && storedDProof > dProof)
-				storedDProof = dProof; // use the "preceding" proof
-		} else
+		else
 			conclusionCounter++;
-		wAcc.release();
 	};
-	auto parseRuleSequence = [](const string& sequence, size_t& lenA, size_t& iA, size_t* lenB = nullptr, size_t* iB = nullptr) -> bool {
-		auto read = [](string::size_type& i, const string& s, unsigned& num) {
-			num = 0;
-			if (i == s.length())
-				throw invalid_argument("Not a valid rule sequence: \"" + s + "\".");
-			for (; i < s.length(); i++)
-				switch (s[i]) {
-				case '0':
-					num = 10 * num;
-					break;
-				case '1':
-					num = 10 * num + 1;
-					break;
-				case '2':
-					num = 10 * num + 2;
-					break;
-				case '3':
-					num = 10 * num + 3;
-					break;
-				case '4':
-					num = 10 * num + 4;
-					break;
-				case '5':
-					num = 10 * num + 5;
-					break;
-				case '6':
-					num = 10 * num + 6;
-					break;
-				case '7':
-					num = 10 * num + 7;
-					break;
-				case '8':
-					num = 10 * num + 8;
-					break;
-				case '9':
-					num = 10 * num + 9;
-					break;
-				case ',':
-				case ':':
-					return;
-				default:
-					throw invalid_argument("Not a valid rule sequence: \"" + s + "\".");
-				}
-		};
-		if (sequence[1] != ':')
-			throw invalid_argument("Not a valid rule sequence: \"" + sequence + "\".");
-		string::size_type i = 2;
-		unsigned num;
-		if (sequence[0] == 'D') { // "D:<length of 1st input>,<length of 2nd input>:<index of 1st input>,<index of 2nd input>"
-			read(i, sequence, num);
-			lenA = num;
-			read(++i, sequence, num);
-			*lenB = num;
-			read(++i, sequence, num);
-			iA = num;
-			read(++i, sequence, num);
-			*iB = num;
-			if (i < sequence.length())
-				throw invalid_argument("Not a valid rule sequence: \"" + sequence + "\".");
-			return true;
-		} else if (sequence[0] == 'N') { // "N:<length of input>:<index of input>"
-			read(i, sequence, num);
-			lenA = num;
-			read(++i, sequence, num);
-			iA = num;
-			if (i < sequence.length())
-				throw invalid_argument("Not a valid rule sequence: \"" + sequence + "\".");
-			return false;
-		} else
-			throw domain_error("Unknown rule '" + string { sequence[0] } + "'.");
+	// NOTE: For online schema removal, conclusions of lower proof lengths (which remain unmodified during collection) are indexed, so that new conclusions with schemas among them can be rejected before
+	//       their insertion. Each rejected candidate is counted as redundant, i.e. the counters end up as if all conclusions were inserted and then removed (see _removeRedundantConclusionsForProofsOfMaxLength()).
+	//       Rejected conclusions are not remembered at all (so that they never occupy memory), i.e. their repetitions are checked again, and rejected candidates rather than distinct conclusions are counted.
+	unique_ptr<DlSchemaIndex> lowerSchemaIndex;
+	atomic<uint64_t> subsumedCounter = 0;
+	if (onlineSchemaRemoval) {
+		lowerSchemaIndex = make_unique<DlSchemaIndex>();
+		representativeProofs.forEach([&lowerSchemaIndex, &wordLengthLimit](string_view formula, string_view dProof) {
+			if (dProof.length() < wordLengthLimit)
+				lowerSchemaIndex->insert(formula);
+		});
+	}
+	auto emplace = [&representativeProofs, &spill, &partition, &handleEmplacement, &lowerSchemaIndex, &subsumedCounter, &redundantCounter](string_view conclusion, string_view dProof) {
+		if (partition && partition->fForward && partition->fForward(conclusion, dProof))
+			return; // counted by its owner
+		if (lowerSchemaIndex && !representativeProofs.find(conclusion) && lowerSchemaIndex->forEachPotentialSchemaOf(conclusion, [&conclusion](string_view potentialSchema) {
+			return DlCore::isSchemaOf_polishNotation_noRename_numVars_vec(potentialSchema, conclusion); // conclusion redundant ; NOTE: Known conclusions (which are their own schemas) were excluded.
+		})) {
+			redundantCounter++;
+			subsumedCounter++;
+			return;
+		}
+		if (!spill)
+			handleEmplacement(representativeProofs.emplace(conclusion, dProof, true));
+		else if (int result = spill->emplace(conclusion, dProof); result >= 0)
+			handleEmplacement(result);
+		// else: deferred, i.e. counted by DlConclusionSpill::merge()
 	};
-	auto dRuleUnify = [](const shared_ptr<DlFormula>& antecedent, const shared_ptr<DlFormula>& conditional, shared_ptr<DlFormula>& consequentVariant, string& consequent, size_t& consequentSize) -> bool {
-		const vector<shared_ptr<DlFormula>>& conditional_children = conditional->getChildren();
-		if (conditional_children.size() != 2 || conditional->getValue()->value != DlCore::terminalStr_imply())
+	auto dRuleUnify_flat = [](DlFormulaArena& arena, uint32_t antecedent, uint32_t conditional, uint32_t& consequentVariant, string& consequent, size_t& consequentSize) -> bool {
+		const DlFlatNode& conditionalNode = arena.nodes[conditional];
+		if (conditionalNode.symbol != 'C')
 			return false;
-		map<string, shared_ptr<DlFormula>> substitutions;
-		if (DlCore::tryUnifyTrees(antecedent, conditional_children[0], &substitutions)) {
-			consequentVariant = DlCore::substitute(conditional_children[1], substitutions); // variable names may be incorrect
-			consequent = DlCore::toPolishNotation_numVars(consequentVariant);
-			consequentSize = consequentVariant->size();
+		uint32_t conditional_antecedent = conditionalNode.data[0];
+		uint32_t conditional_consequent = conditionalNode.data[1];
+		thread_local vector<uint32_t> substitutions;
+		if (DlCore::tryUnifyTrees(arena, antecedent, conditional_antecedent, substitutions)) {
+			consequentVariant = DlCore::substitute(arena, conditional_consequent, substitutions); // variable names may be incorrect
+			consequent = DlCore::toPolishNotation_numVars(arena, consequentVariant);
+			consequentSize = arena.symbolicLength(consequentVariant);
 			return true;
 		}
 		return false;
 	};
-	auto checkConsequentLength = [&maxSymbolicConsequentLength](const shared_ptr<DlFormula>& conclusion, size_t conclusionSize) -> bool {
-		if (conclusion->getValue()->value == DlCore::terminalStr_imply()) {
-			if (conclusion->getChildren()[1]->size() > maxSymbolicConsequentLength)
+	auto checkConsequentLength_flat = [&maxSymbolicConsequentLength](const DlFormulaArena& arena, uint32_t conclusion, size_t conclusionSize) -> bool {
+		const DlFlatNode& conclusionNode = arena.nodes[conclusion];
+		if (conclusionNode.symbol == 'C') {
+			if (arena.symbolicLength(conclusionNode.data[1]) > maxSymbolicConsequentLength)
 				return false;
 		} else if (conclusionSize > maxSymbolicConsequentLength)
 			return false;
 		return true;
 	};
+	auto checkConsequentLength_polishNotation = [&maxSymbolicConsequentLength](const string& conclusion, size_t conclusionSize) -> bool { // 'conclusionSize' = 0 means it is yet unknown
+		if (conclusion[0] == 'C') {
+			string::size_type consequentIndex = DlCore::traverseFormulas_polishNotation_noRename_numVars(conclusion, 1) + 1;
+			if (conclusion[consequentIndex] == '.')
+				consequentIndex++;
+			if (DlCore::symbolicLen_polishNotation_noRename_numVars(conclusion, consequentIndex) > maxSymbolicConsequentLength)
+				return false;
+		} else if ((conclusionSize ? conclusionSize : DlCore::symbolicLen_polishNotation_noRename_numVars(conclusion)) > maxSymbolicConsequentLength)
+			return false;
+		return true;
+	};
 	auto process = [&representativeProofs, &progressData, &misses_speedupN, &lookup_speedupN, &maxSymbolicConclusionLength, &maxSymbolicConsequentLength, &counter, &invalidCounter, &handleEmplacement](string& sequence) {
 		counter++;
-		tbb::concurrent_hash_map<string, string>::accessor wAcc;
 		bool isNew;
-		if (parseAndInsertDProof_speedupN(&wAcc, &isNew, sequence, representativeProofs, lookup_speedupN, true, misses_speedupN, maxSymbolicConclusionLength, maxSymbolicConsequentLength)) // parse was permissive
-			handleEmplacement(wAcc, isNew, sequence);
+		if (parseAndInsertDProof_speedupN(&isNew, sequence, representativeProofs, lookup_speedupN, true, misses_speedupN, maxSymbolicConclusionLength, maxSymbolicConsequentLength, true)) // parse was permissive
+			handleEmplacement(isNew);
 		else
 			invalidCounter++;
 
@@ -4496,13 +5636,72 @@ void DlProofEnumerator::_collectProvenFormulas(tbb::concurrent_hash_map<string,
 				cout << myTime() << ": Iterated " << percentage << "% of D-proof candidates. [" << progress << "] (" << etc << ")" << endl;
 		}
 	};
-	switch (mode) {
+	auto skip = [&](uint64_t amount) {
+		counter += amount;
+		invalidCounter += amount;
+		skippedCounter += amount;
+
+		// Show progress if requested
+		if (progressData)
+			for (unsigned states = progressData->nextSteps(amount); states; states--) {
+				string percentage;
+				string progress;
+				string etc;
+				if (progressData->nextState(percentage, progress, etc))
+					cout << myTime() << ": Iterated " << percentage << "% of D-proof candidates. [" << progress << "] (" << etc << ")" << endl;
+			}
+	};
+	auto process_useConclusionTrees = [&progressData, &maxSymbolicConclusionLength, &maxSymbolicConsequentLength, &counter, &invalidCounter, &emplace, &dRuleUnify_flat, &checkConsequentLength_flat, &genIn_allRepresentativesLookup, &genIn_allConclusionsLookup, &genInOut_allParsedConclusions](const DlRuleCandidate& candidate) {
+		counter++;
+		const uint32_t lenA = candidate.lenA;
+		const uint32_t lenB = candidate.lenB;
+		const uint32_t iA = candidate.iA;
+		const uint32_t iB = candidate.iB;
+		if (lenB) { // D-rule
+			const vector<vector<DlFlatFormula>>& allParsedConclusions = *genInOut_allParsedConclusions;
+			DlFormulaArena& arena = DlFormulaArena::threadLocal();
+			arena.clear();
+			// NOTE: Variables of the antecedent are shifted behind those of the conditional, so they are distinct even when a formula is unified with itself.
+			uint32_t tB = arena.append(allParsedConclusions[lenB][iB]);
+			uint32_t tA = arena.append(allParsedConclusions[lenA][iA], arena.variableBound);
+			uint32_t conclusionVariant;
+			string conclusion;
+			size_t conclusionSize;
+			if (dRuleUnify_flat(arena, tA, tB, conclusionVariant, conclusion, conclusionSize) && (maxSymbolicConclusionLength == SIZE_MAX || conclusionSize <= maxSymbolicConclusionLength) && (maxSymbolicConsequentLength == SIZE_MAX || checkConsequentLength_flat(arena, conclusionVariant, conclusionSize))) {
+				const vector<vector<string_view>>& allRepresentatives = *genIn_allRepresentativesLookup;
+				string dProof = string("D").append(allRepresentatives[lenB][iB]).append(allRepresentatives[lenA][iA]);
+				emplace(conclusion, dProof);
+			} else
+				invalidCounter++;
+		} else { // N-rule
+			const vector<vector<string_view>>& allConclusions = *genIn_allConclusionsLookup;
+			string_view f = allConclusions[lenA][iA];
+			size_t conclusionSize = 0;
+			// NOTE: All formulas that result from an N-rule start with \nece, i.e. are no conditionals, thus 'maxSymbolicConclusionLength' and 'maxSymbolicConsequentLength' are used in the same way here.
+			if ((maxSymbolicConclusionLength == SIZE_MAX || (conclusionSize = 1 + DlCore::symbolicLen_polishNotation_noRename_numVars(f)) <= maxSymbolicConclusionLength) && (maxSymbolicConsequentLength == SIZE_MAX || (conclusionSize ? conclusionSize : 1 + DlCore::symbolicLen_polishNotation_noRename_numVars(f)) <= maxSymbolicConsequentLength)) {
+				const vector<vector<string_view>>& allRepresentatives = *genIn_allRepresentativesLookup;
+				string dProof = string("N").append(allRepresentatives[lenA][iA]);
+				emplace(string("L").append(f), dProof);
+			} else
+				invalidCounter++;
+		}
+
+		// Show progress if requested
+		if (progressData && progressData->nextStep()) {
+			string percentage;
+			string progress;
+			string etc;
+			if (progressData->nextState(percentage, progress, etc))
+				cout << myTime() << ": Iterated " << percentage << "% of D-proof candidates. [" << progress << "] (" << etc << ")" << endl;
+		}
+	};
+	if (!_checkpointing || _checkpointing->resumePosition < UINT64_MAX) switch (mode) {
 	case DlProofEnumeratorMode::Dynamic:
 		if (!genIn_stack || !genIn_n || !genIn_allRepresentativesLookup)
 			throw invalid_argument("Parameters missing for DlProofEnumeratorMode::Dynamic.");
 		if (progressData)
 			progressData->setStartTime();
-		processCondensedDetachmentProofs_dynamic(*genIn_stack, wordLengthLimit, *genIn_n, *genIn_allRepresentativesLookup, process, _necessitationLimit, candidateQueueCapacities);
+		processCondensedDetachmentProofs_dynamic(*genIn_stack, wordLengthLimit, *genIn_n, *genIn_allRepresentativesLookup, process, _necessitationLimit, candidateQueueCapacities, optOut_workerIdleTimes, _checkpointing);
 		break;
 	case DlProofEnumeratorMode::FromConclusionStrings:
 		if (!genIn_n || !genIn_allRepresentativesLookup || !genIn_allConclusionsLookup)
@@ -4511,49 +5710,31 @@ void DlProofEnumerator::_collectProvenFormulas(tbb::concurrent_hash_map<string,
 			throw invalid_argument("Can only process single increase for DlProofEnumeratorMode::FromConclusionStrings.");
 		if (progressData)
 			progressData->setStartTime();
-		processCondensedDetachmentProofs_dynamic( { }, wordLengthLimit, *genIn_n, *genIn_allRepresentativesLookup, [&representativeProofs, &progressData, &maxSymbolicConclusionLength, &maxSymbolicConsequentLength, &counter, &invalidCounter, &handleEmplacement, &parseRuleSequence, &dRuleUnify, &checkConsequentLength, &genIn_allRepresentativesLookup, &genIn_allConclusionsLookup](string& sequence) {
+		processCondensedDetachmentProofs_useConclusions(*genIn_n, *genIn_allRepresentativesLookup, *genIn_allConclusionsLookup, [&progressData, &maxSymbolicConclusionLength, &maxSymbolicConsequentLength, &counter, &invalidCounter, &emplace, &checkConsequentLength_polishNotation, &genIn_allRepresentativesLookup, &genIn_allConclusionsLookup](const DlRuleCandidate& candidate) {
 			// auto process_useConclusionStrings
 			counter++;
-			auto distinguishVariables = [](shared_ptr<DlFormula>& f) {
-				vector<string> vars = DlCore::primitivesOfFormula_ordered(f);
-				map<string, shared_ptr<DlFormula>> substitutions;
-				for (const string& v : vars)
-					substitutions.emplace(v, make_shared<DlFormula>(make_shared<String>(v + "_")));
-				f = DlCore::substitute(f, substitutions);
-			};
-			const vector<vector<string>>& allConclusions = *genIn_allConclusionsLookup;
-			size_t lenA, lenB, iA, iB;
-			if (parseRuleSequence(sequence, lenA, iA, &lenB, &iB)) { // D-rule
-				const string& fA = allConclusions[lenA][iA];
-				const string& fB = allConclusions[lenB][iB];
-				shared_ptr<DlFormula> tA;
-				shared_ptr<DlFormula> tB;
-				if (!DlCore::fromPolishNotation_noRename(tA, fA))
-					throw domain_error("Could not parse \"" + fA + "\" as a formula in dotted Polish notation.");
-				distinguishVariables(tA);
-				if (!DlCore::fromPolishNotation_noRename(tB, fB))
-					throw domain_error("Could not parse \"" + fB + "\" as a formula in dotted Polish notation.");
-				shared_ptr<DlFormula> conclusionVariant;
+			const vector<vector<string_view>>& allConclusions = *genIn_allConclusionsLookup;
+			const uint32_t lenA = candidate.lenA;
+			const uint32_t lenB = candidate.lenB;
+			const uint32_t iA = candidate.iA;
+			const uint32_t iB = candidate.iB;
+			if (lenB) { // D-rule
 				string conclusion;
-				size_t conclusionSize;
-				if (dRuleUnify(tA, tB, conclusionVariant, conclusion, conclusionSize) && (maxSymbolicConclusionLength == SIZE_MAX || conclusionSize <= maxSymbolicConclusionLength) && (maxSymbolicConsequentLength == SIZE_MAX || checkConsequentLength(conclusionVariant, conclusionSize))) {
-					const vector<vector<string>>& allRepresentatives = *genIn_allRepresentativesLookup;
-					string dProof = "D" + allRepresentatives[lenB][iB] + allRepresentatives[lenA][iA];
-					tbb::concurrent_hash_map<string, string>::accessor wAcc;
-					bool isNew = representativeProofs.emplace(wAcc, conclusion, dProof);
-					handleEmplacement(wAcc, isNew, dProof);
+				size_t conclusionSize = 0;
+				if (DlCore::condensedDetachment_polishNotation_noRename_numVars(allConclusions[lenA][iA], allConclusions[lenB][iB], conclusion) && (maxSymbolicConclusionLength == SIZE_MAX || (conclusionSize = DlCore::symbolicLen_polishNotation_noRename_numVars(conclusion)) <= maxSymbolicConclusionLength) && (maxSymbolicConsequentLength == SIZE_MAX || checkConsequentLength_polishNotation(conclusion, conclusionSize))) {
+					const vector<vector<string_view>>& allRepresentatives = *genIn_allRepresentativesLookup;
+					string dProof = string("D").append(allRepresentatives[lenB][iB]).append(allRepresentatives[lenA][iA]);
+					emplace(conclusion, dProof);
 				} else
 					invalidCounter++;
 			} else { // N-rule
-				const string& f = allConclusions[lenA][iA];
+				string_view f = allConclusions[lenA][iA];
 				size_t conclusionSize = 0;
 				// NOTE: All formulas that result from an N-rule start with \nece, i.e. are no conditionals, thus 'maxSymbolicConclusionLength' and 'maxSymbolicConsequentLength' are used in the same way here.
 				if ((maxSymbolicConclusionLength == SIZE_MAX || (conclusionSize = 1 + DlCore::symbolicLen_polishNotation_noRename_numVars(f)) <= maxSymbolicConclusionLength) && (maxSymbolicConsequentLength == SIZE_MAX || (conclusionSize ? conclusionSize : 1 + DlCore::symbolicLen_polishNotation_noRename_numVars(f)) <= maxSymbolicConsequentLength)) {
-					const vector<vector<string>>& allRepresentatives = *genIn_allRepresentativesLookup;
-					string dProof = "N" + allRepresentatives[lenA][iA];
-					tbb::concurrent_hash_map<string, string>::accessor wAcc;
-					bool isNew = representativeProofs.emplace(wAcc, "L" + f, dProof);
-					handleEmplacement(wAcc, isNew, dProof);
+					const vector<vector<string_view>>& allRepresentatives = *genIn_allRepresentativesLookup;
+					string dProof = string("N").append(allRepresentatives[lenA][iA]);
+					emplace(string("L").append(f), dProof);
 				} else
 					invalidCounter++;
 			}
@@ -4566,7 +5747,7 @@ void DlProofEnumerator::_collectProvenFormulas(tbb::concurrent_hash_map<string,
 				if (progressData->nextState(percentage, progress, etc))
 					cout << myTime() << ": Iterated " << percentage << "% of D-proof candidates. [" << progress << "] (" << etc << ")" << endl;
 			}
-		}, _necessitationLimit, candidateQueueCapacities, genIn_allConclusionsLookup);
+		}, _necessitationLimit, nullptr, nullptr, optOut_workerIdleTimes, _checkpointing, thread::hardware_concurrency(), partition, skip);
 		break;
 	case DlProofEnumeratorMode::FromConclusionTrees:
 		if (!genIn_n || !genIn_allRepresentativesLookup || !genIn_allConclusionsLookup || !genInOut_allParsedConclusions)
@@ -4575,125 +5756,628 @@ void DlProofEnumerator::_collectProvenFormulas(tbb::concurrent_hash_map<string,
 			throw invalid_argument("Can only process single increase for DlProofEnumeratorMode::FromConclusionTrees.");
 		if (progressData)
 			progressData->setStartTime();
-		processCondensedDetachmentProofs_dynamic( { }, wordLengthLimit, *genIn_n, *genIn_allRepresentativesLookup, [&representativeProofs, &progressData, &maxSymbolicConclusionLength, &maxSymbolicConsequentLength, &counter, &invalidCounter, &handleEmplacement, &parseRuleSequence, &dRuleUnify, &checkConsequentLength, &genIn_allRepresentativesLookup, &genIn_allConclusionsLookup, &genInOut_allParsedConclusions](string& sequence) {
-			// auto process_useConclusionTrees
-			counter++;
-			size_t lenA, lenB, iA, iB;
-			if (parseRuleSequence(sequence, lenA, iA, &lenB, &iB)) { // D-rule
-				const vector<vector<shared_ptr<DlFormula>>>& allParsedConclusions = *genInOut_allParsedConclusions;
-				const shared_ptr<DlFormula>& tA = allParsedConclusions[lenA][iA];
-				const shared_ptr<DlFormula>& tB = allParsedConclusions[lenB][iB];
-				// For special case: When lenA == lenB and iA == iB, a formula is unified with itself, thus there needs to be an extra separation of variables.
-				shared_ptr<DlFormula> _distinguishedFormula;
-				auto distinguishVariables = [&](const shared_ptr<DlFormula>& f) -> const shared_ptr<DlFormula>& {
-					vector<string> vars = DlCore::primitivesOfFormula_ordered(f);
-					map<string, shared_ptr<DlFormula>> substitutions;
-					for (const string& v : vars)
-						substitutions.emplace(v, make_shared<DlFormula>(make_shared<String>(v + "_")));
-					_distinguishedFormula = DlCore::substitute(f, substitutions);
-					return _distinguishedFormula;
-				};
-				shared_ptr<DlFormula> conclusionVariant;
-				string conclusion;
-				size_t conclusionSize;
-				if (dRuleUnify(lenA == lenB && iA == iB ? distinguishVariables(tA) : tA, tB, conclusionVariant, conclusion, conclusionSize) && (maxSymbolicConclusionLength == SIZE_MAX || conclusionSize <= maxSymbolicConclusionLength) && (maxSymbolicConsequentLength == SIZE_MAX || checkConsequentLength(conclusionVariant, conclusionSize))) {
-					const vector<vector<string>>& allRepresentatives = *genIn_allRepresentativesLookup;
-					string dProof = "D" + allRepresentatives[lenB][iB] + allRepresentatives[lenA][iA];
-					tbb::concurrent_hash_map<string, string>::accessor wAcc;
-					bool isNew = representativeProofs.emplace(wAcc, conclusion, dProof);
-					handleEmplacement(wAcc, isNew, dProof);
-				} else
-					invalidCounter++;
-			} else { // N-rule
-				const vector<vector<string>>& allConclusions = *genIn_allConclusionsLookup;
-				const string& f = allConclusions[lenA][iA];
-				size_t conclusionSize = 0;
-				// NOTE: All formulas that result from an N-rule start with \nece, i.e. are no conditionals, thus 'maxSymbolicConclusionLength' and 'maxSymbolicConsequentLength' are used in the same way here.
-				if ((maxSymbolicConclusionLength == SIZE_MAX || (conclusionSize = 1 + DlCore::symbolicLen_polishNotation_noRename_numVars(f)) <= maxSymbolicConclusionLength) && (maxSymbolicConsequentLength == SIZE_MAX || (conclusionSize ? conclusionSize : 1 + DlCore::symbolicLen_polishNotation_noRename_numVars(f)) <= maxSymbolicConsequentLength)) {
-					const vector<vector<string>>& allRepresentatives = *genIn_allRepresentativesLookup;
-					string dProof = "N" + allRepresentatives[lenA][iA];
-					tbb::concurrent_hash_map<string, string>::accessor wAcc;
-					bool isNew = representativeProofs.emplace(wAcc, "L" + f, dProof);
-					handleEmplacement(wAcc, isNew, dProof);
+		processCondensedDetachmentProofs_useConclusions(*genIn_n, *genIn_allRepresentativesLookup, *genIn_allConclusionsLookup, process_useConclusionTrees, _necessitationLimit, genInOut_allParsedConclusions, genInOut_allParsedConclusions_init, optOut_workerIdleTimes, _checkpointing, thread::hardware_concurrency(), partition, skip);
+		break;
+	case DlProofEnumeratorMode::FromGroupedConclusionTrees:
+		if (!genIn_n || !genIn_allRepresentativesLookup || !genIn_allConclusionsLookup || !genInOut_allParsedConclusions)
+			throw invalid_argument("Parameters missing for DlProofEnumeratorMode::FromGroupedConclusionTrees.");
+		if (*genIn_n + (_necessitationLimit ? 1 : 2) != wordLengthLimit)
+			throw invalid_argument("Can only process single increase for DlProofEnumeratorMode::FromGroupedConclusionTrees.");
+		if (progressData)
+			progressData->setStartTime();
+		processCondensedDetachmentProofs_useConclusions(*genIn_n, *genIn_allRepresentativesLookup, *genIn_allConclusionsLookup, [&](const DlRuleCandidateRange& range) {
+			// NOTE: Conditionals of a group have equal antecedents up to variable renaming, so their parsed antecedents have equal node layouts (and only differ in variable IDs). Therefore, a minor premise
+			//       is unified only with the antecedent of the group's first conditional (within the range), and the consequents of further conditionals of the group are appended with their antecedents'
+			//       variables translated accordingly (and their other variables shifted behind all others), such that the unifier applies to them as well. Resulting conclusions are variants of those
+			//       from individual unification (since most general unifiers are unique up to variable renaming), i.e. equal after renaming variables in order of their first occurrences.
+			DlRuleCandidate candidate = range.first;
+			if (!candidate.lenB || !range.groupsB) {
+				if (range.indicesB)
+					for (uint32_t p = range.first.iB; p < range.end; p++) {
+						candidate.iB = range.indicesB[p];
+						process_useConclusionTrees(candidate);
+					}
+				else
+					for (uint32_t& i = candidate.lenB ? candidate.iB : candidate.iA; i < range.end; i++)
+						process_useConclusionTrees(candidate);
+				return;
+			}
+			const vector<vector<DlFlatFormula>>& allParsedConclusions = *genInOut_allParsedConclusions;
+			const vector<vector<string_view>>& allRepresentatives = *genIn_allRepresentativesLookup;
+			const uint32_t lenA = candidate.lenA;
+			const uint32_t lenB = candidate.lenB;
+			const uint32_t iA = candidate.iA;
+			DlFormulaArena& arena = DlFormulaArena::threadLocal();
+			thread_local vector<uint32_t> substitutions;
+			thread_local vector<uint32_t> translation; // variable IDs of a conditional's antecedent -> variable IDs of the group's first antecedent
+			for (uint32_t p = range.first.iB; p < range.end;) {
+				uint32_t q = p + 1;
+				while (q < range.end && range.groupsB[q] == range.groupsB[p])
+					q++;
+				const DlFlatFormula& first = allParsedConclusions[lenB][range.indicesB[p]];
+				arena.clear();
+				// NOTE: Variables of the antecedent are shifted behind those of the conditional, so they are distinct even when a formula is unified with itself.
+				uint32_t tB = arena.append(first);
+				uint32_t tA = arena.append(allParsedConclusions[lenA][iA], arena.variableBound);
+				bool unified = DlCore::tryUnifyTrees(arena, tA, arena.nodes[tB].data[0], substitutions);
+				const uint32_t freshOffset = arena.variableBound;
+				const size_t sharedSize = arena.nodes.size();
+				for (uint32_t r = p; r < q; r++) {
+					counter++;
+					const uint32_t iB = range.indicesB[r];
+					if (unified) {
+						uint32_t consequent;
+						if (r == p)
+							consequent = arena.nodes[tB].data[1];
+						else { // append the consequent, i.e. nodes [0, root.data[1]], with translated variables (see DlCore::fromPolishNotation_noRename() for the layout)
+							arena.nodes.resize(sharedSize);
+							const DlFlatFormula& formulaB = allParsedConclusions[lenB][iB];
+							const uint32_t consequentEnd = formulaB.back().data[1] + 1;
+							const uint32_t antecedentOffset = first.back().data[1] + 1;
+							translation.clear();
+							for (uint32_t j = consequentEnd; j + 1 < formulaB.size(); j++) {
+								const DlFlatNode& node = formulaB[j];
+								const DlFlatNode& firstNode = first[antecedentOffset + j - consequentEnd];
+								if (node.symbol != firstNode.symbol)
+									throw logic_error("DlProofEnumerator::_collectProvenFormulas(): Antecedents of group " + to_string(range.groupsB[r]) + " differ in structure.");
+								if (!node.symbol) {
+									if (node.data[0] >= translation.size())
+										translation.resize(node.data[0] + 1, UINT32_MAX);
+									translation[node.data[0]] = firstNode.data[0];
+								}
+							}
+							uint32_t base = static_cast<uint32_t>(arena.nodes.size());
+							for (uint32_t j = 0; j < consequentEnd; j++) {
+								const DlFlatNode& node = formulaB[j];
+								if (node.symbol)
+									arena.addOperator(node.symbol, node.arity, node.data[0] + base, node.data[1] + base);
+								else
+									arena.addVariable(node.data[0] < translation.size() && translation[node.data[0]] != UINT32_MAX ? translation[node.data[0]] : freshOffset + node.data[0]);
+							}
+							consequent = static_cast<uint32_t>(arena.nodes.size() - 1);
+						}
+						uint32_t conclusionVariant = DlCore::substitute(arena, consequent, substitutions); // variable names may be incorrect
+						string conclusion = DlCore::toPolishNotation_numVars(arena, conclusionVariant);
+						size_t conclusionSize = arena.symbolicLength(conclusionVariant);
+						if ((maxSymbolicConclusionLength == SIZE_MAX || conclusionSize <= maxSymbolicConclusionLength) && (maxSymbolicConsequentLength == SIZE_MAX || checkConsequentLength_flat(arena, conclusionVariant, conclusionSize))) {
+							string dProof = string("D").append(allRepresentatives[lenB][iB]).append(allRepresentatives[lenA][iA]);
+							emplace(conclusion, dProof);
+						} else
+							invalidCounter++;
+					} else
+						invalidCounter++;
+
+					// Show progress if requested
+					if (progressData && progressData->nextStep()) {
+						string percentage;
+						string progress;
+						string etc;
+						if (progressData->nextState(percentage, progress, etc))
+							cout << myTime() << ": Iterated " << percentage << "% of D-proof candidates. [" << progress << "] (" << etc << ")" << endl;
+					}
+				}
+				p = q;
+			}
+		}, _necessitationLimit, genInOut_allParsedConclusions, genInOut_allParsedConclusions_init, optOut_workerIdleTimes, _checkpointing, thread::hardware_concurrency(), partition, skip, true);
+		break;
+	case DlProofEnumeratorMode::Naive:
+		if (progressData)
+			progressData->setStartTime();
+		processCondensedDetachmentProofs_naive(wordLengthLimit, process, candidateQueueCapacities, optOut_workerIdleTimes, _checkpointing);
+		break;
+	}
+	if (checkpoints && checkpointing.resumePosition < UINT64_MAX)
+		checkpointing.fCheckpoint(UINT64_MAX);
+	if (spill)
+		spill->merge(handleEmplacement);
+	if (optOut_counter)
+		*optOut_counter = counter;
+	if (optOut_conclusionCounter)
+		*optOut_conclusionCounter = conclusionCounter;
+	if (optOut_redundantCounter)
+		*optOut_redundantCounter = redundantCounter;
+	if (optOut_invalidCounter)
+		*optOut_invalidCounter = invalidCounter;
+	if (optOut_skippedCounter)
+		*optOut_skippedCounter = skippedCounter;
+	if (optOut_subsumedCounter)
+		*optOut_subsumedCounter = subsumedCounter;
+}
+
+bool DlProofEnumerator::_writeCollectionCheckpoint(const string& file, const vector<uint64_t>& settings, const DlCollectionCheckpoint& checkpoint, const DlConclusionStore& representativeProofs, uint32_t wordLengthLimit) {
+	// NOTE: Format (in native byte order): "pmGenChk", uint32 version, uint32 amount of settings, uint64 settings, uint64 checkpoint values, uint64 amount of entries, and entries of uint32-prefixed conclusions and D-proofs.
+	//       Only conclusions of the collected proof length are stored, since all others are loaded from proof files. The file is written to a temporary location first, so an existing checkpoint remains intact
+	//       in case the process is killed while writing. Version 2 addresses tiles of candidates (rather than groups of consecutive 1st inputs) by its position.
+	filesystem::path path = filesystem::u8path(file);
+	filesystem::path tmpPath = filesystem::u8path(file + ".tmp");
+	if (!filesystem::exists(path) && !FctHelper::ensureDirExists(path.string()))
+		return false;
+	{
+		ofstream fout(tmpPath, fstream::out | fstream::binary);
+		if (!fout)
+			return false;
+		auto writeUInt = [&](auto value) { fout.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+		auto writeString = [&](string_view str) { writeUInt(static_cast<uint32_t>(str.length())); fout.write(str.data(), str.length()); };
+		fout.write("pmGenChk", 8);
+		writeUInt(uint32_t(2));
+		writeUInt(static_cast<uint32_t>(settings.size()));
+		for (uint64_t setting : settings)
+			writeUInt(setting);
+		for (uint64_t value : { checkpoint.position, checkpoint.counter, checkpoint.conclusionCounter, checkpoint.redundantCounter, checkpoint.invalidCounter })
+			writeUInt(value);
+		uint64_t amount = 0;
+		representativeProofs.forEach([&](string_view, string_view dProof) {
+			if (dProof.length() == wordLengthLimit)
+				amount++;
+		});
+		writeUInt(amount);
+		representativeProofs.forEach([&](string_view conclusion, string_view dProof) {
+			if (dProof.length() == wordLengthLimit) {
+				writeString(conclusion);
+				writeString(dProof);
+			}
+		});
+		if (!fout.flush())
+			return false;
+	}
+	error_code ec;
+	filesystem::rename(tmpPath, path, ec);
+	return !ec;
+}
+
+bool DlProofEnumerator::_readCollectionCheckpoint(const string& file, const vector<uint64_t>& settings, DlCollectionCheckpoint& checkpoint, DlConclusionStore& representativeProofs, string& error) {
+	string content;
+	if (!FctHelper::readFile(file, content)) {
+		error = "file not readable";
+		return false;
+	}
+	string::size_type pos = 8;
+	auto readUInt = [&](auto& value) { if (content.length() - pos < sizeof(value)) return false; memcpy(&value, content.data() + pos, sizeof(value)); pos += sizeof(value); return true; };
+	auto readString = [&](string_view& str) { uint32_t length; if (!readUInt(length) || content.length() - pos < length) return false; str = string_view(content.data() + pos, length); pos += length; return true; };
+	uint32_t version;
+	uint32_t settingsAmount;
+	if (content.compare(0, 8, "pmGenChk") || !readUInt(version) || version != 2 || !readUInt(settingsAmount)) {
+		error = "unknown format";
+		return false;
+	}
+	for (uint32_t i = 0; i < settingsAmount; i++) {
+		uint64_t setting;
+		if (!readUInt(setting) || settingsAmount != settings.size() || setting != settings[i]) {
+			error = "different settings";
+			return false;
+		}
+	}
+	DlCollectionCheckpoint result;
+	uint64_t amount;
+	if (!readUInt(result.position) || !readUInt(result.counter) || !readUInt(result.conclusionCounter) || !readUInt(result.redundantCounter) || !readUInt(result.invalidCounter) || !readUInt(amount)) {
+		error = "truncated file";
+		return false;
+	}
+	vector<pair<string_view, string_view>> entries; // NOTE: Verify everything before modifying 'representativeProofs'.
+	for (uint64_t i = 0; i < amount; i++) {
+		string_view conclusion;
+		string_view dProof;
+		if (!readString(conclusion) || !readString(dProof)) {
+			error = "truncated file";
+			return false;
+		}
+		entries.emplace_back(conclusion, dProof);
+	}
+	for (const pair<string_view, string_view>& p : entries)
+		representativeProofs.emplace(p.first, p.second, true);
+	checkpoint = result;
+	return true;
+}
+
+bool DlProofEnumerator::_writeFilterCheckpoint(const string& file, const vector<uint64_t>& settings, const vector<array<uint64_t, 2>>& completed, const IndexBitmap& redundant) {
+	// NOTE: Format (in native byte order): "pmGenChk", uint32 version, uint32 amount of settings, uint64 settings, uint64 amount of completed ranges, uint64 pairs of completed ranges,
+	//       uint64 length of the encoded redundant indices, and their encoding (see IndexBitmap::encode()). Written to a temporary location first, like collection checkpoints.
+	filesystem::path path = filesystem::u8path(file);
+	filesystem::path tmpPath = filesystem::u8path(file + ".tmp");
+	if (!filesystem::exists(path) && !FctHelper::ensureDirExists(path.string()))
+		return false;
+	{
+		ofstream fout(tmpPath, fstream::out | fstream::binary);
+		if (!fout)
+			return false;
+		auto writeUInt = [&](auto value) { fout.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+		fout.write("pmGenChk", 8);
+		writeUInt(uint32_t(1));
+		writeUInt(static_cast<uint32_t>(settings.size()));
+		for (uint64_t setting : settings)
+			writeUInt(setting);
+		writeUInt(static_cast<uint64_t>(completed.size()));
+		for (const array<uint64_t, 2>& range : completed) {
+			writeUInt(range[0]);
+			writeUInt(range[1]);
+		}
+		string encoding;
+		redundant.encode(0, redundant.size(), encoding);
+		writeUInt(static_cast<uint64_t>(encoding.length()));
+		fout.write(encoding.data(), encoding.length());
+		if (!fout.flush())
+			return false;
+	}
+	error_code ec;
+	filesystem::rename(tmpPath, path, ec);
+	return !ec;
+}
+
+bool DlProofEnumerator::_readFilterCheckpoint(const string& file, const vector<uint64_t>& settings, vector<array<uint64_t, 2>>& completed, IndexBitmap& redundant, string& error) {
+	string content;
+	if (!FctHelper::readFile(file, content)) {
+		error = "file not readable";
+		return false;
+	}
+	string::size_type pos = 8;
+	auto readUInt = [&](auto& value) { if (content.length() - pos < sizeof(value)) return false; memcpy(&value, content.data() + pos, sizeof(value)); pos += sizeof(value); return true; };
+	uint32_t version;
+	uint32_t settingsAmount;
+	if (content.compare(0, 8, "pmGenChk") || !readUInt(version) || version != 1 || !readUInt(settingsAmount)) {
+		error = "unknown format";
+		return false;
+	}
+	for (uint32_t i = 0; i < settingsAmount; i++) {
+		uint64_t setting;
+		if (!readUInt(setting) || settingsAmount != settings.size() || setting != settings[i]) {
+			error = "different settings";
+			return false;
+		}
+	}
+	uint64_t amount;
+	if (!readUInt(amount) || (content.length() - pos) / (2 * sizeof(uint64_t)) < amount) {
+		error = "truncated file";
+		return false;
+	}
+	vector<array<uint64_t, 2>> ranges(amount); // NOTE: Verify everything before modifying 'completed' and 'redundant'.
+	for (array<uint64_t, 2>& range : ranges)
+		if (!readUInt(range[0]) || !readUInt(range[1]) || range[0] >= range[1] || range[1] > redundant.size()) {
+			error = "invalid ranges";
+			return false;
+		}
+	uint64_t length;
+	if (!readUInt(length) || content.length() - pos != length) {
+		error = "truncated file";
+		return false;
+	}
+	IndexBitmap detections(redundant.size());
+	try {
+		detections.merge(0, redundant.size(), string_view(content.data() + pos, length));
+	} catch (const invalid_argument&) {
+		error = "invalid encoding";
+		return false;
+	}
+	completed.insert(completed.end(), ranges.begin(), ranges.end());
+	string encoding;
+	detections.encode(0, detections.size(), encoding);
+	redundant.merge(0, redundant.size(), encoding);
+	return true;
+}
+
+vector<pair<uint32_t, uint32_t>> DlProofEnumerator::_listProofFilesForSearch(const string& filePrefix, uint32_t& unfiltered) {
+	const uint32_t c = _necessitationLimit ? 1 : 2;
+	const size_t maxFileStart = 1 + c * currentRepresentatives().size();
+	vector<pair<uint32_t, uint32_t>> files;
+	string filePostfix = ".txt";
+	unfiltered = 0;
+	for (uint32_t limit = 1; true; limit += c)
+		if (!_proofFileExists(filePrefix + to_string(limit) + filePostfix)) {
+			if (limit >= maxFileStart) {
+				if (!unfiltered) {
+					unfiltered = limit;
+					limit -= c;
+					filePostfix = "-unfiltered" + to_string(unfiltered) + "+" + filePostfix;
 				} else
-					invalidCounter++;
+					break; // remains to generate
 			}
+		} else
+			files.emplace_back(limit, unfiltered);
+	return files;
+}
 
-			// Show progress if requested
-			if (progressData && progressData->nextStep()) {
-				string percentage;
-				string progress;
-				string etc;
-				if (progressData->nextState(percentage, progress, etc))
-					cout << myTime() << ": Iterated " << percentage << "% of D-proof candidates. [" << progress << "] (" << etc << ")" << endl;
+bool DlProofEnumerator::_proofFileExists(const string& file) {
+	return filesystem::exists(file) || filesystem::exists(DlProofArchive::archivePath(file));
+}
+
+unique_ptr<istream> DlProofEnumerator::_openProofFile(const string& file) {
+	if (filesystem::exists(file)) {
+		unique_ptr<ifstream> fin = make_unique<ifstream>(file, fstream::in | fstream::binary);
+		if (!fin->is_open())
+			return nullptr;
+		return fin;
+	}
+	shared_ptr<DlProofArchive> archive = make_shared<DlProofArchive>();
+	string error;
+	if (!archive->open(DlProofArchive::archivePath(file), &error)) {
+		cerr << "Failed to open archive " << DlProofArchive::archivePath(file) << " due to " << error << "." << endl;
+		return nullptr;
+	}
+	return make_unique<DlProofArchive::Stream>(archive);
+}
+
+bool DlProofEnumerator::_forEachLineInChunks(const string& file, const function<void(size_t)>& fInit, const function<bool(size_t, uint64_t, string&)>& fLine, vector<uint64_t>* optOut_lineOffsets, uint64_t* optOut_bytes, unsigned chunkCount) {
+	constexpr uint64_t minChunkSize = 1 << 24;
+	shared_ptr<DlProofArchive> archive;
+	error_code ec;
+	uint64_t size = filesystem::file_size(file, ec);
+	if (ec) { // read from archive (if any)
+		archive = make_shared<DlProofArchive>();
+		string error;
+		if (!archive->open(DlProofArchive::archivePath(file), &error)) {
+			if (error != "missing file")
+				cerr << "Failed to open archive " << DlProofArchive::archivePath(file) << " due to " << error << "." << endl;
+			return false;
+		}
+		size = archive->size();
+	}
+	// NOTE: A line that starts at position p belongs to the range [b, e) with b <= p < e, so each range can find its first line (after the first '\n' from b - 1 on) independently.
+	//       Since 'e' is where the next range begins, a range is complete as soon as it reads a line that starts at or after 'e'.
+	//       For archives, inner range bounds are located one byte after block bounds, so each range starts reading (at b - 1) within its first block, and only the lines
+	//       that cross block bounds are decoded by multiple ranges.
+	size_t n = static_cast<size_t>(max(min(static_cast<uint64_t>(chunkCount), size / minChunkSize), uint64_t(1)));
+	if (archive)
+		n = max(min(n, archive->blockCount()), size_t(1));
+	auto bound = [&](size_t k) { return !archive ? size / n * k + size % n * k / n : k && k < n ? archive->blockOffset(archive->blockCount() * k / n) + 1 : k ? size : 0; };
+	auto openStream = [&]() -> unique_ptr<istream> {
+		if (archive)
+			return make_unique<DlProofArchive::Stream>(archive);
+		unique_ptr<ifstream> fin = make_unique<ifstream>(file, fstream::in | fstream::binary);
+		if (!fin->is_open())
+			return nullptr;
+		return fin;
+	};
+	if (fInit)
+		fInit(n);
+	vector<uint64_t> lineCounts(n);
+	vector<uint64_t> stopPositions(n, UINT64_MAX); // UINT64_MAX: range is complete
+	vector<uint64_t> readBytes(n);
+	atomic<bool> readable = true;
+	tbb::parallel_for(size_t(0), n, [&](size_t k) {
+		unique_ptr<istream> stream = openStream();
+		if (!stream) {
+			readable = false;
+			return;
+		}
+		istream& fin = *stream;
+		uint64_t position = bound(k);
+		uint64_t end = bound(k + 1);
+		string line;
+		if (position) { // skip the rest of the line that contains 'position - 1'
+			fin.seekg(static_cast<streamoff>(position - 1));
+			if (!getline(fin, line))
+				return;
+			position += line.length();
+		}
+		uint64_t begin = position;
+		uint64_t counter = 0;
+		while (position < end && getline(fin, line)) {
+			position += line.length() + 1;
+			if (!fLine(k, counter++, line)) {
+				stopPositions[k] = position;
+				break;
 			}
-		}, _necessitationLimit, candidateQueueCapacities, genIn_allConclusionsLookup, genInOut_allParsedConclusions, genInOut_allParsedConclusions_init);
-		break;
-	case DlProofEnumeratorMode::Naive:
-		if (progressData)
-			progressData->setStartTime();
-		processCondensedDetachmentProofs_naive(wordLengthLimit, process, candidateQueueCapacities);
-		break;
+		}
+		lineCounts[k] = counter;
+		readBytes[k] = min(position, size) - begin;
+	});
+	if (!readable)
+		return false;
+	if (optOut_lineOffsets) {
+		tbb::parallel_for(size_t(0), n - 1, [&](size_t k) { // only lines of preceding ranges are relevant, so the final range can be ignored
+			uint64_t position = stopPositions[k];
+			uint64_t end = bound(k + 1);
+			if (position >= end)
+				return;
+			unique_ptr<istream> stream = openStream();
+			if (!stream)
+				return;
+			istream& fin = *stream;
+			fin.seekg(static_cast<streamoff>(position));
+			uint64_t counter = 1; // the line that starts at 'position'
+			vector<char> buffer(1 << 20);
+			for (uint64_t remaining = end - 1 - position; remaining && fin;) { // a '\n' at 'end - 1' precedes a line of the next range
+				streamsize amount = static_cast<streamsize>(min(remaining, static_cast<uint64_t>(buffer.size())));
+				fin.read(buffer.data(), amount);
+				counter += count(buffer.begin(), buffer.begin() + fin.gcount(), '\n');
+				remaining -= static_cast<uint64_t>(fin.gcount());
+			}
+			lineCounts[k] += counter;
+		});
+		optOut_lineOffsets->assign(n, 0);
+		for (size_t k = 1; k < n; k++)
+			(*optOut_lineOffsets)[k] = (*optOut_lineOffsets)[k - 1] + lineCounts[k - 1];
 	}
-	if (optOut_counter)
-		*optOut_counter = counter;
-	if (optOut_conclusionCounter)
-		*optOut_conclusionCounter = conclusionCounter;
-	if (optOut_redundantCounter)
-		*optOut_redundantCounter = redundantCounter;
-	if (optOut_invalidCounter)
-		*optOut_invalidCounter = invalidCounter;
+	if (optOut_bytes)
+		*optOut_bytes = accumulate(readBytes.begin(), readBytes.end(), uint64_t(0));
+	return true;
 }
 
-void DlProofEnumerator::_removeRedundantConclusionsForProofsOfMaxLength(const uint32_t maxLength, tbb::concurrent_hash_map<string, string>& representativeProofs, ProgressData* const progressData, uint64_t& conclusionCounter, uint64_t& redundantCounter) {
-	//#chrono::time_point<chrono::steady_clock> startTime = chrono::steady_clock::now();
-	tbb::concurrent_map<size_t, tbb::concurrent_vector<const string*>> formulasByStandardLength;
-	tbb::parallel_for(representativeProofs.range(), [&formulasByStandardLength](tbb::concurrent_hash_map<string, string>::range_type& range) {
-		for (tbb::concurrent_hash_map<string, string>::const_iterator it = range.begin(); it != range.end(); ++it) {
-			const string& formula = it->first;
-			formulasByStandardLength[DlCore::standardLen_polishNotation_noRename_numVars(formula)].push_back(&formula);
+bool DlProofEnumerator::_readProofFilesForIndex(const string& searchPath, const vector<pair<uint32_t, uint32_t>>& files, const function<void(size_t, uint64_t, uint64_t, const string&)>& fLine, const function<void(size_t, uint64_t, int64_t, bool, uint64_t)>& fFile, bool debug) {
+	mutex mtx_cout;
+	atomic<bool> readable = true;
+	tbb::parallel_for(size_t(0), files.size(), [&](size_t k) {
+		chrono::time_point<chrono::steady_clock> startTime = chrono::steady_clock::now();
+		uint32_t wordLengthLimit = files[k].first;
+		string filePostfix = (files[k].second ? "-unfiltered" + to_string(files[k].second) + "+" : "") + ".txt";
+		string file = searchPath + "dProofs" + to_string(wordLengthLimit) + filePostfix;
+		bool archived = !filesystem::exists(file);
+		filesystem::path path = filesystem::u8path(archived ? DlProofArchive::archivePath(file) : file);
+		error_code ec;
+		uint64_t size = filesystem::file_size(path, ec);
+		int64_t time = ec ? 0 : static_cast<int64_t>(filesystem::last_write_time(path, ec).time_since_epoch().count()); // NOTE: Taken before reading, so that modifications during reading outdate the index.
+		unique_ptr<istream> stream = ec ? nullptr : _openProofFile(file);
+		if (!stream) {
+			readable = false;
+			return;
+		}
+		istream& fin = *stream;
+		string line;
+		uint64_t position = 0;
+		uint64_t lineIndex = 0;
+		while (getline(fin, line)) {
+			if (line.length() < wordLengthLimit + 2)
+				throw domain_error("Erroneous proof file at \"" + file + "\": Line " + to_string(lineIndex + 1) + " (\"" + line + "\") too short.");
+			if (line[wordLengthLimit] != ':')
+				throw domain_error("Erroneous proof file at \"" + file + "\": Line " + to_string(lineIndex + 1) + " (\"" + line + "\") should contain ':' at index " + to_string(wordLengthLimit) + ".");
+			fLine(k, lineIndex, position, line);
+			position += line.length() + 1;
+			lineIndex++;
+		}
+		fFile(k, size, time, archived, lineIndex);
+		if (debug) {
+			chrono::microseconds dur = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime);
+			stringstream ss;
+			ss << FctHelper::durationStringMs(dur) << " taken to load and index " << lineIndex << " line" << (lineIndex == 1 ? "" : "s") << " from 'dProofs" << wordLengthLimit << filePostfix << "' (" << throughputString(position, dur) << "). [tid:" << this_thread::get_id() << "]";
+			lock_guard<mutex> lock(mtx_cout);
+			cout << ss.str() << endl;
+		}
+	});
+	return readable;
+}
+
+bool DlProofEnumerator::_createSearchIndex(const string& searchPath, const vector<pair<uint32_t, uint32_t>>& files, bool debug) {
+	chrono::time_point<chrono::steady_clock> startTime = chrono::steady_clock::now();
+	constexpr uint32_t lineStep = DlProofIndex::defaultLineStep;
+	vector<DlProofIndex::FileRecord> records(files.size());
+	vector<vector<uint64_t>> fileLineOffsets(files.size());
+	vector<vector<DlProofIndex::Entry>> fileConclusions(files.size());
+	vector<vector<DlProofIndex::Entry>> fileDProofs(files.size());
+
+	// 1. Read files.
+	if (!_readProofFilesForIndex(searchPath, files, [&](size_t k, uint64_t lineIndex, uint64_t position, const string& line) {
+		uint32_t wordLengthLimit = files[k].first;
+		if (lineIndex % lineStep == 0)
+			fileLineOffsets[k].push_back(position);
+		string_view content(line);
+		uint64_t location = DlProofIndex::location(k, lineIndex);
+		fileConclusions[k].push_back(DlProofIndex::Entry { DlProofIndex::fingerprint(content.substr(wordLengthLimit + 1)), location });
+		fileDProofs[k].push_back(DlProofIndex::Entry { DlProofIndex::fingerprint(content.substr(0, wordLengthLimit)), location });
+	}, [&](size_t k, uint64_t size, int64_t time, bool archived, uint64_t lineCount) {
+		records[k] = DlProofIndex::FileRecord { files[k].first, files[k].second, archived ? 1u : 0u, 0, size, time, lineCount, 0 };
+	}, debug))
+		return false;
+
+	// 2. Merge and sort entries.
+	vector<uint64_t> lineOffsets;
+	vector<DlProofIndex::Entry> conclusions;
+	vector<DlProofIndex::Entry> dProofs;
+	for (size_t k = 0; k < files.size(); k++) {
+		records[k].firstOffset = lineOffsets.size();
+		lineOffsets.insert(lineOffsets.end(), fileLineOffsets[k].begin(), fileLineOffsets[k].end());
+		conclusions.insert(conclusions.end(), fileConclusions[k].begin(), fileConclusions[k].end());
+		dProofs.insert(dProofs.end(), fileDProofs[k].begin(), fileDProofs[k].end());
+		vector<DlProofIndex::Entry>().swap(fileConclusions[k]);
+		vector<DlProofIndex::Entry>().swap(fileDProofs[k]);
+	}
+	tbb::parallel_sort(conclusions.begin(), conclusions.end());
+	tbb::parallel_sort(dProofs.begin(), dProofs.end());
+
+	// 3. Save index.
+	string indexFile = DlProofIndex::indexPath(searchPath);
+	size_t bytes = DlProofIndex::write(indexFile, records, lineOffsets, conclusions, dProofs, _customAxiomsHash, lineStep);
+	if (!bytes) {
+		cerr << "Failed to write lookup index to " << indexFile << "." << endl;
+		return false;
+	}
+	cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to index " << conclusions.size() << " lines of " << files.size() << " proof file" << (files.size() == 1 ? "" : "s") << " and to save " << bytes << " bytes of lookup index data to " << indexFile << "." << endl;
+	return true;
+}
+
+void DlProofEnumerator::_writeProofFileCompanion(const string& file, const vector<string_view>& dProofs, const vector<string_view>* conclusions) {
+	chrono::time_point<chrono::steady_clock> startTime = chrono::steady_clock::now();
+	string binaryFile = DlProofFile::companionPath(file);
+	size_t bytes = DlProofFile::write(file, dProofs, conclusions, _customAxiomsHash);
+	if (bytes)
+		cout << FctHelper::durationStringMs(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime)) << " taken to save " << bytes << " bytes of binary proof data to " << binaryFile << "." << endl;
+	else
+		cerr << "Failed to write binary proof data to " << binaryFile << "." << endl;
+}
+
+shared_ptr<const void> DlProofEnumerator::_readProofFileCompanion(const string& file, vector<string_view>& contents, vector<string_view>* conclusions, string& error) {
+	error.clear();
+	if (!filesystem::exists(DlProofFile::companionPath(file)))
+		return nullptr;
+	shared_ptr<DlProofFile> proofFile = make_shared<DlProofFile>();
+	if (!proofFile->open(file, _customAxiomsHash, &error))
+		return nullptr;
+	if (conclusions && !proofFile->hasConclusions()) {
+		error = "missing conclusions";
+		return nullptr;
+	}
+	// NOTE: Entries are views into the mapping, which is kept alive by the lookup vectors (see DlProofLookup). So nothing is copied, and pages are only read (and held by the page cache) once they are accessed.
+	size_t n = proofFile->size();
+	contents.resize(n);
+	if (conclusions)
+		conclusions->resize(n);
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, n), [&](const tbb::blocked_range<size_t>& range) {
+		for (size_t i = range.begin(); i != range.end(); i++) {
+			contents[i] = proofFile->dProof(i);
+			if (conclusions)
+				(*conclusions)[i] = proofFile->conclusion(i);
 		}
 	});
+	return proofFile;
+}
+
+void DlProofEnumerator::_removeRedundantConclusionsForProofsOfMaxLength(const uint32_t maxLength, DlConclusionStore& representativeProofs, ProgressData* const progressData, uint64_t& conclusionCounter, uint64_t& redundantCounter, bool useSchemaIndex, bool sameLengthOnly) {
+	//#chrono::time_point<chrono::steady_clock> startTime = chrono::steady_clock::now();
+	DlSchemaIndex schemaIndex;
+	tbb::concurrent_map<size_t, tbb::concurrent_vector<string_view>> formulasByStandardLength; // only for brute-force filtering (without index), which is kept for cross-checking
+	// NOTE: With 'sameLengthOnly', only formulas of proofs of length 'maxLength' are potential schemas, i.e. conclusions with schemas of lower proof lengths must have been rejected already (via online schema removal).
+	if (useSchemaIndex)
+		representativeProofs.forEach([&schemaIndex, &maxLength, &sameLengthOnly](string_view formula, string_view dProof) {
+			if (!sameLengthOnly || dProof.length() == maxLength)
+				schemaIndex.insert(formula);
+		});
+	else
+		representativeProofs.forEach_par([&formulasByStandardLength, &maxLength, &sameLengthOnly](string_view formula, string_view dProof) {
+			if (!sameLengthOnly || dProof.length() == maxLength)
+				formulasByStandardLength[DlCore::standardLen_polishNotation_noRename_numVars(formula)].push_back(formula);
+		});
+	//#if (useSchemaIndex) cout << FctHelper::round(static_cast<long double>(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime).count()) / 1000.0, 2) << " ms taken to index " << schemaIndex.size() << " formulas via " << schemaIndex.nodeCount() << " nodes." << endl;
 	//#cout << FctHelper::round(static_cast<long double>(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime).count()) / 1000.0, 2) << " ms taken to create " << formulasByStandardLength.size() << " class" << (formulasByStandardLength.size() == 1 ? "" : "es") << " of formulas by their standard length." << endl;
-	//#cout << [](tbb::concurrent_map<size_t, tbb::concurrent_vector<const string*>>& m) { stringstream ss; for (const pair<const size_t, tbb::concurrent_vector<const string*>>& p : m) { ss << p.first << ":" << p.second.size() << ", "; } return ss.str(); }(formulasByStandardLength) << endl;
+	//#cout << [](tbb::concurrent_map<size_t, tbb::concurrent_vector<string_view>>& m) { stringstream ss; for (const pair<const size_t, tbb::concurrent_vector<string_view>>& p : m) { ss << p.first << ":" << p.second.size() << ", "; } return ss.str(); }(formulasByStandardLength) << endl;
 	auto iterateFormulasOfStandardLengthUpTo = [&formulasByStandardLength](const size_t upperBound, atomic<bool>& done, const auto& func) {
-		tbb::parallel_for(formulasByStandardLength.range(), [&upperBound, &done, &func](tbb::concurrent_map<size_t, tbb::concurrent_vector<const string*>>::range_type& range) {
-			for (tbb::concurrent_map<size_t, tbb::concurrent_vector<const string*>>::const_iterator it = range.begin(); it != range.end(); ++it)
+		tbb::parallel_for(formulasByStandardLength.range(), [&upperBound, &done, &func](tbb::concurrent_map<size_t, tbb::concurrent_vector<string_view>>::range_type& range) {
+			for (tbb::concurrent_map<size_t, tbb::concurrent_vector<string_view>>::const_iterator it = range.begin(); it != range.end(); ++it)
 				if (done)
 					return;
 				else if (it->first <= upperBound)
-					for (const string* const f : it->second) {
-						func(*f);
+					for (string_view f : it->second) {
+						func(f);
 						if (done)
 							return;
 					}
 		});
 	};
-	tbb::concurrent_unordered_map<const string*, string> toErase;
+	tbb::concurrent_vector<string_view> toErase; // NOTE: Views remain valid after erasure, since DlConclusionStore does not free erased entries (until compaction).
 	if (progressData)
 		progressData->setStartTime();
-	tbb::parallel_for(representativeProofs.range(), [&maxLength, &progressData, &iterateFormulasOfStandardLengthUpTo, &toErase](tbb::concurrent_hash_map<string, string>::range_type& range) {
-		for (tbb::concurrent_hash_map<string, string>::const_iterator it = range.begin(); it != range.end(); ++it) {
-			const string::size_type dProofLen = it->second.length();
-			if (dProofLen == maxLength) {
-				const string& formula = it->first;
-				atomic<bool> redundant = false;
+	representativeProofs.forEach_par([&maxLength, &progressData, &useSchemaIndex, &schemaIndex, &iterateFormulasOfStandardLengthUpTo, &toErase](string_view formula, string_view dProof) {
+		const string::size_type dProofLen = dProof.length();
+		if (dProofLen == maxLength) {
+			atomic<bool> redundant = false;
+			if (useSchemaIndex)
+				redundant = schemaIndex.forEachPotentialSchemaOf(formula, [&formula](string_view potentialSchema) {
+					return formula.data() != potentialSchema.data() && DlCore::isSchemaOf_polishNotation_noRename_numVars_vec(potentialSchema, formula); // formula redundant
+				});
+			else {
 				size_t formulaLen = DlCore::standardLen_polishNotation_noRename_numVars(formula);
-				iterateFormulasOfStandardLengthUpTo(formulaLen, redundant, [&formula, &redundant](const string& potentialSchema) {
+				iterateFormulasOfStandardLengthUpTo(formulaLen, redundant, [&formula, &redundant](string_view potentialSchema) {
 					if (formula != potentialSchema && DlCore::isSchemaOf_polishNotation_noRename_numVars_vec(potentialSchema, formula)) // formula redundant
 						redundant = true;
 				});
-				if (redundant) {
-					toErase.emplace(&it->first, it->first);
+			}
+			if (redundant) {
+				toErase.push_back(formula);
 
-					// Show progress if requested
-					if (progressData && progressData->nextStep()) {
-						string percentage;
-						string progress;
-						string etc;
-						if (progressData->nextState(percentage, progress, etc))
-							cout << myTime() << ": Removed " << percentage << "% of redundant conclusions. [" << progress << "] (" << etc << ")" << endl;
-					}
+				// Show progress if requested
+				if (progressData && progressData->nextStep()) {
+					string percentage;
+					string progress;
+					string etc;
+					if (progressData->nextState(percentage, progress, etc))
+						cout << myTime() << ": Removed " << percentage << "% of redundant conclusions. [" << progress << "] (" << etc << ")" << endl;
 				}
 			}
 		}
@@ -4702,16 +6386,22 @@ void DlProofEnumerator::_removeRedundantConclusionsForProofsOfMaxLength(const ui
 	redundantCounter += toErase.size();
 	//#cout << FctHelper::round(static_cast<long double>(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime).count()) / 1000.0, 2) << " ms taken for data iteration." << endl;
 	//#startTime = chrono::steady_clock::now();
-	tbb::parallel_for(toErase.range(), [&representativeProofs](tbb::concurrent_unordered_map<const string*, string>::range_type& range) {
-		for (tbb::concurrent_unordered_map<const string*, string>::const_iterator it = range.begin(); it != range.end(); ++it)
-			representativeProofs.erase(it->second);
+	tbb::parallel_for(toErase.range(), [&representativeProofs](tbb::concurrent_vector<string_view>::range_type& range) {
+		for (tbb::concurrent_vector<string_view>::const_iterator it = range.begin(); it != range.end(); ++it)
+			representativeProofs.erase(*it);
 	});
 	//#cout << FctHelper::round(static_cast<long double>(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime).count()) / 1000.0, 2) << " ms taken for erasure of " << toErase.size() << " elements." << endl;
+
+	// Release the bytes of erased entries, which requires that no views into the store remain.
+	schemaIndex = DlSchemaIndex();
+	formulasByStandardLength.clear();
+	toErase.clear();
+	representativeProofs.compact();
 }
 
-tbb::concurrent_unordered_set<uint64_t> DlProofEnumerator::_mpi_removeRedundantConclusionsForProofsOfMaxLength(int mpi_rank, int mpi_size, const uint32_t maxLength, tbb::concurrent_hash_map<string, string>& representativeProofs, const vector<string>& recentConclusionSequence, ProgressData* const progressData, bool smoothProgress) {
+IndexBitmap DlProofEnumerator::_mpi_removeRedundantConclusionsForProofsOfMaxLength(int mpi_rank, int mpi_size, const vector<string_view>& conclusions, uint64_t recentBegin, ProgressData* const progressData, bool smoothProgress, bool useSchemaIndex, bool oneSidedBalancing, DlFilterCheckpointing* checkpointing) {
 	bool isMainProc = mpi_rank == 0;
-	size_t n = recentConclusionSequence.size();
+	size_t n = conclusions.size() - recentBegin;
 
 	// Reorders indices according to affine ciphered values (https://en.wikipedia.org/wiki/Affine_cipher),
 	// using a factor with good spectral results (https://en.wikipedia.org/wiki/Spectral_test).
@@ -4726,10 +6416,133 @@ tbb::concurrent_unordered_set<uint64_t> DlProofEnumerator::_mpi_removeRedundantC
 		return v;
 	};
 	//#chrono::time_point<chrono::steady_clock> startTime = chrono::steady_clock::now();
-	const vector<uint64_t> indexDistribution = smoothProgress ? distributeIndices(n) : vector<uint64_t> { };
+	vector<uint64_t> indexDistribution = smoothProgress ? distributeIndices(n) : vector<uint64_t> { };
 	//#if (smoothProgress) cout << "[Rank " + to_string(mpi_rank) + "] " + FctHelper::round(static_cast<long double>(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime).count()) / 1000.0, 2) + " ms taken to prepare index distribution of size " + to_string(n) + "." << endl;
 	// e.g. (..., 27, 29, 31): (..., 18.83, 55.38, 166.21) ms taken to prepare index distribution of size (6649, 19416, 56321, 165223, 490604, 1459555, 4375266, 13194193).
 
+	// Restrict checks to pending positions, i.e. those which are not completed according to checkpoints. Workloads address the pending positions in ascending order, i.e. ranges
+	// of the 'm' pending positions are distributed. For m < n, 'indexDistribution' then maps them to indices (and is non-empty also when 'smoothProgress' is disabled).
+	IndexBitmap redundant(n); // NOTE: Each process registers its own detections, which are gathered by the caller.
+	vector<array<uint64_t, 2>> pending; // ranges [first, end) of pending positions
+	vector<uint64_t> pendingOffsets; // amounts of pending positions before each range
+	uint64_t m = n;
+	if (checkpointing) {
+		uint64_t position = 0;
+		for (const array<uint64_t, 2>& range : checkpointing->completed) {
+			if (position < range[0])
+				pending.push_back( { position, range[0] });
+			position = range[1];
+		}
+		if (position < n)
+			pending.push_back( { position, n });
+		m = 0;
+		for (const array<uint64_t, 2>& range : pending) {
+			pendingOffsets.push_back(m);
+			m += range[1] - range[0];
+		}
+		if (isMainProc && checkpointing->redundant.size() == n) {
+			// NOTE: Known detections at pending positions (i.e. of incomplete workloads) are dropped, since they are detected again, and all processes' detections must be disjoint.
+			redundant = move(checkpointing->redundant);
+			for (const array<uint64_t, 2>& range : pending)
+				tbb::parallel_for(range[0], range[1], [&indexDistribution, &redundant](uint64_t position) { redundant.reset(indexDistribution.empty() ? position : indexDistribution[position]); });
+			if (progressData)
+				progressData->skip(redundant.count());
+		}
+		if (m < n) {
+			vector<uint64_t> pendingIndices(m);
+			tbb::parallel_for(size_t(0), pending.size(), [&](size_t k) {
+				for (uint64_t position = pending[k][0]; position < pending[k][1]; position++)
+					pendingIndices[pendingOffsets[k] + position - pending[k][0]] = indexDistribution.empty() ? position : indexDistribution[position];
+			});
+			indexDistribution = move(pendingIndices);
+		}
+	}
+
+	// Register completed workloads (i.e. ranges of pending positions) as ranges of positions, for checkpoints.
+	map<uint64_t, uint64_t> completed; // NOTE: Only accessed by the thread that processes workloads (and by the main thread after that thread is done).
+	if (checkpointing && isMainProc)
+		for (const array<uint64_t, 2>& range : checkpointing->completed)
+			completed.emplace(range[0], range[1]);
+	chrono::time_point<chrono::steady_clock> checkpointTime = chrono::steady_clock::now();
+	auto storeCheckpoint = [&]() {
+		vector<array<uint64_t, 2>> ranges;
+		for (const pair<const uint64_t, uint64_t>& p : completed)
+			ranges.push_back( { p.first, p.second });
+		checkpointing->fCheckpoint(ranges, redundant);
+		checkpointTime = chrono::steady_clock::now();
+	};
+	function<void(uint64_t, uint64_t)> fCompleted;
+	if (checkpointing && checkpointing->fCheckpoint)
+		fCompleted = [&](uint64_t first, uint64_t end) {
+			size_t k = upper_bound(pendingOffsets.begin(), pendingOffsets.end(), first) - pendingOffsets.begin() - 1;
+			for (; first < end; k++) {
+				uint64_t amount = min(end, pendingOffsets[k] + pending[k][1] - pending[k][0]) - first;
+				uint64_t a = pending[k][0] + first - pendingOffsets[k];
+				uint64_t b = a + amount;
+				map<uint64_t, uint64_t>::iterator it = completed.lower_bound(a); // join with adjacent ranges
+				if (it != completed.end() && it->first == b) {
+					b = it->second;
+					it = completed.erase(it);
+				}
+				if (it != completed.begin() && prev(it)->second == a)
+					prev(it)->second = b;
+				else
+					completed.emplace_hint(it, a, b);
+				first += amount;
+			}
+			if (chrono::steady_clock::now() - checkpointTime >= checkpointing->interval)
+				storeCheckpoint();
+		};
+
+	//#startTime = chrono::steady_clock::now();
+	DlSchemaIndex schemaIndex;
+	tbb::concurrent_map<size_t, tbb::concurrent_vector<string_view>> formulasByStandardLength; // only for brute-force filtering (without index), which is kept for cross-checking
+	if (useSchemaIndex)
+		for (string_view formula : conclusions)
+			schemaIndex.insert(formula);
+	else
+		tbb::parallel_for(size_t(0), conclusions.size(), [&conclusions, &formulasByStandardLength](size_t i) {
+			formulasByStandardLength[DlCore::standardLen_polishNotation_noRename_numVars(conclusions[i])].push_back(conclusions[i]);
+		});
+	//#if (isMainProc && useSchemaIndex) cout << FctHelper::round(static_cast<long double>(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime).count()) / 1000.0, 2) + " ms taken to index " + to_string(schemaIndex.size()) + " formulas via " + to_string(schemaIndex.nodeCount()) + " nodes." << endl;
+	//#if (isMainProc) cout << FctHelper::round(static_cast<long double>(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime).count()) / 1000.0, 2) + " ms taken to create " + to_string(formulasByStandardLength.size()) + " class" + (formulasByStandardLength.size() == 1 ? "" : "es") + " of formulas by their standard length." << endl;
+	//#if (isMainProc) cout << [](tbb::concurrent_map<size_t, tbb::concurrent_vector<string_view>>& m) { stringstream ss; for (const pair<const size_t, tbb::concurrent_vector<string_view>>& p : m) { ss << p.first << ":" << p.second.size() << ", "; } return ss.str(); }(formulasByStandardLength) << endl;
+	auto iterateFormulasOfStandardLengthUpTo = [&formulasByStandardLength](const size_t upperBound, atomic<bool>& done, const auto& func) {
+		tbb::parallel_for(formulasByStandardLength.range(), [&upperBound, &done, &func](tbb::concurrent_map<size_t, tbb::concurrent_vector<string_view>>::range_type& range) {
+			for (tbb::concurrent_map<size_t, tbb::concurrent_vector<string_view>>::const_iterator it = range.begin(); it != range.end(); ++it)
+				if (done)
+					return;
+				else if (it->first <= upperBound)
+					for (string_view f : it->second) {
+						func(f);
+						if (done)
+							return;
+					}
+		});
+	};
+	auto isRedundant = [&conclusions, &recentBegin, &useSchemaIndex, &schemaIndex, &iterateFormulasOfStandardLengthUpTo](uint64_t index) -> bool {
+		string_view formula = conclusions[recentBegin + index];
+		atomic<bool> redundant = false;
+		if (useSchemaIndex)
+			redundant = schemaIndex.forEachPotentialSchemaOf(formula, [&formula](string_view potentialSchema) {
+				return formula != potentialSchema && DlCore::isSchemaOf_polishNotation_noRename_numVars_vec(potentialSchema, formula); // formula redundant
+			});
+		else {
+			size_t formulaLen = DlCore::standardLen_polishNotation_noRename_numVars(formula);
+			iterateFormulasOfStandardLengthUpTo(formulaLen, redundant, [&formula, &redundant](string_view potentialSchema) {
+				if (formula != potentialSchema && DlCore::isSchemaOf_polishNotation_noRename_numVars_vec(potentialSchema, formula)) // formula redundant
+					redundant = true;
+			});
+		}
+		return redundant;
+	};
+	if (oneSidedBalancing) {
+		_mpi_detectRedundantIndices_oneSided(mpi_rank, mpi_size, m, indexDistribution, isRedundant, redundant, fCompleted, progressData);
+		if (fCompleted)
+			storeCheckpoint();
+		return redundant;
+	}
+
 	// To register what workload is reservable, and / or to assign a new workload.
 	auto split = [](size_t first, size_t end, array<uint64_t, 2>* reg, array<uint64_t, 2>* load) {
 		// NOTE: The balancing strategy involves to request reservable workloads from other processes when the own workload is complete, and to grant reservable workloads to others whenever they request them.
@@ -4774,8 +6587,8 @@ tbb::concurrent_unordered_set<uint64_t> DlProofEnumerator::_mpi_removeRedundantC
 	atomic<bool> loading = false;
 	//#MPI_Barrier(MPI_COMM_WORLD);
 	for (int rank = 0; rank < mpi_size; rank++) {
-		size_t first = rank * n / mpi_size;
-		size_t end = rank + 1 == mpi_size ? n : (rank + 1) * n / mpi_size; // first index that is not contained
+		size_t first = rank * m / mpi_size;
+		size_t end = rank + 1 == mpi_size ? m : (rank + 1) * m / mpi_size; // first index that is not contained
 		split(first, end, &reservableWorkloads[rank], rank == mpi_rank ? &workload : nullptr); // initialize 'workload' and 'reservableWorkloads'
 		//#if (rank == mpi_rank) cout << "[Rank " + to_string(mpi_rank) + ", n = " + to_string(n) + "] Interval: [" + to_string(first) + ", " + (end ? to_string(end - 1) : "-1") + "] (size " + to_string(end - first) + ")" << endl;
 	}
@@ -4784,31 +6597,7 @@ tbb::concurrent_unordered_set<uint64_t> DlProofEnumerator::_mpi_removeRedundantC
 		int r = 0;
 		cout << "Reservable workloads: " + FctHelper::vectorStringF(reservableWorkloads, [&](const array<uint64_t, 2>& a) { return to_string(r++) + ":[" + (a[0] == UINT64_MAX ? "" : to_string(a[0]) + ", " + (a[1] ? to_string(a[1] - 1) : "-1")) + "]"; }, "{ ", " }") << endl;
 	}
-	//#startTime = chrono::steady_clock::now();
-	tbb::concurrent_map<size_t, tbb::concurrent_vector<const string*>> formulasByStandardLength;
-	tbb::parallel_for(representativeProofs.range(), [&formulasByStandardLength](tbb::concurrent_hash_map<string, string>::range_type& range) {
-		for (tbb::concurrent_hash_map<string, string>::const_iterator it = range.begin(); it != range.end(); ++it) {
-			const string& formula = it->first;
-			formulasByStandardLength[DlCore::standardLen_polishNotation_noRename_numVars(formula)].push_back(&formula);
-		}
-	});
-	//#if (isMainProc) cout << FctHelper::round(static_cast<long double>(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime).count()) / 1000.0, 2) + " ms taken to create " + to_string(formulasByStandardLength.size()) + " class" + (formulasByStandardLength.size() == 1 ? "" : "es") + " of formulas by their standard length." << endl;
-	//#if (isMainProc) cout << [](tbb::concurrent_map<size_t, tbb::concurrent_vector<const string*>>& m) { stringstream ss; for (const pair<const size_t, tbb::concurrent_vector<const string*>>& p : m) { ss << p.first << ":" << p.second.size() << ", "; } return ss.str(); }(formulasByStandardLength) << endl;
-	auto iterateFormulasOfStandardLengthUpTo = [&formulasByStandardLength](const size_t upperBound, atomic<bool>& done, const auto& func) {
-		tbb::parallel_for(formulasByStandardLength.range(), [&upperBound, &done, &func](tbb::concurrent_map<size_t, tbb::concurrent_vector<const string*>>::range_type& range) {
-			for (tbb::concurrent_map<size_t, tbb::concurrent_vector<const string*>>::const_iterator it = range.begin(); it != range.end(); ++it)
-				if (done)
-					return;
-				else if (it->first <= upperBound)
-					for (const string* const f : it->second) {
-						func(*f);
-						if (done)
-							return;
-					}
-		});
-	};
-	tbb::concurrent_queue<uint64_t> toErase;
-	tbb::concurrent_unordered_set<uint64_t> toErase_mainProc;
+	atomic<uint64_t> unreported = 0; // amount of detections that were not yet reported to the main process (for progress)
 	mutex mtx;
 	unique_lock<mutex> condLock(mtx);
 	condition_variable cond;
@@ -4816,9 +6605,12 @@ tbb::concurrent_unordered_set<uint64_t> DlProofEnumerator::_mpi_removeRedundantC
 	atomic<bool> waitTermination = false;
 	atomic<bool> workerDone = false;
 	atomic<uint64_t> localCounter = 0;
+	atomic<uint64_t> busyTime = 0; // in microseconds
+	uint64_t messageCounter = 0; // NOTE: Only the main thread sends messages.
+	chrono::time_point<chrono::steady_clock> startTime = chrono::steady_clock::now();
 	if (progressData)
 		progressData->setStartTime();
-	auto worker = [&recentConclusionSequence, &indexDistribution, &split, &iterateFormulasOfStandardLengthUpTo](int mpi_rank, array<uint64_t, 2>& workload, vector<array<uint64_t, 2>>& reservableWorkloads, mutex& mtx_reservations, atomic<bool>& checkRequests, atomic<bool>& loading, size_t n, bool smoothProgress, bool isMainProc, atomic<uint64_t>& localCounter, condition_variable& cond, atomic<bool>& communicate, atomic<bool>& workerDone, tbb::concurrent_queue<uint64_t>& toErase, tbb::concurrent_unordered_set<uint64_t>& toErase_mainProc, ProgressData* const progressData) {
+	auto worker = [&indexDistribution, &split, &isRedundant, &busyTime, &fCompleted](int mpi_rank, array<uint64_t, 2>& workload, vector<array<uint64_t, 2>>& reservableWorkloads, mutex& mtx_reservations, atomic<bool>& checkRequests, atomic<bool>& loading, bool isMainProc, atomic<uint64_t>& localCounter, condition_variable& cond, atomic<bool>& communicate, atomic<bool>& workerDone, IndexBitmap& redundant, atomic<uint64_t>& unreported, ProgressData* const progressData) {
 		// The main thread also reads and writes 'workload' and 'reservableWorkloads', which thereby require locks.
 		// When 'workload' is modified by the main thread, the worker requested more work and is looping in 'loading' state, so reading it here is fine.
 		uint64_t first = workload[0];
@@ -4855,41 +6647,43 @@ tbb::concurrent_unordered_set<uint64_t> DlProofEnumerator::_mpi_removeRedundantC
 			}
 			return true;
 		};
-		do
-			tbb::parallel_for(first, end, [&recentConclusionSequence, &indexDistribution, &smoothProgress, &isMainProc, &localCounter, &cond, &progressData, &iterateFormulasOfStandardLengthUpTo, &toErase, &toErase_mainProc](size_t i) {
-				uint64_t index = smoothProgress ? indexDistribution[i] : i;
-				const string& formula = recentConclusionSequence[index];
-				atomic<bool> redundant = false;
-				size_t formulaLen = DlCore::standardLen_polishNotation_noRename_numVars(formula);
-				iterateFormulasOfStandardLengthUpTo(formulaLen, redundant, [&formula, &redundant](const string& potentialSchema) {
-					if (formula != potentialSchema && DlCore::isSchemaOf_polishNotation_noRename_numVars_vec(potentialSchema, formula)) // formula redundant
-						redundant = true;
-				});
-				if (redundant) {
-					localCounter++;
-					if (isMainProc)
-						toErase_mainProc.insert(index);
-					else {
-						toErase.push(index);
-						cond.notify_one();
-					}
+		// NOTE: For checkpoints, workloads are processed in blocks, each of which is registered when it is complete.
+		const uint64_t blockSize = fCompleted ? 256 * max(thread::hardware_concurrency(), 1u) : UINT64_MAX;
+		do {
+			for (uint64_t blockFirst = first; blockFirst < end;) {
+				uint64_t blockEnd = end - blockFirst > blockSize ? blockFirst + blockSize : end;
+				chrono::time_point<chrono::steady_clock> startTime = chrono::steady_clock::now();
+				tbb::parallel_for(blockFirst, blockEnd, [&indexDistribution, &isMainProc, &localCounter, &cond, &progressData, &isRedundant, &redundant, &unreported](size_t i) {
+					uint64_t index = indexDistribution.empty() ? i : indexDistribution[i];
+					if (isRedundant(index)) {
+						localCounter++;
+						redundant.set(index);
+						if (!isMainProc) {
+							unreported++;
+							cond.notify_one();
+						}
 
-					// Show progress if requested ; NOTE: Shouldn't be requested for non-main processes.
-					if (progressData && progressData->nextStep()) {
-						string percentage;
-						string progress;
-						string etc;
-						if (progressData->nextState(percentage, progress, etc))
-							cout << myTime() + ": Removed " + percentage + "% of redundant conclusions. [" + progress + "] (" + etc + ")" << endl;
-					}
-				} else if (!isMainProc && !toErase.empty())
-					cond.notify_one();
-			});
-		while (moreWork(first, end));
+						// Show progress if requested ; NOTE: Shouldn't be requested for non-main processes.
+						if (progressData && progressData->nextStep()) {
+							string percentage;
+							string progress;
+							string etc;
+							if (progressData->nextState(percentage, progress, etc))
+								cout << myTime() + ": Removed " + percentage + "% of redundant conclusions. [" + progress + "] (" + etc + ")" << endl;
+						}
+					} else if (!isMainProc && unreported)
+						cond.notify_one();
+				});
+				busyTime += chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime).count();
+				if (fCompleted)
+					fCompleted(blockFirst, blockEnd);
+				blockFirst = blockEnd;
+			}
+		} while (moreWork(first, end));
 		workerDone = true;
 		//#cout << "[Rank " + to_string(mpi_rank) + "] Worker complete." << endl;
 	};
-	thread workerThread(worker, mpi_rank, ref(workload), ref(reservableWorkloads), ref(mtx_reservations), ref(checkRequests), ref(loading), n, smoothProgress, isMainProc, ref(localCounter), ref(cond), ref(communicate), ref(workerDone), ref(toErase), ref(toErase_mainProc), progressData);
+	thread workerThread(worker, mpi_rank, ref(workload), ref(reservableWorkloads), ref(mtx_reservations), ref(checkRequests), ref(loading), isMainProc, ref(localCounter), ref(cond), ref(communicate), ref(workerDone), ref(redundant), ref(unreported), progressData);
 	auto queryTimer = [](bool isMainProc, condition_variable& cond, atomic<bool>& communicate, atomic<bool>& checkRequests) {
 		// Only the main thread should make MPI queries. When not on the main process, the main thread has to be notified whenever communication
 		//  should happen. Each main thread should check for incoming balancing requests from other processes up to 20 times a second.
@@ -4938,6 +6732,7 @@ tbb::concurrent_unordered_set<uint64_t> DlProofEnumerator::_mpi_removeRedundantC
 							split(owned[0], owned[1], &owned, nullptr); // update owned reservable workload
 						} else
 							FctHelper::mpi_sendBool(mpi_rank, false, status.MPI_SOURCE, FctHelper::mpi_tag_custom + mpi_tag_respond_reservation);
+						messageCounter++;
 
 						// Update reservable workload that is owned by the requesting process to empty.
 						array<uint64_t, 2>& reservableInfo = reservableWorkloads[status.MPI_SOURCE];
@@ -4950,6 +6745,7 @@ tbb::concurrent_unordered_set<uint64_t> DlProofEnumerator::_mpi_removeRedundantC
 					MPI_Status status;
 					while (FctHelper::mpi_tryRecvBool(mpi_rank, MPI_ANY_SOURCE, sink, FctHelper::mpi_tag_custom + mpi_tag_request_reservable, &status)) {
 						FctHelper::mpi_sendPairUint64(mpi_rank, owned, status.MPI_SOURCE, FctHelper::mpi_tag_custom + mpi_tag_respond_reservable);
+						messageCounter++;
 
 						// Update reservable workload that is owned by the requesting process to empty.
 						array<uint64_t, 2>& reservableInfo = reservableWorkloads[status.MPI_SOURCE];
@@ -4965,6 +6761,7 @@ tbb::concurrent_unordered_set<uint64_t> DlProofEnumerator::_mpi_removeRedundantC
 						for (int source = 0; source < mpi_size; source++)
 							if (source != mpi_rank && reservableWorkloads[source][0] != UINT64_MAX) {
 								FctHelper::mpi_sendBool(mpi_rank, true, source, FctHelper::mpi_tag_custom + mpi_tag_request_reservable);
+								messageCounter++;
 								pendingSources.insert(source);
 							}
 						needToRequest = false;
@@ -5002,6 +6799,7 @@ tbb::concurrent_unordered_set<uint64_t> DlProofEnumerator::_mpi_removeRedundantC
 							requestedSource = bestSource;
 							requestingWorkload = reservableWorkloads[requestedSource];
 							FctHelper::mpi_sendPairUint64(mpi_rank, requestingWorkload, requestedSource, FctHelper::mpi_tag_custom + mpi_tag_attempt_reservation); // request to transfer workload
+							messageCounter++;
 						} else { // all other processes are done as well
 							workload[0] = UINT64_MAX; // signal to the worker, that there is nothing left to do
 							loading = false; // the worker thread may now continue
@@ -5036,29 +6834,30 @@ tbb::concurrent_unordered_set<uint64_t> DlProofEnumerator::_mpi_removeRedundantC
 	};
 	if (isMainProc) {
 		int numComplete = 0;
-		uint64_t index;
+		uint64_t amount;
 		while (communicate) {
-			while (FctHelper::mpi_tryRecvUint64(mpi_rank, MPI_ANY_SOURCE, index))
-				if (index == UINT64_MAX) // notification that the process is done
+			while (FctHelper::mpi_tryRecvUint64(mpi_rank, MPI_ANY_SOURCE, amount))
+				if (amount == UINT64_MAX) // notification that the process is done
 					numComplete++;
-				else {
-					toErase_mainProc.insert(index);
-
-					// Show progress if requested
-					if (progressData && progressData->nextStep()) {
-						string percentage;
-						string progress;
-						string etc;
-						if (progressData->nextState(percentage, progress, etc))
-							cout << myTime() + ": Removed " + percentage + "% of redundant conclusions. [" + progress + "] (" + etc + ")" << endl;
+				else // amount of detections by the process
+					for (uint64_t k = 0; k < amount; k++) {
+
+						// Show progress if requested
+						if (progressData && progressData->nextStep()) {
+							string percentage;
+							string progress;
+							string etc;
+							if (progressData->nextState(percentage, progress, etc))
+								cout << myTime() + ": Removed " + percentage + "% of redundant conclusions. [" + progress + "] (" + etc + ")" << endl;
+						}
 					}
-				}
 			if (numComplete + 1 == mpi_size) {
 				// NOTE: The MPI standard guarantees that messages are received in the order they are sent ("non-overtaking messages", https://www.mpi-forum.org/docs/mpi-1.1/mpi-11-html/node41.html).
 				//       Therefore, since UINT64_MAX is the last message for each rank, all messages have been received.
 				//#cerr << "[ARNOLD] EVERYONE, SHUT THE FUCK DOWN!" << endl;
 				for (int dest = 1; dest < mpi_size; dest++) // tell everyone to shut down
 					FctHelper::mpi_sendBool(mpi_rank, true, dest, FctHelper::mpi_tag_custom + mpi_tag_terminate);
+				messageCounter += mpi_size - 1;
 				communicate = false;
 			} else if (checkRequests) // timed notification to check for incoming balancing requests from other processes
 				handleBalancingRequests();
@@ -5068,11 +6867,13 @@ tbb::concurrent_unordered_set<uint64_t> DlProofEnumerator::_mpi_removeRedundantC
 	} else
 		while (communicate) {
 			cond.wait(condLock);
-			uint64_t index = 0;
-			while (toErase.try_pop(index)) // send and clear 'toErase'
-				FctHelper::mpi_sendUint64(mpi_rank, index, 0);
-			if (workerDone && !waitTermination && toErase.empty()) {
+			if (uint64_t amount = unreported.exchange(0)) { // report amount of detections (rather than indices, which are gathered later)
+				FctHelper::mpi_sendUint64(mpi_rank, amount, 0);
+				messageCounter++;
+			}
+			if (workerDone && !waitTermination && !unreported) {
 				FctHelper::mpi_sendUint64(mpi_rank, UINT64_MAX, 0); // notify main process that this process is done
+				messageCounter++;
 				waitTermination = true; // stay responsive to balancing requests in order to avoid deadlocks ; communication ends only when the main process says so
 				//#cout << "[Rank " + to_string(mpi_rank) + "] WHERE'S ARNOLD?" << endl;
 			}
@@ -5082,17 +6883,139 @@ tbb::concurrent_unordered_set<uint64_t> DlProofEnumerator::_mpi_removeRedundantC
 	//#cout << "[Rank " + to_string(mpi_rank) + "] Communication complete, waiting for worker to join main thread." << endl;
 	workerThread.join();
 	timerThread.join();
+	chrono::microseconds duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime);
+	mpi_printBalancingStatistics(mpi_rank, mpi_size, "two-sided requests", duration - chrono::microseconds(min(static_cast<uint64_t>(duration.count()), static_cast<uint64_t>(busyTime))), messageCounter);
 	//#if (isMainProc) cout << FctHelper::round(static_cast<long double>(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime).count()) / 1000.0, 2) + " ms taken for data iteration." << endl;
 
 	//#MPI_Barrier(MPI_COMM_WORLD);
 	//#cout << "[Rank " + to_string(mpi_rank) + "] Done. Candidates registered: " + to_string(localCounter) << endl;
-	return toErase_mainProc;
+	if (fCompleted)
+		storeCheckpoint();
+	return redundant;
+}
+
+void DlProofEnumerator::_mpi_detectRedundantIndices_oneSided(int mpi_rank, int mpi_size, uint64_t n, const vector<uint64_t>& indexDistribution, const function<bool(uint64_t)>& isRedundant, IndexBitmap& redundant, const function<void(uint64_t, uint64_t)>& fCompleted, ProgressData* const progressData) {
+	// NOTE: The balancing strategy involves a counter for each process, i.e. the next unclaimed position in its initial range [rank * n / size, (rank + 1) * n / size), in an MPI window.
+	//       Chunks of positions are claimed via atomic fetch-and-add (MPI_Fetch_and_op) on these counters, first on the own counter, then on those of the other processes on the same node,
+	//       and finally on those of all remaining processes. Since claims complete without participation of the targeted processes, there are no requests to be polled for, and no responses
+	//       to wait for. Each claim is issued before the current chunk is processed, so its latency is hidden behind computation. A counter is exhausted when a claim exceeds its range.
+	bool isMainProc = mpi_rank == 0;
+	const uint64_t chunkSize = 16 * max(thread::hardware_concurrency(), 1u);
+	auto rangeEnd = [&n, &mpi_size](int rank) -> uint64_t { return rank + 1 == mpi_size ? n : (rank + 1) * n / mpi_size; };
+
+	// Order claim targets hierarchically, i.e. the own counter first, then those of the node, then the others (each cyclically after the own rank, to spread out contention).
+	MPI_Comm nodeComm;
+	MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, mpi_rank, MPI_INFO_NULL, &nodeComm);
+	int node_size;
+	MPI_Comm_size(nodeComm, &node_size);
+	vector<int> nodeRanks(node_size);
+	MPI_Allgather(&mpi_rank, 1, MPI_INT, nodeRanks.data(), 1, MPI_INT, nodeComm);
+	MPI_Comm_free(&nodeComm);
+	vector<bool> onNode(mpi_size);
+	for (int rank : nodeRanks)
+		onNode[rank] = true;
+	vector<int> targets { mpi_rank };
+	for (bool local : { true, false })
+		for (int k = 1; k < mpi_size; k++)
+			if (onNode[(mpi_rank + k) % mpi_size] == local)
+				targets.push_back((mpi_rank + k) % mpi_size);
+
+	// Window layout: [next unclaimed position of the own range] [amount of detected redundant conclusions (only used at the main process, for progress)]
+	uint64_t* counters;
+	MPI_Win win;
+	MPI_Win_allocate(2 * sizeof(uint64_t), sizeof(uint64_t), MPI_INFO_NULL, MPI_COMM_WORLD, &counters, &win);
+	MPI_Win_lock_all(0, win);
+	counters[0] = mpi_rank * n / mpi_size;
+	counters[1] = 0;
+	MPI_Win_sync(win);
+	MPI_Barrier(MPI_COMM_WORLD); // all counters are initialized
+
+	uint64_t messageCounter = 0; // NOTE: Only operations that target other processes are counted.
+	chrono::microseconds busyTime(0);
+	chrono::time_point<chrono::steady_clock> startTime = chrono::steady_clock::now();
+	if (progressData)
+		progressData->setStartTime();
+	uint64_t claims[2]; // alternating result buffers, i.e. one for the current chunk and one for the pending claim
+	unsigned current = 0;
+	size_t t = 0;
+	auto claim = [&](uint64_t& result) {
+		MPI_Fetch_and_op(&chunkSize, &result, MPI_UINT64_T, targets[t], 0, MPI_SUM, win);
+		if (targets[t] != mpi_rank)
+			messageCounter++;
+	};
+	uint64_t found; // NOTE: Must remain valid until the accumulation is locally complete.
+	uint64_t reported = 0;
+	claim(claims[current]);
+	while (true) {
+		MPI_Win_flush(targets[t], win);
+		uint64_t first = claims[current];
+		uint64_t end = rangeEnd(targets[t]);
+		if (first >= end) { // the target's range is exhausted
+			if (++t == targets.size())
+				break;
+			claim(claims[current]);
+			continue;
+		}
+		end = min(end, first + chunkSize);
+		current ^= 1;
+		claim(claims[current]); // claim the next chunk in advance
+
+		chrono::time_point<chrono::steady_clock> chunkStartTime = chrono::steady_clock::now();
+		atomic<uint64_t> counter = 0;
+		tbb::parallel_for(first, end, [&indexDistribution, &isRedundant, &redundant, &counter](uint64_t i) {
+			uint64_t index = indexDistribution.empty() ? i : indexDistribution[i];
+			if (isRedundant(index)) {
+				redundant.set(index);
+				counter++;
+			}
+		});
+		busyTime += chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - chunkStartTime);
+		if (fCompleted)
+			fCompleted(first, end);
+		if ((found = counter)) {
+			MPI_Accumulate(&found, 1, MPI_UINT64_T, 0, 1, 1, MPI_UINT64_T, MPI_SUM, win);
+			if (!isMainProc)
+				messageCounter++;
+			MPI_Win_flush_local(0, win);
+		}
+
+		// Show progress if requested ; NOTE: Shouldn't be requested for non-main processes.
+		if (progressData) {
+			uint64_t total;
+			MPI_Fetch_and_op(nullptr, &total, MPI_UINT64_T, 0, 1, MPI_NO_OP, win);
+			MPI_Win_flush(0, win);
+			for (; reported < total; reported++)
+				if (progressData->nextStep()) {
+					string percentage;
+					string progress;
+					string etc;
+					if (progressData->nextState(percentage, progress, etc))
+						cout << myTime() + ": Removed " + percentage + "% of redundant conclusions. [" + progress + "] (" + etc + ")" << endl;
+				}
+		}
+	}
+	MPI_Win_unlock_all(win);
+	MPI_Win_free(&win); // NOTE: Collective, i.e. all processes are done.
+	chrono::microseconds duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime);
+
+	mpi_printBalancingStatistics(mpi_rank, mpi_size, "one-sided fetch-and-add", duration - min(duration, busyTime), messageCounter);
+}
+
+vector<chrono::microseconds> DlProofEnumerator::_workerIdleTimes(const vector<atomic<uint64_t>>& busyTimes, chrono::microseconds duration) {
+	vector<chrono::microseconds> idleTimes(busyTimes.size());
+	for (size_t t = 0; t < busyTimes.size(); t++) {
+		uint64_t busyTime = busyTimes[t];
+		idleTimes[t] = busyTime < static_cast<uint64_t>(duration.count()) ? duration - chrono::microseconds(busyTime) : chrono::microseconds(0);
+	}
+	return idleTimes;
 }
 
-void DlProofEnumerator::_loadCondensedDetachmentProofs_useConclusions(uint32_t knownLimit, const vector<vector<string>>& allRepresentatives, const vector<vector<string>>& allConclusions, vector<tbb::concurrent_bounded_queue<string>>& queues, uint32_t necessitationLimit, vector<vector<shared_ptr<DlFormula>>>* allParsedConclusions, vector<vector<atomic<bool>>>* allParsedConclusions_init) {
-	vector<vector<shared_ptr<DlFormula>>> __allParsedConclusions;
+void DlProofEnumerator::_processCondensedDetachmentProofs_useConclusions_par(uint32_t knownLimit, const vector<vector<string_view>>& allRepresentatives, const vector<vector<string_view>>& allConclusions, const function<void(const DlRuleCandidateRange&)>& fRange, uint32_t necessitationLimit, vector<vector<DlFlatFormula>>* allParsedConclusions, vector<vector<atomic<bool>>>* allParsedConclusions_init, const DlEnumerationCheckpointing* checkpointing, const DlCollectionPartition* partition, const function<void(uint64_t)>& fSkipped, bool groupAntecedents) {
+	if (checkpointing && partition)
+		throw invalid_argument("Cannot combine checkpointing with a partition of segments.");
+	vector<vector<DlFlatFormula>> __allParsedConclusions;
 	vector<vector<atomic<bool>>> __allParsedConclusions_init;
-	vector<vector<shared_ptr<DlFormula>>>& _allParsedConclusions = allParsedConclusions ? *allParsedConclusions : __allParsedConclusions;
+	vector<vector<DlFlatFormula>>& _allParsedConclusions = allParsedConclusions ? *allParsedConclusions : __allParsedConclusions;
 	vector<vector<atomic<bool>>>& _allParsedConclusions_init = allParsedConclusions ? *allParsedConclusions_init : __allParsedConclusions_init;
 	if (allParsedConclusions) {
 		if (!allParsedConclusions_init)
@@ -5115,147 +7038,193 @@ void DlProofEnumerator::_loadCondensedDetachmentProofs_useConclusions(uint32_t k
 		}
 	}
 	const vector<pair<array<uint32_t, 2>, unsigned>> combinations = necessitationLimit ? proofLengthCombinationsD_allLengths(knownLimit, true) : proofLengthCombinationsD_oddLengths(knownLimit, true);
-	auto registerD = [&queues](size_t lenA, size_t lenB, size_t iA, size_t iB) {
-		// Build and register strings "D:<length of 1st input>,<length of 2nd input>:<index of 1st input>,<index of 2nd input>".
-		stringstream ss;
-		ss << "D:" << lenA << "," << lenB << ":" << iA << "," << iB;
-		bool processed = false;
-		for (unsigned t = 0; t < queues.size(); t++) {
-			tbb::concurrent_bounded_queue<string>& queue = queues[t];
-			if (queue.empty()) {
-				queue.push(ss.str());
-				processed = true;
-				break;
-			}
-		}
-		if (!processed)
-			while (!queues[rand() % queues.size()].try_push(ss.str()));
-	};
-	auto registerN = [&queues](size_t len, size_t i) {
-		// Build and register strings "N:<length of input>:<index of input>".
-		stringstream ss;
-		ss << "N:" << len << ":" << i;
-		bool processed = false;
-		for (unsigned t = 0; t < queues.size(); t++) {
-			tbb::concurrent_bounded_queue<string>& queue = queues[t];
-			if (queue.empty()) {
-				queue.push(ss.str());
-				processed = true;
-				break;
+	mutex mtx; // NOTE: Shared by all combinations, since they share conclusion trees of equal lengths.
+	auto obtainTree = [&](uint32_t len, uint32_t i) {
+		atomic<bool>& t_init = _allParsedConclusions_init[len][i];
+		if (!t_init) {
+			string_view f = allConclusions[len][i];
+			lock_guard<mutex> lock(mtx);
+			if (!t_init) { // parse f, store in tree
+				if (!DlCore::fromPolishNotation_noRename(_allParsedConclusions[len][i], f))
+					throw domain_error("Could not parse \"" + string(f) + "\" as a formula in dotted Polish notation.");
+				t_init = true;
 			}
 		}
-		if (!processed)
-			while (!queues[rand() % queues.size()].try_push(ss.str()));
 	};
 
-	// 1. Build & register D-rules.
-	if (allParsedConclusions) { // NOTE: Sequences are processed at 'auto process_useConclusionTrees'.
-		auto distinguishVariables = [](shared_ptr<DlFormula>& f, size_t len, size_t index) {
-			vector<string> vars = DlCore::primitivesOfFormula_ordered(f);
-			map<string, shared_ptr<DlFormula>> substitutions;
-			for (const string& v : vars)
-				substitutions.emplace(v, make_shared<DlFormula>(make_shared<String>(to_string(len) + "_" + to_string(index) + "_" + v)));
-			f = DlCore::substitute(f, substitutions);
-		};
-		for (const pair<array<uint32_t, 2>, unsigned>& p : combinations) {
-			size_t lenA = p.first[0];
-			size_t lenB = p.first[1];
-
-			const vector<string>& conclusionsA = allConclusions[lenA];
-			const vector<string>& conclusionsB = allConclusions[lenB];
-			vector<shared_ptr<DlFormula>>& conclusionTreesA = _allParsedConclusions[lenA];
-			vector<shared_ptr<DlFormula>>& conclusionTreesB = _allParsedConclusions[lenB];
-			vector<atomic<bool>>& conclusionTreesA_init = _allParsedConclusions_init[lenA];
-			vector<atomic<bool>>& conclusionTreesB_init = _allParsedConclusions_init[lenB];
-			mutex mtx;
-			tbb::parallel_for(size_t(0), conclusionsA.size(), [&](size_t iA) {
-				for (size_t iB = 0; iB < conclusionsB.size(); iB++) {
-					shared_ptr<DlFormula>& tA = conclusionTreesA[iA];
-					shared_ptr<DlFormula>& tB = conclusionTreesB[iB];
-					atomic<bool>& tA_init = conclusionTreesA_init[iA];
-					atomic<bool>& tB_init = conclusionTreesB_init[iB];
-					if (!tA_init) {
-						const string& fA = conclusionsA[iA];
-						lock_guard<mutex> lock(mtx);
-						if (!tA_init) { // parse fA, store in tA
-							if (!DlCore::fromPolishNotation_noRename(tA, fA))
-								throw domain_error("Could not parse \"" + fA + "\" as a formula in dotted Polish notation.");
-							distinguishVariables(tA, lenA, iA);
-							tA_init = true;
+	// 1. Determine segments, i.e. for each combination, tiles of consecutive 1st inputs and of consecutive (positions of) 2nd inputs (of about 'candidateSegmentSize' candidates each, in the order of
+	//    their rows, and of their columns within each row), followed by groups of consecutive N-rule inputs (if applicable). Segment 'j' in [segmentOffsets[k], segmentOffsets[k + 1]) covers the
+	//    'j - segmentOffsets[k]'-th tile for 'combinations[k]', or the 'j - segmentOffsets[k]'-th group of N-rule inputs in case of k = combinations.size().
+	//    NOTE: Tiles are at most 'candidateTileWidth' columns wide, so that the 2nd inputs of a tile remain cached while they are combined with each of the tile's 1st inputs. Otherwise, for large
+	//          amounts of 2nd inputs (where segments consisted of only one 1st input), each 1st input was combined with all 2nd inputs in turn, such that the 2nd inputs had to be reloaded from memory
+	//          for each 1st input.
+	vector<uint32_t> rowsPerSegment(combinations.size() + 1);
+	vector<uint32_t> colsPerSegment(combinations.size() + 1);
+	vector<uint32_t> segmentsPerRow(combinations.size() + 1);
+	vector<uint64_t> segmentOffsets(combinations.size() + 2);
+	for (size_t k = 0; k <= combinations.size(); k++) {
+		uint32_t rows;
+		uint32_t cols;
+		if (k < combinations.size()) {
+			rows = static_cast<uint32_t>(allConclusions[combinations[k].first[0]].size());
+			cols = static_cast<uint32_t>(allConclusions[combinations[k].first[1]].size());
+			colsPerSegment[k] = max(min(cols, candidateTileWidth), 1u);
+		} else {
+			rows = necessitationLimit ? (static_cast<uint32_t>(allRepresentatives[knownLimit].size()) + candidateRangeSize - 1) / candidateRangeSize : 0; // N-rules: rows are chunks of inputs
+			cols = candidateRangeSize;
+			colsPerSegment[k] = cols;
+		}
+		rowsPerSegment[k] = max(candidateSegmentSize / colsPerSegment[k], 1u);
+		segmentsPerRow[k] = (cols + colsPerSegment[k] - 1) / colsPerSegment[k];
+		segmentOffsets[k + 1] = segmentOffsets[k] + (rows && cols ? static_cast<uint64_t>((rows + rowsPerSegment[k] - 1) / rowsPerSegment[k]) * segmentsPerRow[k] : 0);
+	}
+	const uint64_t segmentCount = segmentOffsets.back();
+	unique_ptr<DlSkeletonIndex> skeletons;
+	if (fSkipped)
+		skeletons = make_unique<DlSkeletonIndex>(allConclusions, groupAntecedents);
+	else if (groupAntecedents)
+		throw invalid_argument("Cannot group antecedents without skipping candidates of incompatible skeletons.");
+
+	// 2. Build & process rules of a segment, in ranges over indices of 2nd inputs (D-rules) or over indices of inputs (N-rules).
+	//    NOTE: Segments, 1st inputs and ranges of 2nd inputs are all split up by nested TBB loops, such that idle threads can steal work at every level.
+	auto processSegment = [&](uint64_t j) {
+		size_t k = static_cast<size_t>(upper_bound(segmentOffsets.begin(), segmentOffsets.end(), j) - segmentOffsets.begin() - 1);
+		uint64_t t = j - segmentOffsets[k];
+		uint32_t begin = static_cast<uint32_t>(t / segmentsPerRow[k]) * rowsPerSegment[k];
+		if (k < combinations.size()) { // D-rules
+			uint32_t lenA = combinations[k].first[0];
+			uint32_t lenB = combinations[k].first[1];
+			uint32_t sizeA = static_cast<uint32_t>(allConclusions[lenA].size());
+			uint32_t sizeB = static_cast<uint32_t>(allConclusions[lenB].size());
+			uint32_t colBegin = static_cast<uint32_t>(t % segmentsPerRow[k]) * colsPerSegment[k];
+			uint32_t colEnd = min(colBegin + colsPerSegment[k], sizeB);
+			if (skeletons) { // only iterate 2nd inputs whose antecedents have compatible skeletons, in ranges over their positions in 'skeletons->conditionals(lenB)' ; NOTE: Columns are such positions.
+				const vector<uint32_t>& indicesB = skeletons->conditionals(lenB);
+				const vector<DlSkeletonIndex::Class>& classes = skeletons->classes(lenB);
+				const uint32_t* groupsB = groupAntecedents ? skeletons->groups(lenB).data() : nullptr;
+				// NOTE: Classes are ordered by their ranges, so only those which overlap the tile's columns are considered.
+				vector<DlSkeletonIndex::Class>::const_iterator classesBegin = partition_point(classes.begin(), classes.end(), [&](const DlSkeletonIndex::Class& c) { return c.end <= colBegin; });
+				vector<DlSkeletonIndex::Class>::const_iterator classesEnd = partition_point(classesBegin, classes.end(), [&](const DlSkeletonIndex::Class& c) { return c.begin < colEnd; });
+				tbb::parallel_for(begin, min(begin + rowsPerSegment[k], sizeA), [&](uint32_t iA) {
+					if (allParsedConclusions)
+						obtainTree(lenA, iA);
+					DlSkeletonIndex::Skeleton skeletonA = skeletons->skeletonOf(lenA, iA);
+					uint32_t compatibleCount = 0;
+					for (vector<DlSkeletonIndex::Class>::const_iterator it = classesBegin; it != classesEnd; ++it) {
+						const DlSkeletonIndex::Class& c = *it;
+						uint32_t classBegin = max(c.begin, colBegin);
+						uint32_t classEnd = min(c.end, colEnd);
+						if (DlSkeletonIndex::compatible(skeletonA, c.skeleton)) {
+							compatibleCount += classEnd - classBegin;
+							tbb::parallel_for(uint32_t(0), (classEnd - classBegin + candidateRangeSize - 1) / candidateRangeSize, [&](uint32_t chunk) {
+								uint32_t pB = classBegin + chunk * candidateRangeSize;
+								uint32_t end = min(pB + candidateRangeSize, classEnd);
+								if (allParsedConclusions)
+									for (uint32_t qB = pB; qB < end; qB++)
+										obtainTree(lenB, indicesB[qB]);
+								fRange(DlRuleCandidateRange { DlRuleCandidate { lenA, lenB, iA, pB }, end, indicesB.data(), groupsB });
+							});
 						}
 					}
-					if (!tB_init) {
-						const string& fB = conclusionsB[iB];
-						lock_guard<mutex> lock(mtx);
-						if (!tB_init) { // parse fB, store in tB
-							if (!DlCore::fromPolishNotation_noRename(tB, fB))
-								throw domain_error("Could not parse \"" + fB + "\" as a formula in dotted Polish notation.");
-							distinguishVariables(tB, lenB, iB);
-							tB_init = true;
+					if (compatibleCount < colEnd - colBegin) // NOTE: Positions beyond 'indicesB' account for 2nd inputs that are no conditionals.
+						fSkipped(colEnd - colBegin - compatibleCount);
+				});
+			} else
+				tbb::parallel_for(tbb::blocked_range2d<uint32_t>(begin, min(begin + rowsPerSegment[k], sizeA), colBegin / candidateRangeSize, (colEnd + candidateRangeSize - 1) / candidateRangeSize), [&](const tbb::blocked_range2d<uint32_t>& r) {
+					for (uint32_t iA = r.rows().begin(); iA != r.rows().end(); iA++) {
+						if (allParsedConclusions) // NOTE: Sequences are processed at 'auto process_useConclusionTrees'.
+							obtainTree(lenA, iA);
+						for (uint32_t chunk = r.cols().begin(); chunk != r.cols().end(); chunk++) {
+							uint32_t iB = chunk * candidateRangeSize;
+							uint32_t end = min(iB + candidateRangeSize, colEnd);
+							if (allParsedConclusions)
+								for (uint32_t jB = iB; jB < end; jB++)
+									obtainTree(lenB, jB);
+							fRange(DlRuleCandidateRange { DlRuleCandidate { lenA, lenB, iA, iB }, end }); // NOTE: Sequences are processed at 'auto process_useConclusionStrings' when trees are not used.
 						}
 					}
-					registerD(lenA, lenB, iA, iB);
-				}
-			});
-		}
-	} else // NOTE: Sequences are processed at 'auto process_useConclusionStrings'.
-		for (const pair<array<uint32_t, 2>, unsigned>& p : combinations) {
-			size_t lenA = p.first[0];
-			size_t lenB = p.first[1];
-			const vector<string>& conclusionsA = allConclusions[lenA];
-			const vector<string>& conclusionsB = allConclusions[lenB];
-			tbb::parallel_for(size_t(0), conclusionsA.size(), [&](size_t iA) {
-				for (size_t iB = 0; iB < conclusionsB.size(); iB++)
-					registerD(lenA, lenB, iA, iB);
+				});
+		} else { // N-rules
+			const vector<string_view>& representatives = allRepresentatives[knownLimit];
+			uint32_t size = static_cast<uint32_t>(representatives.size());
+			tbb::parallel_for(begin, min(begin + rowsPerSegment[k], (size + candidateRangeSize - 1) / candidateRangeSize), [&](uint32_t chunk) {
+				uint32_t first = chunk * candidateRangeSize;
+				uint32_t end = min(first + candidateRangeSize, size);
+				if (necessitationLimit < UINT32_MAX) { // register maximal subranges of inputs with fitting amounts of leading Ns
+					auto countLeadingNs = [](string_view p) { uint32_t counter = 0; for (string_view::const_iterator it = p.begin(); it != p.end() && *it == 'N'; ++it) counter++; return counter; };
+					uint32_t rangeBegin = first;
+					for (uint32_t i = first; i < end; i++)
+						if (countLeadingNs(representatives[i]) >= necessitationLimit) {
+							if (rangeBegin < i)
+								fRange(DlRuleCandidateRange { DlRuleCandidate { knownLimit, 0, rangeBegin, 0 }, i });
+							rangeBegin = i + 1;
+						}
+					if (rangeBegin < end)
+						fRange(DlRuleCandidateRange { DlRuleCandidate { knownLimit, 0, rangeBegin, 0 }, end });
+				} else
+					fRange(DlRuleCandidateRange { DlRuleCandidate { knownLimit, 0, first, 0 }, end });
 			});
 		}
+	};
 
-	// 2. Build & register N-rules (if applicable).
-	if (necessitationLimit) {
-		const vector<string>& representatives = allRepresentatives[knownLimit];
-		tbb::parallel_for(size_t(0), representatives.size(), [&](size_t i) {
-			if (necessitationLimit < UINT32_MAX) {
-				auto countLeadingNs = [](const string& p) { uint32_t counter = 0; for (string::const_iterator it = p.begin(); it != p.end() && *it == 'N'; ++it) counter++; return counter; };
-				if (countLeadingNs(representatives[i]) < necessitationLimit)
-					registerN(knownLimit, i);
-			} else
-				registerN(knownLimit, i);
-		});
+	// 3. Process segments, all at once, or (for a partition) in rounds of consecutive segments of which only the partition's segments are processed,
+	//    or (for checkpointing) in epochs of consecutive segments, with a potential checkpoint after each epoch.
+	if (partition) {
+		// NOTE: The amount of rounds only depends on the inputs, so it is equal for all partitions (even when some have no segments left).
+		const uint64_t count = partition->count;
+		const uint64_t roundSize = max(partition->roundSize, uint64_t(1));
+		for (uint64_t position = 0; position < segmentCount || !position; position += roundSize) {
+			uint64_t end = min(position + roundSize, segmentCount);
+			uint64_t first = position + (partition->index + count - position % count) % count; // first segment of the partition in [position, end)
+			if (first < end)
+				tbb::parallel_for(uint64_t(0), (end - first + count - 1) / count, [&](uint64_t t) { processSegment(first + t * count); });
+			if (partition->fRound)
+				partition->fRound();
+		}
+	} else if (!checkpointing)
+		tbb::parallel_for(uint64_t(0), segmentCount, processSegment);
+	else {
+		// NOTE: Epochs grow until they take at least 1/16 of the checkpoint interval, so that waiting for an epoch's final segments costs little time.
+		uint64_t epochSize = 1;
+		chrono::time_point<chrono::steady_clock> checkpointTime = chrono::steady_clock::now();
+		for (uint64_t position = checkpointing->resumePosition; position < segmentCount;) {
+			uint64_t end = min(position + epochSize, segmentCount);
+			chrono::time_point<chrono::steady_clock> epochStartTime = chrono::steady_clock::now();
+			tbb::parallel_for(position, end, processSegment);
+			position = end;
+			chrono::time_point<chrono::steady_clock> now = chrono::steady_clock::now();
+			if (16 * (now - epochStartTime) < checkpointing->interval)
+				epochSize *= 2;
+			if (checkpointing->fCheckpoint && position < segmentCount && now - checkpointTime >= checkpointing->interval) {
+				checkpointing->fCheckpoint(position);
+				checkpointTime = chrono::steady_clock::now();
+			}
+		}
 	}
 }
 
-void DlProofEnumerator::_loadCondensedDetachmentProofs_dynamic_par(string& prefix, vector<uint32_t>& stack, uint32_t wordLengthLimit, uint32_t knownLimit, const vector<vector<string>>& allRepresentatives, vector<tbb::concurrent_bounded_queue<string>>& queues, uint32_t necessitationLimit) {
+void DlProofEnumerator::_loadCondensedDetachmentProofs_dynamic_par(string& prefix, vector<uint32_t>& stack, uint32_t wordLengthLimit, uint32_t knownLimit, const vector<vector<string_view>>& allRepresentatives, const function<void(const string&)>& fRegister, uint32_t necessitationLimit) {
 	const uint32_t c = necessitationLimit ? 1 : 2; // proof length step size
 	bool singleStep = wordLengthLimit <= knownLimit + c;
 	const vector<pair<array<uint32_t, 2>, unsigned>> combinations = necessitationLimit ? proofLengthCombinationsD_allLengths(knownLimit, singleStep) : proofLengthCombinationsD_oddLengths(knownLimit, singleStep);
 	bool ignoreN = !necessitationLimit || necessitationLimit == UINT32_MAX;
-	auto recurse = [&wordLengthLimit, &knownLimit, &allRepresentatives, &queues, &necessitationLimit, &c, &singleStep, &combinations, &ignoreN](string& prefix, vector<uint32_t>& stack, const auto& me, uint32_t N = 0) -> void {
+	auto recurse = [&wordLengthLimit, &knownLimit, &allRepresentatives, &fRegister, &necessitationLimit, &c, &singleStep, &combinations, &ignoreN](string& prefix, vector<uint32_t>& stack, const auto& me, uint32_t N = 0) -> void {
 		constexpr uint32_t S = 0;
 		const uint32_t A = knownLimit + c;
 		// NOTE: X1, ..., X<knownLimit> are now simply 1, ..., knownLimit.
 		if (prefix.length() + stack.size() > wordLengthLimit)
 			return;
-		if (stack.empty()) {
-			bool processed = false;
-			for (unsigned t = 0; t < queues.size(); t++) {
-				tbb::concurrent_bounded_queue<string>& queue = queues[t];
-				if (queue.empty()) {
-					queue.push(prefix);
-					processed = true;
-					break;
-				}
-			}
-			if (!processed)
-				while (!queues[rand() % queues.size()].try_push(prefix));
-		} else {
-			auto countLeadingNs = [](const string& p) { uint32_t counter = 0; for (string::const_iterator it = p.begin(); it != p.end() && *it == 'N'; ++it) counter++; return counter; };
-			auto countTrailingNs = [](const string& p) { uint32_t counter = 0; for (string::const_reverse_iterator it = p.rbegin(); it != p.rend() && *it == 'N'; ++it) counter++; return counter; };
-			auto fittingNs = [&](const string& pre, const string& post) { return countTrailingNs(pre) + countLeadingNs(post) <= necessitationLimit; };
-			auto processX = [&](const vector<string>& representatives) {
+		if (stack.empty())
+			fRegister(prefix);
+		else {
+			auto countLeadingNs = [](string_view p) { uint32_t counter = 0; for (string_view::const_iterator it = p.begin(); it != p.end() && *it == 'N'; ++it) counter++; return counter; };
+			auto countTrailingNs = [](string_view p) { uint32_t counter = 0; for (string_view::const_reverse_iterator it = p.rbegin(); it != p.rend() && *it == 'N'; ++it) counter++; return counter; };
+			auto fittingNs = [&](string_view pre, string_view post) { return countTrailingNs(pre) + countLeadingNs(post) <= necessitationLimit; };
+			auto processX = [&](const vector<string_view>& representatives) {
 				vector<uint32_t> stack_copy; // Since there are multiple options, we use copies for all
 				string prefix_copy; //          but the last option, in order to restore the parameters.
-				vector<string>::const_iterator last = prev(representatives.end());
-				for (vector<string>::const_iterator it = representatives.begin(); it != last; ++it) {
+				vector<string_view>::const_iterator last = prev(representatives.end());
+				for (vector<string_view>::const_iterator it = representatives.begin(); it != last; ++it) {
 					stack_copy = stack;
 					prefix_copy = prefix;
 					if (ignoreN) {
@@ -5280,8 +7249,8 @@ void DlProofEnumerator::_loadCondensedDetachmentProofs_dynamic_par(string& prefi
 				// 1/2 : {1,...,allRepresentatives[knownLimit].back()}, S, [] ; stack: pop current symbol, push nothing
 				vector<uint32_t> stack_copy; // Since there are multiple options, we use copies for all
 				string prefix_copy; //          but the last option, in order to restore the parameters.
-				auto processRepresentatives = [&](const vector<string>& representatives) {
-					for (const string& sequence : representatives) {
+				auto processRepresentatives = [&](const vector<string_view>& representatives) {
+					for (string_view sequence : representatives) {
 						stack_copy = stack;
 						prefix_copy = prefix;
 						if (ignoreN) {
@@ -5346,7 +7315,7 @@ void DlProofEnumerator::_loadCondensedDetachmentProofs_dynamic_par(string& prefi
 			} else {
 				if (symbol > 1 && prefix.length() + symbol + stack.size() > wordLengthLimit + 1)
 					return; // cancel already if adding the below sequences would exceed the word length limit ; condition already outruled for 'symbol == 1'
-				const vector<string>& r = allRepresentatives[symbol];
+				const vector<string_view>& r = allRepresentatives[symbol];
 				if (r.empty())
 					return; // when X<symbol> is empty, throw out all stacks which make use of it
 				stack.pop_back(); // pop already for all cases
@@ -5358,23 +7327,13 @@ void DlProofEnumerator::_loadCondensedDetachmentProofs_dynamic_par(string& prefi
 	recurse(prefix, stack, recurse);
 }
 
-void DlProofEnumerator::_loadCondensedDetachmentProofs_naive_par(string& prefix, unsigned stackSize, uint32_t wordLengthLimit, vector<tbb::concurrent_bounded_queue<string>>& queues) {
+void DlProofEnumerator::_loadCondensedDetachmentProofs_naive_par(string& prefix, unsigned stackSize, uint32_t wordLengthLimit, const function<void(const string&)>& fRegister) {
 	auto recurse = [&](string& prefix, unsigned stackSize, const auto& me) -> void {
 		if (prefix.length() + stackSize > wordLengthLimit)
 			return;
-		if (!stackSize) {
-			bool processed = false;
-			for (unsigned t = 0; t < queues.size(); t++) {
-				tbb::concurrent_bounded_queue<string>& queue = queues[t];
-				if (queue.empty()) {
-					queue.push(prefix);
-					processed = true;
-					break;
-				}
-			}
-			if (!processed)
-				while (!queues[rand() % queues.size()].try_push(prefix));
-		} else {
+		if (!stackSize)
+			fRegister(prefix);
+		else {
 			// 1/4 : 1, S, [] ; stack: pop current symbol, push nothing
 			string prefix_copy = prefix; // Since there are multiple options, we use copies for all but the last option, in order to restore the parameters.
 			prefix_copy += "1";
@@ -2,23 +2,33 @@
 #define XAMIDI_LOGIC_DLPROOFENUMERATOR_H
 
 #include "../helper/FwdTbb.h"
+#include "../helper/IndexBitmap.h"
 #include "../helper/ProgressData.h"
 #include "../metamath/DRuleParser.h"
+#include "DlConclusionSpill.h"
+#include "DlConclusionStore.h"
+#include "DlFormulaArena.h"
+#include "DlProofLookup.h"
 
 #include <array>
+#include <chrono>
 #include <condition_variable>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <tbb/concurrent_hash_map.h>
 #include <tbb/concurrent_queue.h>
 #include <tbb/concurrent_unordered_map.h>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
 #include <thread>
+#include <type_traits>
 
 namespace xamidi {
 namespace logic {
 
 enum class DlProofEnumeratorMode {
-	Dynamic, FromConclusionStrings, FromConclusionTrees, Naive
+	Dynamic, FromConclusionStrings, FromConclusionTrees, Naive, FromGroupedConclusionTrees
 };
 
 enum class DlFormulaStyle {
@@ -29,16 +39,79 @@ enum class ExtractionMethod {
 	TopListFile, ProofSystemFromTopList, ProofSystemFromString, ProofSystemFromFile, CopyWithLimitedConclusions
 };
 
+// Rule candidate for conclusion-based generation, such that allConclusions[lenA][iA] (and allConclusions[lenB][iB] for D-rules) address conclusion strings to be used.
+// Since there are no proofs of length 0, 'lenB' = 0 indicates an N-rule (which ignores 'iB').
+struct DlRuleCandidate {
+	std::uint32_t lenA;
+	std::uint32_t lenB;
+	std::uint32_t iA;
+	std::uint32_t iB;
+};
+
+// Work item for conclusion-based generation, representing all candidates from 'first' up to (excluding) index 'end', where
+// the index of the 2nd input (i.e. 'iB') is iterated for D-rules, and the index of the input (i.e. 'iA') is iterated for N-rules.
+// 'indicesB' != nullptr => iterated values are positions p (rather than indices) of 2nd inputs, whose indices are indicesB[p] (see DlSkeletonIndex::conditionals())
+// 'groupsB' != nullptr => groupsB[p] identifies the group of the 2nd input at position p, i.e. its antecedent up to variable renaming (see DlSkeletonIndex::groups())
+struct DlRuleCandidateRange {
+	DlRuleCandidate first;
+	std::uint32_t end;
+	const std::uint32_t* indicesB = nullptr;
+	const std::uint32_t* groupsB = nullptr;
+};
+
+// Checkpointing of a candidate enumeration, where candidates (or groups of candidates) are addressed by fixed positions in the order of enumeration. Candidates before 'resumePosition' are skipped,
+// and whenever 'interval' has passed since the previous checkpoint, the enumeration pauses until all pending candidates are processed, and calls 'fCheckpoint' with the position up to which
+// (excluding) all candidates have been processed (and no others). 'fCheckpoint' is called from the enumerating thread, i.e. from a thread that calls DlProofEnumerator::processCondensedDetachmentProofs_*(),
+// and may be empty in order to only resume an enumeration.
+struct DlEnumerationCheckpointing {
+	std::chrono::milliseconds interval;
+	std::uint64_t resumePosition = 0;
+	std::function<void(std::uint64_t)> fCheckpoint;
+};
+
+// Distribution of a conclusion-based collection of proven formulas among multiple processes (see DlProofEnumerator::mpi_generateDProofRepresentativeFiles()). Segments of candidates
+// (see DlProofEnumerator::_processCondensedDetachmentProofs_useConclusions_par()) are enumerated in rounds of 'roundSize' consecutive segments, of which a process handles those with
+// indices j where j % 'count' = 'index'. 'fRound' is called from the enumerating thread after each round, i.e. equally often on all processes (which allows for collective communication).
+// Conclusions for which 'fForward(conclusion, dProof)' returns true belong to other processes, i.e. they were forwarded rather than inserted, and are counted by their owners.
+struct DlCollectionPartition {
+	std::uint32_t count;
+	std::uint32_t index;
+	std::uint64_t roundSize;
+	std::function<void()> fRound;
+	std::function<bool(std::string_view, std::string_view)> fForward;
+};
+
+// State of a collection of proven formulas (see DlProofEnumerator::_collectProvenFormulas()) at a checkpoint, i.e. its enumeration position and counters. Position UINT64_MAX indicates a complete collection.
+struct DlCollectionCheckpoint {
+	std::uint64_t position = 0;
+	std::uint64_t counter = 0;
+	std::uint64_t conclusionCounter = 0;
+	std::uint64_t redundantCounter = 0;
+	std::uint64_t invalidCounter = 0;
+};
+
+// Checkpointing of the MPI-based filter (see DlProofEnumerator::mpi_filterDProofRepresentativeFile()), where indices of the unfiltered file are addressed by their positions in the order of checking.
+// Positions within 'completed' (disjoint ranges [first, end) in ascending order, e.g. of previous runs) are skipped. 'redundant' holds known redundant indices (of size 0 if there are none), which
+// together with 'completed', are taken over by the main process. Whenever 'interval' has passed since the previous checkpoint, and when a process completed all of its workloads, 'fCheckpoint' is
+// called with the process's completed ranges and its detections. 'fCheckpoint' is called between the processing of workloads (i.e. there are no concurrent detections), and may be empty in order
+// to only resume a filter.
+struct DlFilterCheckpointing {
+	std::chrono::milliseconds interval;
+	std::vector<std::array<std::uint64_t, 2>> completed;
+	helper::IndexBitmap redundant;
+	std::function<void(const std::vector<std::array<std::uint64_t, 2>>&, const helper::IndexBitmap&)> fCheckpoint;
+};
+
 struct DlProofEnumerator {
 	// Data loading
-	static bool loadDProofRepresentatives(std::vector<std::vector<std::string>>& allRepresentatives, std::vector<std::vector<std::string>>* optOut_allConclusions, std::uint64_t* optOut_allRepresentativesCount = nullptr, std::map<std::uint32_t, std::uint64_t>* optOut_representativeCounts = nullptr, std::uint32_t* optOut_firstMissingIndex = nullptr, bool debug = false, const std::string& filePrefix = "data/dProofs", const std::string& filePostfix = ".txt", bool initFresh = true, std::uint32_t limit = UINT32_MAX, const std::uint32_t* proofLenStepSize = nullptr);
-	static tbb::concurrent_hash_map<std::string, std::string> parseDProofRepresentatives(const std::vector<std::string>& representatives, helper::ProgressData* const progressData = nullptr, std::atomic<std::uint64_t>* misses_speedupN = nullptr, tbb::concurrent_hash_map<std::string, std::string>* target_speedupN = nullptr, tbb::concurrent_unordered_map<std::string, std::string>* lookup_speedupN = nullptr);
-	static tbb::concurrent_hash_map<std::string, std::string> parseDProofRepresentatives(const std::vector<std::vector<std::string>>& allRepresentatives, helper::ProgressData* const progressData = nullptr, std::atomic<std::uint64_t>* misses_speedupN = nullptr, tbb::concurrent_unordered_map<std::string, std::string>* lookup_speedupN = nullptr, const std::uint32_t* proofLenStepSize = nullptr);
-	static tbb::concurrent_hash_map<std::string, std::string> connectDProofConclusions(const std::vector<std::vector<std::string>>& allRepresentatives, const std::vector<std::vector<std::string>>& allConclusions, helper::ProgressData* const progressData = nullptr, const std::uint32_t* proofLenStepSize = nullptr);
-	static bool parseAndInsertDProof_speedupN(tbb::concurrent_hash_map<std::string, std::string>::accessor* wAcc, bool* isNew, const std::string& dProof, tbb::concurrent_hash_map<std::string, std::string>& results, tbb::concurrent_unordered_map<std::string, std::string>* lookup_speedupN = nullptr, bool permissive = false, std::atomic<std::uint64_t>* misses_speedupN = nullptr, std::size_t maxSymbolicConclusionLength = SIZE_MAX, std::size_t maxSymbolicConsequentLength = SIZE_MAX);
-	static tbb::concurrent_unordered_map<std::string, std::string> parseDProofRepresentatives_um(const std::vector<std::string>& representatives, helper::ProgressData* const progressData = nullptr, std::atomic<std::uint64_t>* misses_speedupN = nullptr, tbb::concurrent_unordered_map<std::string, std::string>* target_speedupN = nullptr, tbb::concurrent_unordered_map<std::string, tbb::concurrent_unordered_map<std::string, std::string>::iterator>* lookup_speedupN = nullptr);
-	static tbb::concurrent_unordered_map<std::string, std::string> parseDProofRepresentatives_um(const std::vector<std::vector<std::string>>& allRepresentatives, helper::ProgressData* const progressData = nullptr, std::atomic<std::uint64_t>* misses_speedupN = nullptr, tbb::concurrent_unordered_map<std::string, tbb::concurrent_unordered_map<std::string, std::string>::iterator>* lookup_speedupN = nullptr, const std::uint32_t* proofLenStepSize = nullptr);
-	static tbb::concurrent_unordered_map<std::string, std::string> connectDProofConclusions_um(const std::vector<std::vector<std::string>>& allRepresentatives, const std::vector<std::vector<std::string>>& allConclusions, helper::ProgressData* const progressData = nullptr, const std::uint32_t* proofLenStepSize = nullptr);
+	static bool loadDProofRepresentatives(DlProofLookup& allRepresentatives, DlProofLookup* optOut_allConclusions, std::uint64_t* optOut_allRepresentativesCount = nullptr, std::map<std::uint32_t, std::uint64_t>* optOut_representativeCounts = nullptr, std::uint32_t* optOut_firstMissingIndex = nullptr, bool debug = false, const std::string& filePrefix = "data/dProofs", const std::string& filePostfix = ".txt", bool initFresh = true, std::uint32_t limit = UINT32_MAX, const std::uint32_t* proofLenStepSize = nullptr);
+	static DlConclusionStore parseDProofRepresentatives(const std::vector<std::string_view>& representatives, helper::ProgressData* const progressData = nullptr, std::atomic<std::uint64_t>* misses_speedupN = nullptr, DlConclusionStore* target_speedupN = nullptr, tbb::concurrent_unordered_map<std::string, std::string>* lookup_speedupN = nullptr);
+	static DlConclusionStore parseDProofRepresentatives(const std::vector<std::vector<std::string_view>>& allRepresentatives, helper::ProgressData* const progressData = nullptr, std::atomic<std::uint64_t>* misses_speedupN = nullptr, tbb::concurrent_unordered_map<std::string, std::string>* lookup_speedupN = nullptr, const std::uint32_t* proofLenStepSize = nullptr);
+	static DlConclusionStore connectDProofConclusions(const std::vector<std::vector<std::string_view>>& allRepresentatives, const std::vector<std::vector<std::string_view>>& allConclusions, helper::ProgressData* const progressData = nullptr, const std::uint32_t* proofLenStepSize = nullptr);
+	static bool parseAndInsertDProof_speedupN(bool* isNew, const std::string& dProof, DlConclusionStore& results, tbb::concurrent_unordered_map<std::string, std::string>* lookup_speedupN = nullptr, bool permissive = false, std::atomic<std::uint64_t>* misses_speedupN = nullptr, std::size_t maxSymbolicConclusionLength = SIZE_MAX, std::size_t maxSymbolicConsequentLength = SIZE_MAX, bool replaceWorseProof = false);
+	static tbb::concurrent_unordered_map<std::string, std::string> parseDProofRepresentatives_um(const std::vector<std::string_view>& representatives, helper::ProgressData* const progressData = nullptr, std::atomic<std::uint64_t>* misses_speedupN = nullptr, tbb::concurrent_unordered_map<std::string, std::string>* target_speedupN = nullptr, tbb::concurrent_unordered_map<std::string, tbb::concurrent_unordered_map<std::string, std::string>::iterator>* lookup_speedupN = nullptr);
+	static tbb::concurrent_unordered_map<std::string, std::string> parseDProofRepresentatives_um(const std::vector<std::vector<std::string_view>>& allRepresentatives, helper::ProgressData* const progressData = nullptr, std::atomic<std::uint64_t>* misses_speedupN = nullptr, tbb::concurrent_unordered_map<std::string, tbb::concurrent_unordered_map<std::string, std::string>::iterator>* lookup_speedupN = nullptr, const std::uint32_t* proofLenStepSize = nullptr);
+	static tbb::concurrent_unordered_map<std::string, std::string> connectDProofConclusions_um(const std::vector<std::vector<std::string_view>>& allRepresentatives, const std::vector<std::vector<std::string_view>>& allConclusions, helper::ProgressData* const progressData = nullptr, const std::uint32_t* proofLenStepSize = nullptr);
 	static std::pair<tbb::concurrent_unordered_map<std::string, std::string>::iterator, bool> parseAndInsertDProof_speedupN_um(const std::string& dProof, tbb::concurrent_unordered_map<std::string, std::string>& results, tbb::concurrent_unordered_map<std::string, tbb::concurrent_unordered_map<std::string, std::string>::iterator>* lookup_speedupN = nullptr, bool permissive = false, std::atomic<std::uint64_t>* misses_speedupN = nullptr, std::size_t maxSymbolicConclusionLength = SIZE_MAX, std::size_t maxSymbolicConsequentLength = SIZE_MAX);
 
 	// Basic functionality
@@ -66,9 +139,10 @@ public:
 	static void readConfigFile(bool initMissingFile = true, std::size_t* showProgress_bound = nullptr, std::size_t* parseProgressSteps5 = nullptr, std::size_t* parseProgressSteps10 = nullptr, std::size_t* collectProgressSteps2 = nullptr, std::size_t* collectProgressSteps5 = nullptr, std::size_t* collectProgressSteps10 = nullptr, std::size_t* filterProgressSteps2 = nullptr, std::size_t* filterProgressSteps5 = nullptr, std::size_t* filterProgressSteps10 = nullptr);
 	static std::vector<const std::vector<std::string>*>& currentRepresentatives();
 	static std::vector<const std::vector<std::string>*>& currentConclusions();
-	static std::vector<std::vector<std::string>> composeToLookupVector(const std::vector<const std::vector<std::string>*>& all, const std::uint32_t* proofLenStepSize = nullptr);
-	static bool readRepresentativesLookupVectorFromFiles_seq(std::vector<std::vector<std::string>>& allRepresentativesLookup, std::vector<std::vector<std::string>>* optOut_allConclusionsLookup, bool debug = false, const std::string& filePrefix = "data/dProofs", const std::string& filePostfix = ".txt", bool initFresh = true, std::uint32_t limit = UINT32_MAX, const std::uint32_t* proofLenStepSize = nullptr);
-	static bool readRepresentativesLookupVectorFromFiles_par(std::vector<std::vector<std::string>>& allRepresentativesLookup, std::vector<std::vector<std::string>>* optOut_allConclusionsLookup, bool debug = false, unsigned concurrencyCount = std::thread::hardware_concurrency(), const std::string& filePrefix = "data/dProofs", const std::string& filePostfix = ".txt", bool initFresh = true, std::uint32_t limit = UINT32_MAX, const std::uint32_t* proofLenStepSize = nullptr);
+	static DlProofLookup composeToLookupVector(const std::vector<const std::vector<std::string>*>& all, const std::uint32_t* proofLenStepSize = nullptr);
+	// NOTE: Proof files are read from their binary companions (see DlProofFile) whenever those are valid, i.e. without parsing text lines. Entries are still copied into the (owning) lookup vectors.
+	static bool readRepresentativesLookupVectorFromFiles_seq(DlProofLookup& allRepresentativesLookup, DlProofLookup* optOut_allConclusionsLookup, bool debug = false, const std::string& filePrefix = "data/dProofs", const std::string& filePostfix = ".txt", bool initFresh = true, std::uint32_t limit = UINT32_MAX, const std::uint32_t* proofLenStepSize = nullptr);
+	static bool readRepresentativesLookupVectorFromFiles_par(DlProofLookup& allRepresentativesLookup, DlProofLookup* optOut_allConclusionsLookup, bool debug = false, unsigned concurrencyCount = std::thread::hardware_concurrency(), const std::string& filePrefix = "data/dProofs", const std::string& filePostfix = ".txt", bool initFresh = true, std::uint32_t limit = UINT32_MAX, const std::uint32_t* proofLenStepSize = nullptr);
 	static std::vector<std::pair<std::array<std::uint32_t, 2>, unsigned>> proofLengthCombinationsD_oddLengths(std::uint32_t knownLimit, bool singleStep = false);
 	static std::vector<std::pair<std::array<std::uint32_t, 2>, unsigned>> proofLengthCombinationsD_allLengths(std::uint32_t knownLimit, bool singleStep = false);
 	static void sampleCombinations();
@@ -92,22 +166,56 @@ public:
 	// The earlier one begins to generate D-proofs with redundant conclusions, the larger resulting files 'dProofs<m>-unfiltered<n+1>+.txt' become (with an exponential growth).
 	// 'dProofs1.txt', 'dProofs3.txt', ..., 'dProofs15.txt' are built-in, and 'dProofs17.txt', ..., 'dProofs29.txt' are available at https://github.com/xamidi/pmGenerator/tree/master/data/dProofs-withConclusions
 	// and https://github.com/xamidi/pmGenerator/tree/master/data/dProofs-withoutConclusions (150'170'911 bytes compressed into 'dProofs17-29.7z' of 1'005'537 bytes), so it is recommended to choose n >= 29.
-	static void generateDProofRepresentativeFiles(std::uint32_t limit = UINT32_MAX, bool redundantSchemaRemoval = true, bool withConclusions = true, std::size_t* candidateQueueCapacities = nullptr, std::size_t maxSymbolicConclusionLength = SIZE_MAX, std::size_t maxSymbolicConsequentLength = SIZE_MAX, bool useConclusionStrings = false, bool useConclusionTrees = false);
+	// Redundant schema removal utilizes a generalization index (DlSchemaIndex) to only check candidates for schemas ; 'useSchemaIndex' = false selects the brute-force variant (for cross-checking).
+	// For 'checkpointInterval' > 0, the collection of each proof length's conclusions stores a checkpoint (i.e. its position in candidate enumeration, its counters, and all conclusions collected so far) at least every
+	// 'checkpointInterval' seconds, and once it is complete, at ./data/[<hash>/]/dProofs-with(out)Conclusions/dProofs<n>[-unfiltered<m>+]-checkpoint.bin (which is removed as soon as 'dProofs<n>[-unfiltered<m>+].txt' is written).
+	// When 'resume' is set and a checkpoint for the first missing proof length exists (which was stored with equal settings), generation continues from there and results in identical proof files.
+	// For 'memoryBudget' > 0 (in bytes), unfiltered generation from conclusion strings or trees collects out-of-core, i.e. conclusions are partitioned by hash into buckets, of which the largest are moved to disk
+	// (at ./data/[<hash>/]/dProofs-withConclusions/dProofs-spill/) whenever the conclusion store exceeds the budget (see DlConclusionSpill). Results are identical, but checkpoints are unavailable in this mode.
+	// 'groupedEvaluation' (with 'useConclusionTrees') selects DlProofEnumeratorMode::FromGroupedConclusionTrees, i.e. conditionals are grouped by their antecedents up to variable renaming, and each minor premise
+	// is unified only once per group (and range of candidates), with the unifier applied to all consequents of the group. Results are identical.
+	// 'onlineSchemaRemoval' (with 'redundantSchemaRemoval', from conclusion strings or trees) rejects new conclusions with schemas among the conclusions of lower proof lengths before inserting them (via a DlSchemaIndex),
+	// such that they never occupy memory, and only conclusions with schemas of equal proof lengths are removed after collection. Since rejected conclusions are not remembered, their repetitions are
+	// checked again (i.e. this trades time for memory), and removal counts remain unknown. Results are identical, but checkpoints are unavailable in this mode.
+	static void generateDProofRepresentativeFiles(std::uint32_t limit = UINT32_MAX, bool redundantSchemaRemoval = true, bool withConclusions = true, std::size_t* candidateQueueCapacities = nullptr, std::size_t maxSymbolicConclusionLength = SIZE_MAX, std::size_t maxSymbolicConsequentLength = SIZE_MAX, bool useConclusionStrings = false, bool useConclusionTrees = false, bool useSchemaIndex = true, std::uint32_t checkpointInterval = 0, bool resume = false, std::size_t memoryBudget = 0, bool groupedEvaluation = false, bool onlineSchemaRemoval = false);
 	// Given word length limit n, filters a first unfiltered proof file (with conclusions) at ./data/dProofs-withConclusions/dProofs<n>-unfiltered<n>+.txt in order to create dProofs<n>.txt.
 	// The function utilizes multiple processes via Message Passing Interface (MPI) and assumes that MPI has been initialized with at least MPI_THREAD_FUNNELED threading support.
 	// Prints a warning message for single-process calls, i.e. when the executable was not called via "mpiexec -n <np> ./pmGenerator <args>" or "srun -n <np> ./pmGenerator <args>" (with np > 1), or similar.
-	// The schema checks are distributed among the processes, and candidates for removal are sent to the main thread of the main process for registration, as soon as they are detected.
-	// Finally, the main process (MPI_COMM_WORLD rank 0) waits until all other processes have finished, and stores the resulting database at ./data/dProofs-withConclusions/dProofs<n>.txt.
-	static void mpi_filterDProofRepresentativeFile(std::uint32_t wordLengthLimit, bool smoothProgress = true);
+	// Only the first process of each node loads the proof files, and provides their conclusions to all processes of its node via an MPI shared memory window (i.e. there is one copy per node),
+	// so that additionally, only the main process holds the unfiltered file's D-proofs. The schema checks are distributed among the processes, each of which registers its detections in a bitmap
+	// (see helper::IndexBitmap), while only their amounts are sent to the main process for progress information.
+	// Finally, the main process (MPI_COMM_WORLD rank 0) receives all bitmaps in compressed pieces, merging and writing them piece by piece, and thereby stores the resulting database
+	// at ./data/dProofs-withConclusions/dProofs<n>.txt.
+	// As for generateDProofRepresentativeFiles(), 'useSchemaIndex' = false selects brute-force schema checks (for cross-checking).
+	// When 'oneSidedBalancing' is set, workloads are not balanced via requests that are answered by the processes' main threads, but claimed in chunks via atomic fetch-and-add on counters
+	// in an MPI window (see _mpi_detectRedundantIndices_oneSided()). Either way, the main process prints all processes' idle times and amounts of sent messages, for comparison.
+	// For 'checkpointInterval' > 0, each process stores its completed ranges of positions and its detections at least every 'checkpointInterval' seconds (and when its workloads are complete)
+	// at ./data/[<hash>/]/dProofs-withConclusions/dProofs<n>-checkpoint-mpi/rank<r>.bin, which requires a data directory that is shared by all processes. For 'resume', the main process reads
+	// all checkpoints of equal settings (i.e. of previous runs with any amounts of processes), and merges them into its own checkpoint, so only the remaining positions are distributed.
+	static void mpi_filterDProofRepresentativeFile(std::uint32_t wordLengthLimit, bool smoothProgress = true, bool useSchemaIndex = true, bool oneSidedBalancing = false, std::uint32_t checkpointInterval = 0, bool resume = false);
+	// Generates unfiltered proof files with conclusions, i.e. ./data/dProofs-withConclusions/dProofs<n>-unfiltered<m>+.txt for n up to 'limit', beginning after the longest existing proof file.
+	// The function utilizes multiple processes via MPI (see mpi_filterDProofRepresentativeFile() for requirements), each of which loads all existing proof files. Candidate enumeration is distributed
+	// round-robin over segments (see DlCollectionPartition), and each conclusion is owned by one process via its hash. After each round, candidates are exchanged with their owners, who keep
+	// the shortest (then lexicographically smallest) D-proof per conclusion. Finally, the processes' new representatives are merged, so results are identical to those of generateDProofRepresentativeFiles().
+	// NOTE: All processes must be able to access the same data directory, i.e. multi-node runs require a shared file system.
+	static void mpi_generateDProofRepresentativeFiles(std::uint32_t limit = UINT32_MAX, bool useConclusionTrees = false);
 	// To create generator files with conclusions from those without, or vice versa. Generator files with conclusions are around four times bigger, with an increasing factor for increasing
 	// proof lengths, e.g. for 'dProofs17.txt' there is a factor (369412 bytes)/(93977 bytes) ≈ 3.93, and for 'dProofs29.txt' there is a factor (516720692 bytes)/(103477529 bytes) ≈ 4.99.
 	// Furthermore, files with conclusions have much higher entropy, thus can be compressed worse. For example, { 'dProofs17.txt', ..., 'dProofs29.txt' } can be compressed via LZMA to around
 	// around 42 MB when conclusions are stored (compression ratio 735676962/41959698 ≈ 17.53), but to around 1 MB when conclusions are omitted (compression ratio 150170911/1005537 ≈ 149.34).
-	static void createGeneratorFilesWithConclusions(const std::string& dataLocation = "data", const std::string& inputFilePrefix = "dProofs-withoutConclusions/dProofs", const std::string& outputFilePrefix = "dProofs-withConclusions/dProofs", bool memoryOnly = false, bool debug = false, const std::uint32_t* proofLenStepSize = nullptr);
-	static void createGeneratorFilesWithoutConclusions(const std::string& dataLocation = "data", const std::string& inputFilePrefix = "dProofs-withConclusions/dProofs", const std::string& outputFilePrefix = "dProofs-withoutConclusions/dProofs", bool memoryOnly = false, bool debug = false, const std::uint32_t* proofLenStepSize = nullptr);
+	// When 'binaryCompanions' is set, each created proof file is accompanied by a binary proof file (see DlProofFile), which is loaded via memory mapping instead of parsing the text file.
+	static void createGeneratorFilesWithConclusions(const std::string& dataLocation = "data", const std::string& inputFilePrefix = "dProofs-withoutConclusions/dProofs", const std::string& outputFilePrefix = "dProofs-withConclusions/dProofs", bool memoryOnly = false, bool binaryCompanions = false, bool debug = false, const std::uint32_t* proofLenStepSize = nullptr);
+	static void createGeneratorFilesWithoutConclusions(const std::string& dataLocation = "data", const std::string& inputFilePrefix = "dProofs-withConclusions/dProofs", const std::string& outputFilePrefix = "dProofs-withoutConclusions/dProofs", bool memoryOnly = false, bool binaryCompanions = false, bool debug = false, const std::uint32_t* proofLenStepSize = nullptr);
 
 	// Data search ; input files with conclusions are required
-	static std::map<std::string, std::string> searchProofFiles(const std::vector<std::string>& searchTerms, bool normalPolishNotation = false, bool searchProofs = false, unsigned schemaSearch = 0, const std::string* inputFile = nullptr, bool debug = false);
+	// Exact searches (i.e. for schemaSearch = 0) use the lookup index of the search path (see DlProofIndex) instead of reading the proof files whenever the index is up to date.
+	// When 'createIndex' is set, a missing or outdated lookup index is created (which requires to read all proof files once) before searching.
+	static std::map<std::string, std::string> searchProofFiles(const std::vector<std::string>& searchTerms, bool normalPolishNotation = false, bool searchProofs = false, unsigned schemaSearch = 0, const std::string* inputFile = nullptr, bool createIndex = false, bool debug = false);
+	// Creates the term index (see DlTermIndex) of the search path, which is used by schema searches (i.e. for schemaSearch > 0) instead of reading the proof files whenever it is up to date.
+	static void createTermIndex(bool debug = false);
+	// Query server ; keeps the proof files of the search path resident (via their term index, which is created first when it is missing or outdated), and answers requests
+	// in newline-delimited JSON (see helper::NdJson) from stdin or, if 'socketPath' is given, from connections to a Unix domain socket, until the input is exhausted.
+	static void serveQueries(const std::string* socketPath = nullptr, bool debug = false);
 	static void extractConclusions(ExtractionMethod method, std::uint32_t extractAmount, const std::string* config = nullptr, bool allowRedundantSchemaRemoval = false, bool forceRedundantSchemaRemoval = false, std::size_t bound1 = 0, std::size_t bound2 = 0, bool debug = false, std::string* optOut_createdExDir = nullptr);
 
 	// Data representation ; input files with conclusions are required
@@ -115,9 +223,34 @@ public:
 
 	// Helper functions
 private:
-	static void _collectProvenFormulas(tbb::concurrent_hash_map<std::string, std::string>& representativeProofs, std::uint32_t wordLengthLimit, DlProofEnumeratorMode mode, helper::ProgressData* const progressData, tbb::concurrent_unordered_map<std::string, std::string>* lookup_speedupN, std::atomic<std::uint64_t>* misses_speedupN, std::uint64_t* optOut_counter, std::uint64_t* optOut_conclusionCounter, std::uint64_t* optOut_redundantCounter, std::uint64_t* optOut_invalidCounter, const std::vector<std::uint32_t>* genIn_stack = nullptr, const std::uint32_t* genIn_n = nullptr, const std::vector<std::vector<std::string>>* genIn_allRepresentativesLookup = nullptr, const std::vector<std::vector<std::string>>* genIn_allConclusionsLookup = nullptr, std::vector<std::vector<std::shared_ptr<DlFormula>>>* genInOut_allParsedConclusions = nullptr, std::vector<std::vector<std::atomic<bool>>>* genInOut_allParsedConclusions_init = nullptr, std::size_t* candidateQueueCapacities = nullptr, std::size_t maxSymbolicConclusionLength = SIZE_MAX, std::size_t maxSymbolicConsequentLength = SIZE_MAX);
-	static void _removeRedundantConclusionsForProofsOfMaxLength(const std::uint32_t maxLength, tbb::concurrent_hash_map<std::string, std::string>& representativeProofs, helper::ProgressData* const progressData, std::uint64_t& conclusionCounter, std::uint64_t& redundantCounter);
-	static tbb_concurrent_unordered_set<std::uint64_t> _mpi_removeRedundantConclusionsForProofsOfMaxLength(int mpi_rank, int mpi_size, const std::uint32_t maxLength, tbb::concurrent_hash_map<std::string, std::string>& representativeProofs, const std::vector<std::string>& recentConclusionSequence, helper::ProgressData* const progressData, bool smoothProgress);
+	static void _collectProvenFormulas(DlConclusionStore& representativeProofs, std::uint32_t wordLengthLimit, DlProofEnumeratorMode mode, helper::ProgressData* const progressData, tbb::concurrent_unordered_map<std::string, std::string>* lookup_speedupN, std::atomic<std::uint64_t>* misses_speedupN, std::uint64_t* optOut_counter, std::uint64_t* optOut_conclusionCounter, std::uint64_t* optOut_redundantCounter, std::uint64_t* optOut_invalidCounter, const std::vector<std::uint32_t>* genIn_stack = nullptr, const std::uint32_t* genIn_n = nullptr, const std::vector<std::vector<std::string_view>>* genIn_allRepresentativesLookup = nullptr, const std::vector<std::vector<std::string_view>>* genIn_allConclusionsLookup = nullptr, std::vector<std::vector<DlFlatFormula>>* genInOut_allParsedConclusions = nullptr, std::vector<std::vector<std::atomic<bool>>>* genInOut_allParsedConclusions_init = nullptr, std::size_t* candidateQueueCapacities = nullptr, std::size_t maxSymbolicConclusionLength = SIZE_MAX, std::size_t maxSymbolicConsequentLength = SIZE_MAX, std::vector<std::chrono::microseconds>* optOut_workerIdleTimes = nullptr, const DlCollectionCheckpoint* resumePoint = nullptr, std::chrono::milliseconds checkpointInterval = std::chrono::milliseconds(0), const std::function<void(const DlCollectionCheckpoint&)>& fCheckpoint = nullptr, DlConclusionSpill* spill = nullptr, const DlCollectionPartition* partition = nullptr, std::uint64_t* optOut_skippedCounter = nullptr, bool onlineSchemaRemoval = false, std::uint64_t* optOut_subsumedCounter = nullptr);
+	static bool _writeCollectionCheckpoint(const std::string& file, const std::vector<std::uint64_t>& settings, const DlCollectionCheckpoint& checkpoint, const DlConclusionStore& representativeProofs, std::uint32_t wordLengthLimit);
+	static bool _readCollectionCheckpoint(const std::string& file, const std::vector<std::uint64_t>& settings, DlCollectionCheckpoint& checkpoint, DlConclusionStore& representativeProofs, std::string& error);
+	static bool _writeFilterCheckpoint(const std::string& file, const std::vector<std::uint64_t>& settings, const std::vector<std::array<std::uint64_t, 2>>& completed, const helper::IndexBitmap& redundant);
+	static bool _readFilterCheckpoint(const std::string& file, const std::vector<std::uint64_t>& settings, std::vector<std::array<std::uint64_t, 2>>& completed, helper::IndexBitmap& redundant, std::string& error); // merges into 'completed' (unordered) and 'redundant'
+	// A text proof file is available if it exists or if its xz archive exists (see DlProofArchive), in which case it is read from the archive. Returns nullptr if the file cannot be read.
+	static bool _proofFileExists(const std::string& file);
+	static std::unique_ptr<std::istream> _openProofFile(const std::string& file);
+	// Splits 'file' into up to 'chunkCount' byte ranges of similar sizes (but of at least 16 MiB), where each range consists of the lines that start within it, and reads the ranges concurrently.
+	// For an archived file, ranges consist of whole blocks, so an archive of a single block is read sequentially.
+	// Calls 'fInit(n)' with the amount n of ranges first, then 'fLine(chunk, line, content)' (with the range's index, the line's index within the range, and the line) for each line, in order
+	// within each range, until it returns false. Stores each range's amount of preceding lines in 'optOut_lineOffsets' (i.e. global line indices are given by 'optOut_lineOffsets[chunk] + line'),
+	// for which lines of stopped ranges are counted after all ranges are done, and stores the amount of bytes of all read lines in 'optOut_bytes'. Returns false iff the file cannot be read.
+	static bool _forEachLineInChunks(const std::string& file, const std::function<void(std::size_t)>& fInit, const std::function<bool(std::size_t, std::uint64_t, std::string&)>& fLine, std::vector<std::uint64_t>* optOut_lineOffsets = nullptr, std::uint64_t* optOut_bytes = nullptr, unsigned chunkCount = std::thread::hardware_concurrency());
+	// Lists the proof files (with conclusions) at 'filePrefix' that are searched, as pairs of proof lengths and first unfiltered proof lengths (or 0 for filtered files), and stores the
+	// first unfiltered proof length that is considered in 'unfiltered'.
+	static std::vector<std::pair<std::uint32_t, std::uint32_t>> _listProofFilesForSearch(const std::string& filePrefix, std::uint32_t& unfiltered);
+	// Reads the given proof files (as listed by _listProofFilesForSearch()) at 'searchPath' concurrently, but each file sequentially. Calls 'fLine(file, line, position, content)' for each
+	// line, and 'fFile(file, size, archived, lineCount)' after each file, where 'size' is the size of the text file, or of its archive if the file was read from its archive.
+	// Throws domain_error for erroneous lines. Returns false iff a file cannot be read.
+	static bool _readProofFilesForIndex(const std::string& searchPath, const std::vector<std::pair<std::uint32_t, std::uint32_t>>& files, const std::function<void(std::size_t, std::uint64_t, std::uint64_t, const std::string&)>& fLine, const std::function<void(std::size_t, std::uint64_t, std::int64_t, bool, std::uint64_t)>& fFile, bool debug);
+	// Creates the lookup index (see DlProofIndex) for the given proof files (of pairs of proof lengths and first unfiltered proof lengths, or 0 for filtered files) at 'searchPath'.
+	static bool _createSearchIndex(const std::string& searchPath, const std::vector<std::pair<std::uint32_t, std::uint32_t>>& files, bool debug);
+	static void _writeProofFileCompanion(const std::string& file, const std::vector<std::string_view>& dProofs, const std::vector<std::string_view>* conclusions);
+	static std::shared_ptr<const void> _readProofFileCompanion(const std::string& file, std::vector<std::string_view>& contents, std::vector<std::string_view>* conclusions, std::string& error); // returns the mapping which must outlive the views, or nullptr
+	static void _removeRedundantConclusionsForProofsOfMaxLength(const std::uint32_t maxLength, DlConclusionStore& representativeProofs, helper::ProgressData* const progressData, std::uint64_t& conclusionCounter, std::uint64_t& redundantCounter, bool useSchemaIndex = true, bool sameLengthOnly = false);
+	static helper::IndexBitmap _mpi_removeRedundantConclusionsForProofsOfMaxLength(int mpi_rank, int mpi_size, const std::vector<std::string_view>& conclusions, std::uint64_t recentBegin, helper::ProgressData* const progressData, bool smoothProgress, bool useSchemaIndex, bool oneSidedBalancing, DlFilterCheckpointing* checkpointing = nullptr);
+	static void _mpi_detectRedundantIndices_oneSided(int mpi_rank, int mpi_size, std::uint64_t n, const std::vector<std::uint64_t>& indexDistribution, const std::function<bool(std::uint64_t)>& isRedundant, helper::IndexBitmap& redundant, const std::function<void(std::uint64_t, std::uint64_t)>& fCompleted, helper::ProgressData* const progressData);
 
 public:
 	// Iterates condensed detachment strings for proofs in D-N-notation (i.e. rules D : modus ponens and N : necessitation are supported),
@@ -129,49 +262,72 @@ public:
 	// Strings of lengths of n + c and higher may not encode valid proofs, i.e. may result in unification failures upon parsing.
 	// One may customize what is being iterated by specifying the stack, i.e. { 0 } iterates all formulas, { s } for 0 < s <= n iterates formulas of length s, and
 	// { n + c } iterates all formulas of at least length n + c. Note that this can be combined with 'wordLengthLimit' := n + c to iterate only formulas of length n + c.
-	static void processCondensedDetachmentProofs_dynamic(const std::vector<std::uint32_t>& stack, std::uint32_t wordLengthLimit, std::uint32_t n, const std::vector<const std::vector<std::string>*>& allRepresentatives, const auto& fString, std::uint32_t necessitationLimit, std::size_t* candidateQueueCapacities = nullptr, unsigned concurrencyCount = std::thread::hardware_concurrency()) {
-		processCondensedDetachmentProofs_dynamic(stack, wordLengthLimit, n, composeToLookupVector(allRepresentatives), fString, necessitationLimit, candidateQueueCapacities, nullptr, nullptr, nullptr, concurrencyCount);
+	// 'checkpointing' != nullptr => positions are indices of candidate strings ; NOTE: Skipped candidates are still iterated (which is fast), but not processed.
+	static void processCondensedDetachmentProofs_dynamic(const std::vector<std::uint32_t>& stack, std::uint32_t wordLengthLimit, std::uint32_t n, const std::vector<const std::vector<std::string>*>& allRepresentatives, const auto& fString, std::uint32_t necessitationLimit, std::size_t* candidateQueueCapacities = nullptr, std::vector<std::chrono::microseconds>* optOut_workerIdleTimes = nullptr, const DlEnumerationCheckpointing* checkpointing = nullptr, unsigned concurrencyCount = std::thread::hardware_concurrency()) {
+		processCondensedDetachmentProofs_dynamic(stack, wordLengthLimit, n, composeToLookupVector(allRepresentatives), fString, necessitationLimit, candidateQueueCapacities, optOut_workerIdleTimes, checkpointing, concurrencyCount);
 	}
-	// default: parse full D-proofs
-	// 'allConclusionsLookup' != nullptr => use (stored) conclusion strings to parse final rules
-	// 'allConclusionsLookup' != nullptr && 'allParsedConclusions' != nullptr => use (stored) conclusion strings to parse and store unknown conclusion trees, and use those to parse final rules
-	// 'stack' and 'wordLengthLimit' are only used for default variant ; 'fString' must be defined accordingly (see _loadCondensedDetachmentProofs_useConclusions() for non-default variants)
-	static void processCondensedDetachmentProofs_dynamic(const std::vector<std::uint32_t>& stack, std::uint32_t wordLengthLimit, std::uint32_t n, const std::vector<std::vector<std::string>>& allRepresentativesLookup, const auto& fString, std::uint32_t necessitationLimit, std::size_t* candidateQueueCapacities = nullptr, const std::vector<std::vector<std::string>>* allConclusionsLookup = nullptr, std::vector<std::vector<std::shared_ptr<DlFormula>>>* allParsedConclusions = nullptr, std::vector<std::vector<std::atomic<bool>>>* allParsedConclusions_init = nullptr, unsigned concurrencyCount = std::thread::hardware_concurrency()) {
+	static void processCondensedDetachmentProofs_dynamic(const std::vector<std::uint32_t>& stack, std::uint32_t wordLengthLimit, std::uint32_t n, const std::vector<std::vector<std::string_view>>& allRepresentativesLookup, const auto& fString, std::uint32_t necessitationLimit, std::size_t* candidateQueueCapacities = nullptr, std::vector<std::chrono::microseconds>* optOut_workerIdleTimes = nullptr, const DlEnumerationCheckpointing* checkpointing = nullptr, unsigned concurrencyCount = std::thread::hardware_concurrency()) {
 		if (n % 2 == 0 && necessitationLimit == 0)
 			throw std::logic_error("Cannot have an even limit.");
-		if (!allConclusionsLookup) {
-			std::string prefix;
-			std::vector<std::uint32_t> _stack = stack;
-			if (concurrencyCount < 2) // call 'fString' only from this thread
-				_processCondensedDetachmentProofs_dynamic_seq(prefix, _stack, wordLengthLimit, n, allRepresentativesLookup, fString, necessitationLimit);
-			else { // call 'fString' from different threads ; NOTE: Iteration itself is super fast, so the worker threads' queues are loaded (and balanced while being processed) by this thread only.
-				std::vector<tbb::concurrent_bounded_queue<std::string>> queues(concurrencyCount);
-				if (candidateQueueCapacities)
-					for (tbb::concurrent_bounded_queue<std::string>& queue : queues)
-						queue.set_capacity(*candidateQueueCapacities);
-				_loadAndProcessQueuesConcurrently(concurrencyCount, queues, [&]() { _loadCondensedDetachmentProofs_dynamic_par(prefix, _stack, wordLengthLimit, n, allRepresentativesLookup, queues, necessitationLimit); }, fString);
-			}
-		} else {
-			std::vector<tbb::concurrent_bounded_queue<std::string>> queues(concurrencyCount);
-			if (candidateQueueCapacities)
-				for (tbb::concurrent_bounded_queue<std::string>& queue : queues)
-					queue.set_capacity(*candidateQueueCapacities);
-			_loadAndProcessQueuesConcurrently(concurrencyCount, queues, [&]() { _loadCondensedDetachmentProofs_useConclusions(n, allRepresentativesLookup, *allConclusionsLookup, queues, necessitationLimit, allParsedConclusions, allParsedConclusions_init); }, fString);
+		std::string prefix;
+		std::vector<std::uint32_t> _stack = stack;
+		if (concurrencyCount < 2) // call 'fString' only from this thread
+			_processSequentially(checkpointing, fString, [&](const auto& f) { _processCondensedDetachmentProofs_dynamic_seq(prefix, _stack, wordLengthLimit, n, allRepresentativesLookup, f, necessitationLimit); });
+		else { // call 'fString' from different threads ; NOTE: Iteration itself is super fast, so candidates are loaded by this thread only, and batches of them are stolen by idle worker threads.
+			std::vector<std::chrono::microseconds> idleTimes = _loadAndProcessConcurrently<std::string>(concurrencyCount, candidateQueueCapacities, [&](const std::function<void(const std::string&)>& fRegister) { _loadCondensedDetachmentProofs_dynamic_par(prefix, _stack, wordLengthLimit, n, allRepresentativesLookup, fRegister, necessitationLimit); }, fString, checkpointing);
+			if (optOut_workerIdleTimes)
+				*optOut_workerIdleTimes = std::move(idleTimes);
 		}
 	}
 
+	// Iterates rule candidates (see DlRuleCandidate) for proofs of length n + c (for proof length step size c) based on (stored) conclusion strings, which are used to evaluate final rules.
+	// 'allParsedConclusions' != nullptr => use (stored) conclusion strings to parse and store unknown conclusion trees, and use those to evaluate final rules
+	// 'fCandidate' must accept 'const DlRuleCandidate&' (see _processCondensedDetachmentProofs_useConclusions_par()). Candidates are distributed in ranges, but 'fCandidate' is called for each single candidate,
+	// unless 'fCandidate' accepts 'const DlRuleCandidateRange&', in which case it is called for each range (e.g. to process groups of 2nd inputs at once).
+	// 'checkpointing' != nullptr => positions are indices of segments, i.e. of tiles of candidates with consecutive inputs (see _processCondensedDetachmentProofs_useConclusions_par())
+	// 'partition' != nullptr => only candidates of the partition's segments are iterated (see DlCollectionPartition) ; cannot be combined with 'checkpointing'
+	// 'fSkipped' non-empty => D-rule candidates that cannot be unified due to incompatible skeletons (see DlSkeletonIndex) are not iterated, but their amounts are passed to 'fSkipped' (concurrently)
+	// 'groupAntecedents' => ranges of D-rule candidates (with 'fSkipped' non-empty) address groups of their 2nd inputs via 'DlRuleCandidateRange::groupsB'
+	static void processCondensedDetachmentProofs_useConclusions(std::uint32_t n, const std::vector<std::vector<std::string_view>>& allRepresentativesLookup, const std::vector<std::vector<std::string_view>>& allConclusionsLookup, const auto& fCandidate, std::uint32_t necessitationLimit, std::vector<std::vector<DlFlatFormula>>* allParsedConclusions = nullptr, std::vector<std::vector<std::atomic<bool>>>* allParsedConclusions_init = nullptr, std::vector<std::chrono::microseconds>* optOut_workerIdleTimes = nullptr, const DlEnumerationCheckpointing* checkpointing = nullptr, unsigned concurrencyCount = std::thread::hardware_concurrency(), const DlCollectionPartition* partition = nullptr, const std::function<void(std::uint64_t)>& fSkipped = nullptr, bool groupAntecedents = false) {
+		if (n % 2 == 0 && necessitationLimit == 0)
+			throw std::logic_error("Cannot have an even limit.");
+		tbb::task_arena arena(static_cast<int>(concurrencyCount));
+		std::vector<std::atomic<std::uint64_t>> busyTimes(arena.max_concurrency()); // in microseconds, for each arena slot
+		std::chrono::time_point<std::chrono::steady_clock> startTime = std::chrono::steady_clock::now();
+		arena.execute([&]() {
+			_processCondensedDetachmentProofs_useConclusions_par(n, allRepresentativesLookup, allConclusionsLookup, [&fCandidate, &busyTimes](const DlRuleCandidateRange& range) {
+				std::chrono::time_point<std::chrono::steady_clock> rangeStartTime = std::chrono::steady_clock::now();
+				if constexpr (std::is_invocable_v<decltype(fCandidate), const DlRuleCandidateRange&>)
+					fCandidate(range);
+				else {
+					DlRuleCandidate candidate = range.first;
+					if (range.indicesB)
+						for (std::uint32_t p = range.first.iB; p < range.end; p++) {
+							candidate.iB = range.indicesB[p];
+							fCandidate(static_cast<const DlRuleCandidate&>(candidate));
+						}
+					else
+						for (std::uint32_t& i = candidate.lenB ? candidate.iB : candidate.iA; i < range.end; i++)
+							fCandidate(static_cast<const DlRuleCandidate&>(candidate));
+				}
+				busyTimes[tbb::this_task_arena::current_thread_index()] += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - rangeStartTime).count();
+			}, necessitationLimit, allParsedConclusions, allParsedConclusions_init, checkpointing, partition, fSkipped, groupAntecedents);
+		});
+		if (optOut_workerIdleTimes)
+			*optOut_workerIdleTimes = _workerIdleTimes(busyTimes, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime));
+	}
+
 	// Iterates condensed detachment strings for proofs in D-notation.
 	// Strings of lengths of 3 and higher may not encode valid proofs, i.e. may result in unification failures upon parsing.
-	static void processCondensedDetachmentProofs_naive(std::uint32_t wordLengthLimit, const auto& fString, std::size_t* candidateQueueCapacities = nullptr, unsigned concurrencyCount = std::thread::hardware_concurrency()) {
+	// 'checkpointing' != nullptr => positions are indices of candidate strings ; NOTE: Skipped candidates are still iterated (which is fast), but not processed.
+	static void processCondensedDetachmentProofs_naive(std::uint32_t wordLengthLimit, const auto& fString, std::size_t* candidateQueueCapacities = nullptr, std::vector<std::chrono::microseconds>* optOut_workerIdleTimes = nullptr, const DlEnumerationCheckpointing* checkpointing = nullptr, unsigned concurrencyCount = std::thread::hardware_concurrency()) {
 		std::string prefix;
 		if (concurrencyCount < 2) // call 'fString' only from this thread
-			_processCondensedDetachmentProofs_naive_seq(prefix, 1, wordLengthLimit, fString);
-		else { // call 'fString' from different threads ; NOTE: Iteration itself is super fast, so the worker threads' queues are loaded (and balanced while being processed) by this thread only.
-			std::vector<tbb::concurrent_bounded_queue<std::string>> queues(concurrencyCount);
-			if (candidateQueueCapacities)
-				for (tbb::concurrent_bounded_queue<std::string>& queue : queues)
-					queue.set_capacity(*candidateQueueCapacities);
-			_loadAndProcessQueuesConcurrently(concurrencyCount, queues, [&]() { _loadCondensedDetachmentProofs_naive_par(prefix, 1, wordLengthLimit, queues); }, fString);
+			_processSequentially(checkpointing, fString, [&](const auto& f) { _processCondensedDetachmentProofs_naive_seq(prefix, 1, wordLengthLimit, f); });
+		else { // call 'fString' from different threads ; NOTE: Iteration itself is super fast, so candidates are loaded by this thread only, and batches of them are stolen by idle worker threads.
+			std::vector<std::chrono::microseconds> idleTimes = _loadAndProcessConcurrently<std::string>(concurrencyCount, candidateQueueCapacities, [&](const std::function<void(const std::string&)>& fRegister) { _loadCondensedDetachmentProofs_naive_par(prefix, 1, wordLengthLimit, fRegister); }, fString, checkpointing);
+			if (optOut_workerIdleTimes)
+				*optOut_workerIdleTimes = std::move(idleTimes);
 		}
 	}
 
@@ -188,127 +344,116 @@ private:
 	// after resulting in a parse error. When providing 'wordLengthLimit' := n + 2, this means to only iterate candidates of length n + 2 in an efficient way.
 	// For even n allowed, this similarly works with proofLengthCombinationsD_allLengths(n), e.g. n = 3 => A -> D X1 X2 | D X2 X1 | D X1 X3 | D X3 X1 | D X2 X2 | D X2 X3 | D X3 X2 | D X1 A | D A X1 | D X3 X3 | D X2 A | D A X2 | D X3 A | D A X3 | D A A
 	// [NOTE: Sequential non-generic variants (with explicit grammars given as comments) are available at https://github.com/deontic-logic/proof-tool/blob/29dd7dfab9f373d1dd387fb99c16e82c577ec21f/nortmann/DlProofEnumerator.h?ts=4#L167-L174 and below.]
-	static void _loadAndProcessQueuesConcurrently(unsigned concurrencyCount, std::vector<tbb::concurrent_bounded_queue<std::string>>& queues, const auto& loader, const auto& process);
-	static void _processCondensedDetachmentProofs_dynamic_seq(std::string& prefix, std::vector<std::uint32_t>& stack, std::uint32_t wordLengthLimit, std::uint32_t knownLimit, const std::vector<std::vector<std::string>>& allRepresentatives, const auto& fString, std::uint32_t necessitationLimit);
+	template<typename T> static std::vector<std::chrono::microseconds> _loadAndProcessConcurrently(unsigned concurrencyCount, std::size_t* candidateQueueCapacities, const auto& loader, const auto& process, const DlEnumerationCheckpointing* checkpointing = nullptr);
+	static void _processSequentially(const DlEnumerationCheckpointing* checkpointing, const auto& fString, const auto& enumerate); // calls 'enumerate' with 'fString' (or a variant of it for 'checkpointing')
+	static std::vector<std::chrono::microseconds> _workerIdleTimes(const std::vector<std::atomic<std::uint64_t>>& busyTimes, std::chrono::microseconds duration);
+	static void _processCondensedDetachmentProofs_dynamic_seq(std::string& prefix, std::vector<std::uint32_t>& stack, std::uint32_t wordLengthLimit, std::uint32_t knownLimit, const std::vector<std::vector<std::string_view>>& allRepresentatives, const auto& fString, std::uint32_t necessitationLimit);
 	static void _processCondensedDetachmentProofs_naive_seq(std::string& prefix, unsigned stackSize, std::uint32_t wordLengthLimit, const auto& fString);
-	static void _loadCondensedDetachmentProofs_dynamic_par(std::string& prefix, std::vector<std::uint32_t>& stack, std::uint32_t wordLengthLimit, std::uint32_t knownLimit, const std::vector<std::vector<std::string>>& allRepresentatives, std::vector<tbb::concurrent_bounded_queue<std::string>>& queues, std::uint32_t necessitationLimit);
-	static void _loadCondensedDetachmentProofs_naive_par(std::string& prefix, unsigned stackSize, std::uint32_t wordLengthLimit, std::vector<tbb::concurrent_bounded_queue<std::string>>& queues);
+	static void _loadCondensedDetachmentProofs_dynamic_par(std::string& prefix, std::vector<std::uint32_t>& stack, std::uint32_t wordLengthLimit, std::uint32_t knownLimit, const std::vector<std::vector<std::string_view>>& allRepresentatives, const std::function<void(const std::string&)>& fRegister, std::uint32_t necessitationLimit);
+	static void _loadCondensedDetachmentProofs_naive_par(std::string& prefix, unsigned stackSize, std::uint32_t wordLengthLimit, const std::function<void(const std::string&)>& fRegister);
 
 	// Similar to _loadCondensedDetachmentProofs_dynamic_par(), but can only generate unknown D-proofs of the smallest greater length (i.e. length of D-proofs with known conclusions increased by proof length step size),
 	// since all conclusions that serve as inputs of the topmost rule (two for D-rule; one for N-rule) are required to be known to evaluate the rule directly (tree unification in case of D-rule, string concatenation in case of N-rule).
-	// Registers strings like "D:<length of 1st input>,<length of 2nd input>:<index of 1st input>,<index of 2nd input>" or "N:<length of input>:<index of input>",
-	// such that allConclusions[<length of (|1st |2nd )input>][<index of (|1st |2nd ) input>] address conclusion strings to be used.
+	// Calls 'fRange' on ranges of up to 'candidateRangeSize' rule candidates (see DlRuleCandidate), such that allConclusions[<length of (|1st |2nd )input>][<index of (|1st |2nd ) input>] address conclusion strings to be used.
+	// Ranges are processed by nested TBB loops (i.e. distributed via work stealing) within the current task arena, so 'fRange' is called concurrently.
 	// When 'allParsedConclusions' is given, conclusions used by D-rules are additionally parsed and inserted into 'allParsedConclusions' at equal positions as in 'allConclusions'.
-	static void _loadCondensedDetachmentProofs_useConclusions(std::uint32_t knownLimit, const std::vector<std::vector<std::string>>& allRepresentatives, const std::vector<std::vector<std::string>>& allConclusions, std::vector<tbb::concurrent_bounded_queue<std::string>>& queues, std::uint32_t necessitationLimit, std::vector<std::vector<std::shared_ptr<DlFormula>>>* allParsedConclusions, std::vector<std::vector<std::atomic<bool>>>* allParsedConclusions_init);
+	// Candidates are grouped into segments of about 'candidateSegmentSize' candidates, which are the positions for 'checkpointing'. For D-rules, segments are tiles of consecutive 1st inputs and of up to
+	// 'candidateTileWidth' consecutive 2nd inputs, such that the 2nd inputs of a tile (and their parsed conclusions) fit into a core's L2 cache while being combined with all of the tile's 1st inputs.
+	// For N-rules, segments are groups of consecutive inputs.
+	// When 'fSkipped' is non-empty, only 2nd inputs with antecedents of skeletons compatible with their 1st inputs' skeletons (see DlSkeletonIndex) are iterated (addressed via 'DlRuleCandidateRange::indicesB'),
+	// and for each 1st input of a tile, the amount of the tile's other 2nd inputs is passed to 'fSkipped'. Segments remain the same (where columns are positions of 2nd inputs rather than their indices),
+	// so checkpoints are compatible in both modes. With 'groupAntecedents', 2nd inputs
+	// are additionally ordered by groups of equal antecedents (up to variable renaming), which are addressed via 'DlRuleCandidateRange::groupsB' (and may span multiple ranges).
+	static constexpr std::uint32_t candidateRangeSize = 64;
+	static constexpr std::uint32_t candidateSegmentSize = 65536;
+	static constexpr std::uint32_t candidateTileWidth = 1024; // NOTE: Must be a multiple of 'candidateRangeSize'. Parsed conclusions take some hundred bytes each, i.e. a tile's 2nd inputs take some hundred KiB.
+	static void _processCondensedDetachmentProofs_useConclusions_par(std::uint32_t knownLimit, const std::vector<std::vector<std::string_view>>& allRepresentatives, const std::vector<std::vector<std::string_view>>& allConclusions, const std::function<void(const DlRuleCandidateRange&)>& fRange, std::uint32_t necessitationLimit, std::vector<std::vector<DlFlatFormula>>* allParsedConclusions, std::vector<std::vector<std::atomic<bool>>>* allParsedConclusions_init, const DlEnumerationCheckpointing* checkpointing = nullptr, const DlCollectionPartition* partition = nullptr, const std::function<void(std::uint64_t)>& fSkipped = nullptr, bool groupAntecedents = false);
 };
 
-void DlProofEnumerator::_loadAndProcessQueuesConcurrently(unsigned concurrencyCount, std::vector<tbb::concurrent_bounded_queue<std::string>>& queues, const auto& loader, const auto& process) {
-	if (queues.size() != concurrencyCount)
-		throw std::invalid_argument("|queues| = " + std::to_string(queues.size()) + ", but concurrencyCount = " + std::to_string(concurrencyCount) + ".");
-
-	// 1. Prepare thread queues and worker threads.
-	constexpr unsigned tinyBound = 10;
-	constexpr unsigned sharingBound = 20;
-	std::mutex mtx;
-	std::unique_lock<std::mutex> condLock(mtx);
-	std::condition_variable cond;
-	std::vector<std::thread> threads;
-	std::atomic<bool> incomplete = true; // NOTE: Indicates whether balancing may still take place, not whether all all queues are empty.
-	auto worker = [&process, &queues, &cond, &incomplete](unsigned t) {
-		tbb::concurrent_bounded_queue<std::string>& queue = queues[t];
-		// NOTE: It is important to check '!queue.empty()' in loop header _after_ 'incomplete', since 'queue' might
-		//       become filled and 'incomplete' false, while this condition is being processed in this thread.
-		//       Since 'incomplete' can only become false after all queues are filled and no more balancing will
-		//       take place, evaluating 'incomplete' first ensures that whenever 'queue' is not filled completely,
-		//       the loop remains active, i.e. whenever !incomplete holds (such that '!queue.empty()' is checked here),
-		//       the loop is discontinued only if there is nothing left to process.
-		while (incomplete || !queue.empty()) {
-			std::string s;
-			if (queue.try_pop(s)) {
-				process(s);
-				if (queue.size() < tinyBound)
-					cond.notify_one(); // notify queue balancer
-			} else {
-				cond.notify_one(); // notify queue balancer
-				std::this_thread::yield();
-			}
-		}
+template<typename T>
+std::vector<std::chrono::microseconds> DlProofEnumerator::_loadAndProcessConcurrently(unsigned concurrencyCount, std::size_t* candidateQueueCapacities, const auto& loader, const auto& process, const DlEnumerationCheckpointing* checkpointing) {
+	// NOTE: Items are registered by 'loader' (in this thread) and gathered into batches, which are spawned as tasks of a dedicated task arena. TBB's scheduler is work-stealing,
+	//       i.e. idle worker threads take pending batches from busy ones, so there is neither a balancing thread nor any spinning on empty queues. While there are too many
+	//       pending batches (more than 'candidateQueueCapacities' allows for per worker thread), the loading thread processes its own batches rather than spawning them.
+	constexpr std::size_t batchSize = 16;
+	const std::size_t maxPendingBatches = candidateQueueCapacities ? std::max<std::size_t>((*candidateQueueCapacities * concurrencyCount + batchSize - 1) / batchSize, 1) : SIZE_MAX;
+	tbb::task_arena arena(static_cast<int>(concurrencyCount));
+	tbb::task_group group;
+	std::atomic<std::size_t> pendingBatches = 0;
+	std::vector<std::atomic<std::uint64_t>> busyTimes(arena.max_concurrency()); // in microseconds, for each arena slot
+	auto processBatch = [&process, &busyTimes](std::vector<T>& batch, bool measure) {
+		std::chrono::time_point<std::chrono::steady_clock> startTime = std::chrono::steady_clock::now();
+		for (T& item : batch)
+			process(item);
+		if (measure)
+			busyTimes[tbb::this_task_arena::current_thread_index()] += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
 	};
-	for (unsigned t = 0; t < concurrencyCount; t++)
-		threads.emplace_back(worker, t);
-
-	// 2. Line up the working queues.
-	loader();
-	//#std::cout << "Loader complete." << std::endl;
-
-	// 3. Balance the queues while they are being worked on.
-	//#std::size_t balanceCounter = 0;
-	while (true) {
-		// NOTE: Every worker thread with a tiny queue will spam notifications until 'incomplete' is set to false below this loop, i.e. there cannot be a deadlock based on 'cond'.
-		//       This way, no worker thread is ever blocked due to 'cond', which has better performance than utilizing locks to synchronize conditions.
-		cond.wait(condLock);
-		bool allTiny = true;
-		bool someTiny = false;
-		for (unsigned t = 0; t < queues.size(); t++)
-			if (queues[t].size() < tinyBound) {
-				someTiny = true;
-				if (!allTiny)
-					break;
-			} else {
-				allTiny = false;
-				if (someTiny)
-					break;
-			}
-		if (allTiny)
-			break;
-		if (someTiny) {
-			std::map<unsigned, unsigned> tinyCandidates;
-			std::map<unsigned, unsigned> sharingCandidates;
-			for (unsigned t = 0; t < queues.size(); t++) {
-				std::ptrdiff_t size = queues[t].size();
-				if (size < tinyBound)
-					tinyCandidates.emplace(size, t);
-				else if (size > sharingBound)
-					sharingCandidates.emplace(size, t);
-			}
-			while (!tinyCandidates.empty() && !sharingCandidates.empty()) {
-				std::map<unsigned, unsigned>::const_iterator itSmallest = tinyCandidates.begin();
-				std::map<unsigned, unsigned>::const_iterator itLargest = std::prev(sharingCandidates.end());
-				unsigned t_smallest = itSmallest->second;
-				unsigned t_largest = itLargest->second;
-				std::vector<std::string> tmp;
-				tbb::concurrent_bounded_queue<std::string>& queue_largest = queues[t_largest];
-				bool skip = false;
-				std::ptrdiff_t size_largest = queue_largest.size();
-				if (size_largest > sharingBound) { // ensure there still are enough elements
-					std::size_t halfSize = size_largest / 2;
-					if (halfSize >= tinyBound) { // ensure there still are enough elements, again
-						tbb::concurrent_bounded_queue<std::string>& queue_smallest = queues[t_smallest];
-						std::string s;
-						for (std::size_t i = 0; i < halfSize && queue_largest.try_pop(s); i++)
-							queue_smallest.push(s);
-						//#balanceCounter++;
-					} else
-						skip = true;
-				} else
-					skip = true;
-				if (!skip)
-					tinyCandidates.erase(itSmallest);
-				sharingCandidates.erase(itLargest);
+	std::chrono::time_point<std::chrono::steady_clock> startTime = std::chrono::steady_clock::now();
+	arena.execute([&]() {
+		std::shared_ptr<std::vector<T>> batch = std::make_shared<std::vector<T>>();
+		batch->reserve(batchSize);
+		auto flush = [&]() {
+			if (pendingBatches >= maxPendingBatches)
+				processBatch(*batch, false); // NOTE: Counted as part of the loading thread's busy time.
+			else {
+				pendingBatches++;
+				group.run([&processBatch, &pendingBatches, batch]() { processBatch(*batch, true); pendingBatches--; });
+				batch = std::make_shared<std::vector<T>>();
+				batch->reserve(batchSize);
 			}
-		}
-		//#auto queueSizesStr = [&]() -> std::string { std::stringstream ss; for (unsigned t = 0; t < queues.size(); t++) { if (t) ss << ", "; std::size_t size = queues[t].size(); ss << t << ": " << size; } return ss.str(); }; // requires '#include <sstream>'
-		//#std::cout << queueSizesStr() << std::endl; // print sizes of queues when a balancing attempt just took place
-	}
-	//#std::cout << "Balanced " << balanceCounter << " times." << std::endl;
+			batch->clear();
+		};
+		std::chrono::time_point<std::chrono::steady_clock> loadStartTime = std::chrono::steady_clock::now();
+		if (checkpointing) {
+			// NOTE: At a checkpoint, the loading thread waits for all spawned batches, so exactly the items before the current position have been processed.
+			std::uint64_t position = 0;
+			std::chrono::time_point<std::chrono::steady_clock> checkpointTime = loadStartTime;
+			loader(std::function<void(const T&)>([&](const T& item) {
+				if (position++ < checkpointing->resumePosition)
+					return;
+				batch->push_back(item);
+				if (batch->size() == batchSize) {
+					flush();
+					if (checkpointing->fCheckpoint && position % 1024 == 0 && std::chrono::steady_clock::now() - checkpointTime >= checkpointing->interval) {
+						group.wait();
+						checkpointing->fCheckpoint(position);
+						checkpointTime = std::chrono::steady_clock::now();
+					}
+				}
+			}));
+		} else
+			loader(std::function<void(const T&)>([&](const T& item) {
+				batch->push_back(item);
+				if (batch->size() == batchSize)
+					flush();
+			}));
+		if (!batch->empty())
+			flush();
+		busyTimes[tbb::this_task_arena::current_thread_index()] += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - loadStartTime).count();
+		group.wait(); // NOTE: The loading thread participates in processing the remaining batches.
+	});
+	return _workerIdleTimes(busyTimes, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime));
+}
 
-	// 4. Wait for all threads to complete.
-	incomplete = false;
-	for (unsigned t = 0; t < threads.size(); t++)
-		threads[t].join();
+void DlProofEnumerator::_processSequentially(const DlEnumerationCheckpointing* checkpointing, const auto& fString, const auto& enumerate) {
+	if (!checkpointing) {
+		enumerate(fString);
+		return;
+	}
+	std::uint64_t position = 0;
+	std::chrono::time_point<std::chrono::steady_clock> checkpointTime = std::chrono::steady_clock::now();
+	enumerate([&](std::string& sequence) {
+		if (position++ < checkpointing->resumePosition)
+			return;
+		fString(sequence);
+		if (checkpointing->fCheckpoint && position % 1024 == 0 && std::chrono::steady_clock::now() - checkpointTime >= checkpointing->interval) {
+			checkpointing->fCheckpoint(position);
+			checkpointTime = std::chrono::steady_clock::now();
+		}
+	});
 }
 
-void DlProofEnumerator::_processCondensedDetachmentProofs_dynamic_seq(std::string& prefix, std::vector<std::uint32_t>& stack, std::uint32_t wordLengthLimit, std::uint32_t knownLimit, const std::vector<std::vector<std::string>>& allRepresentatives, const auto& fString, std::uint32_t necessitationLimit) {
+void DlProofEnumerator::_processCondensedDetachmentProofs_dynamic_seq(std::string& prefix, std::vector<std::uint32_t>& stack, std::uint32_t wordLengthLimit, std::uint32_t knownLimit, const std::vector<std::vector<std::string_view>>& allRepresentatives, const auto& fString, std::uint32_t necessitationLimit) {
 	const std::uint32_t c = necessitationLimit ? 1 : 2; // proof length step size
 	bool singleStep = wordLengthLimit <= knownLimit + c;
 	const std::vector<std::pair<std::array<std::uint32_t, 2>, unsigned>> combinations = necessitationLimit ? proofLengthCombinationsD_allLengths(knownLimit, singleStep) : proofLengthCombinationsD_oddLengths(knownLimit, singleStep);
@@ -322,14 +467,14 @@ void DlProofEnumerator::_processCondensedDetachmentProofs_dynamic_seq(std::strin
 		if (stack.empty())
 			fString(prefix);
 		else {
-			auto countLeadingNs = [](const std::string& p) { std::uint32_t counter = 0; for (std::string::const_iterator it = p.begin(); it != p.end() && *it == 'N'; ++it) counter++; return counter; };
-			auto countTrailingNs = [](const std::string& p) { std::uint32_t counter = 0; for (std::string::const_reverse_iterator it = p.rbegin(); it != p.rend() && *it == 'N'; ++it) counter++; return counter; };
-			auto fittingNs = [&](const std::string& pre, const std::string& post) { return countTrailingNs(pre) + countLeadingNs(post) <= necessitationLimit; };
-			auto processX = [&](const std::vector<std::string>& representatives) {
+			auto countLeadingNs = [](std::string_view p) { std::uint32_t counter = 0; for (std::string_view::const_iterator it = p.begin(); it != p.end() && *it == 'N'; ++it) counter++; return counter; };
+			auto countTrailingNs = [](std::string_view p) { std::uint32_t counter = 0; for (std::string_view::const_reverse_iterator it = p.rbegin(); it != p.rend() && *it == 'N'; ++it) counter++; return counter; };
+			auto fittingNs = [&](std::string_view pre, std::string_view post) { return countTrailingNs(pre) + countLeadingNs(post) <= necessitationLimit; };
+			auto processX = [&](const std::vector<std::string_view>& representatives) {
 				std::vector<std::uint32_t> stack_copy; // Since there are multiple options, we use copies for all
 				std::string prefix_copy; //               but the last option, in order to restore the parameters.
-				std::vector<std::string>::const_iterator last = std::prev(representatives.end());
-				for (std::vector<std::string>::const_iterator it = representatives.begin(); it != last; ++it) {
+				std::vector<std::string_view>::const_iterator last = std::prev(representatives.end());
+				for (std::vector<std::string_view>::const_iterator it = representatives.begin(); it != last; ++it) {
 					stack_copy = stack;
 					prefix_copy = prefix;
 					if (ignoreN) {
@@ -354,8 +499,8 @@ void DlProofEnumerator::_processCondensedDetachmentProofs_dynamic_seq(std::strin
 				// 1/2 : {1,...,allRepresentatives[knownLimit].back()}, S, [] ; stack: pop current symbol, push nothing
 				std::vector<std::uint32_t> stack_copy; // Since there are multiple options, we use copies for all
 				std::string prefix_copy; //               but the last option, in order to restore the parameters.
-				auto processRepresentatives = [&](const std::vector<std::string>& representatives) {
-					for (const std::string& sequence : representatives) {
+				auto processRepresentatives = [&](const std::vector<std::string_view>& representatives) {
+					for (std::string_view sequence : representatives) {
 						stack_copy = stack;
 						prefix_copy = prefix;
 						if (ignoreN) {
@@ -420,7 +565,7 @@ void DlProofEnumerator::_processCondensedDetachmentProofs_dynamic_seq(std::strin
 			} else {
 				if (symbol > 1 && prefix.length() + symbol + stack.size() > wordLengthLimit + 1)
 					return; // cancel already if adding the below sequences would exceed the word length limit ; condition already outruled for 'symbol == 1'
-				const std::vector<std::string>& r = allRepresentatives[symbol];
+				const std::vector<std::string_view>& r = allRepresentatives[symbol];
 				if (r.empty())
 					return; // when X<symbol> is empty, throw out all stacks which make use of it
 				stack.pop_back(); // pop already for all cases
@@ -0,0 +1,146 @@
+#include "DlProofFile.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace std;
+namespace bip = boost::interprocess;
+
+namespace xamidi {
+namespace logic {
+
+namespace {
+constexpr char magic[8] = { 'p', 'm', 'G', 'e', 'n', 'P', 'r', 'f' };
+
+bool textFileStamp(const string& textFile, uint64_t& size, int64_t& time) {
+	filesystem::path path = filesystem::u8path(textFile);
+	error_code ec;
+	size = filesystem::file_size(path, ec);
+	if (ec)
+		return false;
+	time = static_cast<int64_t>(filesystem::last_write_time(path, ec).time_since_epoch().count());
+	return !ec;
+}
+}
+
+string DlProofFile::companionPath(const string& textFile) {
+	return (textFile.ends_with(".txt") ? textFile.substr(0, textFile.length() - 4) : textFile) + ".bin";
+}
+
+size_t DlProofFile::write(const string& textFile, const vector<string_view>& dProofs, const vector<string_view>* conclusions, const string& systemHash) {
+	if ((conclusions && conclusions->size() != dProofs.size()) || systemHash.length() > systemHashSize)
+		return 0;
+	uint64_t textFileSize;
+	int64_t textFileTime;
+	if (!textFileStamp(textFile, textFileSize, textFileTime))
+		return 0;
+	uint64_t n = dProofs.size();
+	vector<uint64_t> offsets(n + 1);
+	auto writeOffsets = [&](ofstream& fout, const vector<string_view>& entries, uint64_t position) {
+		for (size_t i = 0; i < entries.size(); i++) {
+			offsets[i] = position;
+			position += entries[i].length();
+		}
+		offsets[n] = position;
+		fout.write(reinterpret_cast<const char*>(offsets.data()), static_cast<streamsize>((n + 1) * sizeof(uint64_t)));
+		return position;
+	};
+	string file = companionPath(textFile);
+	filesystem::path path = filesystem::u8path(file);
+	filesystem::path tmpPath = filesystem::u8path(file + ".tmp");
+	ofstream fout(tmpPath, fstream::out | fstream::binary | fstream::trunc);
+	if (!fout.is_open())
+		return 0;
+	char header[headerSize] = { };
+	uint32_t flags = conclusions ? 1 : 0;
+	memcpy(header, magic, 8);
+	memcpy(header + 8, &version, 4);
+	memcpy(header + 12, &flags, 4);
+	memcpy(header + 16, &n, 8);
+	memcpy(header + 24, &textFileSize, 8);
+	memcpy(header + 32, &textFileTime, 8);
+	memcpy(header + 40, systemHash.data(), systemHash.length());
+	fout.write(header, headerSize);
+	uint64_t position = headerSize + (conclusions ? 2 : 1) * (n + 1) * sizeof(uint64_t);
+	position = writeOffsets(fout, dProofs, position);
+	if (conclusions)
+		position = writeOffsets(fout, *conclusions, position);
+	for (const string_view& s : dProofs)
+		fout.write(s.data(), static_cast<streamsize>(s.length()));
+	if (conclusions)
+		for (const string_view& s : *conclusions)
+			fout.write(s.data(), static_cast<streamsize>(s.length()));
+	fout.close();
+	if (!fout)
+		return 0;
+	error_code ec;
+	filesystem::rename(tmpPath, path, ec); // replaces the companion atomically, so processes which still map the old one keep reading consistent contents
+	return ec ? 0 : position;
+}
+
+bool DlProofFile::open(const string& textFile, const string& systemHash, string* optOut_error) {
+	auto fail = [&](const string& error) {
+		if (optOut_error)
+			*optOut_error = error;
+		region = bip::mapped_region();
+		mapping = bip::file_mapping();
+		data = nullptr;
+		dProofOffsets = nullptr;
+		conclusionOffsets = nullptr;
+		count = 0;
+		return false;
+	};
+	string file = companionPath(textFile);
+	error_code ec;
+	uint64_t fileSize = filesystem::file_size(filesystem::u8path(file), ec);
+	if (ec)
+		return fail("missing file");
+	uint64_t textFileSize;
+	int64_t textFileTime;
+	if (!textFileStamp(textFile, textFileSize, textFileTime))
+		return fail("missing text file");
+	if (fileSize < headerSize + sizeof(uint64_t))
+		return fail("truncated file");
+	try {
+		mapping = bip::file_mapping(file.c_str(), bip::read_only);
+		region = bip::mapped_region(mapping, bip::read_only);
+	} catch (bip::interprocess_exception& e) {
+		return fail(string("failed mapping (") + e.what() + ")");
+	}
+	if (region.get_size() != fileSize)
+		return fail("failed mapping");
+	data = static_cast<const char*>(region.get_address());
+	uint32_t _version;
+	uint32_t flags;
+	uint64_t n;
+	uint64_t recordedTextFileSize;
+	int64_t recordedTextFileTime;
+	memcpy(&_version, data + 8, 4);
+	memcpy(&flags, data + 12, 4);
+	memcpy(&n, data + 16, 8);
+	memcpy(&recordedTextFileSize, data + 24, 8);
+	memcpy(&recordedTextFileTime, data + 32, 8);
+	if (memcmp(data, magic, 8) || _version != version || flags > 1)
+		return fail("unknown format");
+	if (systemHash.length() > systemHashSize || memcmp(data + 40, systemHash.data(), systemHash.length()) || (systemHash.length() < systemHashSize && data[40 + systemHash.length()]))
+		return fail("different proof system");
+	if (recordedTextFileSize != textFileSize || recordedTextFileTime != textFileTime)
+		return fail("outdated file");
+	uint64_t tables = flags ? 2 : 1;
+	if (n > (fileSize - headerSize) / (tables * sizeof(uint64_t)) - 1)
+		return fail("truncated file");
+	dProofOffsets = reinterpret_cast<const uint64_t*>(data + headerSize);
+	conclusionOffsets = flags ? dProofOffsets + n + 1 : nullptr;
+	const uint64_t* end = (conclusionOffsets ? conclusionOffsets : dProofOffsets) + n;
+	if (dProofOffsets[0] != headerSize + tables * (n + 1) * sizeof(uint64_t) || (conclusionOffsets && conclusionOffsets[0] != dProofOffsets[n]) || *end != fileSize)
+		return fail("inconsistent offsets");
+	for (const uint64_t* it = dProofOffsets; it != end; ++it) // NOTE: Both tables are adjacent, so along with the above bounds, this ensures that every entry lies within the file.
+		if (it[0] > it[1])
+			return fail("inconsistent offsets");
+	count = n;
+	return true;
+}
+
+}
+}
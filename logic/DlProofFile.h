@@ -0,0 +1,54 @@
+#ifndef XAMIDI_LOGIC_DLPROOFFILE_H
+#define XAMIDI_LOGIC_DLPROOFFILE_H
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace xamidi {
+namespace logic {
+
+// Read-only memory mapping of a binary proof file, i.e. of a companion (e.g. "dProofs29.bin") of a text proof file (e.g. "dProofs29.txt") with the same entries in the same order.
+// Layout (native byte order): 104-byte header { char[8] "pmGenPrf", uint32 version, uint32 flags (1: with conclusions), uint64 entry count n, uint64 size of the text file in bytes,
+// int64 last write time of the text file (in ticks of std::filesystem::file_time_type), char[64] system hash (zero-padded, empty for the built-in system) }, uint64 D-proof offsets[n + 1], [uint64 conclusion offsets[n + 1],] D-proof bytes, [conclusion bytes].
+// Offsets are positions in the file, where entry i occupies [offsets[i], offsets[i + 1]). There are no separators, so entries are accessed via std::string_view without any parsing.
+// NOTE: Mappings are shared, so the page cache holds a file's contents only once for all processes that map it (e.g. concurrent jobs on one node).
+//       A companion is considered valid only as long as its text file has the recorded size and last write time, since text proof files (but not their companions) are replaced by proof generation,
+//       and since edits which preserve a file's size would otherwise go unnoticed. Companions are written to a temporary file first, so neither an interrupted write
+//       nor a rewrite while other processes map the file leaves them with a truncated companion.
+struct DlProofFile {
+	static constexpr std::uint32_t version = 2;
+	static constexpr std::size_t headerSize = 104;
+	static constexpr std::size_t systemHashSize = 64;
+private:
+	boost::interprocess::file_mapping mapping;
+	boost::interprocess::mapped_region region;
+	const char* data = nullptr;
+	const std::uint64_t* dProofOffsets = nullptr;
+	const std::uint64_t* conclusionOffsets = nullptr; // nullptr if without conclusions
+	std::size_t count = 0;
+public:
+	// Path of the binary companion of a text proof file, i.e. with ".txt" replaced by ".bin".
+	static std::string companionPath(const std::string& textFile);
+
+	// Writes the entries (where 'conclusions' may be nullptr, or must be of the same size as 'dProofs') of the completely written (i.e. closed) 'textFile' to its companion. Returns the amount of bytes written, or 0 on failure.
+	static std::size_t write(const std::string& textFile, const std::vector<std::string_view>& dProofs, const std::vector<std::string_view>* conclusions, const std::string& systemHash);
+
+	// Maps the companion of 'textFile'. Fails (and stores the reason in 'optOut_error') when the companion is missing or malformed, or when it belongs to another system or to a different text file.
+	bool open(const std::string& textFile, const std::string& systemHash, std::string* optOut_error = nullptr);
+
+	std::size_t size() const { return count; }
+	bool hasConclusions() const { return conclusionOffsets; }
+	std::string_view dProof(std::size_t i) const { return std::string_view(data + dProofOffsets[i], dProofOffsets[i + 1] - dProofOffsets[i]); }
+	std::string_view conclusion(std::size_t i) const { return std::string_view(data + conclusionOffsets[i], conclusionOffsets[i + 1] - conclusionOffsets[i]); }
+};
+
+}
+}
+
+#endif // XAMIDI_LOGIC_DLPROOFFILE_H
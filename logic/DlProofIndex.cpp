@@ -0,0 +1,137 @@
+#include "DlProofIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace std;
+namespace bip = boost::interprocess;
+
+namespace xamidi {
+namespace logic {
+
+namespace {
+constexpr char magic[8] = { 'p', 'm', 'G', 'e', 'n', 'I', 'd', 'x' };
+}
+
+string DlProofIndex::indexPath(const string& searchPath) {
+	return searchPath + "dProofs-index.bin";
+}
+
+uint64_t DlProofIndex::fingerprint(string_view s) {
+	uint64_t h = 14695981039346656037u;
+	for (char c : s) {
+		h ^= static_cast<unsigned char>(c);
+		h *= 1099511628211u;
+	}
+	return h;
+}
+
+size_t DlProofIndex::write(const string& file, const vector<FileRecord>& files, const vector<uint64_t>& lineOffsets, const vector<Entry>& conclusions, const vector<Entry>& dProofs, const string& systemHash, uint32_t lineStep) {
+	if (conclusions.size() != dProofs.size() || systemHash.length() > systemHashSize || !lineStep)
+		return 0;
+	filesystem::path path = filesystem::u8path(file);
+	filesystem::path tmpPath = filesystem::u8path(file + ".tmp");
+	ofstream fout(tmpPath, fstream::out | fstream::binary | fstream::trunc);
+	if (!fout.is_open())
+		return 0;
+	char header[headerSize] = { };
+	uint64_t m = files.size();
+	uint64_t n = conclusions.size();
+	uint64_t k = lineOffsets.size();
+	memcpy(header, magic, 8);
+	memcpy(header + 8, &version, 4);
+	memcpy(header + 12, &lineStep, 4);
+	memcpy(header + 16, &m, 8);
+	memcpy(header + 24, &n, 8);
+	memcpy(header + 32, &k, 8);
+	memcpy(header + 40, systemHash.data(), systemHash.length());
+	fout.write(header, headerSize);
+	fout.write(reinterpret_cast<const char*>(files.data()), static_cast<streamsize>(m * sizeof(FileRecord)));
+	fout.write(reinterpret_cast<const char*>(lineOffsets.data()), static_cast<streamsize>(k * sizeof(uint64_t)));
+	fout.write(reinterpret_cast<const char*>(conclusions.data()), static_cast<streamsize>(n * sizeof(Entry)));
+	fout.write(reinterpret_cast<const char*>(dProofs.data()), static_cast<streamsize>(n * sizeof(Entry)));
+	fout.close();
+	if (!fout)
+		return 0;
+	error_code ec;
+	filesystem::rename(tmpPath, path, ec);
+	return ec ? 0 : headerSize + m * sizeof(FileRecord) + k * sizeof(uint64_t) + 2 * n * sizeof(Entry);
+}
+
+bool DlProofIndex::open(const string& file, const string& systemHash, string* optOut_error) {
+	auto fail = [&](const string& error) {
+		if (optOut_error)
+			*optOut_error = error;
+		region = bip::mapped_region();
+		mapping = bip::file_mapping();
+		files = nullptr;
+		lineOffsets = nullptr;
+		conclusionEntries = nullptr;
+		dProofEntries = nullptr;
+		fileAmount = 0;
+		count = 0;
+		step = 0;
+		return false;
+	};
+	error_code ec;
+	uint64_t fileSize = filesystem::file_size(filesystem::u8path(file), ec);
+	if (ec)
+		return fail("missing file");
+	if (fileSize < headerSize)
+		return fail("truncated file");
+	try {
+		mapping = bip::file_mapping(file.c_str(), bip::read_only);
+		region = bip::mapped_region(mapping, bip::read_only);
+	} catch (bip::interprocess_exception& e) {
+		return fail(string("failed mapping (") + e.what() + ")");
+	}
+	if (region.get_size() != fileSize)
+		return fail("failed mapping");
+	const char* data = static_cast<const char*>(region.get_address());
+	uint32_t _version;
+	uint32_t lineStep;
+	uint64_t m;
+	uint64_t n;
+	uint64_t k;
+	memcpy(&_version, data + 8, 4);
+	memcpy(&lineStep, data + 12, 4);
+	memcpy(&m, data + 16, 8);
+	memcpy(&n, data + 24, 8);
+	memcpy(&k, data + 32, 8);
+	if (memcmp(data, magic, 8) || _version != version || !lineStep)
+		return fail("unknown format");
+	if (systemHash.length() > systemHashSize || memcmp(data + 40, systemHash.data(), systemHash.length()) || (systemHash.length() < systemHashSize && data[40 + systemHash.length()]))
+		return fail("different proof system");
+	uint64_t remaining = fileSize - headerSize;
+	if (m > remaining / sizeof(FileRecord) || k > (remaining -= m * sizeof(FileRecord)) / sizeof(uint64_t) || n > (remaining -= k * sizeof(uint64_t)) / (2 * sizeof(Entry)) || remaining != 2 * n * sizeof(Entry))
+		return fail("truncated file");
+	files = reinterpret_cast<const FileRecord*>(data + headerSize);
+	lineOffsets = reinterpret_cast<const uint64_t*>(files + m);
+	conclusionEntries = reinterpret_cast<const Entry*>(lineOffsets + k);
+	dProofEntries = conclusionEntries + n;
+	uint64_t lines = 0;
+	for (uint64_t i = 0; i < m; i++) {
+		if (files[i].firstOffset + (files[i].lineCount + lineStep - 1) / lineStep > k)
+			return fail("inconsistent offsets");
+		lines += files[i].lineCount;
+	}
+	if (lines != n)
+		return fail("inconsistent line counts");
+	fileAmount = m;
+	count = n;
+	step = lineStep;
+	return true;
+}
+
+pair<const DlProofIndex::Entry*, const DlProofIndex::Entry*> DlProofIndex::findConclusion(uint64_t fingerprint) const {
+	return equal_range(conclusionEntries, conclusionEntries + count, Entry { fingerprint, 0 }, [](const Entry& a, const Entry& b) { return a.fingerprint < b.fingerprint; });
+}
+
+pair<const DlProofIndex::Entry*, const DlProofIndex::Entry*> DlProofIndex::findDProof(uint64_t fingerprint) const {
+	return equal_range(dProofEntries, dProofEntries + count, Entry { fingerprint, 0 }, [](const Entry& a, const Entry& b) { return a.fingerprint < b.fingerprint; });
+}
+
+}
+}
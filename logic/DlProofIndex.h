@@ -0,0 +1,88 @@
+#ifndef XAMIDI_LOGIC_DLPROOFINDEX_H
+#define XAMIDI_LOGIC_DLPROOFINDEX_H
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace xamidi {
+namespace logic {
+
+// Read-only memory mapping of a lookup index (e.g. "dProofs-index.bin") for the proof files (with conclusions) of a data directory, which maps fingerprints of conclusions and of
+// D-proofs to their lines. Layout (native byte order): 104-byte header { char[8] "pmGenIdx", uint32 version, uint32 line step s, uint64 file count m, uint64 entry count n,
+// uint64 line offset count k, char[64] system hash (zero-padded, empty for the built-in system) }, FileRecord files[m], uint64 line offsets[k], Entry conclusions[n], Entry dProofs[n].
+// Both entry tables are sorted by fingerprint (and then by location), so lookups are binary searches. A location refers to a file and a line (see location()), and the line offsets of
+// a file (starting at its 'firstOffset') are the positions of every s-th of its lines, i.e. a line can be read by seeking to the preceding offset and skipping less than s lines.
+// NOTE: Fingerprints are not unique, so the lines of all locations found for a fingerprint must be compared with the search term.
+//       An index is considered valid only as long as all of its files have the recorded sizes and last write times (see FileRecord), since proof files are replaced by proof generation,
+//       and since edits which preserve a file's size would otherwise go unnoticed. Indices are written to a temporary file first, so an interrupted write leaves no truncated index behind.
+struct DlProofIndex {
+	static constexpr std::uint32_t version = 2;
+	static constexpr std::size_t headerSize = 104;
+	static constexpr std::size_t systemHashSize = 64;
+	static constexpr std::uint32_t defaultLineStep = 1024;
+	struct FileRecord {
+		std::uint32_t wordLengthLimit; // proof length of all entries of the file
+		std::uint32_t unfiltered; // 0 for a filtered file, otherwise the first unfiltered proof length (e.g. 17 for "dProofs25-unfiltered17+.txt")
+		std::uint32_t flags; // 1: indexed via archive
+		std::uint32_t reserved;
+		std::uint64_t size; // of the text file or, if the file was indexed via archive, of the archive
+		std::int64_t time; // last write time of the same file, in ticks of std::filesystem::file_time_type
+		std::uint64_t lineCount;
+		std::uint64_t firstOffset; // index of the file's first line offset
+	};
+	struct Entry {
+		std::uint64_t fingerprint;
+		std::uint64_t location;
+		bool operator<(const Entry& other) const { return fingerprint < other.fingerprint || (fingerprint == other.fingerprint && location < other.location); }
+	};
+private:
+	boost::interprocess::file_mapping mapping;
+	boost::interprocess::mapped_region region;
+	const FileRecord* files = nullptr;
+	const std::uint64_t* lineOffsets = nullptr;
+	const Entry* conclusionEntries = nullptr;
+	const Entry* dProofEntries = nullptr;
+	std::size_t fileAmount = 0;
+	std::size_t count = 0;
+	std::uint32_t step = 0;
+public:
+	// Path of the lookup index for the proof files in 'searchPath' (e.g. "data/dProofs-withConclusions/").
+	static std::string indexPath(const std::string& searchPath);
+
+	// Stable 64-bit fingerprint (FNV-1a) of a conclusion or a D-proof.
+	static std::uint64_t fingerprint(std::string_view s);
+
+	// Locations are combined file indices (upper 24 bits) and line indices (lower 40 bits) ; in particular, locations within a file are ordered like its lines.
+	static std::uint64_t location(std::size_t fileIndex, std::uint64_t line) { return static_cast<std::uint64_t>(fileIndex) << 40 | line; }
+	static std::size_t fileIndexOf(std::uint64_t location) { return static_cast<std::size_t>(location >> 40); }
+	static std::uint64_t lineOf(std::uint64_t location) { return location & ((std::uint64_t(1) << 40) - 1); }
+
+	// Writes an index (where 'conclusions' and 'dProofs' must be sorted and of equal size) to 'file'. Returns the amount of bytes written, or 0 on failure.
+	static std::size_t write(const std::string& file, const std::vector<FileRecord>& files, const std::vector<std::uint64_t>& lineOffsets, const std::vector<Entry>& conclusions, const std::vector<Entry>& dProofs, const std::string& systemHash, std::uint32_t lineStep);
+
+	// Maps the index at 'file'. Fails (and stores the reason in 'optOut_error') when the index is missing or malformed, or when it belongs to another system.
+	bool open(const std::string& file, const std::string& systemHash, std::string* optOut_error = nullptr);
+
+	std::size_t size() const { return count; }
+	std::size_t fileCount() const { return fileAmount; }
+	const FileRecord& fileRecord(std::size_t i) const { return files[i]; }
+
+	// Position of the latest line at or before 'line' of the i-th file whose position is recorded, and the index of that line.
+	std::pair<std::uint64_t, std::uint64_t> seekPosition(std::size_t i, std::uint64_t line) const { std::uint64_t k = line / step; return { lineOffsets[files[i].firstOffset + k], k * step }; }
+
+	// Ranges of entries with the given fingerprint, ordered by location.
+	std::pair<const Entry*, const Entry*> findConclusion(std::uint64_t fingerprint) const;
+	std::pair<const Entry*, const Entry*> findDProof(std::uint64_t fingerprint) const;
+};
+
+}
+}
+
+#endif // XAMIDI_LOGIC_DLPROOFINDEX_H
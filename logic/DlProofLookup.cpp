@@ -0,0 +1,74 @@
+#include "DlProofLookup.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+using namespace std;
+
+namespace xamidi {
+namespace logic {
+
+DlProofLookup::DlProofLookup(DlProofLookup&& other) noexcept :
+		vector<vector<string_view>>(move(other)), owners(move(other.owners)), next(exchange(other.next, nullptr)), remaining(exchange(other.remaining, 0)) {
+}
+
+DlProofLookup& DlProofLookup::operator=(DlProofLookup&& other) noexcept {
+	vector<vector<string_view>>::operator=(move(other));
+	owners = move(other.owners);
+	next = exchange(other.next, nullptr);
+	remaining = exchange(other.remaining, 0);
+	return *this;
+}
+
+void DlProofLookup::keep(shared_ptr<const void> owner) {
+	owners.push_back(move(owner));
+}
+
+string_view DlProofLookup::store(string_view entry) {
+	constexpr size_t bufferSize = 1 << 20;
+	if (entry.length() > remaining) {
+		size_t size = max(bufferSize, entry.length());
+		shared_ptr<char[]> buffer(new char[size]);
+		next = buffer.get();
+		remaining = size;
+		owners.push_back(move(buffer));
+	}
+	memcpy(next, entry.data(), entry.length());
+	string_view copy(next, entry.length());
+	next += entry.length();
+	remaining -= entry.length();
+	return copy;
+}
+
+shared_ptr<const void> DlProofLookup::concatenate(vector<vector<string>>& entries, vector<string_view>& target) {
+	size_t size = 0;
+	size_t amount = 0;
+	for (const vector<string>& chunk : entries) {
+		for (const string& s : chunk)
+			size += s.length();
+		amount += chunk.size();
+	}
+	shared_ptr<char[]> buffer(new char[max<size_t>(size, 1)]);
+	char* next = buffer.get();
+	target.reserve(target.size() + amount);
+	for (vector<string>& chunk : entries) {
+		for (const string& s : chunk) {
+			memcpy(next, s.data(), s.length());
+			target.emplace_back(next, s.length());
+			next += s.length();
+		}
+		vector<string>().swap(chunk);
+	}
+	return buffer;
+}
+
+void DlProofLookup::clear() {
+	vector<vector<string_view>>::clear();
+	owners.clear();
+	next = nullptr;
+	remaining = 0;
+}
+
+}
+}
@@ -0,0 +1,47 @@
+#ifndef XAMIDI_LOGIC_DLPROOFLOOKUP_H
+#define XAMIDI_LOGIC_DLPROOFLOOKUP_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace xamidi {
+namespace logic {
+
+// Entries of proof files by proof length, i.e. (*this)[n] holds views of the D-proofs (or of the conclusions) of length n, as a replacement for std::vector<std::vector<std::string>>.
+// The viewed memory is owned by the lookup, e.g. memory-mapped binary proof files (see DlProofFile) stay mapped for the lifetime of the lookup, such that their entries are never copied.
+// Other entries are copied into buffers of the lookup, which saves the per-entry overhead of std::string.
+// NOTE: Views remain valid until the lookup is cleared or destroyed. keep() and store() are not thread-safe.
+struct DlProofLookup : public std::vector<std::vector<std::string_view>> {
+private:
+	std::vector<std::shared_ptr<const void>> owners;
+	char* next = nullptr; // next unused byte of the current buffer of store()
+	std::size_t remaining = 0;
+public:
+	using std::vector<std::vector<std::string_view>>::vector;
+	DlProofLookup() = default;
+	DlProofLookup(const DlProofLookup&) = delete;
+	DlProofLookup(DlProofLookup&& other) noexcept;
+	DlProofLookup& operator=(const DlProofLookup&) = delete;
+	DlProofLookup& operator=(DlProofLookup&& other) noexcept;
+
+	// Keeps 'owner' (e.g. a mapped DlProofFile) alive until the lookup is cleared or destroyed, in order to store views into memory owned by 'owner'.
+	void keep(std::shared_ptr<const void> owner);
+
+	// Copies 'entry' into a buffer of the lookup, and returns a view of the copy.
+	std::string_view store(std::string_view entry);
+
+	// Copies all 'entries' into a single buffer (which is returned, in order to be kept via keep()), and appends views of the copies to 'target'. Frees 'entries' on the fly.
+	// Thread-safe, such that files can be loaded concurrently.
+	static std::shared_ptr<const void> concatenate(std::vector<std::vector<std::string>>& entries, std::vector<std::string_view>& target);
+
+	// Removes all entries and releases all owned memory.
+	void clear();
+};
+
+}
+}
+
+#endif // XAMIDI_LOGIC_DLPROOFLOOKUP_H
@@ -0,0 +1,138 @@
+#include "DlSchemaIndex.h"
+
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+namespace xamidi {
+namespace logic {
+
+DlSchemaIndex::DlSchemaIndex(size_t bucketCapacity) :
+		nodes(1), bucketCapacity(bucketCapacity ? bucketCapacity : 1) {
+}
+
+void DlSchemaIndex::insert(string_view formula, uint32_t id) {
+	uint32_t nodeIndex = 0;
+	uint32_t offset = 0;
+	while (true) {
+		Node& node = nodes[nodeIndex];
+		if (node.leaf) {
+			node.entries.push_back(Entry { formula.data(), static_cast<uint32_t>(formula.length()), offset, id });
+			if (node.entries.size() > bucketCapacity)
+				_split(nodeIndex);
+			break;
+		}
+		if (offset == formula.length()) {
+			node.entries.push_back(Entry { formula.data(), static_cast<uint32_t>(formula.length()), offset, id });
+			break;
+		}
+		char c = _readSymbol(formula, offset);
+		nodeIndex = _obtainChild(nodeIndex, c); // NOTE: May invalidate 'node'.
+	}
+	formulaCounter++;
+}
+
+unsigned DlSchemaIndex::operatorArity(char c) {
+	switch (c) { // NOTE: Operator classes as in DlCore::traverseFormulas_polishNotation_noRename_numVars().
+	case 'V':
+	case 'O':
+		return 0;
+	case 'N':
+	case 'L':
+	case 'M':
+	case 'Z':
+	case 'P':
+		return 1;
+	case 'K':
+	case 'A':
+	case 'D':
+	case 'X':
+	case 'C':
+	case 'B':
+	case 'F':
+	case 'G':
+	case 'E':
+	case 'J':
+	case 'S':
+	case 'U':
+		return 2;
+	default:
+		throw domain_error("Unknown Łukasiewicz operator '" + string { c } + "'.");
+	}
+}
+
+void DlSchemaIndex::prepareQuery(string_view formula, vector<char>& symbols, vector<uint32_t>& ends) {
+	for (uint32_t offset = 0; offset < formula.length();)
+		symbols.push_back(_readSymbol(formula, offset));
+	uint32_t n = static_cast<uint32_t>(symbols.size());
+	ends.resize(n + 1);
+	ends[n] = n;
+	for (uint32_t i = n; i > 0; i--) {
+		uint32_t end = i; // 'i - 1' is the index of the current symbol
+		char c = symbols[i - 1];
+		if (c)
+			for (unsigned arity = operatorArity(c); arity; arity--) {
+				if (end == n)
+					throw domain_error("DlSchemaIndex::prepareQuery(): Incomplete formula \"" + string(formula) + "\".");
+				end = ends[end];
+			}
+		ends[i - 1] = end;
+	}
+}
+
+char DlSchemaIndex::_readSymbol(string_view formula, uint32_t& offset) {
+	char c = formula[offset++];
+	if (c >= '0' && c <= '9') {
+		while (offset < formula.length() && formula[offset] >= '0' && formula[offset] <= '9')
+			offset++;
+		if (offset < formula.length() && formula[offset] == '.')
+			offset++; // separator between adjacent variables
+		return '\0';
+	}
+	return c;
+}
+
+void DlSchemaIndex::_split(uint32_t nodeIndex) {
+	vector<Entry> entries = move(nodes[nodeIndex].entries);
+	nodes[nodeIndex].entries.clear();
+	nodes[nodeIndex].leaf = false;
+	for (Entry& entry : entries)
+		if (entry.offset == entry.length)
+			nodes[nodeIndex].entries.push_back(entry);
+		else {
+			char c = _readSymbol(entry.view(), entry.offset);
+			nodes[_obtainChild(nodeIndex, c)].entries.push_back(entry);
+		}
+
+	// Split overfull children, e.g. when all formulas of the bucket share their next symbol.
+	vector<uint32_t> childIndices;
+	if (nodes[nodeIndex].wildcardChild)
+		childIndices.push_back(nodes[nodeIndex].wildcardChild);
+	for (const pair<char, uint32_t>& child : nodes[nodeIndex].children)
+		childIndices.push_back(child.second);
+	for (uint32_t childIndex : childIndices)
+		if (nodes[childIndex].entries.size() > bucketCapacity)
+			_split(childIndex);
+}
+
+uint32_t DlSchemaIndex::_obtainChild(uint32_t nodeIndex, char symbol) {
+	if (!symbol) {
+		if (!nodes[nodeIndex].wildcardChild) {
+			uint32_t childIndex = static_cast<uint32_t>(nodes.size());
+			nodes.emplace_back();
+			nodes[nodeIndex].wildcardChild = childIndex;
+		}
+		return nodes[nodeIndex].wildcardChild;
+	}
+	for (const pair<char, uint32_t>& child : nodes[nodeIndex].children)
+		if (child.first == symbol)
+			return child.second;
+	uint32_t childIndex = static_cast<uint32_t>(nodes.size());
+	nodes.emplace_back();
+	nodes[nodeIndex].children.emplace_back(symbol, childIndex);
+	return childIndex;
+}
+
+}
+}
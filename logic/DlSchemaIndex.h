@@ -0,0 +1,146 @@
+#ifndef XAMIDI_LOGIC_DLSCHEMAINDEX_H
+#define XAMIDI_LOGIC_DLSCHEMAINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace xamidi {
+namespace logic {
+
+// Generalization retrieval index (discrimination tree) over formulas in normal Polish notation with numeric variables (e.g. "C0C1.0").
+// Every variable is abstracted into a wildcard, so a query for a formula returns a superset of all indexed schemas (or instances) of that formula, i.e.
+// candidates still need to be confirmed via DlCore::isSchemaOf_polishNotation_noRename_numVars[_vec](), which also checks variable consistency.
+// Nodes are expanded lazily ("burst trie"), i.e. a leaf holds up to 'bucketCapacity' formulas before it is split up by their next symbol,
+// which keeps memory requirements near linear in the amount of indexed formulas, rather than in their combined lengths.
+// NOTE: Indexed formulas are referenced via their data pointers (e.g. into a DlConclusionStore), so they must remain valid and unmodified throughout the lifetime of the index.
+//       Insertions are not thread-safe, but concurrent queries are (as long as there are no concurrent insertions).
+struct DlSchemaIndex {
+	struct Entry {
+		const char* formula;
+		std::uint32_t length; // length of the formula's string
+		std::uint32_t offset; // position in the formula's string where the next symbol (of the path that is not yet represented by nodes) begins
+		std::uint32_t id; // as given on insertion, e.g. the formula's position in a list of search terms
+		std::string_view view() const { return std::string_view(formula, length); }
+	};
+	struct Node {
+		std::vector<std::pair<char, std::uint32_t>> children; // operator symbol -> node index
+		std::uint32_t wildcardChild = 0; // 0: no wildcard child (since the root node is never a child)
+		bool leaf = true;
+		std::vector<Entry> entries; // leaf: bucket of formulas with unrepresented paths ; non-leaf: formulas with paths that end at this node
+	};
+private:
+	std::vector<Node> nodes;
+	std::size_t bucketCapacity;
+	std::size_t formulaCounter = 0;
+public:
+	DlSchemaIndex(std::size_t bucketCapacity = 16);
+
+	void insert(std::string_view formula, std::uint32_t id = 0);
+	std::size_t size() const { return formulaCounter; }
+	std::size_t nodeCount() const { return nodes.size(); }
+
+	// Calls 'func' (with a std::string_view argument, and with the formula's id as second argument if 'func' accepts one) for each indexed formula that might be a schema of 'formula'
+	// (including 'formula' itself if it was indexed), until 'func' returns true.
+	// Returns true iff 'func' returned true, i.e. the query was aborted.
+	bool forEachPotentialSchemaOf(std::string_view formula, const auto& func) const {
+		std::vector<char> symbols;
+		std::vector<std::uint32_t> ends;
+		prepareQuery(formula, symbols, ends);
+		return _retrieve(0, 0, symbols, ends, func);
+	}
+
+	// Calls 'func' (with a std::string_view argument, and with the formula's id as second argument if 'func' accepts one) for each indexed formula that might be an instance of 'schema'
+	// (including 'schema' itself if it was indexed), until 'func' returns true.
+	// Returns true iff 'func' returned true, i.e. the query was aborted.
+	bool forEachPotentialInstanceOf(std::string_view schema, const auto& func) const {
+		std::vector<char> symbols;
+		std::vector<std::uint32_t> ends;
+		prepareQuery(schema, symbols, ends);
+		return _retrieveInstances(0, 0, symbols, func);
+	}
+
+	static unsigned operatorArity(char c);
+
+	// Splits 'formula' into symbols (variables are represented by '\0'), and determines for each symbol the index (in 'symbols') after the subformula that starts with it.
+	static void prepareQuery(std::string_view formula, std::vector<char>& symbols, std::vector<std::uint32_t>& ends);
+private:
+	static char _readSymbol(std::string_view formula, std::uint32_t& offset); // returns '\0' for variables, and advances 'offset' to the next symbol
+	void _split(std::uint32_t nodeIndex);
+	std::uint32_t _obtainChild(std::uint32_t nodeIndex, char symbol);
+
+	static bool _visit(const Entry& entry, const auto& func) {
+		if constexpr (std::is_invocable_v<decltype(func), std::string_view, std::uint32_t>)
+			return func(entry.view(), entry.id);
+		else
+			return func(entry.view());
+	}
+
+	bool _retrieve(std::uint32_t nodeIndex, std::uint32_t i, const std::vector<char>& symbols, const std::vector<std::uint32_t>& ends, const auto& func) const {
+		const Node& node = nodes[nodeIndex];
+		if (node.leaf) { // all formulas of a bucket are candidates
+			for (const Entry& entry : node.entries)
+				if (_visit(entry, func))
+					return true;
+			return false;
+		}
+		if (i == symbols.size()) { // only paths that end here can match, since formulas' paths are prefix-free
+			for (const Entry& entry : node.entries)
+				if (_visit(entry, func))
+					return true;
+			return false;
+		}
+		if (node.wildcardChild && _retrieve(node.wildcardChild, ends[i], symbols, ends, func)) // a variable of a schema may represent the entire subformula
+			return true;
+		char c = symbols[i];
+		if (c)
+			for (const std::pair<char, std::uint32_t>& child : node.children)
+				if (child.first == c)
+					return _retrieve(child.second, i + 1, symbols, ends, func);
+		return false;
+	}
+
+	bool _retrieveInstances(std::uint32_t nodeIndex, std::uint32_t i, const std::vector<char>& symbols, const auto& func) const {
+		const Node& node = nodes[nodeIndex];
+		if (node.leaf || i == symbols.size()) { // all formulas of a bucket are candidates, and only paths that end here can match
+			for (const Entry& entry : node.entries)
+				if (_visit(entry, func))
+					return true;
+			return false;
+		}
+		char c = symbols[i];
+		if (!c) // a variable of the query may represent any subformula
+			return _skipSubformulas(nodeIndex, 1, i + 1, symbols, func);
+		for (const std::pair<char, std::uint32_t>& child : node.children)
+			if (child.first == c)
+				return _retrieveInstances(child.second, i + 1, symbols, func);
+		return false;
+	}
+
+	bool _skipSubformulas(std::uint32_t nodeIndex, std::size_t pending, std::uint32_t i, const std::vector<char>& symbols, const auto& func) const {
+		const Node& node = nodes[nodeIndex];
+		if (node.leaf) {
+			for (const Entry& entry : node.entries)
+				if (_visit(entry, func))
+					return true;
+			return false;
+		}
+		auto descend = [&](std::uint32_t childIndex, std::size_t remaining) { // NOTE: Paths that end at this node are too short to contain 'pending' more subformulas.
+			return remaining ? _skipSubformulas(childIndex, remaining, i, symbols, func) : _retrieveInstances(childIndex, i, symbols, func);
+		};
+		if (node.wildcardChild && descend(node.wildcardChild, pending - 1))
+			return true;
+		for (const std::pair<char, std::uint32_t>& child : node.children)
+			if (descend(child.second, pending - 1 + operatorArity(child.first)))
+				return true;
+		return false;
+	}
+};
+
+}
+}
+
+#endif // XAMIDI_LOGIC_DLSCHEMAINDEX_H
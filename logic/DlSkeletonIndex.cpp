@@ -0,0 +1,131 @@
+#include "DlSkeletonIndex.h"
+
+#include "DlSchemaIndex.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+using namespace std;
+
+namespace xamidi {
+namespace logic {
+
+namespace {
+char readSymbol(string_view formula, uint32_t& offset) { // returns '\0' for variables, and advances 'offset' to the next symbol
+	if (offset >= formula.length())
+		throw domain_error("DlSkeletonIndex: Incomplete formula \"" + string(formula) + "\".");
+	char c = formula[offset++];
+	if (c >= '0' && c <= '9') {
+		while (offset < formula.length() && formula[offset] >= '0' && formula[offset] <= '9')
+			offset++;
+		if (offset < formula.length() && formula[offset] == '.')
+			offset++; // separator between adjacent variables
+		return '\0';
+	}
+	return c;
+}
+void skipFormula(string_view formula, uint32_t& offset) {
+	for (uint64_t pending = 1; pending; pending--) {
+		char c = readSymbol(formula, offset);
+		if (c)
+			pending += DlSchemaIndex::operatorArity(c);
+	}
+}
+}
+
+DlSkeletonIndex::DlSkeletonIndex(const vector<vector<string_view>>& allConclusions, bool groupAntecedents) :
+		buckets(allConclusions.size()) {
+	for (size_t len = 0; len < allConclusions.size(); len++) {
+		const vector<string_view>& conclusions = allConclusions[len];
+		Bucket& bucket = buckets[len];
+		uint32_t size = static_cast<uint32_t>(conclusions.size());
+		bucket.skeletons.resize(size);
+		vector<Skeleton> antecedentSkeletons(size);
+		tbb::parallel_for(uint32_t(0), size, [&](uint32_t i) {
+			bucket.skeletons[i] = skeleton(conclusions[i]);
+			antecedentSkeletons[i] = antecedentSkeleton(conclusions[i]);
+		});
+		vector<array<uint32_t, 3>> keys; // skeleton, group ID (if applicable), index
+		for (uint32_t i = 0; i < size; i++)
+			if (antecedentSkeletons[i] != noSkeleton)
+				keys.push_back( { antecedentSkeletons[i], 0, i });
+		if (groupAntecedents) {
+			vector<string> canonicalAntecedents(keys.size());
+			tbb::parallel_for(size_t(0), keys.size(), [&](size_t j) { canonicalAntecedents[j] = canonicalAntecedent(conclusions[keys[j][2]]); });
+			unordered_map<string, uint32_t> groupIds;
+			for (size_t j = 0; j < keys.size(); j++)
+				keys[j][1] = groupIds.emplace(move(canonicalAntecedents[j]), static_cast<uint32_t>(groupIds.size())).first->second;
+		}
+		tbb::parallel_sort(keys.begin(), keys.end());
+		bucket.conditionals.resize(keys.size());
+		if (groupAntecedents)
+			bucket.groups.resize(keys.size());
+		for (uint32_t j = 0; j < keys.size(); j++) {
+			bucket.conditionals[j] = keys[j][2];
+			if (groupAntecedents)
+				bucket.groups[j] = keys[j][1];
+			if (bucket.classes.empty() || bucket.classes.back().skeleton != keys[j][0])
+				bucket.classes.push_back(Class { keys[j][0], j, j + 1 });
+			else
+				bucket.classes.back().end = j + 1;
+		}
+	}
+}
+
+DlSkeletonIndex::Skeleton DlSkeletonIndex::skeleton(string_view formula, uint32_t offset) {
+	char c = readSymbol(formula, offset);
+	if (!c)
+		return 0;
+	unsigned arity = DlSchemaIndex::operatorArity(c);
+	Skeleton result = static_cast<uint8_t>(c);
+	for (unsigned i = 0; i < 2; i++) {
+		uint8_t symbol = 1;
+		if (i < arity) {
+			uint32_t childOffset = offset;
+			symbol = static_cast<uint8_t>(readSymbol(formula, childOffset));
+			if (i + 1 < arity)
+				skipFormula(formula, offset);
+		}
+		result |= static_cast<Skeleton>(symbol) << (8 * (i + 1));
+	}
+	return result;
+}
+
+DlSkeletonIndex::Skeleton DlSkeletonIndex::antecedentSkeleton(string_view formula) {
+	if (formula.empty() || formula[0] != 'C')
+		return noSkeleton;
+	return skeleton(formula, 1);
+}
+
+string DlSkeletonIndex::canonicalAntecedent(string_view formula) {
+	uint32_t offset = 1;
+	uint32_t end = offset;
+	skipFormula(formula, end);
+	string result;
+	vector<pair<uint32_t, uint32_t>> translation; // original variable -> canonical variable (few variables, thus searched linearly)
+	while (offset < end) {
+		uint32_t begin = offset;
+		char c = readSymbol(formula, offset);
+		if (c)
+			result += c;
+		else {
+			uint32_t variable = 0;
+			for (uint32_t k = begin; k < offset && formula[k] != '.'; k++)
+				variable = 10 * variable + (formula[k] - '0');
+			vector<pair<uint32_t, uint32_t>>::const_iterator it = find_if(translation.begin(), translation.end(), [&](const pair<uint32_t, uint32_t>& p) { return p.first == variable; });
+			if (it == translation.end())
+				it = translation.emplace(translation.end(), variable, static_cast<uint32_t>(translation.size()));
+			result += to_string(it->second) + ".";
+		}
+	}
+	return result;
+}
+
+}
+}
@@ -0,0 +1,62 @@
+#ifndef XAMIDI_LOGIC_DLSKELETONINDEX_H
+#define XAMIDI_LOGIC_DLSKELETONINDEX_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace xamidi {
+namespace logic {
+
+// Unifiability index over conclusions of proofs of each length, in normal Polish notation with numeric variables (e.g. "C0C1.0"), to skip D-rule candidates that cannot be unified.
+// A skeleton of a formula consists of its top symbol and the top symbols of its direct subformulas, where variables are wildcards. A D-rule with minor premise A and major premise B
+// requires a unifier of A and the antecedent φ of B = C(φ, ψ), so conditionals are grouped by the skeletons of their antecedents, and only groups of skeletons compatible with A's need
+// to be considered. Skeletons are compatible iff at each of their positions, at least one of them has a wildcard or both have the same symbol.
+// Proof that no unifiable pair is skipped: A substitution σ only replaces variables, so for every operator symbol at a position p of a formula f, σ(f) has the same symbol at p.
+// Hence if A and φ have distinct operator symbols at a position p (which then is a position of both, since the symbols at all of p's predecessors are equal operators), σ(A) and σ(φ)
+// differ at p for every σ, i.e. they have no unifier. Similarly, a formula B that is no conditional has no antecedent, thus all candidates with major premise B fail.
+// Optionally, conclusions within each class are further grouped by their antecedents up to variable renaming, such that a minor premise can be unified only once per group.
+// NOTE: Indexed conclusions are referenced by their indices, so the index remains valid as long as 'allConclusions' (which it was built for) remains unmodified.
+struct DlSkeletonIndex {
+	typedef std::uint32_t Skeleton; // symbols (one byte each) at the root and at its 1st and 2nd child, where 0 is a wildcard and 1 marks absent children (i.e. of operators of lower arity)
+	static constexpr Skeleton noSkeleton = UINT32_MAX;
+	struct Class {
+		Skeleton skeleton;
+		std::uint32_t begin; // range of 'Bucket::conditionals'
+		std::uint32_t end;
+	};
+	struct Bucket {
+		std::vector<Skeleton> skeletons; // of each formula
+		std::vector<std::uint32_t> conditionals; // indices of conditionals, grouped by the skeletons of their antecedents (in ascending order within each class, or within each group of antecedents)
+		std::vector<Class> classes;
+		std::vector<std::uint32_t> groups; // for grouped antecedents, the group ID of each conditional in 'conditionals', where each group's conditionals are consecutive
+	};
+private:
+	std::vector<Bucket> buckets; // for each proof length
+public:
+	DlSkeletonIndex(const std::vector<std::vector<std::string_view>>& allConclusions, bool groupAntecedents = false);
+
+	Skeleton skeletonOf(std::uint32_t len, std::uint32_t i) const { return buckets[len].skeletons[i]; }
+	const std::vector<std::uint32_t>& conditionals(std::uint32_t len) const { return buckets[len].conditionals; }
+	const std::vector<Class>& classes(std::uint32_t len) const { return buckets[len].classes; }
+	const std::vector<std::uint32_t>& groups(std::uint32_t len) const { return buckets[len].groups; } // empty unless antecedents are grouped
+
+	static Skeleton skeleton(std::string_view formula, std::uint32_t offset = 0); // of the subformula that starts at 'offset'
+	static Skeleton antecedentSkeleton(std::string_view formula); // returns 'noSkeleton' if 'formula' is no conditional
+	static std::string canonicalAntecedent(std::string_view formula); // antecedent of conditional 'formula' with variables renamed in order of their first occurrences (as a key, each followed by '.')
+	static bool compatible(Skeleton a, Skeleton b) {
+		for (unsigned shift = 0; shift < 24; shift += 8) {
+			std::uint8_t x = static_cast<std::uint8_t>(a >> shift);
+			std::uint8_t y = static_cast<std::uint8_t>(b >> shift);
+			if (x && y && x != y)
+				return false;
+		}
+		return true;
+	}
+};
+
+}
+}
+
+#endif // XAMIDI_LOGIC_DLSKELETONINDEX_H
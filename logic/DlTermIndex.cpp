@@ -0,0 +1,186 @@
+#include "DlTermIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace std;
+namespace bip = boost::interprocess;
+
+namespace xamidi {
+namespace logic {
+
+namespace {
+constexpr char magic[8] = { 'p', 'm', 'G', 'e', 'n', 'T', 'r', 'm' };
+}
+
+string DlTermIndex::indexPath(const string& searchPath) {
+	return searchPath + "dProofs-termIndex.bin";
+}
+
+string DlTermIndex::skeleton(string_view formula) {
+	vector<char> symbols;
+	vector<uint32_t> ends;
+	DlSchemaIndex::prepareQuery(formula, symbols, ends);
+	return string(symbols.begin(), symbols.end());
+}
+
+size_t DlTermIndex::write(const string& file, const vector<DlProofIndex::FileRecord>& files, const vector<uint64_t>& locations, const vector<string>& lines, const vector<string>& skeletons, const vector<size_t>& order, const string& systemHash) {
+	uint64_t n = order.size();
+	if (locations.size() != n || lines.size() != n || skeletons.size() != n || systemHash.length() > systemHashSize)
+		return 0;
+	uint64_t m = files.size();
+	vector<uint64_t> offsets(n + 1);
+	auto writeOffsets = [&](ofstream& fout, const vector<string>& entries, uint64_t position) {
+		for (size_t i = 0; i < n; i++) {
+			offsets[i] = position;
+			position += entries[order[i]].length();
+		}
+		offsets[n] = position;
+		fout.write(reinterpret_cast<const char*>(offsets.data()), static_cast<streamsize>((n + 1) * sizeof(uint64_t)));
+		return position;
+	};
+	filesystem::path path = filesystem::u8path(file);
+	filesystem::path tmpPath = filesystem::u8path(file + ".tmp");
+	ofstream fout(tmpPath, fstream::out | fstream::binary | fstream::trunc);
+	if (!fout.is_open())
+		return 0;
+	char header[headerSize] = { };
+	memcpy(header, magic, 8);
+	memcpy(header + 8, &version, 4);
+	memcpy(header + 16, &m, 8);
+	memcpy(header + 24, &n, 8);
+	memcpy(header + 40, systemHash.data(), systemHash.length());
+	fout.write(header, headerSize);
+	fout.write(reinterpret_cast<const char*>(files.data()), static_cast<streamsize>(m * sizeof(DlProofIndex::FileRecord)));
+	for (size_t i = 0; i < n; i++)
+		fout.write(reinterpret_cast<const char*>(&locations[order[i]]), sizeof(uint64_t));
+	uint64_t position = headerSize + m * sizeof(DlProofIndex::FileRecord) + (2 * n + 2 + n) * sizeof(uint64_t);
+	position = writeOffsets(fout, lines, position);
+	position = writeOffsets(fout, skeletons, position);
+	for (size_t i : order)
+		fout.write(lines[i].data(), static_cast<streamsize>(lines[i].length()));
+	for (size_t i : order)
+		fout.write(skeletons[i].data(), static_cast<streamsize>(skeletons[i].length()));
+	fout.close();
+	if (!fout)
+		return 0;
+	error_code ec;
+	filesystem::rename(tmpPath, path, ec);
+	return ec ? 0 : position;
+}
+
+bool DlTermIndex::open(const string& file, const string& systemHash, string* optOut_error) {
+	auto fail = [&](const string& error) {
+		if (optOut_error)
+			*optOut_error = error;
+		region = bip::mapped_region();
+		mapping = bip::file_mapping();
+		data = nullptr;
+		files = nullptr;
+		locations = nullptr;
+		lineOffsets = nullptr;
+		skeletonOffsets = nullptr;
+		fileAmount = 0;
+		count = 0;
+		return false;
+	};
+	error_code ec;
+	uint64_t fileSize = filesystem::file_size(filesystem::u8path(file), ec);
+	if (ec)
+		return fail("missing file");
+	if (fileSize < headerSize + 2 * sizeof(uint64_t))
+		return fail("truncated file");
+	try {
+		mapping = bip::file_mapping(file.c_str(), bip::read_only);
+		region = bip::mapped_region(mapping, bip::read_only);
+	} catch (bip::interprocess_exception& e) {
+		return fail(string("failed mapping (") + e.what() + ")");
+	}
+	if (region.get_size() != fileSize)
+		return fail("failed mapping");
+	data = static_cast<const char*>(region.get_address());
+	uint32_t _version;
+	uint64_t m;
+	uint64_t n;
+	memcpy(&_version, data + 8, 4);
+	memcpy(&m, data + 16, 8);
+	memcpy(&n, data + 24, 8);
+	if (memcmp(data, magic, 8) || _version != version)
+		return fail("unknown format");
+	if (systemHash.length() > systemHashSize || memcmp(data + 40, systemHash.data(), systemHash.length()) || (systemHash.length() < systemHashSize && data[40 + systemHash.length()]))
+		return fail("different proof system");
+	uint64_t remaining = fileSize - headerSize - 2 * sizeof(uint64_t);
+	if (m > remaining / sizeof(DlProofIndex::FileRecord) || n > (remaining - m * sizeof(DlProofIndex::FileRecord)) / (3 * sizeof(uint64_t)))
+		return fail("truncated file");
+	files = reinterpret_cast<const DlProofIndex::FileRecord*>(data + headerSize);
+	locations = reinterpret_cast<const uint64_t*>(files + m);
+	lineOffsets = locations + n;
+	skeletonOffsets = lineOffsets + n + 1;
+	if (lineOffsets[0] != static_cast<uint64_t>(reinterpret_cast<const char*>(skeletonOffsets + n + 1) - data) || skeletonOffsets[0] != lineOffsets[n] || skeletonOffsets[n] != fileSize)
+		return fail("inconsistent offsets");
+	for (const uint64_t* it = lineOffsets; it != skeletonOffsets + n; ++it) // NOTE: Both tables are adjacent, so along with the above bounds, this ensures that every entry lies within the file.
+		if (it[0] > it[1])
+			return fail("inconsistent offsets");
+	for (uint64_t i = 0; i < n; i++)
+		if (DlProofIndex::fileIndexOf(locations[i]) >= m || lineOffsets[i + 1] - lineOffsets[i] <= files[DlProofIndex::fileIndexOf(locations[i])].wordLengthLimit)
+			return fail("inconsistent locations");
+	fileAmount = m;
+	count = n;
+	return true;
+}
+
+pair<size_t, size_t> DlTermIndex::skeletonRange(string_view formula) const {
+	string symbols = skeleton(formula);
+	pair<size_t, size_t> range = { 0, count };
+	for (size_t depth = 0; depth < symbols.length() && range.first < range.second; depth++)
+		range = _childRange(range.first, range.second, depth, symbols[depth]);
+	return range;
+}
+
+pair<size_t, size_t> DlTermIndex::_childRange(size_t begin, size_t end, size_t depth, char symbol) const {
+	auto symbolAt = [&](size_t i) { return static_cast<unsigned char>(_symbol(i, depth)); };
+	unsigned char c = static_cast<unsigned char>(symbol);
+	size_t lo = begin;
+	size_t hi = end;
+	while (lo < hi) { // first entry with a symbol not less than 'c'
+		size_t mid = lo + (hi - lo) / 2;
+		if (symbolAt(mid) < c)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	size_t first = lo;
+	hi = end;
+	while (lo < hi) { // first entry with a symbol greater than 'c'
+		size_t mid = lo + (hi - lo) / 2;
+		if (symbolAt(mid) <= c)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return { first, lo };
+}
+
+size_t DlTermIndex::_groupEnd(size_t begin, size_t end, size_t depth) const {
+	char c = _symbol(begin, depth);
+	size_t lo = begin + 1;
+	size_t step = 1;
+	while (lo + step < end && _symbol(lo + step, depth) == c) {
+		lo += step + 1;
+		step <<= 1;
+	}
+	size_t hi = min(lo + step, end);
+	while (lo < hi) { // first entry with a different symbol
+		size_t mid = lo + (hi - lo) / 2;
+		if (_symbol(mid, depth) == c)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+}
+}
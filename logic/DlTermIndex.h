@@ -0,0 +1,136 @@
+#ifndef XAMIDI_LOGIC_DLTERMINDEX_H
+#define XAMIDI_LOGIC_DLTERMINDEX_H
+
+#include "DlProofIndex.h"
+#include "DlSchemaIndex.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace xamidi {
+namespace logic {
+
+// Read-only memory mapping of a term index (e.g. "dProofs-termIndex.bin") for the proof files (with conclusions) of a data directory, i.e. of a discrimination tree over all conclusions
+// that is flattened into an array of lines sorted by the skeletons of their conclusions. A skeleton is the sequence of symbols of a formula in normal Polish notation with numeric variables,
+// where each variable is represented by '\0' (e.g. "CC\0\0\0" for "CC0.1.0"). Since skeletons are prefix-free, each node of the tree is a range of entries with a common skeleton prefix,
+// and its children are subranges that are found via binary search. Layout (native byte order): 104-byte header { char[8] "pmGenTrm", uint32 version, uint32 reserved, uint64 file count m,
+// uint64 entry count n, uint64 reserved, char[64] system hash (zero-padded, empty for the built-in system) }, DlProofIndex::FileRecord files[m], uint64 locations[n] (see DlProofIndex::location()),
+// uint64 line offsets[n + 1], uint64 skeleton offsets[n + 1], line bytes, skeleton bytes. Offsets are positions in the file, where entry i occupies [offsets[i], offsets[i + 1]).
+// Entries with equal skeletons are ordered by location, and lines are without line breaks (e.g. "D1D11:C0C1C2.0").
+// NOTE: Both queries return supersets of their results (since variables are not distinguished), i.e. candidates still need to be confirmed via
+//       DlCore::isSchemaOf_polishNotation_noRename_numVars(), which also checks variable consistency.
+//       An index is considered valid only as long as all of its files have the recorded sizes and last write times (see DlProofIndex::FileRecord), since proof files are replaced by proof generation.
+//       Indices are written to a temporary file first, so an interrupted write leaves no truncated index behind.
+struct DlTermIndex {
+	static constexpr std::uint32_t version = 2;
+	static constexpr std::size_t headerSize = 104;
+	static constexpr std::size_t systemHashSize = 64;
+	static constexpr std::size_t bucketCapacity = 16; // ranges of at most this many entries are not narrowed down further, i.e. all of their entries are candidates
+private:
+	boost::interprocess::file_mapping mapping;
+	boost::interprocess::mapped_region region;
+	const char* data = nullptr;
+	const DlProofIndex::FileRecord* files = nullptr;
+	const std::uint64_t* locations = nullptr;
+	const std::uint64_t* lineOffsets = nullptr;
+	const std::uint64_t* skeletonOffsets = nullptr;
+	std::size_t fileAmount = 0;
+	std::size_t count = 0;
+public:
+	// Path of the term index for the proof files in 'searchPath' (e.g. "data/dProofs-withConclusions/").
+	static std::string indexPath(const std::string& searchPath);
+
+	// Skeleton of a formula in normal Polish notation with numeric variables (e.g. "CC\0\0\0" for "CC0.1.0").
+	static std::string skeleton(std::string_view formula);
+
+	// Writes an index (where all vectors but 'files' are of equal size, and 'order' is a permutation that sorts the entries by skeletons and then by locations) to 'file'.
+	// Returns the amount of bytes written, or 0 on failure.
+	static std::size_t write(const std::string& file, const std::vector<DlProofIndex::FileRecord>& files, const std::vector<std::uint64_t>& locations, const std::vector<std::string>& lines, const std::vector<std::string>& skeletons, const std::vector<std::size_t>& order, const std::string& systemHash);
+
+	// Maps the index at 'file'. Fails (and stores the reason in 'optOut_error') when the index is missing or malformed, or when it belongs to another system.
+	bool open(const std::string& file, const std::string& systemHash, std::string* optOut_error = nullptr);
+
+	std::size_t size() const { return count; }
+	std::size_t fileCount() const { return fileAmount; }
+	const DlProofIndex::FileRecord& fileRecord(std::size_t i) const { return files[i]; }
+	std::uint64_t location(std::size_t i) const { return locations[i]; }
+	std::string_view line(std::size_t i) const { return std::string_view(data + lineOffsets[i], lineOffsets[i + 1] - lineOffsets[i]); }
+	std::string_view conclusion(std::size_t i) const { return line(i).substr(files[DlProofIndex::fileIndexOf(locations[i])].wordLengthLimit + 1); }
+
+	// Range of entries with the skeleton of 'formula', i.e. of all indexed conclusions that might equal 'formula' (ordered by location).
+	std::pair<std::size_t, std::size_t> skeletonRange(std::string_view formula) const;
+
+	// Calls 'func' (with an entry index argument) for each indexed conclusion that might be a schema of 'formula', in order of entries.
+	void forEachPotentialSchemaOf(std::string_view formula, const auto& func) const {
+		std::vector<char> symbols;
+		std::vector<std::uint32_t> ends;
+		DlSchemaIndex::prepareQuery(formula, symbols, ends);
+		_retrieveSchemas(0, count, 0, 0, symbols, ends, func);
+	}
+
+	// Calls 'func' (with an entry index argument) for each indexed conclusion that might be an instance of 'schema', in order of entries.
+	void forEachPotentialInstanceOf(std::string_view schema, const auto& func) const {
+		std::vector<char> symbols;
+		std::vector<std::uint32_t> ends;
+		DlSchemaIndex::prepareQuery(schema, symbols, ends);
+		_retrieveInstances(0, count, 0, 0, symbols, func);
+	}
+private:
+	char _symbol(std::size_t i, std::size_t depth) const { return data[skeletonOffsets[i] + depth]; }
+
+	// Subrange of [begin, end) with the given symbol at 'depth', where all entries of [begin, end) share their first 'depth' symbols.
+	std::pair<std::size_t, std::size_t> _childRange(std::size_t begin, std::size_t end, std::size_t depth, char symbol) const;
+
+	// End of the subrange of [begin, end) with the symbol of 'begin' at 'depth' ; searches exponentially from 'begin', since subranges of subformulas tend to be small.
+	std::size_t _groupEnd(std::size_t begin, std::size_t end, std::size_t depth) const;
+
+	void _retrieveAll(std::size_t begin, std::size_t end, const auto& func) const {
+		for (std::size_t k = begin; k < end; k++)
+			func(k);
+	}
+
+	void _retrieveSchemas(std::size_t begin, std::size_t end, std::size_t depth, std::uint32_t i, const std::vector<char>& symbols, const std::vector<std::uint32_t>& ends, const auto& func) const {
+		if (i == symbols.size() || end - begin <= bucketCapacity) // NOTE: Only entries with equal skeletons remain when 'i' reaches the end, since skeletons are prefix-free.
+			return _retrieveAll(begin, end, func);
+		std::pair<std::size_t, std::size_t> range = _childRange(begin, end, depth, '\0'); // a variable of a schema may represent the entire subformula
+		_retrieveSchemas(range.first, range.second, depth + 1, ends[i], symbols, ends, func);
+		if (symbols[i]) {
+			range = _childRange(begin, end, depth, symbols[i]);
+			_retrieveSchemas(range.first, range.second, depth + 1, i + 1, symbols, ends, func);
+		}
+	}
+
+	void _retrieveInstances(std::size_t begin, std::size_t end, std::size_t depth, std::uint32_t i, const std::vector<char>& symbols, const auto& func) const {
+		if (i == symbols.size() || end - begin <= bucketCapacity)
+			return _retrieveAll(begin, end, func);
+		if (symbols[i]) {
+			std::pair<std::size_t, std::size_t> range = _childRange(begin, end, depth, symbols[i]);
+			_retrieveInstances(range.first, range.second, depth + 1, i + 1, symbols, func);
+		} else // a variable of the query may represent any subformula
+			_skipSubformulas(begin, end, depth, 1, i + 1, symbols, func);
+	}
+
+	void _skipSubformulas(std::size_t begin, std::size_t end, std::size_t depth, std::size_t pending, std::uint32_t i, const std::vector<char>& symbols, const auto& func) const {
+		if (end - begin <= bucketCapacity)
+			return _retrieveAll(begin, end, func);
+		while (begin < end) { // for each distinct symbol at 'depth'
+			char c = _symbol(begin, depth);
+			std::size_t next = _groupEnd(begin, end, depth);
+			std::size_t remaining = pending - 1 + (c ? DlSchemaIndex::operatorArity(c) : 0);
+			if (remaining)
+				_skipSubformulas(begin, next, depth + 1, remaining, i, symbols, func);
+			else
+				_retrieveInstances(begin, next, depth + 1, i, symbols, func);
+			begin = next;
+		}
+	}
+};
+
+}
+}
+
+#endif // XAMIDI_LOGIC_DLTERMINDEX_H
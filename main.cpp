@@ -47,12 +47,15 @@ enum class Task {
 	RebaseProofSummary, //      --rebase
 	ConvertNaturalDeduction, // --ndconvert
 	SearchProofFiles, //        --search
+	CreateTermIndex, //         --index
+	ServeQueries, //            --serve
 	ExtractFromProofFiles, //   --extract
 	AssessGeneration, //        --assess
 	IterateProofCandidates, //  --iterate
 	FileConversion, //          --variate
 	ConclusionLengthPlot, //    --plot
-	MpiFilter //                -m
+	MpiFilter, //               -m
+	MpiGenerate //              -M
 };
 
 static const map<Task, string>& cmdInfo() {
@@ -69,15 +72,21 @@ static const map<Task, string>& cmdInfo() {
 				"         -e: specify extracted system with the given identifier\n"
 				"         -d: default system ; ignore all other arguments except '-e'\n";
 		_[Task::Generate] =
-				"    -g <limit or -1> [-u] [-q <limit or -1>] [-l <limit or -1>] [-k <limit or -1>] [-b] [-f] [-s]\n"
-				"       Generate proof files ; at ./data/[<hash>/]/dProofs-withConclusions/ when '-s' unspecified ; otherwise at ./data/[<hash>/]/dProofs-withoutConclusions/\n"
+				"    -g <limit or -1> [-u] [-q <limit or -1>] [-l <limit or -1>] [-k <limit or -1>] [-b] [-j] [-f] [-s] [-i] [-p <seconds>] [-z] [-x <MiB>] [-o]\n"
+				"       Generate proof files ; at ./data/[<hash>/]/dProofs-withConclusions/ when '-s' unspecified ; otherwise at ./data/[<hash>/]/dProofs-withoutConclusions/ ; proof files that are present only as xz archives (e.g. \"dProofs29.txt.xz\", created via \"xz -T0\" for block-wise concurrent reading) are read directly from their archives\n"
 				"         -u: unfiltered (significantly faster, but generates redundant proofs)\n"
-				"         -q: limit number of proof candidate strings queued per worker thread (may lower memory requirements for systems with low acceptance rates) ; default: 50\n"
+				"         -q: limit number of proof candidate strings pending per worker thread ; used only with '-f' or '-s' (may lower memory requirements for systems with low acceptance rates) ; default: 50\n"
 				"         -l: limit symbolic length of generated conclusions to at most the given number ; works only in extracted environments ; recommended to use in combination with '-q' to save memory\n"
 				"         -k: similar to '-l' ; limit symbolic length of consequents in generated conclusions, i.e. antecedents in conditionals are not limited (but non-conditionals are limited in full length)\n"
 				"         -b: brief parsing ; append conclusion structures to D-proof processing and use them for rule evaluation (collects faster, but requires significantly more memory)\n"
+				"         -j: joint rule evaluation ; group conditionals by their antecedents (up to variable renaming), and unify each minor premise only once per group, applying the unifier to all of the group's consequents ; entails '-b' ; results in identical proof files\n"
 				"         -f: full parsing ; parse entire D-proofs rather than using conclusion strings for rule evaluation ; used only when '-b' unspecified\n"
-				"         -s: proof files without conclusions, requires additional parsing ; entails '-f' ; used only when '-b' unspecified\n";
+				"         -s: proof files without conclusions, requires additional parsing ; entails '-f' ; used only when '-b' unspecified\n"
+				"         -i: disable generalization index for redundant schema removal ; check all potential schemas by brute force (significantly slower, but useful for cross-checking)\n"
+				"         -p: store checkpoints of proof collection at least every given number of seconds (and when a collection is complete) ; at ./data/[<hash>/]/dProofs-with(out)Conclusions/dProofs<n>[-unfiltered<m>+]-checkpoint.bin\n"
+				"         -z: resume from the checkpoint of the first missing proof file, if stored with equal settings ; results in identical proof files\n"
+				"         -x: out-of-core collection with a memory budget of the given number of MiB for conclusions ; used only with '-u' and when '-f' and '-s' unspecified ; moves hash buckets of conclusions to ./data/[<hash>/]/dProofs-withConclusions/dProofs-spill/ when exceeded ; results in identical proof files, but disables '-p' and '-z'\n"
+				"         -o: online schema removal ; reject new conclusions with more general variants proven in fewer steps before storing them, so that only variants proven in equally many steps are filtered afterwards ; trades time for memory, since rejected conclusions are not remembered but checked again whenever they reoccur ; used only when '-u', '-f' and '-s' unspecified ; results in identical proof files, but disables '-p' and '-z', and removal counts are not updated\n";
 		_[Task::CreateReplacements] =
 				"    -r <D-proof database> <output file> [-l <path>] [-i <prefix>] [-s] [-d]\n"
 				"       Replacements file creation based on proof files\n"
@@ -167,7 +176,7 @@ static const map<Task, string>& cmdInfo() {
 				"         -o: redirect the result's output to the specified file\n"
 				"         -d: print debug information\n";
 		_[Task::SearchProofFiles] =
-				"    --search <string> [-n] [-s] [-w] [-t] [-p] [-f] [-d]\n"
+				"    --search <string> [-n] [-s] [-w] [-t] [-p] [-f] [-i] [-d]\n"
 				"       Search in proof files at ./data/[<hash>/]/dProofs-withConclusions/ via comma-separated string of full formulas or full proofs ; [Hint: Generate missing files with '--variate 1 -s'.]\n"
 				"         -n: specify formulas in normal Polish notation (e.g. \"CpCqp\"), not with numeric variables (e.g. \"C0C1.0\")\n"
 				"         -s: search for schemas of the given formulas\n"
@@ -175,6 +184,19 @@ static const map<Task, string>& cmdInfo() {
 				"         -t: search for formulas of the given schemas (allows multiple results per term) ; used only when '-s' and '-w' unspecified\n"
 				"         -p: search proofs (rather than conclusions) ; used only when '-n', '-s', '-w' and '-t' unspecified\n"
 				"         -f: search terms are given by input file path (where a comma-separated string is stored), ignoring all CR, LF, whitespace, and lines starting with '%'\n"
+				"         -i: create lookup index at ./data/[<hash>/]/dProofs-withConclusions/dProofs-index.bin if missing or outdated ; exact searches use an up-to-date index automatically ; used only when '-s', '-w' and '-t' unspecified\n"
+				"         -d: print debug information\n";
+		_[Task::CreateTermIndex] =
+				"    --index [-d]\n"
+				"       Create term index at ./data/[<hash>/]/dProofs-withConclusions/dProofs-termIndex.bin from proof files with conclusions ; schema and instance searches ('--search' with '-s', '-w' or '-t') use an up-to-date index automatically ; [Hint: Generate missing files with '--variate 1 -s'.]\n"
+				"         -d: print debug information\n";
+		_[Task::ServeQueries] =
+				"    --serve [-u <socket path>] [-d]\n"
+				"       Answer queries (one JSON object per line) with proof files at ./data/[<hash>/]/dProofs-withConclusions/ kept resident via their term index (see '--index', created if missing or outdated) ; prints {\"ready\":true,…} when loaded ; requests are handled concurrently, and responses (one JSON object per line) contain the \"id\" of their request:\n"
+				"       {\"id\":<any>,\"op\":\"search\",\"terms\":[<string>,…],\"mode\":( \"conclusion\" | \"proof\" | \"schema\" | \"schemas\" | \"instances\" ),\"normalPolishNotation\":<bool>,\"limit\":<amount per term>} ; like '--search' (with '-p', '-s', '-w', '-t', '-n')\n"
+				"       {\"id\":<any>,\"op\":\"parse\",\"proofs\":[<string>,…]} ; conclusions of proofs, like '--parse <string> -b'\n"
+				"       {\"id\":<any>,\"op\":\"extract\",\"amount\":<amount>} ; smallest conclusions with their proofs, like '--extract -t <amount>' (without redundant schema removal)\n"
+				"         -u: read requests from connections to a Unix domain socket at the given path (rather than from standard input) ; runs until terminated\n"
 				"         -d: print debug information\n";
 		_[Task::ExtractFromProofFiles] =
 				"    --extract [-t <limit or -1>] [-o <output file>] [-s] [-z] [-# <amount up to 35>] [-h <string>] [-l <limit or -1>] [-k <limit or -1>] [-f] [-d]\n"
@@ -201,12 +223,13 @@ static const map<Task, string>& cmdInfo() {
 				"         -u: use unfiltered proof files\n"
 				"         -s: use proof files without conclusions\n";
 		_[Task::FileConversion] =
-				"    --variate ( 0 | 1 ) [-l <path>] [-i <prefix>] [-o <prefix>] [-s] [-d]\n"
+				"    --variate ( 0 | 1 ) [-l <path>] [-i <prefix>] [-o <prefix>] [-s] [-b] [-d]\n"
 				"       Create proof files with removed (--variate 0) or added (--variate 1) conclusions from in-memory data and proof files of the other variant\n"
 				"         -l: customize data location path ; default: \"data\"\n"
 				"         -i: customize input file path prefix in data location ; default: \"dProofs-withConclusions/dProofs\" or \"dProofs-withoutConclusions/dProofs\"\n"
 				"         -o: customize output file path prefix in data location ; default: \"dProofs-withoutConclusions/dProofs\" or \"dProofs-withConclusions/dProofs\"\n"
 				"         -s: only use data stored in-memory\n"
+				"         -b: also create binary companions of created proof files (with \".txt\" replaced by \".bin\") ; loaded via memory mapping as long as their text files remain unchanged\n"
 				"         -d: print debug information\n";
 		_[Task::ConclusionLengthPlot] =
 				"    --plot [-l <path>] [-i <prefix>] [-s] [-u] [-t] [-x <limit or -1>] [-y <limit or -1>] [-o <output file>] [-d]\n"
@@ -221,9 +244,17 @@ static const map<Task, string>& cmdInfo() {
 				"         -o: print to given output file\n"
 				"         -d: print debug information\n";
 		_[Task::MpiFilter] =
-				"    -m <limit> [-s]\n"
+				"    -m <limit> [-s] [-i] [-w] [-p <seconds>] [-z]\n"
 				"       MPI-based multi-node filtering (-m <n>) of a first unfiltered proof file (with conclusions) at ./data/[<hash>/]dProofs-withConclusions/dProofs<n>-unfiltered<n>+.txt. Creates dProofs<n>.txt.\n"
-				"         -s: disable smooth progress mode (lowers memory requirements, but makes terrible progress predictions)\n";
+				"         -s: disable smooth progress mode (lowers memory requirements, but makes terrible progress predictions)\n"
+				"         -i: disable generalization index ; check all potential schemas by brute force (significantly slower, but useful for cross-checking)\n"
+				"         -w: one-sided workload distribution ; processes claim chunks of indices via atomic fetch-and-add on counters in an MPI window (rather than via requests), from their node first\n"
+				"         -p: store checkpoints of completed index ranges and redundant indices per process at least every given number of seconds (and when a process is done) ; at ./data/[<hash>/]/dProofs-withConclusions/dProofs<n>-checkpoint-mpi/rank<r>.bin ; requires a shared data directory\n"
+				"         -z: resume from the checkpoints of previous runs with equal settings (and any number of processes), only distributing unfinished index ranges ; results in identical proof files\n";
+		_[Task::MpiGenerate] =
+				"    -M <limit or -1> [-b]\n"
+				"       MPI-based multi-node generation (-M <n>) of unfiltered proof files (with conclusions) at ./data/[<hash>/]dProofs-withConclusions/dProofs<k>-unfiltered<m>+.txt for k up to n ; requires a shared data directory\n"
+				"         -b: brief parsing ; append conclusion structures to D-proof processing and use them for rule evaluation (collects faster, but requires significantly more memory)\n";
 		return _;
 	}();
 	return _;
@@ -326,7 +357,7 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 	}
 	//#
 	vector<string> improvedAbstractDProof = abstractDProof;
-	map<string, string> bestResults = DlProofEnumerator::searchProofFiles(conclusions, false, false, true, nullptr, true);
+	map<string, string> bestResults = DlProofEnumerator::searchProofFiles(conclusions, false, false, true, nullptr, false, true);
 	vector<size_t> indicesToCheck;
 	vector<string> proofsToCheck;
 	for (size_t i = 0; i < conclusions.size(); i++) {
@@ -446,6 +477,8 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 			cout << cmdInfo().at(Task::RebaseProofSummary);
 			cout << cmdInfo().at(Task::ConvertNaturalDeduction);
 			cout << cmdInfo().at(Task::SearchProofFiles);
+			cout << cmdInfo().at(Task::CreateTermIndex);
+			cout << cmdInfo().at(Task::ServeQueries);
 			cout << cmdInfo().at(Task::ExtractFromProofFiles);
 			cout << cmdInfo().at(Task::AssessGeneration);
 			cout << cmdInfo().at(Task::IterateProofCandidates);
@@ -453,6 +486,7 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 			cout << cmdInfo().at(Task::ConclusionLengthPlot);
 			cout << "Standalone:\n";
 			cout << cmdInfo().at(Task::MpiFilter);
+			cout << cmdInfo().at(Task::MpiGenerate);
 			cout << "Examples:\n"
 					"    pmGenerator -g -1 -q 50\n"
 					"    pmGenerator -g 19 -g 21 -u -r data/pmproofs-old.txt data/pmproofs-reducer.txt -d -a SD data/pmproofs-reducer.txt data/pmproofs-old.txt data/pmproofs-result-styleAll-modifiedOnly.txt -s -w -d\n"
@@ -538,6 +572,10 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 				return Task::ParseAndPrintProofs;
 			else if (s == "search")
 				return Task::SearchProofFiles;
+			else if (s == "index")
+				return Task::CreateTermIndex;
+			else if (s == "serve")
+				return Task::ServeQueries;
 			else if (s == "iterate")
 				return Task::IterateProofCandidates;
 			else if (s == "variate")
@@ -546,6 +584,8 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 				return Task::ConclusionLengthPlot;
 			else if (s == "m")
 				return Task::MpiFilter;
+			else if (s == "M")
+				return Task::MpiGenerate;
 			else
 				return tasks.empty() ? Task::Invalid : tasks.back().task;
 		};
@@ -562,11 +602,11 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 			mpiIgnoreCount++;
 			extractedEnv = false;
 			break;
-		case 'g': // -g <limit or -1> [-u] [-q <limit>] [-l <limit or -1>] [-k <limit or -1>] [-b] [-f] [-s]
+		case 'g': // -g <limit or -1> [-u] [-q <limit>] [-l <limit or -1>] [-k <limit or -1>] [-b] [-j] [-f] [-s] [-i] [-p <seconds>] [-z] [-x <MiB>] [-o]
 			if (i + 1 >= argc)
 				return printUsage("Missing parameter for \"-" + string { c } + "\".", recent(string { c }));
 			try {
-				tasks.emplace_back(Task::Generate, map<string, string> { }, map<string, int64_t> { { "limit", stoi(argv[++i]) }, { "candidateQueueCapacities", 0 }, { "maxSymbolicConclusionLength", -1 }, { "maxSymbolicConsequentLength", -1 } }, map<string, bool> { { "redundantSchemaRemoval", true }, { "withConclusions", true }, { "useConclusionStrings", true }, { "useConclusionTrees", false }, { "whether -q was called", false } });
+				tasks.emplace_back(Task::Generate, map<string, string> { }, map<string, int64_t> { { "limit", stoi(argv[++i]) }, { "candidateQueueCapacities", 0 }, { "maxSymbolicConclusionLength", -1 }, { "maxSymbolicConsequentLength", -1 }, { "checkpointInterval", 0 }, { "memoryBudget", 0 } }, map<string, bool> { { "redundantSchemaRemoval", true }, { "withConclusions", true }, { "useConclusionStrings", true }, { "useConclusionTrees", false }, { "groupedEvaluation", false }, { "onlineSchemaRemoval", false }, { "useSchemaIndex", true }, { "resume", false }, { "whether -q was called", false } });
 			} catch (...) {
 				return printUsage("Invalid parameter \"" + string(argv[i]) + "\" for \"-" + string { c } + "\".", recent(string { c }));
 			}
@@ -583,7 +623,7 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 			tasks.emplace_back(Task::ApplyReplacements, map<string, string> { { "initials", argv[i + 1] }, { "replacementsFile", argv[i + 2] }, { "dProofDB", argv[i + 3] }, { "outputFile", argv[i + 4] } }, map<string, int64_t> { }, map<string, bool> { { "styleAll", false }, { "listAll", false }, { "wrap", false }, { "debug", false } });
 			i += 4;
 			break;
-		case 'm': // -m <limit> [-s]
+		case 'm': // -m <limit> [-s] [-i] [-w] [-p <seconds>] [-z]
 			if (tasks.size() > mpiIgnoreCount)
 				return printUsage("Invalid argument \"-" + string { c } + "\": Can only be combined with preceding configuring commands.");
 			if (i + 1 >= argc)
@@ -594,10 +634,22 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 				from_chars_result result = FctHelper::toUInt(param, value);
 				if (result.ec != errc())
 					return printUsage("Invalid parameter \"" + param + "\" for \"-" + string { c } + "\".", recent(string { c }));
-				tasks.emplace_back(Task::MpiFilter, map<string, string> { }, map<string, int64_t> { { "wordLengthLimit", value } }, map<string, bool> { { "smoothProgress", true } });
+				tasks.emplace_back(Task::MpiFilter, map<string, string> { }, map<string, int64_t> { { "wordLengthLimit", value }, { "checkpointInterval", 0 } }, map<string, bool> { { "smoothProgress", true }, { "useSchemaIndex", true }, { "oneSidedBalancing", false }, { "resume", false } });
 				mpiArg = "-m";
 			}
 			break;
+		case 'M': // -M <limit or -1> [-b]
+			if (tasks.size() > mpiIgnoreCount)
+				return printUsage("Invalid argument \"-" + string { c } + "\": Can only be combined with preceding configuring commands.");
+			if (i + 1 >= argc)
+				return printUsage("Missing parameter for \"-" + string { c } + "\".", recent(string { c }));
+			try {
+				tasks.emplace_back(Task::MpiGenerate, map<string, string> { }, map<string, int64_t> { { "limit", stoi(argv[++i]) } }, map<string, bool> { { "useConclusionTrees", false } });
+			} catch (...) {
+				return printUsage("Invalid parameter \"" + string(argv[i]) + "\" for \"-" + string { c } + "\".", recent(string { c }));
+			}
+			mpiArg = "-M";
+			break;
 		case '-': { // "--<command>"
 			string command { argv[i] + 2 };
 			if (command == "parse") { // --parse <string> [-n] [-u] [-j <limit or -1>] [-b] [-s] [-e] [-f] [-o <output file>] [-d]
@@ -625,17 +677,21 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 				if (i + 1 >= argc)
 					return printUsage("Missing parameter for \"--" + command + "\".", recent(command));
 				tasks.emplace_back(Task::ConvertNaturalDeduction, map<string, string> { { "inputFile", argv[++i] }, { "baseFile", "" }, { "outputFile", "" } }, map<string, int64_t> { }, map<string, bool> { { "useBaseFile", false }, { "useOutputFile", false }, { "normalPolishNotation", false }, { "printInfixUnicode", false }, { "pure", true }, { "keepAllTheorems", false }, { "debug", false } });
-			} else if (command == "search") { // --search <string> [-n] [-s] [-w] [-t] [-p] [-f] [-d]
+			} else if (command == "search") { // --search <string> [-n] [-s] [-w] [-t] [-p] [-f] [-i] [-d]
 				if (i + 1 >= argc)
 					return printUsage("Missing parameter for \"--" + command + "\".", recent(command));
-				tasks.emplace_back(Task::SearchProofFiles, map<string, string> { { "string", argv[++i] } }, map<string, int64_t> { }, map<string, bool> { { "useInputFile", false }, { "normalPolishNotation", false }, { "searchProofs", false }, { "schemaSearch", false }, { "multiSchemaSearch", false }, { "abstractSearch", false }, { "debug", false } });
-			} else if (command == "extract") // --extract [-t <limit or -1>] [-o <output file>] [-s] [-z] [-# <amount up to 35>] [-h <string>] [-l <limit or -1>] [-k <limit or -1>] [-f] [-d]
+				tasks.emplace_back(Task::SearchProofFiles, map<string, string> { { "string", argv[++i] } }, map<string, int64_t> { }, map<string, bool> { { "useInputFile", false }, { "normalPolishNotation", false }, { "searchProofs", false }, { "schemaSearch", false }, { "multiSchemaSearch", false }, { "abstractSearch", false }, { "createIndex", false }, { "debug", false } });
+			} else if (command == "index") // --index [-d]
+				tasks.emplace_back(Task::CreateTermIndex, map<string, string> { }, map<string, int64_t> { }, map<string, bool> { { "debug", false } });
+			else if (command == "serve") // --serve [-u <socket path>] [-d]
+				tasks.emplace_back(Task::ServeQueries, map<string, string> { { "socketPath", "" } }, map<string, int64_t> { }, map<string, bool> { { "useSocket", false }, { "debug", false } });
+			else if (command == "extract") // --extract [-t <limit or -1>] [-o <output file>] [-s] [-z] [-# <amount up to 35>] [-h <string>] [-l <limit or -1>] [-k <limit or -1>] [-f] [-d]
 				tasks.emplace_back(Task::ExtractFromProofFiles, map<string, string> { { "proofs", "" }, { "outputFile", "" } }, map<string, int64_t> { { "extractToFileAmount", 0 }, { "extractToSystemAmount", 0 }, { "maxConclusionLength", 0 }, { "maxConsequentLength", 0 } }, map<string, bool> { { "useInputFile", false }, { "useOutputFile", false }, { "allowRedundantSchemaRemoval", false }, { "forceRedundantSchemaRemoval", false }, { "debug", false }, { "whether -t was called", false }, { "whether -# was called", false }, { "whether -h was called", false }, { "whether -l was called", false }, { "whether -k was called", false } });
 			else if (command == "assess") // --assess [-u] [-s] [-d]
 				tasks.emplace_back(Task::AssessGeneration, map<string, string> { }, map<string, int64_t> { }, map<string, bool> { { "redundantSchemaRemoval", true }, { "withConclusions", true }, { "debug", false } });
 			else if (command == "iterate") // --iterate [-u] [-s]
 				tasks.emplace_back(Task::IterateProofCandidates, map<string, string> { }, map<string, int64_t> { }, map<string, bool> { { "redundantSchemaRemoval", true }, { "withConclusions", true } });
-			else if (command == "variate") {  // --variate ( 0 | 1 ) [-l <path>] [-i <prefix>] [-o <prefix>] [-s] [-d]
+			else if (command == "variate") {  // --variate ( 0 | 1 ) [-l <path>] [-i <prefix>] [-o <prefix>] [-s] [-b] [-d]
 				if (i + 1 >= argc)
 					return printUsage("Missing parameter for \"--" + command + "\".", recent(command));
 				else {
@@ -643,7 +699,7 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 					if (param != "0" && param != "1")
 						return printUsage("Invalid parameter \"" + param + "\" for \"--" + command + "\".", recent(command));
 					bool with = param == "1";
-					tasks.emplace_back(Task::FileConversion, map<string, string> { { "dataLocation", "data" }, { "inputFilePrefix", with ? "dProofs-withoutConclusions/dProofs" : "dProofs-withConclusions/dProofs" }, { "outputFilePrefix", with ? "dProofs-withConclusions/dProofs" : "dProofs-withoutConclusions/dProofs" } }, map<string, int64_t> { }, map<string, bool> { { "memoryOnly", false }, { "debug", false }, { "with", with } });
+					tasks.emplace_back(Task::FileConversion, map<string, string> { { "dataLocation", "data" }, { "inputFilePrefix", with ? "dProofs-withoutConclusions/dProofs" : "dProofs-withConclusions/dProofs" }, { "outputFilePrefix", with ? "dProofs-withConclusions/dProofs" : "dProofs-withoutConclusions/dProofs" } }, map<string, int64_t> { }, map<string, bool> { { "memoryOnly", false }, { "binaryCompanions", false }, { "debug", false }, { "with", with } });
 				}
 				break;
 			} else if (command == "plot") // --plot [-l <path>] [-i <prefix>] [-s] [-u] [-t] [-x <limit or -1>] [-y <limit or -1>] [-o <output file>] [-d]
@@ -680,8 +736,12 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 			default:
 				return printUsage("Invalid argument \"-" + string { c } + "\".", recent());
 			case Task::Generate: // -g -b (brief parsing)
+			case Task::MpiGenerate: // -M -b (brief parsing)
 				tasks.back().bln["useConclusionTrees"] = true;
 				break;
+			case Task::FileConversion: // --variate -b (also create binary companions of created proof files)
+				tasks.back().bln["binaryCompanions"] = true;
+				break;
 			case Task::ParseAndPrintProofs: // --parse -b (only print conclusions of the given proofs)
 				tasks.back().bln["conclusionsOnly"] = true;
 				if (!tasks.back().bln["whether -j was called"])
@@ -715,6 +775,8 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 			case Task::RebaseProofSummary: //         --rebase -d (print debug information)
 			case Task::ConvertNaturalDeduction: // --ndconvert -d (print debug information)
 			case Task::SearchProofFiles: //           --search -d (print debug information)
+			case Task::CreateTermIndex: //             --index -d (print debug information)
+			case Task::ServeQueries: //                --serve -d (print debug information)
 			case Task::ExtractFromProofFiles: //     --extract -d (print debug information)
 			case Task::AssessGeneration: //           --assess -d (print debug information)
 			case Task::FileConversion: //            --variate -d (print debug information)
@@ -784,6 +846,9 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 				tasks.back().str["axiomFilePath"] = argv[++i];
 				tasks.back().bln["useInputFile"] = true;
 				break;
+			case Task::Generate: // -g -i (disable generalization index for redundant schema removal)
+				tasks.back().bln["useSchemaIndex"] = false;
+				break;
 			case Task::CreateReplacements: // -r -i <prefix> (customize input file path prefix in data location)
 				if (i + 1 >= argc)
 					return printUsage("Missing parameter for \"-" + string { c } + "\".", recent(string { c }));
@@ -806,12 +871,22 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 					return printUsage("Missing parameter for \"-" + string { c } + "\".", recent(string { c }));
 				tasks.back().str["inputFilePrefix"] = argv[++i];
 				break;
+			case Task::MpiFilter: // -m -i (disable generalization index)
+				tasks.back().bln["useSchemaIndex"] = false;
+				break;
+			case Task::SearchProofFiles: // --search -i (create lookup index if missing or outdated)
+				tasks.back().bln["createIndex"] = true;
+				break;
 			}
 			break;
 		case 'j':
 			switch (lastTask()) {
 			default:
 				return printUsage("Invalid argument \"-" + string { c } + "\".", recent());
+			case Task::Generate: // -g -j (joint rule evaluation)
+				tasks.back().bln["useConclusionTrees"] = true;
+				tasks.back().bln["groupedEvaluation"] = true;
+				break;
 			case Task::ParseAndPrintProofs: // --parse -j <limit or -1> (join common subproofs together when they are used at least a given amount of times)
 				if (i + 1 >= argc)
 					return printUsage("Missing parameter for \"-" + string { c } + "\".", recent(string { c }));
@@ -952,6 +1027,9 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 			switch (lastTask()) {
 			default:
 				return printUsage("Invalid argument \"-" + string { c } + "\".", recent());
+			case Task::Generate: // -g -o (online schema removal)
+				tasks.back().bln["onlineSchemaRemoval"] = true;
+				break;
 			case Task::ParseAndPrintProofs: //         --parse -o <output file> (redirect the result's output to the specified file)
 			case Task::TransformProofSummary: //   --transform -o <output file> (redirect the result's output to the specified file)
 			case Task::UnfoldProofSummary: //         --unfold -o <output file> (redirect the result's output to the specified file)
@@ -980,6 +1058,19 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 			switch (lastTask()) {
 			default:
 				return printUsage("Invalid argument \"-" + string { c } + "\".", recent());
+			case Task::Generate: // -g -p <seconds> (store checkpoints of proof collection at least every given number of seconds)
+			case Task::MpiFilter: // -m -p <seconds> (store checkpoints of filtering at least every given number of seconds)
+				if (i + 1 >= argc)
+					return printUsage("Missing parameter for \"-" + string { c } + "\".", recent(string { c }));
+				else {
+					string param = string(argv[++i]);
+					unsigned value;
+					from_chars_result result = FctHelper::toUInt(param, value);
+					if (result.ec != errc())
+						return printUsage("Invalid parameter \"" + param + "\" for \"-" + string { c } + "\".", recent(string { c }));
+					tasks.back().num["checkpointInterval"] = value;
+				}
+				break;
 			case Task::TransformProofSummary: // --transform -p <limit or -1> (only keep subproofs with primitive lengths not exceeding the given limit)
 				if (i + 1 >= argc)
 					return printUsage("Missing parameter for \"-" + string { c } + "\".", recent(string { c }));
@@ -998,7 +1089,7 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 			switch (lastTask()) {
 			default:
 				return printUsage("Invalid argument \"-" + string { c } + "\".", recent());
-			case Task::Generate: // -g -q <limit> (limit number of proof candidate strings queued per worker thread)
+			case Task::Generate: // -g -q <limit> (limit number of proof candidate strings pending per worker thread)
 				if (i + 1 >= argc)
 					return printUsage("Missing parameter for \"-" + string { c } + "\".", recent(string { c }));
 				try {
@@ -1110,6 +1201,12 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 			case Task::ConclusionLengthPlot: // --plot -u (include unfiltered proof files)
 				tasks.back().bln["includeUnfiltered"] = true;
 				break;
+			case Task::ServeQueries: // --serve -u <socket path> (read requests from connections to a Unix domain socket at the given path)
+				if (i + 1 >= argc)
+					return printUsage("Missing parameter for \"-" + string { c } + "\".", recent(string { c }));
+				tasks.back().str["socketPath"] = argv[++i];
+				tasks.back().bln["useSocket"] = true;
+				break;
 			}
 			break;
 		case 'v':
@@ -1141,12 +1238,27 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 			case Task::SearchProofFiles: // --search -w (search whole collections of schemas)
 				tasks.back().bln["multiSchemaSearch"] = true;
 				break;
+			case Task::MpiFilter: // -m -w (one-sided workload distribution)
+				tasks.back().bln["oneSidedBalancing"] = true;
+				break;
 			}
 			break;
 		case 'x':
 			switch (lastTask()) {
 			default:
 				return printUsage("Invalid argument \"-" + string { c } + "\".", recent());
+			case Task::Generate: // -g -x <MiB> (out-of-core collection with a memory budget for conclusions)
+				if (i + 1 >= argc)
+					return printUsage("Missing parameter for \"-" + string { c } + "\".", recent(string { c }));
+				else {
+					string param = string(argv[++i]);
+					unsigned value;
+					from_chars_result result = FctHelper::toUInt(param, value);
+					if (result.ec != errc() || !value)
+						return printUsage("Invalid parameter \"" + param + "\" for \"-" + string { c } + "\".", recent(string { c }));
+					tasks.back().num["memoryBudget"] = value;
+				}
+				break;
 			case Task::TransformProofSummary: // --transform -x <limit> (proof compression with extended modification range)
 				if (i + 1 >= argc)
 					return printUsage("Missing parameter for \"-" + string { c } + "\".", recent(string { c }));
@@ -1187,6 +1299,10 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 			switch (lastTask()) {
 			default:
 				return printUsage("Invalid argument \"-" + string { c } + "\".", recent());
+			case Task::Generate: // -g -z (resume from checkpoint)
+			case Task::MpiFilter: // -m -z (resume from checkpoints)
+				tasks.back().bln["resume"] = true;
+				break;
 			case Task::TransformProofSummary: // --transform -z (proof compression)
 				tasks.back().bln["compress"] = true;
 				break;
@@ -1230,8 +1346,8 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 					ss << ++index << ". resetRepresentativesFor(" << (t.bln["defaultSystem"] ? "null" : "\"" + (t.bln["useInputFile"] ? t.str["axiomFilePath"] : t.str["axiomString"]) + "\"") << ", " << bstr(t.bln["normalPolishNotation"]) << ", " << (unsigned) t.num["necessitationLimit"] << ", " << bstr(t.bln["speedupN"]) << (t.bln["extractedSystem"] ? ", \"" + t.str["extractedSystemId"] + "\"" : "") << ")\n";
 					break;
 				case Task::Generate: { // -g
-					unsigned optParams = t.bln["useConclusionTrees"] ? 5 : t.bln["useConclusionStrings"] ? 4 : t.num["maxSymbolicConsequentLength"] != -1 ? 3 : t.num["maxSymbolicConclusionLength"] != -1 ? 2 : t.bln["whether -q was called"] ? 1 : 0;
-					ss << ++index << ". generateDProofRepresentativeFiles(" << (unsigned) t.num["limit"] << ", " << bstr(t.bln["redundantSchemaRemoval"]) << ", " << bstr(t.bln["withConclusions"]) << (t.bln["whether -q was called"] ? string(", ") + to_string(size_t(t.num["candidateQueueCapacities"])) : optParams > 1 ? ", null" : "") << (t.num["maxSymbolicConclusionLength"] != -1 ? string(", ") + to_string(size_t(t.num["maxSymbolicConclusionLength"])) : optParams > 2 ? ", -1" : "") << (t.num["maxSymbolicConsequentLength"] != -1 ? string(", ") + to_string(size_t(t.num["maxSymbolicConsequentLength"])) : optParams > 3 ? ", -1" : "") << (t.bln["useConclusionStrings"] || optParams > 4 ? string(", ") + bstr(t.bln["useConclusionStrings"]) : "") << (t.bln["useConclusionTrees"] || optParams > 5 ? string(", ") + bstr(t.bln["useConclusionTrees"]) : "") << ")\n";
+					unsigned optParams = t.bln["onlineSchemaRemoval"] ? 11 : t.bln["groupedEvaluation"] ? 10 : t.num["memoryBudget"] ? 9 : t.bln["resume"] ? 8 : t.num["checkpointInterval"] ? 7 : !t.bln["useSchemaIndex"] ? 6 : t.bln["useConclusionTrees"] ? 5 : t.bln["useConclusionStrings"] ? 4 : t.num["maxSymbolicConsequentLength"] != -1 ? 3 : t.num["maxSymbolicConclusionLength"] != -1 ? 2 : t.bln["whether -q was called"] ? 1 : 0;
+					ss << ++index << ". generateDProofRepresentativeFiles(" << (unsigned) t.num["limit"] << ", " << bstr(t.bln["redundantSchemaRemoval"]) << ", " << bstr(t.bln["withConclusions"]) << (t.bln["whether -q was called"] ? string(", ") + to_string(size_t(t.num["candidateQueueCapacities"])) : optParams > 1 ? ", null" : "") << (t.num["maxSymbolicConclusionLength"] != -1 ? string(", ") + to_string(size_t(t.num["maxSymbolicConclusionLength"])) : optParams > 2 ? ", -1" : "") << (t.num["maxSymbolicConsequentLength"] != -1 ? string(", ") + to_string(size_t(t.num["maxSymbolicConsequentLength"])) : optParams > 3 ? ", -1" : "") << (t.bln["useConclusionStrings"] || optParams > 4 ? string(", ") + bstr(t.bln["useConclusionStrings"]) : "") << (t.bln["useConclusionTrees"] || optParams > 5 ? string(", ") + bstr(t.bln["useConclusionTrees"]) : "") << (!t.bln["useSchemaIndex"] || optParams > 6 ? string(", ") + bstr(t.bln["useSchemaIndex"]) : "") << (t.num["checkpointInterval"] || optParams > 7 ? ", " + to_string(t.num["checkpointInterval"]) : "") << (t.bln["resume"] ? ", true" : optParams > 8 ? ", false" : "") << (t.num["memoryBudget"] ? ", " + to_string(size_t(t.num["memoryBudget"]) << 20) : optParams > 9 ? ", 0" : "") << (t.bln["groupedEvaluation"] ? ", true" : optParams > 10 ? ", false" : "") << (t.bln["onlineSchemaRemoval"] ? ", true" : "") << ")\n";
 					break;
 				}
 				case Task::CreateReplacements: // -r
@@ -1259,7 +1375,13 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 					ss << ++index << ". convertFitchFxFileToDProofSummary(\"" << t.str["inputFile"] << "\", " << (t.bln["useOutputFile"] ? "\"" + t.str["outputFile"] + "\"" : "null") << ", " << (t.bln["useBaseFile"] ? "\"" + t.str["baseFile"] + "\"" : "null") << ", " << bstr(t.bln["normalPolishNotation"]) << ", " << bstr(t.bln["printInfixUnicode"]) << ", " << bstr(t.bln["pure"]) << ", " << bstr(t.bln["keepAllTheorems"]) << ", " << bstr(t.bln["debug"]) << ")\n";
 					break;
 				case Task::SearchProofFiles: // --search
-					ss << ++index << ". searchProofFiles(" << (t.bln["useInputFile"] ? "{ }" : "\"" + t.str["string"] + "\"") << ", " << bstr(t.bln["normalPolishNotation"]) << ", " << bstr(t.bln["searchProofs"]) << ", " << (t.bln["multiSchemaSearch"] ? 2 : t.bln["schemaSearch"] ? 1 : t.bln["abstractSearch"] ? 3 : 0) << ", " << (t.bln["useInputFile"] ? "\"" + t.str["string"] + "\"" : "null") << ", " << bstr(t.bln["debug"]) << ")\n";
+					ss << ++index << ". searchProofFiles(" << (t.bln["useInputFile"] ? "{ }" : "\"" + t.str["string"] + "\"") << ", " << bstr(t.bln["normalPolishNotation"]) << ", " << bstr(t.bln["searchProofs"]) << ", " << (t.bln["multiSchemaSearch"] ? 2 : t.bln["schemaSearch"] ? 1 : t.bln["abstractSearch"] ? 3 : 0) << ", " << (t.bln["useInputFile"] ? "\"" + t.str["string"] + "\"" : "null") << ", " << bstr(t.bln["createIndex"]) << ", " << bstr(t.bln["debug"]) << ")\n";
+					break;
+				case Task::CreateTermIndex: // --index
+					ss << ++index << ". createTermIndex(" << bstr(t.bln["debug"]) << ")\n";
+					break;
+				case Task::ServeQueries: // --serve
+					ss << ++index << ". serveQueries(" << (t.bln["useSocket"] ? "\"" + t.str["socketPath"] + "\"" : "null") << ", " << bstr(t.bln["debug"]) << ")\n";
 					break;
 				case Task::ExtractFromProofFiles: // --extract
 					if (t.bln["whether -t was called"])
@@ -1279,15 +1401,18 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 					break;
 				case Task::FileConversion: // --variate
 					if (t.bln["with"])
-						ss << ++index << ". createGeneratorFilesWithConclusions(\"" << t.str["dataLocation"] << "\", \"" << t.str["inputFilePrefix"] << "\", \"" << t.str["outputFilePrefix"] << "\", " << bstr(t.bln["memoryOnly"]) << ", " << bstr(t.bln["debug"]) << ")\n";
+						ss << ++index << ". createGeneratorFilesWithConclusions(\"" << t.str["dataLocation"] << "\", \"" << t.str["inputFilePrefix"] << "\", \"" << t.str["outputFilePrefix"] << "\", " << bstr(t.bln["memoryOnly"]) << ", " << bstr(t.bln["binaryCompanions"]) << ", " << bstr(t.bln["debug"]) << ")\n";
 					else
-						ss << ++index << ". createGeneratorFilesWithoutConclusions(\"" << t.str["dataLocation"] << "\", \"" << t.str["inputFilePrefix"] << "\", \"" << t.str["outputFilePrefix"] << "\", " << bstr(t.bln["memoryOnly"]) << ", " << bstr(t.bln["debug"]) << ")\n";
+						ss << ++index << ". createGeneratorFilesWithoutConclusions(\"" << t.str["dataLocation"] << "\", \"" << t.str["inputFilePrefix"] << "\", \"" << t.str["outputFilePrefix"] << "\", " << bstr(t.bln["memoryOnly"]) << ", " << bstr(t.bln["binaryCompanions"]) << ", " << bstr(t.bln["debug"]) << ")\n";
 					break;
 				case Task::ConclusionLengthPlot: // --plot
 					ss << ++index << ". printConclusionLengthPlotData(" << bstr(t.bln["measureSymbolicLength"]) << ", " << bstr(t.bln["table"]) << ", " << t.num["cutX"] << ", " << t.num["cutY"] << ", \"" << t.str["dataLocation"] << "\", \"" << t.str["inputFilePrefix"] << "\", " << bstr(t.bln["includeUnfiltered"]) << ", " << (t.str["mout"].empty() ? "null" : "\"" + t.str["mout"] + "\"") << ", " << bstr(t.bln["debug"]) << ")\n";
 					break;
 				case Task::MpiFilter: // -m
-					ss << ++index << ". mpi_filterDProofRepresentativeFile(" << (unsigned) t.num["wordLengthLimit"] << ", " << bstr(t.bln["smoothProgress"]) << ")\n";
+					ss << ++index << ". mpi_filterDProofRepresentativeFile(" << (unsigned) t.num["wordLengthLimit"] << ", " << bstr(t.bln["smoothProgress"]) << (!t.bln["useSchemaIndex"] || t.bln["oneSidedBalancing"] || t.num["checkpointInterval"] || t.bln["resume"] ? ", " + string(bstr(t.bln["useSchemaIndex"])) : "") << (t.bln["oneSidedBalancing"] || t.num["checkpointInterval"] || t.bln["resume"] ? ", " + string(bstr(t.bln["oneSidedBalancing"])) : "") << (t.num["checkpointInterval"] || t.bln["resume"] ? ", " + to_string(t.num["checkpointInterval"]) : "") << (t.bln["resume"] ? ", true" : "") << ")\n";
+					break;
+				case Task::MpiGenerate: // -M
+					ss << ++index << ". mpi_generateDProofRepresentativeFiles(" << (unsigned) t.num["limit"] << (t.bln["useConclusionTrees"] ? ", true" : "") << ")\n";
 					break;
 				}
 			cout << "Tasks:\n" << ss.str() << endl;
@@ -1334,11 +1459,11 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 				}
 				break;
 			}
-			case Task::Generate: { // -g <limit or -1> [-u] [-q <limit>] [-l <limit or -1>] [-k <limit or -1>] [-b] [-f] [-s]
-				unsigned optParams = t.bln["useConclusionTrees"] ? 5 : t.bln["useConclusionStrings"] ? 4 : t.num["maxSymbolicConsequentLength"] != -1 ? 3 : t.num["maxSymbolicConclusionLength"] != -1 ? 2 : t.bln["whether -q was called"] ? 1 : 0;
-				cout << "[Main] Calling generateDProofRepresentativeFiles(" << (unsigned) t.num["limit"] << ", " << bstr(t.bln["redundantSchemaRemoval"]) << ", " << bstr(t.bln["withConclusions"]) << (t.bln["whether -q was called"] ? string(", ") + to_string(size_t(t.num["candidateQueueCapacities"])) : optParams > 1 ? ", null" : "") << (t.num["maxSymbolicConclusionLength"] != -1 ? string(", ") + to_string(size_t(t.num["maxSymbolicConclusionLength"])) : optParams > 2 ? ", -1" : "") << (t.num["maxSymbolicConsequentLength"] != -1 ? string(", ") + to_string(size_t(t.num["maxSymbolicConsequentLength"])) : optParams > 3 ? ", -1" : "") << (t.bln["useConclusionStrings"] || optParams > 4 ? string(", ") + bstr(t.bln["useConclusionStrings"]) : "") << (t.bln["useConclusionTrees"] || optParams > 5 ? string(", ") + bstr(t.bln["useConclusionTrees"]) : "") << ")." << endl;
+			case Task::Generate: { // -g <limit or -1> [-u] [-q <limit>] [-l <limit or -1>] [-k <limit or -1>] [-b] [-j] [-f] [-s] [-i] [-p <seconds>] [-z] [-x <MiB>] [-o]
+				unsigned optParams = t.bln["onlineSchemaRemoval"] ? 11 : t.bln["groupedEvaluation"] ? 10 : t.num["memoryBudget"] ? 9 : t.bln["resume"] ? 8 : t.num["checkpointInterval"] ? 7 : !t.bln["useSchemaIndex"] ? 6 : t.bln["useConclusionTrees"] ? 5 : t.bln["useConclusionStrings"] ? 4 : t.num["maxSymbolicConsequentLength"] != -1 ? 3 : t.num["maxSymbolicConclusionLength"] != -1 ? 2 : t.bln["whether -q was called"] ? 1 : 0;
+				cout << "[Main] Calling generateDProofRepresentativeFiles(" << (unsigned) t.num["limit"] << ", " << bstr(t.bln["redundantSchemaRemoval"]) << ", " << bstr(t.bln["withConclusions"]) << (t.bln["whether -q was called"] ? string(", ") + to_string(size_t(t.num["candidateQueueCapacities"])) : optParams > 1 ? ", null" : "") << (t.num["maxSymbolicConclusionLength"] != -1 ? string(", ") + to_string(size_t(t.num["maxSymbolicConclusionLength"])) : optParams > 2 ? ", -1" : "") << (t.num["maxSymbolicConsequentLength"] != -1 ? string(", ") + to_string(size_t(t.num["maxSymbolicConsequentLength"])) : optParams > 3 ? ", -1" : "") << (t.bln["useConclusionStrings"] || optParams > 4 ? string(", ") + bstr(t.bln["useConclusionStrings"]) : "") << (t.bln["useConclusionTrees"] || optParams > 5 ? string(", ") + bstr(t.bln["useConclusionTrees"]) : "") << (!t.bln["useSchemaIndex"] || optParams > 6 ? string(", ") + bstr(t.bln["useSchemaIndex"]) : "") << (t.num["checkpointInterval"] || optParams > 7 ? ", " + to_string(t.num["checkpointInterval"]) : "") << (t.bln["resume"] ? ", true" : optParams > 8 ? ", false" : "") << (t.num["memoryBudget"] ? ", " + to_string(size_t(t.num["memoryBudget"]) << 20) : optParams > 9 ? ", 0" : "") << (t.bln["groupedEvaluation"] ? ", true" : optParams > 10 ? ", false" : "") << (t.bln["onlineSchemaRemoval"] ? ", true" : "") << ")." << endl;
 				size_t candidateQueueCapacities = static_cast<size_t>(t.num["candidateQueueCapacities"]);
-				DlProofEnumerator::generateDProofRepresentativeFiles((unsigned) t.num["limit"], t.bln["redundantSchemaRemoval"], t.bln["withConclusions"], t.bln["whether -q was called"] ? &candidateQueueCapacities : nullptr, t.num["maxSymbolicConclusionLength"], t.num["maxSymbolicConsequentLength"], t.bln["useConclusionStrings"], t.bln["useConclusionTrees"]);
+				DlProofEnumerator::generateDProofRepresentativeFiles((unsigned) t.num["limit"], t.bln["redundantSchemaRemoval"], t.bln["withConclusions"], t.bln["whether -q was called"] ? &candidateQueueCapacities : nullptr, t.num["maxSymbolicConclusionLength"], t.num["maxSymbolicConsequentLength"], t.bln["useConclusionStrings"], t.bln["useConclusionTrees"], t.bln["useSchemaIndex"], static_cast<uint32_t>(t.num["checkpointInterval"]), t.bln["resume"], size_t(t.num["memoryBudget"]) << 20, t.bln["groupedEvaluation"], t.bln["onlineSchemaRemoval"]);
 				break;
 			}
 			case Task::CreateReplacements: // -r <D-proof database> <output file> [-l <path>] [-i <prefix>] [-s] [-d]
@@ -1377,9 +1502,17 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 				cout << "[Main] Calling convertFitchFxFileToDProofSummary(\"" << t.str["inputFile"] << "\", " << (t.bln["useOutputFile"] ? "\"" + t.str["outputFile"] + "\"" : "null") << ", " << (t.bln["useBaseFile"] ? "\"" + t.str["baseFile"] + "\"" : "null") << ", " << bstr(t.bln["normalPolishNotation"]) << ", " << bstr(t.bln["printInfixUnicode"]) << ", " << bstr(t.bln["pure"]) << ", " << bstr(t.bln["keepAllTheorems"]) << ", " << bstr(t.bln["debug"]) << ")." << endl;
 				NdConverter::convertFitchFxFileToDProofSummary(t.str["inputFile"], t.bln["useOutputFile"] ? &t.str["outputFile"] : nullptr, t.bln["useBaseFile"] ? &t.str["baseFile"] : nullptr, t.bln["normalPolishNotation"], t.bln["printInfixUnicode"], t.bln["pure"], t.bln["keepAllTheorems"], t.bln["debug"]);
 				break;
-			case Task::SearchProofFiles: // --search <string> [-n] [-s] [-w] [-t] [-p] [-f] [-d]
-				cout << "[Main] Calling searchProofFiles(" << (t.bln["useInputFile"] ? "{ }" : "\"" + t.str["string"] + "\"") << ", " << bstr(t.bln["normalPolishNotation"]) << ", " << bstr(t.bln["searchProofs"]) << ", " << (t.bln["multiSchemaSearch"] ? 2 : t.bln["schemaSearch"] ? 1 : t.bln["abstractSearch"] ? 3 : 0) << ", " << (t.bln["useInputFile"] ? "\"" + t.str["string"] + "\"" : "null") << ", " << bstr(t.bln["debug"]) << ")." << endl;
-				DlProofEnumerator::searchProofFiles(t.bln["useInputFile"] ? vector<string> { } : FctHelper::stringSplit(t.str["string"], ","), t.bln["normalPolishNotation"], t.bln["searchProofs"], t.bln["multiSchemaSearch"] ? 2 : t.bln["schemaSearch"] ? 1 : t.bln["abstractSearch"] ? 3 : 0, t.bln["useInputFile"] ? &t.str["string"] : nullptr , t.bln["debug"]);
+			case Task::SearchProofFiles: // --search <string> [-n] [-s] [-w] [-t] [-p] [-f] [-i] [-d]
+				cout << "[Main] Calling searchProofFiles(" << (t.bln["useInputFile"] ? "{ }" : "\"" + t.str["string"] + "\"") << ", " << bstr(t.bln["normalPolishNotation"]) << ", " << bstr(t.bln["searchProofs"]) << ", " << (t.bln["multiSchemaSearch"] ? 2 : t.bln["schemaSearch"] ? 1 : t.bln["abstractSearch"] ? 3 : 0) << ", " << (t.bln["useInputFile"] ? "\"" + t.str["string"] + "\"" : "null") << ", " << bstr(t.bln["createIndex"]) << ", " << bstr(t.bln["debug"]) << ")." << endl;
+				DlProofEnumerator::searchProofFiles(t.bln["useInputFile"] ? vector<string> { } : FctHelper::stringSplit(t.str["string"], ","), t.bln["normalPolishNotation"], t.bln["searchProofs"], t.bln["multiSchemaSearch"] ? 2 : t.bln["schemaSearch"] ? 1 : t.bln["abstractSearch"] ? 3 : 0, t.bln["useInputFile"] ? &t.str["string"] : nullptr , t.bln["createIndex"], t.bln["debug"]);
+				break;
+			case Task::CreateTermIndex: // --index [-d]
+				cout << "[Main] Calling createTermIndex(" << bstr(t.bln["debug"]) << ")." << endl;
+				DlProofEnumerator::createTermIndex(t.bln["debug"]);
+				break;
+			case Task::ServeQueries: // --serve [-u <socket path>] [-d]
+				cout << "[Main] Calling serveQueries(" << (t.bln["useSocket"] ? "\"" + t.str["socketPath"] + "\"" : "null") << ", " << bstr(t.bln["debug"]) << ")." << endl;
+				DlProofEnumerator::serveQueries(t.bln["useSocket"] ? &t.str["socketPath"] : nullptr, t.bln["debug"]);
 				break;
 			case Task::ExtractFromProofFiles: // --extract [-t <limit or -1>] [-o <output file>] [-s] [-z] [-# <amount up to 35>] [-h <string>] [-l <limit or -1>] [-k <limit or -1>] [-f] [-d]
 				if (t.bln["whether -t was called"]) {
@@ -1407,13 +1540,13 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 				cout << "[Main] Calling countNextIterationAmount(" << bstr(t.bln["redundantSchemaRemoval"]) << ", " << bstr(t.bln["withConclusions"]) << ")." << endl;
 				DlProofEnumerator::countNextIterationAmount(t.bln["redundantSchemaRemoval"], t.bln["withConclusions"]);
 				break;
-			case Task::FileConversion: // --variate ( 0 | 1 ) [-l <path>] [-i <prefix>] [-o <prefix>] [-s] [-d]
+			case Task::FileConversion: // --variate ( 0 | 1 ) [-l <path>] [-i <prefix>] [-o <prefix>] [-s] [-b] [-d]
 				if (t.bln["with"]) {
-					cout << "[Main] Calling createGeneratorFilesWithConclusions(\"" << t.str["dataLocation"] << "\", \"" << t.str["inputFilePrefix"] << "\", \"" << t.str["outputFilePrefix"] << "\", " << bstr(t.bln["memoryOnly"]) << ", " << bstr(t.bln["debug"]) << ")." << endl;
-					DlProofEnumerator::createGeneratorFilesWithConclusions(t.str["dataLocation"], t.str["inputFilePrefix"], t.str["outputFilePrefix"], t.bln["memoryOnly"], t.bln["debug"]);
+					cout << "[Main] Calling createGeneratorFilesWithConclusions(\"" << t.str["dataLocation"] << "\", \"" << t.str["inputFilePrefix"] << "\", \"" << t.str["outputFilePrefix"] << "\", " << bstr(t.bln["memoryOnly"]) << ", " << bstr(t.bln["binaryCompanions"]) << ", " << bstr(t.bln["debug"]) << ")." << endl;
+					DlProofEnumerator::createGeneratorFilesWithConclusions(t.str["dataLocation"], t.str["inputFilePrefix"], t.str["outputFilePrefix"], t.bln["memoryOnly"], t.bln["binaryCompanions"], t.bln["debug"]);
 				} else {
-					cout << "[Main] Calling createGeneratorFilesWithoutConclusions(\"" << t.str["dataLocation"] << "\", \"" << t.str["inputFilePrefix"] << "\", \"" << t.str["outputFilePrefix"] << "\", " << bstr(t.bln["memoryOnly"]) << ", " << bstr(t.bln["debug"]) << ")." << endl;
-					DlProofEnumerator::createGeneratorFilesWithoutConclusions(t.str["dataLocation"], t.str["inputFilePrefix"], t.str["outputFilePrefix"], t.bln["memoryOnly"], t.bln["debug"]);
+					cout << "[Main] Calling createGeneratorFilesWithoutConclusions(\"" << t.str["dataLocation"] << "\", \"" << t.str["inputFilePrefix"] << "\", \"" << t.str["outputFilePrefix"] << "\", " << bstr(t.bln["memoryOnly"]) << ", " << bstr(t.bln["binaryCompanions"]) << ", " << bstr(t.bln["debug"]) << ")." << endl;
+					DlProofEnumerator::createGeneratorFilesWithoutConclusions(t.str["dataLocation"], t.str["inputFilePrefix"], t.str["outputFilePrefix"], t.bln["memoryOnly"], t.bln["binaryCompanions"], t.bln["debug"]);
 				}
 				break;
 			case Task::ConclusionLengthPlot: // --plot [-l <path>] [-i <prefix>] [-s] [-u] [-t] [-x <limit or -1>] [-y <limit or -1>] [-o <output file>] [-d]
@@ -1429,13 +1562,21 @@ int main(int argc, char* argv[]) { // argc = 1 + N, argv = { <command>, <arg1>,
 					DlProofEnumerator::printConclusionLengthPlotData(t.bln["measureSymbolicLength"], t.bln["table"], t.num["cutX"], t.num["cutY"], t.str["dataLocation"], t.str["inputFilePrefix"], t.bln["includeUnfiltered"], &fout, t.bln["debug"]);
 				}
 				break;
-			case Task::MpiFilter: // -m <limit> [-s]
+			case Task::MpiFilter: { // -m <limit> [-s] [-i] [-w] [-p <seconds>] [-z]
 				stringstream ss;
-				ss << "[Rank " << mpi_rank << " ; pid: " << getpid() << " ; " << mpi_size << " process" << (mpi_size == 1 ? "" : "es") << "] Calling mpi_filterDProofRepresentativeFile(" << (unsigned) t.num["wordLengthLimit"] << ", " << bstr(t.bln["smoothProgress"]) << ").";
+				ss << "[Rank " << mpi_rank << " ; pid: " << getpid() << " ; " << mpi_size << " process" << (mpi_size == 1 ? "" : "es") << "] Calling mpi_filterDProofRepresentativeFile(" << (unsigned) t.num["wordLengthLimit"] << ", " << bstr(t.bln["smoothProgress"]) << (!t.bln["useSchemaIndex"] || t.bln["oneSidedBalancing"] || t.num["checkpointInterval"] || t.bln["resume"] ? ", " + string(bstr(t.bln["useSchemaIndex"])) : "") << (t.bln["oneSidedBalancing"] || t.num["checkpointInterval"] || t.bln["resume"] ? ", " + string(bstr(t.bln["oneSidedBalancing"])) : "") << (t.num["checkpointInterval"] || t.bln["resume"] ? ", " + to_string(t.num["checkpointInterval"]) : "") << (t.bln["resume"] ? ", true" : "") << ").";
 				cout << ss.str() << endl;
-				DlProofEnumerator::mpi_filterDProofRepresentativeFile((unsigned) t.num["wordLengthLimit"], t.bln["smoothProgress"]);
+				DlProofEnumerator::mpi_filterDProofRepresentativeFile((unsigned) t.num["wordLengthLimit"], t.bln["smoothProgress"], t.bln["useSchemaIndex"], t.bln["oneSidedBalancing"], static_cast<uint32_t>(t.num["checkpointInterval"]), t.bln["resume"]);
 				break;
 			}
+			case Task::MpiGenerate: { // -M <limit or -1> [-b]
+				stringstream ss;
+				ss << "[Rank " << mpi_rank << " ; pid: " << getpid() << " ; " << mpi_size << " process" << (mpi_size == 1 ? "" : "es") << "] Calling mpi_generateDProofRepresentativeFiles(" << (unsigned) t.num["limit"] << (t.bln["useConclusionTrees"] ? ", true" : "") << ").";
+				cout << ss.str() << endl;
+				DlProofEnumerator::mpi_generateDProofRepresentativeFiles((unsigned) t.num["limit"], t.bln["useConclusionTrees"]);
+				break;
+			}
+			}
 	} catch (exception& e) {
 		cerr << "ERROR exception thrown: " << e.what() << endl;
 	}
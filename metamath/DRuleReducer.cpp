@@ -61,8 +61,8 @@ void DRuleReducer::createReplacementsFile(const string& dProofDB, const string&
 	// 2. Load and parse generated D-proofs.
 	string fullInputFilePrefix = DlProofEnumerator::concatenateDataPath(dataLocation, inputFilePrefix);
 	string filePostfix = ".txt";
-	vector<vector<string>> allRepresentatives;
-	vector<vector<string>> allConclusions; // TODO: Need ability to parse conclusions on-the-fly in order to save RAM for huge generator files.
+	DlProofLookup allRepresentatives;
+	DlProofLookup allConclusions; // TODO: Need ability to parse conclusions on-the-fly in order to save RAM for huge generator files.
 	uint64_t allRepresentativesCount;
 	uint32_t start;
 	if (!DlProofEnumerator::loadDProofRepresentatives(allRepresentatives, withConclusions ? &allConclusions : nullptr, &allRepresentativesCount, nullptr, &start, debug, fullInputFilePrefix)) {